@@ -0,0 +1,302 @@
+#ifndef BENCH_FAKE_ODBC_DRIVER_H
+#define BENCH_FAKE_ODBC_DRIVER_H
+
+#include <odbccpp/odbcinterface.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ps {
+    namespace bench {
+        /**
+         * @class FakeOdbcDriver
+         * @brief Deterministic in-memory OdbcInterface serving a synthetic result set.
+         *
+         * Every call succeeds and does no work beyond copying the synthetic cell value
+         * into the caller's buffer, so a benchmark driving OdbcWrapper through it
+         * measures the wrapper's own overhead. Every executed query returns `rows` rows
+         * of `columns` columns, each cell holding the same value. SQLGetData returns
+         * long values in buffer-sized pieces and reports the remaining length, as a
+         * driver does for long columns; block cursor fetches fill the bound SQL_C_WCHAR
+         * or SQL_C_CHAR arrays. With setFailExecute(), queries fail with one diagnostic
+         * record so the error path can be measured.
+         *
+         * With setLatency(), SQLExecDirect emulates a server round trip: it sleeps for the
+         * latency, or, on a statement in SQL_ATTR_ASYNC_ENABLE mode, returns
+         * SQL_STILL_EXECUTING until the latency has passed. Only the latency bookkeeping is
+         * thread-safe, so concurrent benchmarks must stick to executing statements.
+         */
+        class FakeOdbcDriver final : public odbc::OdbcInterface {
+        private:
+            struct Binding {
+                SQLSMALLINT type = SQL_C_WCHAR;
+                SQLPOINTER  buffer = nullptr;
+                SQLLEN      length = 0;
+                SQLLEN*     indicators = nullptr;
+            };
+
+            std::vector<SQLWCHAR>   m_value; ///< Cell value as returned for SQL_C_WCHAR.
+            size_t                  m_rows = 0; ///< Rows returned by each query.
+            SQLSMALLINT             m_columns = 1; ///< Columns returned by each query.
+            size_t                  m_position = 0; ///< Rows fetched from the current result set.
+            size_t                  m_offset = 0; ///< Bytes of the current cell already returned.
+            SQLUSMALLINT            m_column = 0; ///< Column the offset refers to.
+            intptr_t                m_nextHandle = 0x1000; ///< Last handle value handed out.
+            SQLULEN                 m_rowArraySize = 1; ///< Current SQL_ATTR_ROW_ARRAY_SIZE.
+            SQLULEN*                m_rowsFetched = nullptr; ///< Current SQL_ATTR_ROWS_FETCHED_PTR.
+            std::vector<Binding>    m_bindings; ///< Column bindings, indexed by column number - 1.
+            bool                    m_failExecute = false; ///< Makes SQLExecDirect fail.
+            std::chrono::microseconds                                   m_latency{0}; ///< Emulated server time per execution.
+            std::mutex                                                  m_latencyMutex; ///< Guards the two members below.
+            std::set<SQLHSTMT>                                          m_async; ///< Statements in asynchronous mode.
+            std::map<SQLHSTMT, std::chrono::steady_clock::time_point>   m_started; ///< Start of asynchronous executions in flight.
+
+            /**
+             * @brief Emulates the server time of an execution.
+             *
+             * @return SQL_STILL_EXECUTING while an asynchronous execution is in progress, SQL_SUCCESS otherwise.
+             */
+            SQLRETURN waitForServer(SQLHSTMT hStmt) {
+                if (m_latency.count() == 0) {
+                    return SQL_SUCCESS;
+                }
+                const auto now = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard<std::mutex> lock(m_latencyMutex);
+                    if (m_async.count(hStmt) != 0) {
+                        auto started = m_started.emplace(hStmt, now).first;
+                        if (now - started->second < m_latency) {
+                            return SQL_STILL_EXECUTING;
+                        }
+                        m_started.erase(started);
+                        return SQL_SUCCESS;
+                    }
+                }
+                std::this_thread::sleep_for(m_latency);
+                return SQL_SUCCESS;
+            }
+
+            void fillCell(const Binding& binding, size_t row) {
+                unsigned char* element = static_cast<unsigned char*>(binding.buffer) + row * binding.length;
+                if (binding.type == SQL_C_CHAR) {
+                    const size_t chars = std::min(m_value.size(), static_cast<size_t>(binding.length) - 1);
+                    for (size_t i = 0; i < chars; i++) {
+                        element[i] = static_cast<unsigned char>(m_value[i]);
+                    }
+                    element[chars] = 0;
+                    binding.indicators[row] = static_cast<SQLLEN>(m_value.size());
+                } else {
+                    const size_t chars = std::min(m_value.size(), static_cast<size_t>(binding.length) / sizeof(SQLWCHAR) - 1);
+                    std::memcpy(element, m_value.data(), chars * sizeof(SQLWCHAR));
+                    std::memset(element + chars * sizeof(SQLWCHAR), 0, sizeof(SQLWCHAR));
+                    binding.indicators[row] = static_cast<SQLLEN>(m_value.size() * sizeof(SQLWCHAR));
+                }
+            }
+
+        public:
+            /**
+             * @brief Creates a driver serving `rows` rows of `columns` copies of `value`.
+             */
+            FakeOdbcDriver(size_t rows, SQLSMALLINT columns, const std::wstring& value)
+                : m_value(value.begin(), value.end()), m_rows(rows), m_columns(columns) {}
+
+            /**
+             * @brief Makes every following SQLExecDirect return SQL_ERROR with a diagnostic record.
+             */
+            void setFailExecute(bool fail) { m_failExecute = fail; }
+
+            /**
+             * @brief Makes every following SQLExecDirect take `latency` of emulated server time.
+             */
+            void setLatency(std::chrono::microseconds latency) { m_latency = latency; }
+
+            SQLRETURN SQLAllocHandle(SQLSMALLINT, SQLHANDLE, SQLHANDLE* OutputHandle) override {
+                *OutputHandle = reinterpret_cast<SQLHANDLE>(m_nextHandle++);
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLSetEnvAttr(SQLHENV, SQLINTEGER, SQLPOINTER, SQLINTEGER) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLConnect(SQLHDBC, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT) override {
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLConnectA(SQLHDBC, SQLCHAR*, SQLSMALLINT, SQLCHAR*, SQLSMALLINT, SQLCHAR*, SQLSMALLINT) override {
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLDisconnect(SQLHDBC) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLFreeHandle(SQLSMALLINT, SQLHANDLE) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLExecDirect(SQLHSTMT StatementHandle, SQLWCHAR*, SQLINTEGER) override {
+                if (waitForServer(StatementHandle) == SQL_STILL_EXECUTING) {
+                    return SQL_STILL_EXECUTING;
+                }
+                m_position = 0;
+                return m_failExecute ? SQL_ERROR : SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLExecDirectA(SQLHSTMT StatementHandle, SQLCHAR*, SQLINTEGER TextLength) override {
+                return SQLExecDirect(StatementHandle, nullptr, TextLength);
+            }
+
+            SQLRETURN SQLNumResultCols(SQLHSTMT, SQLSMALLINT* ColumnCount) override {
+                *ColumnCount = m_columns;
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLFetch(SQLHSTMT) override {
+                if (m_position == m_rows) {
+                    return SQL_NO_DATA;
+                }
+                m_position++;
+                m_column = 0;
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLGetData(SQLHSTMT, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType, SQLPOINTER TargetValue,
+                                 SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) override {
+                if (ColumnNumber != m_column) {
+                    m_column = ColumnNumber;
+                    m_offset = 0;
+                }
+                const size_t total = m_value.size() * sizeof(SQLWCHAR);
+                if (m_offset > 0 && m_offset == total) {
+                    return SQL_NO_DATA;
+                }
+                const size_t terminator = TargetType == SQL_C_WCHAR ? sizeof(SQLWCHAR) : TargetType == SQL_C_CHAR ? 1 : 0;
+                const size_t remaining = total - m_offset;
+                const size_t bytes = std::min(remaining, static_cast<size_t>(BufferLength) - terminator);
+                unsigned char* target = static_cast<unsigned char*>(TargetValue);
+                std::memcpy(target, reinterpret_cast<const unsigned char*>(m_value.data()) + m_offset, bytes);
+                std::memset(target + bytes, 0, terminator);
+                *StrLen_or_Ind = static_cast<SQLLEN>(remaining);
+                m_offset += bytes;
+                return bytes < remaining ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER) override {
+                if (Attribute == SQL_ATTR_ASYNC_ENABLE) {
+                    std::lock_guard<std::mutex> lock(m_latencyMutex);
+                    if (reinterpret_cast<SQLULEN>(Value) == SQL_ASYNC_ENABLE_ON) {
+                        m_async.insert(StatementHandle);
+                    } else {
+                        m_async.erase(StatementHandle);
+                    }
+                } else if (Attribute == SQL_ATTR_ROW_ARRAY_SIZE) {
+                    m_rowArraySize = reinterpret_cast<SQLULEN>(Value);
+                } else if (Attribute == SQL_ATTR_ROWS_FETCHED_PTR) {
+                    m_rowsFetched = static_cast<SQLULEN*>(Value);
+                }
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLBindCol(SQLHSTMT, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType, SQLPOINTER TargetValue,
+                                 SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) override {
+                if (m_bindings.size() < ColumnNumber) {
+                    m_bindings.resize(ColumnNumber);
+                }
+                m_bindings[ColumnNumber - 1] = Binding{TargetType, TargetValue, BufferLength, StrLen_or_Ind};
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLFetchScroll(SQLHSTMT, SQLSMALLINT, SQLLEN) override {
+                const size_t count = std::min<size_t>(m_rowArraySize, m_rows - m_position);
+                if (m_rowsFetched) {
+                    *m_rowsFetched = count;
+                }
+                if (count == 0) {
+                    return SQL_NO_DATA;
+                }
+                for (const Binding& binding : m_bindings) {
+                    if (!binding.buffer) {
+                        continue;
+                    }
+                    for (size_t r = 0; r < count; r++) {
+                        fillCell(binding, r);
+                    }
+                }
+                m_position += count;
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLPrepare(SQLHSTMT, SQLWCHAR*, SQLINTEGER) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLBindParameter(SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLULEN,
+                                       SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN*) override {
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLExecute(SQLHSTMT) override {
+                m_position = 0;
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLFreeStmt(SQLHSTMT, SQLUSMALLINT) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLCancel(SQLHSTMT) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLMoreResults(SQLHSTMT) override { return SQL_NO_DATA; }
+
+            SQLRETURN SQLGetConnectAttr(SQLHDBC, SQLINTEGER, SQLPOINTER Value, SQLINTEGER, SQLINTEGER*) override {
+                *static_cast<SQLUINTEGER*>(Value) = SQL_CD_FALSE;
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLSetConnectAttr(SQLHDBC, SQLINTEGER, SQLPOINTER, SQLINTEGER) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLEndTran(SQLSMALLINT, SQLHANDLE, SQLSMALLINT) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLDescribeCol(SQLHSTMT, SQLUSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLSMALLINT*, SQLSMALLINT* DataType,
+                                     SQLULEN* ColumnSize, SQLSMALLINT* DecimalDigits, SQLSMALLINT* Nullable) override {
+                *DataType = SQL_WVARCHAR;
+                *ColumnSize = m_value.size();
+                *DecimalDigits = 0;
+                *Nullable = SQL_NO_NULLS;
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLRowCount(SQLHSTMT, SQLLEN* RowCount) override {
+                if (RowCount) { // executeUpdate() passes none
+                    *RowCount = static_cast<SQLLEN>(m_rows);
+                }
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLSetPos(SQLHSTMT, SQLSETPOSIROW, SQLUSMALLINT, SQLUSMALLINT) override { return SQL_SUCCESS; }
+
+            SQLRETURN SQLGetInfo(SQLHDBC, SQLUSMALLINT, SQLPOINTER InfoValue, SQLSMALLINT, SQLSMALLINT*) override {
+                *static_cast<SQLUINTEGER*>(InfoValue) = 0; // SQL_GETDATA_EXTENSIONS: every cell fits its binding
+                return SQL_SUCCESS;
+            }
+
+            SQLRETURN SQLGetDiagRec(SQLSMALLINT, SQLHANDLE, SQLSMALLINT RecNumber, SQLWCHAR* SQLState, SQLINTEGER* NativeError,
+                                    SQLWCHAR* MessageText, SQLSMALLINT BufferLength, SQLSMALLINT* TextLength) override {
+                if (!m_failExecute || RecNumber != 1) {
+                    return SQL_NO_DATA;
+                }
+                static const char state[] = "42S02";
+                static const char message[] = "Base table or view not found";
+                // Zero-filled past the end so that the text is also terminated when read as wchar_t.
+                std::fill(SQLState, SQLState + 6, SQLWCHAR(0));
+                std::copy(state, state + 5, SQLState);
+                const size_t chars = std::min<size_t>(sizeof(message) - 1, static_cast<size_t>(BufferLength) - 4);
+                std::fill(MessageText, MessageText + chars + 4, SQLWCHAR(0));
+                std::copy(message, message + chars, MessageText);
+                *NativeError = 208;
+                *TextLength = static_cast<SQLSMALLINT>(chars);
+                return SQL_SUCCESS;
+            }
+        };
+    }
+}
+#endif // BENCH_FAKE_ODBC_DRIVER_H
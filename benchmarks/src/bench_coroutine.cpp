@@ -0,0 +1,119 @@
+#include <fakeodbcdriver.h>
+#include <odbccpp/odbccoroutine.h>
+#include <odbccpp/odbcwrapper.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using ps::bench::FakeOdbcDriver;
+using ps::odbc::CoroutineConnection;
+using ps::odbc::CoroutineExecutor;
+using ps::odbc::OdbcWrapper;
+using ps::odbc::Task;
+
+namespace {
+    constexpr std::chrono::microseconds SERVER_LATENCY{1000}; ///< Emulated server time of every query.
+    const std::wstring QUERY = L"UPDATE sessions SET last_seen = CURRENT_TIMESTAMP WHERE id = 42";
+
+    /**
+     * @brief Single-threaded executor: posted work runs on the thread calling runUntil().
+     */
+    class RunQueue {
+    private:
+        std::mutex                          m_mutex;
+        std::condition_variable             m_ready;
+        std::deque<std::function<void()>>   m_work;
+
+    public:
+        CoroutineExecutor executor() {
+            return [this](std::function<void()> work) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_work.push_back(std::move(work));
+                }
+                m_ready.notify_one();
+            };
+        }
+
+        template <typename Done>
+        void runUntil(Done done) {
+            while (!done()) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_ready.wait(lock, [this] { return !m_work.empty(); });
+                std::function<void()> work = std::move(m_work.front());
+                m_work.pop_front();
+                lock.unlock();
+                work();
+            }
+        }
+    };
+
+    /**
+     * @brief Creates a connected wrapper over a fake driver with emulated server latency.
+     */
+    std::unique_ptr<OdbcWrapper> makeWrapper() {
+        auto driver = std::make_unique<FakeOdbcDriver>(0, 1, L"");
+        driver->setLatency(SERVER_LATENCY);
+        auto wrapper = std::make_unique<OdbcWrapper>(std::move(driver));
+        wrapper->initialize();
+        wrapper->connect(L"BenchDSN", L"user", L"pass");
+        return wrapper;
+    }
+
+    /**
+     * @brief `queries` blocking executeUpdate() calls at once, each on its own thread and connection.
+     */
+    void BM_Concurrency_ThreadPerQuery(benchmark::State& state) {
+        const size_t queries = static_cast<size_t>(state.range(0));
+        std::vector<std::unique_ptr<OdbcWrapper>> connections;
+        for (size_t i = 0; i < queries; i++) {
+            connections.push_back(makeWrapper());
+        }
+
+        for (auto _ : state) {
+            std::vector<std::thread> threads;
+            threads.reserve(queries);
+            for (size_t i = 0; i < queries; i++) {
+                threads.emplace_back([&connections, i] { connections[i]->executeUpdate(QUERY); });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queries));
+    }
+
+    /**
+     * @brief `queries` coroutines in flight at once on one connection, one executor thread and one reactor.
+     */
+    void BM_Concurrency_Coroutines(benchmark::State& state) {
+        const size_t queries = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper();
+        RunQueue queue;
+        CoroutineConnection connection(*wrapper, queue.executor());
+
+        for (auto _ : state) {
+            size_t completed = 0;
+            for (size_t i = 0; i < queries; i++) {
+                spawn(connection.executor(), [](CoroutineConnection& conn, size_t& completed) -> Task<> {
+                    benchmark::DoNotOptimize(co_await conn.execute(QUERY));
+                    completed++;
+                }(connection, completed));
+            }
+            queue.runUntil([&completed, queries] { return completed == queries; });
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queries));
+    }
+}
+
+// 1k concurrent queries of 1 ms each; wall-clock time, as the work happens on other threads
+BENCHMARK(BM_Concurrency_ThreadPerQuery)->Arg(1000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Concurrency_Coroutines)->Arg(1000)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,57 @@
+#include <fakeodbcdriver.h>
+#include <odbccpp/odbcwrapper.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+using ps::bench::FakeOdbcDriver;
+using ps::odbc::OdbcWrapper;
+
+namespace {
+    /**
+     * @brief Creates a connected wrapper over a driver serving one cell of `bytes` bytes of SQLWCHAR data.
+     */
+    std::unique_ptr<OdbcWrapper> makeWrapper(size_t bytes) {
+        std::wstring value(bytes / sizeof(SQLWCHAR), L'x');
+        auto wrapper = std::make_unique<OdbcWrapper>(std::make_unique<FakeOdbcDriver>(1, 1, value));
+        wrapper->initialize();
+        wrapper->connect(L"BenchDSN", L"user", L"pass");
+        return wrapper;
+    }
+
+    /**
+     * @brief Reads one long value into a wide string through fetchResults().
+     */
+    void BM_FetchResults_LongValue(benchmark::State& state) {
+        const size_t bytes = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(bytes);
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT payload FROM documents");
+            auto results = wrapper->fetchResults();
+            benchmark::DoNotOptimize(results);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    }
+
+    /**
+     * @brief Streams one long value chunk by chunk to a sink that only counts bytes.
+     */
+    void BM_StreamColumn_LongValue(benchmark::State& state) {
+        const size_t bytes = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(bytes);
+        size_t streamed = 0;
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT payload FROM documents");
+            wrapper->fetchRow();
+            wrapper->streamColumn(1, [&streamed](const unsigned char*, size_t chunk) { streamed += chunk; });
+        }
+        benchmark::DoNotOptimize(streamed);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    }
+}
+
+// 1 KiB, 64 KiB and 16 MiB values
+BENCHMARK(BM_FetchResults_LongValue)->Arg(1 << 10)->Arg(64 << 10)->Arg(16 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StreamColumn_LongValue)->Arg(1 << 10)->Arg(64 << 10)->Arg(16 << 20)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,19 @@
+#include <odbclogger.h>
+
+#include <benchmark/benchmark.h>
+
+using ps::odbc::OdbcLogger;
+
+int main(int argc, char** argv) {
+    // Only errors are logged, so the logger does not dominate the measured paths
+    OdbcLogger::initialize("logs/odbc_bench.log");
+    OdbcLogger::setLevel(spdlog::level::err);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,293 @@
+#include <fakeodbcdriver.h>
+#include <odbccpp/meteredodbcinterface.h>
+#include <odbccpp/odbcwrapper.h>
+
+#include <benchmark/benchmark.h>
+
+#include <codecvt>
+#include <locale>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ps::bench::FakeOdbcDriver;
+using ps::odbc::BasicOdbcWrapper;
+using ps::odbc::MeteredOdbcInterface;
+using ps::odbc::OdbcMetrics;
+using ps::odbc::OdbcWrapper;
+
+namespace {
+    const std::wstring CELL_VALUE = L"synthetic-value-0123456789"; ///< Value of every cell in row benchmarks.
+
+    /**
+     * @brief Creates an initialized wrapper over a fake driver, connected unless requested otherwise.
+     */
+    std::unique_ptr<OdbcWrapper> makeWrapper(size_t rows, SQLSMALLINT columns, FakeOdbcDriver** driver = nullptr,
+                                             bool connect = true) {
+        auto fake = std::make_unique<FakeOdbcDriver>(rows, columns, CELL_VALUE);
+        if (driver) {
+            *driver = fake.get();
+        }
+        auto wrapper = std::make_unique<OdbcWrapper>(std::move(fake));
+        wrapper->initialize();
+        if (connect) {
+            wrapper->connect(L"BenchDSN", L"user", L"pass");
+        }
+        return wrapper;
+    }
+
+    /**
+     * @brief Reports the rows handled per iteration as throughput and as time per row.
+     *
+     * `row_time` is in seconds per row; the JSON output holds it unscaled.
+     */
+    void setRowCounters(benchmark::State& state, size_t rows) {
+        const double total = static_cast<double>(state.iterations()) * static_cast<double>(rows);
+        state.SetItemsProcessed(static_cast<int64_t>(total));
+        state.counters["row_time"] = benchmark::Counter(total, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    }
+
+    void BM_ConnectDisconnect(benchmark::State& state) {
+        auto wrapper = makeWrapper(0, 1, nullptr, false);
+        for (auto _ : state) {
+            wrapper->connect(L"BenchDSN", L"user", L"pass");
+            wrapper->disconnect();
+        }
+    }
+
+    void BM_ExecuteQuery(benchmark::State& state) {
+        auto wrapper = makeWrapper(0, 1);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(wrapper->executeQuery(L"SELECT id, name FROM users WHERE id = 42"));
+        }
+    }
+
+    /**
+     * @brief fetchResults() with one SQLFetch per row and one SQLGetData per cell.
+     */
+    void BM_FetchResults_RowByRow(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(state.range(1)));
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            auto results = wrapper->fetchResults();
+            benchmark::DoNotOptimize(results);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief fetchResults(rowsetSize) through a block cursor with column-wise bound arrays.
+     */
+    void BM_FetchResults_Block(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(state.range(1)));
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            auto results = wrapper->fetchResults(256);
+            benchmark::DoNotOptimize(results);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief BM_FetchResults_Block through a MeteredOdbcInterface, measuring the cost of metering.
+     */
+    void BM_FetchResults_Block_Metered(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto metrics = std::make_shared<OdbcMetrics>();
+        auto fake = std::make_unique<FakeOdbcDriver>(rows, static_cast<SQLSMALLINT>(state.range(1)), CELL_VALUE);
+        auto wrapper = std::make_unique<OdbcWrapper>(std::make_unique<MeteredOdbcInterface>(std::move(fake), metrics));
+        wrapper->initialize();
+        wrapper->connect(L"BenchDSN", L"user", L"pass");
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            auto results = wrapper->fetchResults(256);
+            benchmark::DoNotOptimize(results);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief fetchResultSet(rowsetSize): the same block cursor as BM_FetchResults_Block, with cells packed into slabs.
+     *
+     * Both include freeing the result, which here is one deallocation per slab instead of one per cell and row.
+     */
+    void BM_FetchResultSet(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(state.range(1)));
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            auto results = wrapper->fetchResultSet(256);
+            benchmark::DoNotOptimize(results);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief fetchResults(rowsetSize) followed by the pivot into one vector per column that analytics code does.
+     */
+    void BM_FetchResults_Pivoted(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        const size_t columns = static_cast<size_t>(state.range(1));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(columns));
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            auto results = wrapper->fetchResults(256);
+            std::vector<std::vector<std::wstring>> pivoted(columns);
+            for (auto& column : pivoted) {
+                column.reserve(results.size());
+            }
+            for (auto& row : results) {
+                for (size_t c = 0; c < columns; c++) {
+                    pivoted[c].push_back(std::move(row[c]));
+                }
+            }
+            benchmark::DoNotOptimize(pivoted);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief fetchColumnar() appending each rowset straight from the bound arrays to contiguous columns.
+     */
+    void BM_FetchColumnar(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(state.range(1)));
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            auto result = wrapper->fetchColumnar(256);
+            benchmark::DoNotOptimize(result);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief fetchResults(rowsetSize) followed by the per-cell std::wstring_convert that UTF-8 consumers do.
+     */
+    void BM_FetchResults_ConvertedToUtf8(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(state.range(1)));
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+        for (auto _ : state) {
+            wrapper->executeQuery(L"SELECT * FROM users");
+            std::vector<std::vector<std::string>> results;
+            for (const auto& row : wrapper->fetchResults(256)) {
+                std::vector<std::string>& converted = results.emplace_back();
+                converted.reserve(row.size());
+                for (const std::wstring& value : row) {
+                    converted.push_back(converter.to_bytes(value));
+                }
+            }
+            benchmark::DoNotOptimize(results);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief fetchResultsUtf8(rowsetSize): SQL_C_CHAR bindings copied into std::string without conversion.
+     */
+    void BM_FetchResultsUtf8(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        auto wrapper = makeWrapper(rows, static_cast<SQLSMALLINT>(state.range(1)));
+        for (auto _ : state) {
+            wrapper->executeQuery(std::string_view("SELECT * FROM users"));
+            auto results = wrapper->fetchResultsUtf8(256);
+            benchmark::DoNotOptimize(results);
+        }
+        setRowCounters(state, rows);
+    }
+
+    /**
+     * @brief Builds `units` code units of UTF-16 text, ASCII apart from one 'ü' in every `asciiRun` units.
+     */
+    ps::odbc::SqlWString makeUtf16Text(size_t units, size_t asciiRun) {
+        ps::odbc::SqlWString text;
+        for (size_t i = 0; i < units; i++) {
+            text.push_back(i % asciiRun == asciiRun - 1 ? 0x00FC : static_cast<SQLWCHAR>('a' + i % 26));
+        }
+        return text;
+    }
+
+    /**
+     * @brief utf16ToUtf8() on mostly-ASCII text; the second argument is the length of the ASCII runs.
+     */
+    void BM_Utf16ToUtf8(benchmark::State& state) {
+        const ps::odbc::SqlWString text = makeUtf16Text(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+        for (auto _ : state) {
+            std::string utf8 = ps::odbc::utf16ToUtf8(text.data(), text.size());
+            benchmark::DoNotOptimize(utf8);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * static_cast<int64_t>(sizeof(SQLWCHAR)));
+    }
+
+    /**
+     * @brief The same conversion with std::wstring_convert, for comparison with BM_Utf16ToUtf8.
+     */
+    void BM_Utf16ToUtf8_WstringConvert(benchmark::State& state) {
+        const ps::odbc::SqlWString text = makeUtf16Text(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+        const std::u16string source(text.begin(), text.end());
+        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
+        for (auto _ : state) {
+            std::string utf8 = converter.to_bytes(source);
+            benchmark::DoNotOptimize(utf8);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * static_cast<int64_t>(sizeof(SQLWCHAR)));
+    }
+
+    /**
+     * @brief Row-by-row fetchResults() over `Wrapper`, reporting `cell_time`, the time per SQLGetData cell.
+     *
+     * OdbcWrapper reaches the driver through the OdbcInterface vtable; BasicOdbcWrapper<FakeOdbcDriver>
+     * calls the final driver class directly, so the difference is the cost of virtual dispatch.
+     */
+    template <typename Wrapper>
+    void BM_FetchResults_Dispatch(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        const SQLSMALLINT columns = static_cast<SQLSMALLINT>(state.range(1));
+        Wrapper wrapper(std::make_unique<FakeOdbcDriver>(rows, columns, CELL_VALUE));
+        wrapper.initialize();
+        wrapper.connect(L"BenchDSN", L"user", L"pass");
+        for (auto _ : state) {
+            wrapper.executeQuery(L"SELECT * FROM users");
+            auto results = wrapper.fetchResults();
+            benchmark::DoNotOptimize(results);
+        }
+        const double cells = static_cast<double>(state.iterations()) * static_cast<double>(rows * columns);
+        state.counters["cell_time"] = benchmark::Counter(cells, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    }
+
+    /**
+     * @brief A failing query: diagnostic retrieval, error logging and the thrown exception.
+     */
+    void BM_HandleError(benchmark::State& state) {
+        FakeOdbcDriver* driver = nullptr;
+        auto wrapper = makeWrapper(0, 1, &driver);
+        driver->setFailExecute(true);
+        for (auto _ : state) {
+            try {
+                wrapper->executeQuery(L"SELECT * FROM missing_table");
+            } catch (const std::runtime_error& e) {
+                benchmark::DoNotOptimize(e.what());
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_ConnectDisconnect);
+BENCHMARK(BM_ExecuteQuery);
+BENCHMARK(BM_FetchResults_RowByRow)->ArgNames({"rows", "cols"})->ArgsProduct({{1, 100, 10000}, {1, 8, 32}});
+BENCHMARK(BM_FetchResults_Block)->ArgNames({"rows", "cols"})->ArgsProduct({{1, 100, 10000}, {1, 8, 32}});
+BENCHMARK(BM_FetchResults_Block_Metered)->ArgNames({"rows", "cols"})->ArgsProduct({{1, 100, 10000}, {1, 8, 32}});
+BENCHMARK(BM_FetchResultSet)->ArgNames({"rows", "cols"})->ArgsProduct({{1, 100, 10000}, {1, 8, 32}});
+BENCHMARK(BM_FetchResults_Pivoted)->ArgNames({"rows", "cols"})->ArgsProduct({{100, 10000}, {8, 32}});
+BENCHMARK(BM_FetchColumnar)->ArgNames({"rows", "cols"})->ArgsProduct({{100, 10000}, {8, 32}});
+BENCHMARK(BM_FetchResults_ConvertedToUtf8)->ArgNames({"rows", "cols"})->ArgsProduct({{100, 10000}, {8, 32}});
+BENCHMARK(BM_FetchResultsUtf8)->ArgNames({"rows", "cols"})->ArgsProduct({{100, 10000}, {8, 32}});
+BENCHMARK(BM_Utf16ToUtf8)->ArgNames({"units", "run"})->ArgsProduct({{64, 4096}, {16, 1 << 20}});
+BENCHMARK(BM_Utf16ToUtf8_WstringConvert)->ArgNames({"units", "run"})->ArgsProduct({{64, 4096}, {16, 1 << 20}});
+BENCHMARK_TEMPLATE(BM_FetchResults_Dispatch, OdbcWrapper)->ArgNames({"rows", "cols"})->ArgsProduct({{1000}, {1, 8, 32}});
+BENCHMARK_TEMPLATE(BM_FetchResults_Dispatch, BasicOdbcWrapper<FakeOdbcDriver>)->ArgNames({"rows", "cols"})->ArgsProduct({{1000}, {1, 8, 32}});
+BENCHMARK(BM_HandleError);
@@ -0,0 +1,114 @@
+#ifndef ODBC_ASYNC_REACTOR_H
+#define ODBC_ASYNC_REACTOR_H
+
+#include <odbccpp/odbcinterface.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class AsyncReactor
+         * @brief Background thread that drives asynchronous ODBC calls to completion.
+         *
+         * A statement in SQL_ATTR_ASYNC_ENABLE mode returns SQL_STILL_EXECUTING until its
+         * operation finishes, and the same call has to be repeated to learn the outcome.
+         * The reactor repeats those calls for every in-flight operation from a single
+         * thread, sleeping `pollInterval` between passes, and runs each operation's
+         * completion on that thread once the call returns anything else. One reactor can
+         * serve many statements across many connections.
+         *
+         * The thread is started by the first submit(). The destructor waits for all
+         * in-flight operations to complete.
+         */
+        class AsyncReactor {
+        public:
+            /**
+             * @brief Repeats the asynchronous call and returns its result.
+             */
+            using Poll = std::function<SQLRETURN()>;
+
+            /**
+             * @brief Receives the first result other than SQL_STILL_EXECUTING.
+             */
+            using Completion = std::function<void(SQLRETURN)>;
+
+            static constexpr std::chrono::microseconds DEFAULT_POLL_INTERVAL{500}; ///< Sleep between polling passes.
+
+        private:
+            /**
+             * @brief An in-flight asynchronous call.
+             */
+            struct Operation {
+                SQLHSTMT    hStmt; ///< Statement the call runs on.
+                Poll        poll; ///< Repeats the call.
+                Completion  complete; ///< Receives the final result.
+            };
+
+            std::chrono::microseconds   m_pollInterval; ///< Sleep between polling passes.
+            mutable std::mutex          m_mutex; ///< Guards all members below.
+            std::condition_variable     m_wake; ///< Signalled on new operations and on shutdown.
+            std::condition_variable     m_completed; ///< Signalled whenever an operation completes.
+            std::vector<Operation>      m_operations; ///< Operations waiting for the next polling pass.
+            std::multiset<SQLHSTMT>     m_inFlight; ///< Statements with an operation not yet completed.
+            std::thread                 m_thread; ///< Polling thread, started on first use.
+            bool                        m_stopping = false; ///< Set by the destructor.
+
+            /**
+             * @brief Polls the in-flight operations until the reactor is stopped and drained.
+             */
+            void run();
+
+        public:
+            /**
+             * @brief Constructs an idle reactor.
+             *
+             * @param pollInterval The sleep between polling passes while operations are in flight.
+             */
+            explicit AsyncReactor(std::chrono::microseconds pollInterval = DEFAULT_POLL_INTERVAL);
+
+            /**
+             * @brief Waits for the in-flight operations and stops the thread.
+             */
+            ~AsyncReactor();
+
+            AsyncReactor(const AsyncReactor&) = delete;
+            AsyncReactor& operator=(const AsyncReactor&) = delete;
+
+            /**
+             * @brief Adds a call that returned SQL_STILL_EXECUTING to the polling set.
+             *
+             * The statement must not be used by anyone else until `complete` has run.
+             *
+             * @param hStmt The statement the call runs on.
+             * @param poll Repeats the call with the same arguments.
+             * @param complete Runs on the reactor thread with the final result.
+             */
+            void submit(SQLHSTMT hStmt, Poll poll, Completion complete);
+
+            /**
+             * @brief Blocks until no operation is in flight on a statement.
+             *
+             * Returns at once on the reactor thread, where a completion releasing its
+             * statement or disconnecting its wrapper ends up here: the completing
+             * operation has already finished, and no other could finish while the thread
+             * waits.
+             *
+             * @param hStmt The statement handle.
+             */
+            void waitFor(SQLHSTMT hStmt);
+
+            /**
+             * @brief Retrieves the number of operations not yet completed.
+             */
+            size_t pending() const;
+        };
+    }
+}
+#endif // ODBC_ASYNC_REACTOR_H
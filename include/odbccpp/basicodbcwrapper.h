@@ -0,0 +1,657 @@
+#ifndef ODBC_BASIC_WRAPPER_H
+#define ODBC_BASIC_WRAPPER_H
+
+#include <odbccpp/longdatareader.h>
+#include <odbccpp/odbcdiagnostic.h>
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/textcodec.h>
+#include <odbclogger.h>
+
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class BasicOdbcWrapper
+         * @brief Connection handling, query execution and row-by-row retrieval over a compile-time ODBC backend.
+         *
+         * `Backend` provides the member functions of OdbcInterface and is always called
+         * through its static type. With a concrete backend declared `final`, such as
+         * OdbcExecutor, every ODBC call, including the SQLGetData per cell in fetchResults(),
+         * is a direct call the compiler can inline rather than a virtual dispatch.
+         *
+         * OdbcWrapper is the type-erased form: it derives from BasicOdbcWrapper<OdbcInterface>,
+         * takes any implementation at run time (a mock in tests), and adds statements,
+         * cursors, prepared statements and asynchronous execution on top. The destructor,
+         * connect(), disconnect(), executeQuery() and executeUpdate() are virtual so that
+         * it can override them; that is one dispatch per call, not per ODBC function.
+         *
+         * @tparam Backend The ODBC implementation, e.g. OdbcExecutor.
+         */
+        template <typename Backend>
+        class BasicOdbcWrapper {
+        protected:
+            SQLHENV                     m_hEnv = SQL_NULL_HENV; ///< ODBC environment handle.
+            SQLHDBC                     m_hDbc = SQL_NULL_HDBC; ///< ODBC connection handle.
+            SQLHSTMT                    m_hStmt = SQL_NULL_HSTMT; ///< ODBC statement handle.
+            bool                        m_connected = false; ///< Indicates whether the connection is active.
+            bool                        m_ownsEnv = true; ///< Indicates whether the environment handle is freed by this wrapper.
+            bool                        m_inTransaction = false; ///< Indicates whether autocommit is off for a transaction.
+            std::unique_ptr<Backend>    m_odbc = nullptr; ///< Pointer to the ODBC backend.
+
+            /**
+             * @brief Handles ODBC errors by retrieving diagnostic information.
+             *
+             * Reads every diagnostic record of the handle into a per-thread OdbcDiagnostic
+             * buffer and logs them; the text is only decoded when error logging is enabled.
+             *
+             * @param handle The ODBC handle where the error occurred.
+             * @param handleType The type of the handle (e.g., environment, connection, statement).
+             * @param retCode The return code from the ODBC function.
+             * @throws OdbcException if `retCode` is SQL_ERROR.
+             */
+            void handleError(SQLHANDLE handle, SQLSMALLINT handleType, SQLRETURN retCode);
+
+            /**
+             * @brief Commits or rolls back the transaction in progress.
+             *
+             * @param completionType SQL_COMMIT or SQL_ROLLBACK.
+             * @param keepOpen Whether to stay in manual-commit mode, so that the next statement starts a new transaction.
+             * @return True on success, false if no transaction is in progress.
+             * @throws std::runtime_error if SQLEndTran or SQLSetConnectAttr fails.
+             */
+            bool endTransaction(SQLSMALLINT completionType, bool keepOpen);
+
+            /**
+             * @brief Completes connect() once SQLConnect or SQLConnectA has returned.
+             *
+             * @param ret The return code of the connect call.
+             * @return True if the connection is successful, false otherwise.
+             */
+            bool completeConnect(SQLRETURN ret);
+
+            template <typename>
+            friend class BasicLongDataReader;
+
+        public:
+            /**
+             * @brief Constructs a wrapper over an ODBC backend.
+             *
+             * @param odbcImpl The backend; a default-constructed one if omitted.
+             */
+            explicit BasicOdbcWrapper(std::unique_ptr<Backend> odbcImpl = std::make_unique<Backend>());
+
+            /**
+             * @brief Destroys the wrapper and releases its handles.
+             */
+            virtual ~BasicOdbcWrapper();
+
+            BasicOdbcWrapper(const BasicOdbcWrapper&) = delete;
+            BasicOdbcWrapper& operator=(const BasicOdbcWrapper&) = delete;
+
+            /**
+             * @brief Initializes the ODBC environment and allocates necessary handles.
+             */
+            void initialize();
+
+            /**
+             * @brief Allocates a connection handle on an environment shared with other wrappers.
+             *
+             * The environment is borrowed: it is not freed by this wrapper and must outlive it.
+             *
+             * @param sharedEnv An environment handle already configured for ODBC 3.
+             */
+            void initialize(SQLHENV sharedEnv);
+
+            /**
+             * @brief Establishes a connection to the database.
+             *
+             * @param dsn The Data Source Name (DSN) for the database.
+             * @param user The username for authentication.
+             * @param password The password for authentication.
+             * @return True if the connection is successful, false otherwise.
+             */
+            virtual bool connect(const std::wstring& dsn, const std::wstring& user, const std::wstring& password);
+
+            /**
+             * @brief Establishes a connection to the database with UTF-8 credentials.
+             *
+             * The text goes to the driver's ANSI entry point with explicit lengths, so no
+             * wide string is built; the driver or driver manager must use a UTF-8 client
+             * character set.
+             *
+             * @param dsn The Data Source Name (DSN) for the database.
+             * @param user The username for authentication.
+             * @param password The password for authentication.
+             * @return True if the connection is successful, false otherwise.
+             */
+            virtual bool connect(std::string_view dsn, std::string_view user, std::string_view password);
+
+            /**
+             * @brief Disconnects from the database and releases the connection handle.
+             */
+            virtual void disconnect();
+
+            /**
+             * @brief Executes a SQL query that retrieves data.
+             *
+             * @param query The SQL query to execute.
+             * @return True if the query executes successfully, false otherwise.
+             */
+            virtual bool executeQuery(const std::wstring& query);
+
+            /**
+             * @brief Executes UTF-8 SQL text that retrieves data, through the driver's ANSI entry point.
+             *
+             * @param query The SQL query to execute; it need not be NUL-terminated.
+             * @return True if the query executes successfully, false otherwise.
+             */
+            virtual bool executeQuery(std::string_view query);
+
+            /**
+             * @brief Executes a SQL query that modifies data.
+             *
+             * @param query The SQL query to execute.
+             * @return True if the query executes successfully, false otherwise.
+             */
+            virtual bool executeUpdate(const std::wstring& query);
+
+            /**
+             * @brief Executes UTF-8 SQL text that modifies data, through the driver's ANSI entry point.
+             *
+             * @param query The SQL query to execute; it need not be NUL-terminated.
+             * @return True if the query executes successfully, false otherwise.
+             */
+            virtual bool executeUpdate(std::string_view query);
+
+            /**
+             * @brief Starts a transaction by switching the connection to manual-commit mode.
+             *
+             * Statements on all of the connection's statement handles then belong to the
+             * transaction until commit() or rollback(). A transaction still in progress
+             * when the wrapper disconnects is rolled back.
+             *
+             * @return True on success, false if not connected or a transaction is already in progress.
+             * @throws std::runtime_error if the driver rejects SQL_ATTR_AUTOCOMMIT.
+             */
+            bool beginTransaction();
+
+            /**
+             * @brief Commits the transaction in progress and returns to autocommit mode.
+             *
+             * @return True on success, false if no transaction is in progress.
+             * @throws std::runtime_error if the commit fails; the transaction then stays in progress.
+             */
+            bool commit() { return endTransaction(SQL_COMMIT, false); }
+
+            /**
+             * @brief Rolls back the transaction in progress and returns to autocommit mode.
+             *
+             * @return True on success, false if no transaction is in progress.
+             * @throws std::runtime_error if the rollback fails.
+             */
+            bool rollback() { return endTransaction(SQL_ROLLBACK, false); }
+
+            /**
+             * @brief Checks whether a transaction started with beginTransaction() is in progress.
+             */
+            bool inTransaction() const { return m_inTransaction; }
+
+            /**
+             * @brief Fetches the results of the last executed query.
+             *
+             * Values of any length are retrieved in full with repeated SQLGetData calls.
+             *
+             * @return A vector of rows, where each row is a vector of strings representing column values.
+             */
+            std::vector<std::vector<std::wstring>> fetchResults();
+
+            /**
+             * @brief Advances to the next row of the last executed query, for use with streamColumn().
+             *
+             * @return True if a row is available, false once the result set is exhausted or if not connected.
+             */
+            bool fetchRow();
+
+            /**
+             * @brief Streams a column of the current row to a sink without holding the whole value in memory.
+             *
+             * Call fetchRow() first. Each column can be streamed once per row, in ascending
+             * column order unless the driver supports SQL_GD_ANY_ORDER.
+             *
+             * @param column The one-based column number.
+             * @param sink Receives the value chunk by chunk.
+             * @param cType The C type to retrieve: SQL_C_BINARY (default), SQL_C_CHAR or SQL_C_WCHAR.
+             * @return The number of bytes streamed, or SQL_NULL_DATA for NULL (also returned if not connected).
+             */
+            SQLLEN streamColumn(SQLUSMALLINT column, const typename BasicLongDataReader<Backend>::Sink& sink,
+                                SQLSMALLINT cType = SQL_C_BINARY);
+
+            /**
+             * @brief Writes a column of the current row to an output stream, chunk by chunk.
+             *
+             * @param column The one-based column number.
+             * @param out The stream receiving the raw bytes of the value.
+             * @param cType The C type to retrieve: SQL_C_BINARY (default), SQL_C_CHAR or SQL_C_WCHAR.
+             * @return The number of bytes written, or SQL_NULL_DATA for NULL (also returned if not connected).
+             */
+            SQLLEN streamColumn(SQLUSMALLINT column, std::ostream& out, SQLSMALLINT cType = SQL_C_BINARY);
+
+            /**
+             * @brief Checks if the database connection is active.
+             *
+             * @return True if connected, false otherwise.
+             */
+            bool isConnected() const { return m_connected; }
+
+            /**
+             * @brief Checks whether the connection is still usable without a server round trip.
+             *
+             * Queries SQL_ATTR_CONNECTION_DEAD. Drivers that do not support the attribute
+             * are assumed to be alive as long as the wrapper is connected.
+             *
+             * @return True if connected and the driver does not report the connection as dead.
+             */
+            bool isAlive();
+
+            /**
+             * @brief Retrieves the ODBC backend.
+             *
+             * @return A pointer to the ODBC backend.
+             */
+            Backend* getBackend() const { return m_odbc.get(); }
+
+            /**
+             * @brief Retrieves the ODBC environment handle.
+             *
+             * @return The ODBC environment handle.
+             */
+            SQLHENV getHEnv() const { return m_hEnv; }
+
+            /**
+             * @brief Retrieves the ODBC connection handle.
+             *
+             * @return The ODBC connection handle.
+             */
+            SQLHDBC getHDbc() const { return m_hDbc; }
+
+            /**
+             * @brief Retrieves the ODBC statement handle.
+             *
+             * @return The ODBC statement handle.
+             */
+            SQLHSTMT getHStmt() const { return m_hStmt; }
+        };
+
+        template <typename Backend>
+        BasicOdbcWrapper<Backend>::BasicOdbcWrapper(std::unique_ptr<Backend> odbcImpl)
+            : m_odbc(std::move(odbcImpl)) {
+            ODBC_LOG_TRACE("Entering OdbcWrapper constructor");
+            ODBC_LOG_TRACE("Exiting OdbcWrapper constructor");
+        }
+
+        template <typename Backend>
+        BasicOdbcWrapper<Backend>::~BasicOdbcWrapper() {
+            ODBC_LOG_TRACE("Entering OdbcWrapper destructor");
+            disconnect();
+            if (m_odbc.get() != nullptr) {
+                if (m_hStmt != SQL_NULL_HSTMT) {
+                    m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, m_hStmt);
+                }
+                if (m_hDbc != SQL_NULL_HDBC) {
+                    m_odbc->SQLFreeHandle(SQL_HANDLE_DBC, m_hDbc);
+                }
+                if (m_hEnv != SQL_NULL_HENV && m_ownsEnv) {
+                    m_odbc->SQLFreeHandle(SQL_HANDLE_ENV, m_hEnv);
+                }
+
+                m_odbc.reset();
+            }
+            ODBC_LOG_TRACE("Exiting OdbcWrapper destructor");
+        }
+
+        template <typename Backend>
+        void BasicOdbcWrapper<Backend>::handleError(SQLHANDLE handle, SQLSMALLINT handleType, SQLRETURN retCode) {
+            ODBC_LOG_TRACE("Entering handleError");
+            // Per thread, since asynchronous executions report their errors on the reactor thread
+            thread_local OdbcDiagnostic diagnostic;
+            const size_t count = diagnostic.collect(*m_odbc, handleType, handle);
+
+            if (OdbcLogger::shouldLog(spdlog::level::err)) {
+                for (size_t i = 0; i < count; i++) {
+                    OdbcLogger::logError(fmt::format("SQLSTATE: {}, Message: {}, Native Error: {}",
+                                                     diagnostic[i].state(), diagnostic[i].text(), diagnostic[i].nativeError));
+                }
+                if (retCode == SQL_ERROR && count == 0) {
+                    OdbcLogger::logError("ODBC Error occurred but diagnostic information unavailable");
+                }
+            }
+
+            if (retCode == SQL_ERROR) {
+                throw diagnostic.toException();
+            }
+
+            ODBC_LOG_TRACE("Exiting handleError");
+        }
+
+        template <typename Backend>
+        void BasicOdbcWrapper<Backend>::initialize() {
+            ODBC_LOG_TRACE("Entering initialize");
+            SQLRETURN ret = m_odbc->SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &m_hEnv);
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLSetEnvAttr(m_hEnv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+                if (SQL_SUCCEEDED(ret)) {
+                    ret = m_odbc->SQLAllocHandle(SQL_HANDLE_DBC, m_hEnv, &m_hDbc);
+                    if (!SQL_SUCCEEDED(ret)) {
+                        handleError(m_hEnv, SQL_HANDLE_ENV, ret);
+                    }
+                } else {
+                    handleError(m_hEnv, SQL_HANDLE_ENV, ret);
+                }
+            } else {
+                handleError(SQL_NULL_HANDLE, SQL_HANDLE_ENV, ret);
+            }
+            ODBC_LOG_TRACE("Exiting initialize");
+        }
+
+        template <typename Backend>
+        void BasicOdbcWrapper<Backend>::initialize(SQLHENV sharedEnv) {
+            ODBC_LOG_TRACE("Entering initialize with shared environment");
+            m_hEnv = sharedEnv;
+            m_ownsEnv = false;
+            SQLRETURN ret = m_odbc->SQLAllocHandle(SQL_HANDLE_DBC, m_hEnv, &m_hDbc);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(m_hEnv, SQL_HANDLE_ENV, ret);
+            }
+            ODBC_LOG_TRACE("Exiting initialize with shared environment");
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::connect(const std::wstring& dsn, const std::wstring& user, const std::wstring& password) {
+            ODBC_LOG_TRACE("Entering connect");
+            SqlWString dsnText = toSqlWide(dsn);
+            SqlWString userText = toSqlWide(user);
+            SqlWString passwordText = toSqlWide(password);
+            return completeConnect(m_odbc->SQLConnect(m_hDbc, dsnText.data(), SQL_NTS, userText.data(), SQL_NTS,
+                                                      passwordText.data(), SQL_NTS));
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::connect(std::string_view dsn, std::string_view user, std::string_view password) {
+            ODBC_LOG_TRACE("Entering connect (UTF-8)");
+            return completeConnect(m_odbc->SQLConnectA(m_hDbc, sqlNarrow(dsn), static_cast<SQLSMALLINT>(dsn.size()),
+                                                       sqlNarrow(user), static_cast<SQLSMALLINT>(user.size()),
+                                                       sqlNarrow(password), static_cast<SQLSMALLINT>(password.size())));
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::completeConnect(SQLRETURN ret) {
+            if (SQL_SUCCEEDED(ret)) {
+                m_connected = true;
+                m_odbc->SQLAllocHandle(SQL_HANDLE_STMT, m_hDbc, &m_hStmt);
+
+                // Handle SQL_SUCCESS_WITH_INFO to log warnings
+                if (ret == SQL_SUCCESS_WITH_INFO) {
+                    handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+                }
+
+                ODBC_LOG_TRACE("Exiting connect with success");
+                return true;
+            }
+
+            handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+            ODBC_LOG_TRACE("Exiting connect with failure");
+            return false;
+        }
+
+        template <typename Backend>
+        void BasicOdbcWrapper<Backend>::disconnect() {
+            ODBC_LOG_TRACE("Entering disconnect");
+            if (m_connected) {
+                if (m_inTransaction) {
+                    // Connection attributes outlive the connection, so autocommit is restored as well
+                    ODBC_LOG_DEBUG("Rolling back open transaction");
+                    m_odbc->SQLEndTran(SQL_HANDLE_DBC, m_hDbc, SQL_ROLLBACK);
+                    m_odbc->SQLSetConnectAttr(m_hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+                    m_inTransaction = false;
+                }
+
+                if (m_hStmt != SQL_NULL_HSTMT) {
+                    ODBC_LOG_DEBUG("Freeing statement handle");
+                    m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, m_hStmt);
+                    m_hStmt = SQL_NULL_HSTMT;
+                }
+
+                if (m_hDbc != SQL_NULL_HDBC) {
+                    ODBC_LOG_DEBUG("Disconnecting from database");
+                    m_odbc->SQLDisconnect(m_hDbc);
+                }
+
+                m_connected = false;
+            }
+            ODBC_LOG_TRACE("Exiting disconnect");
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::isAlive() {
+            if (!m_connected) {
+                return false;
+            }
+
+            SQLUINTEGER dead = SQL_CD_FALSE;
+            SQLRETURN ret = m_odbc->SQLGetConnectAttr(m_hDbc, SQL_ATTR_CONNECTION_DEAD, &dead, 0, nullptr);
+            if (!SQL_SUCCEEDED(ret)) {
+                return true;
+            }
+            return dead == SQL_CD_FALSE;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::executeQuery(const std::wstring& query) {
+            ODBC_LOG_TRACE("Entering executeQuery");
+            if (!m_connected) {
+                spdlog::warn("Exiting executeQuery with failure (not connected)");
+                return false;
+            }
+
+            SqlWString text = toSqlWide(query);
+            SQLRETURN ret = m_odbc->SQLExecDirect(m_hStmt, text.data(), SQL_NTS);
+            if (SQL_SUCCEEDED(ret)) {
+                ODBC_LOG_TRACE("Exiting executeQuery with success");
+                return true;
+            }
+
+            handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+            ODBC_LOG_TRACE("Exiting executeQuery with failure");
+            return false;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::executeQuery(std::string_view query) {
+            ODBC_LOG_TRACE("Entering executeQuery (UTF-8)");
+            if (!m_connected) {
+                spdlog::warn("Exiting executeQuery with failure (not connected)");
+                return false;
+            }
+
+            SQLRETURN ret = m_odbc->SQLExecDirectA(m_hStmt, sqlNarrow(query), static_cast<SQLINTEGER>(query.size()));
+            if (SQL_SUCCEEDED(ret)) {
+                ODBC_LOG_TRACE("Exiting executeQuery with success");
+                return true;
+            }
+
+            handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+            ODBC_LOG_TRACE("Exiting executeQuery with failure");
+            return false;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::executeUpdate(const std::wstring& query) {
+            ODBC_LOG_TRACE("Entering executeUpdate");
+            if (!m_connected) {
+                spdlog::warn("Exiting executeUpdate with failure (not connected)");
+                return false;
+            }
+
+            SqlWString text = toSqlWide(query);
+            SQLRETURN ret = m_odbc->SQLExecDirect(m_hStmt, text.data(), SQL_NTS);
+            if (SQL_SUCCEEDED(ret)) {
+                m_odbc->SQLRowCount(m_hStmt, nullptr); // Consume results if any
+                ODBC_LOG_TRACE("Exiting executeUpdate with success");
+                return true;
+            }
+
+            handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+            ODBC_LOG_TRACE("Exiting executeUpdate with failure");
+            return false;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::executeUpdate(std::string_view query) {
+            ODBC_LOG_TRACE("Entering executeUpdate (UTF-8)");
+            if (!m_connected) {
+                spdlog::warn("Exiting executeUpdate with failure (not connected)");
+                return false;
+            }
+
+            SQLRETURN ret = m_odbc->SQLExecDirectA(m_hStmt, sqlNarrow(query), static_cast<SQLINTEGER>(query.size()));
+            if (SQL_SUCCEEDED(ret)) {
+                m_odbc->SQLRowCount(m_hStmt, nullptr); // Consume results if any
+                ODBC_LOG_TRACE("Exiting executeUpdate with success");
+                return true;
+            }
+
+            handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+            ODBC_LOG_TRACE("Exiting executeUpdate with failure");
+            return false;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::beginTransaction() {
+            ODBC_LOG_TRACE("Entering beginTransaction");
+            if (!m_connected) {
+                spdlog::warn("Exiting beginTransaction with failure (not connected)");
+                return false;
+            }
+            if (m_inTransaction) {
+                spdlog::warn("Exiting beginTransaction with failure (transaction already in progress)");
+                return false;
+            }
+
+            SQLRETURN ret = m_odbc->SQLSetConnectAttr(m_hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+                ODBC_LOG_TRACE("Exiting beginTransaction with failure");
+                return false;
+            }
+
+            m_inTransaction = true;
+            ODBC_LOG_TRACE("Exiting beginTransaction with success");
+            return true;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::endTransaction(SQLSMALLINT completionType, bool keepOpen) {
+            ODBC_LOG_TRACE("Entering endTransaction");
+            if (!m_inTransaction) {
+                spdlog::warn("Exiting endTransaction with failure (no transaction in progress)");
+                return false;
+            }
+
+            SQLRETURN ret = m_odbc->SQLEndTran(SQL_HANDLE_DBC, m_hDbc, completionType);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+                ODBC_LOG_TRACE("Exiting endTransaction with failure");
+                return false;
+            }
+
+            if (!keepOpen) {
+                ret = m_odbc->SQLSetConnectAttr(m_hDbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+                if (!SQL_SUCCEEDED(ret)) {
+                    handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+                    ODBC_LOG_TRACE("Exiting endTransaction with failure");
+                    return false;
+                }
+                m_inTransaction = false;
+            }
+
+            ODBC_LOG_TRACE("Exiting endTransaction with success");
+            return true;
+        }
+
+        template <typename Backend>
+        std::vector<std::vector<std::wstring>> BasicOdbcWrapper<Backend>::fetchResults() {
+            ODBC_LOG_TRACE("Entering fetchResults");
+            std::vector<std::vector<std::wstring>> results;
+            if (!m_connected) {
+                spdlog::warn("Exiting fetchResults with empty results (not connected)");
+                return results;
+            }
+
+            SQLSMALLINT numCols;
+            m_odbc->SQLNumResultCols(m_hStmt, &numCols);
+
+            BasicLongDataReader<Backend> reader(this, m_odbc.get(), m_hStmt);
+            while (m_odbc->SQLFetch(m_hStmt) == SQL_SUCCESS) {
+                std::vector<std::wstring> row(numCols);
+                for (SQLSMALLINT i = 1; i <= numCols; i++) {
+                    if (!reader.readString(i, row[i - 1])) {
+                        row[i - 1].assign(L"NULL");
+                    }
+                }
+                results.push_back(std::move(row));
+            }
+
+            ODBC_LOG_TRACE("Exiting fetchResults with results");
+            return results;
+        }
+
+        template <typename Backend>
+        bool BasicOdbcWrapper<Backend>::fetchRow() {
+            if (!m_connected) {
+                spdlog::warn("Exiting fetchRow with failure (not connected)");
+                return false;
+            }
+
+            SQLRETURN ret = m_odbc->SQLFetch(m_hStmt);
+            if (ret == SQL_NO_DATA) {
+                return false;
+            }
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                return false;
+            }
+            return true;
+        }
+
+        template <typename Backend>
+        SQLLEN BasicOdbcWrapper<Backend>::streamColumn(SQLUSMALLINT column, const typename BasicLongDataReader<Backend>::Sink& sink,
+                                                       SQLSMALLINT cType) {
+            ODBC_LOG_TRACE("Entering streamColumn");
+            if (!m_connected) {
+                spdlog::warn("Exiting streamColumn with failure (not connected)");
+                return SQL_NULL_DATA;
+            }
+
+            BasicLongDataReader<Backend> reader(this, m_odbc.get(), m_hStmt);
+            SQLLEN bytes = reader.read(column, cType, sink);
+            ODBC_LOG_TRACE("Exiting streamColumn");
+            return bytes;
+        }
+
+        template <typename Backend>
+        SQLLEN BasicOdbcWrapper<Backend>::streamColumn(SQLUSMALLINT column, std::ostream& out, SQLSMALLINT cType) {
+            return streamColumn(column, [&out](const unsigned char* data, size_t bytes) {
+                out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            }, cType);
+        }
+
+        extern template class BasicOdbcWrapper<OdbcInterface>;
+    }
+}
+#endif // ODBC_BASIC_WRAPPER_H
@@ -0,0 +1,183 @@
+#ifndef ODBC_COLUMNAR_RESULT_H
+#define ODBC_COLUMNAR_RESULT_H
+
+#include <odbccpp/rowsetbuffer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+    /**
+     * @brief Type description of an Apache Arrow array, as defined by the Arrow C data interface.
+     */
+    struct ArrowSchema {
+        const char* format;
+        const char* name;
+        const char* metadata;
+        int64_t flags;
+        int64_t n_children;
+        struct ArrowSchema** children;
+        struct ArrowSchema* dictionary;
+        void (*release)(struct ArrowSchema*);
+        void* private_data;
+    };
+
+    /**
+     * @brief Buffers of an Apache Arrow array, as defined by the Arrow C data interface.
+     */
+    struct ArrowArray {
+        int64_t length;
+        int64_t null_count;
+        int64_t offset;
+        int64_t n_buffers;
+        int64_t n_children;
+        const void** buffers;
+        struct ArrowArray** children;
+        struct ArrowArray* dictionary;
+        void (*release)(struct ArrowArray*);
+        void* private_data;
+    };
+}
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief Physical type of a ColumnarResult column, following the column's native binding.
+         */
+        enum class ColumnarType {
+            Int64, ///< Columns bound as SQL_C_SBIGINT; Arrow format "l".
+            Float64, ///< Columns bound as SQL_C_DOUBLE; Arrow format "g".
+            Utf8 ///< Columns bound as SQL_C_CHAR; Arrow format "u".
+        };
+
+        /**
+         * @class ColumnarResult
+         * @brief A result set stored column by column in the Apache Arrow memory layout.
+         *
+         * Each column keeps a validity bitmap (one bit per row, least significant bit first,
+         * set for non-NULL values) and either a contiguous array of fixed-width values or,
+         * for text, an array of `rowCount() + 1` 32-bit offsets into a contiguous UTF-8 data
+         * buffer. Numeric values are copied out of the bound rowset arrays with a single
+         * memcpy per column and rowset; text columns are copied without any wide string
+         * conversion, so SQL_C_CHAR data is assumed to be UTF-8.
+         *
+         * exportArrow() hands the buffers to an Arrow consumer through the Arrow C data
+         * interface without copying them.
+         */
+        class ColumnarResult {
+        public:
+            /**
+             * @brief Storage of a single column.
+             */
+            struct Column {
+                std::string                 name; ///< Column name, in UTF-8.
+                ColumnarType                type = ColumnarType::Utf8; ///< Physical type of the values.
+                std::vector<uint8_t>        validity; ///< Validity bitmap, one bit per row.
+                std::vector<unsigned char>  values; ///< Fixed-width values, or the UTF-8 data of a text column.
+                std::vector<int32_t>        offsets; ///< Start of each value in `values` plus the end offset; text columns only.
+                int64_t                     nullCount = 0; ///< Number of NULL values.
+            };
+
+        private:
+            std::vector<Column> m_columns; ///< One entry per result column.
+            size_t              m_rows = 0; ///< Number of rows appended so far.
+
+        public:
+            /**
+             * @brief Constructs an empty result with no columns.
+             */
+            ColumnarResult() = default;
+
+            /**
+             * @brief Constructs an empty result with the columns of a rowset bound with RowsetBuffer::bindNative().
+             *
+             * @param rowset The bound rowset buffer.
+             */
+            explicit ColumnarResult(const RowsetBuffer& rowset);
+
+            /**
+             * @brief Appends the rows of the current rowset.
+             *
+             * @param rowset The buffer the columns were taken from, holding a fetched rowset.
+             * @throws std::length_error if the text of a column exceeds 2 GiB.
+             */
+            void append(const RowsetBuffer& rowset);
+
+            /**
+             * @brief Retrieves the number of rows.
+             */
+            size_t rowCount() const { return m_rows; }
+
+            /**
+             * @brief Retrieves the number of columns.
+             */
+            size_t columnCount() const { return m_columns.size(); }
+
+            /**
+             * @brief Retrieves the storage of a column.
+             *
+             * @param col The zero-based column index.
+             */
+            const Column& column(size_t col) const { return m_columns[col]; }
+
+            /**
+             * @brief Checks whether a value is NULL.
+             *
+             * @param row The zero-based row index.
+             * @param col The zero-based column index.
+             */
+            bool isNull(size_t row, size_t col) const {
+                return (m_columns[col].validity[row / 8] & (1u << (row % 8))) == 0;
+            }
+
+            /**
+             * @brief Retrieves the contiguous values of an Int64 column; NULL slots hold 0.
+             *
+             * @param col The zero-based column index.
+             * @throws std::invalid_argument if the column is not an Int64 column.
+             */
+            const int64_t* int64Values(size_t col) const;
+
+            /**
+             * @brief Retrieves the contiguous values of a Float64 column; NULL slots hold 0.
+             *
+             * @param col The zero-based column index.
+             * @throws std::invalid_argument if the column is not a Float64 column.
+             */
+            const double* doubleValues(size_t col) const;
+
+            /**
+             * @brief Retrieves a value of a Utf8 column; NULL values are empty.
+             *
+             * @param row The zero-based row index.
+             * @param col The zero-based column index.
+             * @throws std::invalid_argument if the column is not a Utf8 column.
+             */
+            std::string_view stringValue(size_t row, size_t col) const;
+
+            /**
+             * @brief Moves the result into Arrow C data interface structures.
+             *
+             * The result is exported as a struct array with one nullable child per column;
+             * the consumer takes ownership and frees the buffers by calling the release
+             * callbacks. The result is left empty.
+             *
+             * @param array Receives the data.
+             * @param schema Receives the type description.
+             */
+            void exportArrow(ArrowArray* array, ArrowSchema* schema);
+        };
+    }
+}
+#endif // ODBC_COLUMNAR_RESULT_H
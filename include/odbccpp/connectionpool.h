@@ -0,0 +1,246 @@
+#ifndef ODBC_CONNECTION_POOL_H
+#define ODBC_CONNECTION_POOL_H
+
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/odbcwrapper.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @struct ConnectionPoolConfig
+         * @brief Sizing and timing options for a ConnectionPool.
+         */
+        struct ConnectionPoolConfig {
+            size_t                      minSize = 1; ///< Connections opened up front and never evicted for idleness.
+            size_t                      maxSize = 8; ///< Upper bound on open connections.
+            std::chrono::milliseconds   idleTimeout = std::chrono::minutes(5); ///< Idle time after which a connection above minSize is closed.
+            std::chrono::milliseconds   acquireTimeout = std::chrono::seconds(30); ///< Maximum wait for a connection when the pool is exhausted.
+            bool                        validateOnCheckout = true; ///< Replaces connections reported dead before handing them out.
+        };
+
+        /**
+         * @class ConnectionPool
+         * @brief Thread-safe pool of connected OdbcWrapper instances sharing one environment.
+         *
+         * Idle connections are spread over several independently locked stripes. A thread
+         * checks out from its home stripe first and only visits the others when it is
+         * empty, so concurrent checkouts rarely contend on the same mutex. The pool grows
+         * on demand up to `maxSize` connections; callers beyond that wait on a condition
+         * variable that is only touched while someone is actually waiting.
+         *
+         * Connections idle for longer than `idleTimeout` are closed on checkout or by
+         * evictIdle(), down to `minSize`. With `validateOnCheckout` set, a connection the
+         * driver reports as dead is replaced before it is handed out.
+         *
+         * All pooled connections share one AsyncReactor, so their asynchronous executions
+         * are polled from a single thread.
+         *
+         * The pool must outlive every Lease it hands out.
+         */
+        class ConnectionPool {
+        public:
+            /**
+             * @brief Creates the ODBC interface used by each pooled connection.
+             */
+            using InterfaceFactory = std::function<std::unique_ptr<OdbcInterface>()>;
+
+            /**
+             * @brief Pool sizing and timing options.
+             */
+            using Config = ConnectionPoolConfig;
+
+            /**
+             * @class Lease
+             * @brief Move-only handle to a checked-out connection, returned to the pool on destruction.
+             */
+            class Lease {
+            private:
+                ConnectionPool*                 m_pool = nullptr; ///< Pool the connection is returned to.
+                std::unique_ptr<OdbcWrapper>    m_connection; ///< Checked-out connection.
+
+            public:
+                Lease() = default;
+
+                /**
+                 * @brief Wraps a connection checked out from a pool.
+                 */
+                Lease(ConnectionPool* pool, std::unique_ptr<OdbcWrapper> connection)
+                    : m_pool(pool), m_connection(std::move(connection)) {}
+
+                /**
+                 * @brief Returns the connection to the pool.
+                 */
+                ~Lease() { release(); }
+
+                Lease(Lease&& other) noexcept = default;
+
+                Lease& operator=(Lease&& other) noexcept {
+                    if (this != &other) {
+                        release();
+                        m_pool = other.m_pool;
+                        m_connection = std::move(other.m_connection);
+                    }
+                    return *this;
+                }
+
+                Lease(const Lease&) = delete;
+                Lease& operator=(const Lease&) = delete;
+
+                /**
+                 * @brief Returns the connection to the pool early. The lease becomes empty.
+                 */
+                void release() {
+                    if (m_pool && m_connection) {
+                        m_pool->release(std::move(m_connection));
+                    }
+                    m_connection.reset();
+                }
+
+                OdbcWrapper* get() const { return m_connection.get(); }
+                OdbcWrapper* operator->() const { return m_connection.get(); }
+                OdbcWrapper& operator*() const { return *m_connection; }
+                explicit operator bool() const { return m_connection != nullptr; }
+            };
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief A connection waiting in a stripe, with the time it was returned.
+             */
+            struct Idle {
+                std::unique_ptr<OdbcWrapper>    connection; ///< The idle connection.
+                Clock::time_point               since; ///< When the connection was returned.
+            };
+
+            /**
+             * @brief Independently locked list of idle connections.
+             *
+             * Aligned to a cache line so that neighbouring stripes do not share one.
+             */
+            struct alignas(64) Stripe {
+                std::mutex          mutex; ///< Guards the idle list.
+                std::vector<Idle>   idle; ///< Idle connections, most recently returned last.
+            };
+
+            std::wstring                    m_dsn; ///< Data source name for new connections.
+            std::wstring                    m_user; ///< User name for new connections.
+            std::wstring                    m_password; ///< Password for new connections.
+            Config                          m_config; ///< Sizing and timing options.
+            InterfaceFactory                m_factory; ///< Creates the ODBC interface of each connection.
+            std::unique_ptr<OdbcInterface>  m_odbc; ///< Interface owning the shared environment handle.
+            SQLHENV                         m_hEnv = SQL_NULL_HENV; ///< Environment shared by every pooled connection.
+            std::shared_ptr<AsyncReactor>   m_reactor = std::make_shared<AsyncReactor>(); ///< Reactor shared by every pooled connection.
+            std::unique_ptr<Stripe[]>       m_stripes; ///< Idle connection stripes.
+            size_t                          m_stripeCount = 0; ///< Number of stripes.
+            std::atomic<size_t>             m_size{0}; ///< Open connections, idle or leased.
+            std::atomic<size_t>             m_waiters{0}; ///< Threads blocked in acquire().
+            std::mutex                      m_waitMutex; ///< Guards the slow path of acquire().
+            std::condition_variable         m_available; ///< Signalled when a connection is returned or closed.
+
+            /**
+             * @brief Returns the stripe a thread checks first and returns connections to.
+             */
+            Stripe& homeStripe() const;
+
+            /**
+             * @brief Takes an idle connection from any stripe, closing expired or dead ones on the way.
+             *
+             * @param discarded Incremented for every connection closed on the way.
+             * @return A usable connection, or nullptr if no stripe has one.
+             */
+            std::unique_ptr<OdbcWrapper> takeIdle(size_t& discarded);
+
+            /**
+             * @brief Reserves room for one more connection if the pool is below its maximum.
+             */
+            bool reserve();
+
+            /**
+             * @brief Opens a new connection on the shared environment for a reserved slot.
+             *
+             * @throws std::runtime_error if the connection cannot be established; the slot is released.
+             */
+            std::unique_ptr<OdbcWrapper> open();
+
+            /**
+             * @brief Closes a connection and frees its slot.
+             */
+            void discard(std::unique_ptr<OdbcWrapper> connection);
+
+            /**
+             * @brief Wakes one waiting thread, if there is any.
+             */
+            void notifyWaiter();
+
+            /**
+             * @brief Returns a leased connection to the pool, rolling back a transaction left in progress.
+             */
+            void release(std::unique_ptr<OdbcWrapper> connection);
+
+        public:
+            /**
+             * @brief Allocates the shared environment and opens `minSize` connections.
+             *
+             * @param dsn The Data Source Name (DSN) for the database.
+             * @param user The username for authentication.
+             * @param password The password for authentication.
+             * @param config Sizing and timing options.
+             * @param factory Creates the ODBC interface for each connection; defaults to OdbcExecutor.
+             * @throws std::runtime_error if the environment or an initial connection cannot be set up.
+             */
+            ConnectionPool(std::wstring dsn, std::wstring user, std::wstring password,
+                           Config config = Config(), InterfaceFactory factory = nullptr);
+
+            /**
+             * @brief Closes all idle connections and frees the shared environment.
+             */
+            ~ConnectionPool();
+
+            ConnectionPool(const ConnectionPool&) = delete;
+            ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+            /**
+             * @brief Checks out a connection, opening one or waiting if none is idle.
+             *
+             * @return A lease on a connected wrapper.
+             * @throws std::runtime_error if no connection becomes available within `acquireTimeout`
+             *         or a new connection cannot be established.
+             */
+            Lease acquire();
+
+            /**
+             * @brief Closes connections above `minSize` that have been idle longer than `idleTimeout`.
+             *
+             * @return The number of connections closed.
+             */
+            size_t evictIdle();
+
+            /**
+             * @brief Retrieves the number of open connections, idle or leased.
+             */
+            size_t size() const { return m_size.load(); }
+
+            /**
+             * @brief Retrieves the number of idle connections.
+             */
+            size_t idleCount() const;
+
+            /**
+             * @brief Retrieves the pool options.
+             */
+            const Config& getConfig() const { return m_config; }
+        };
+    }
+}
+#endif // ODBC_CONNECTION_POOL_H
@@ -0,0 +1,149 @@
+#ifndef ODBC_EXPORT_ENCODER_H
+#define ODBC_EXPORT_ENCODER_H
+
+#include <odbccpp/rowsetbuffer.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief File formats written by OdbcWrapper::exportTo().
+         */
+        enum class ExportFormat {
+            Csv, ///< RFC 4180 fields; NULL is an empty field and an empty string is `""`.
+            Tsv, ///< Tab-separated with backslash escapes; NULL is `\N`, as read by PostgreSQL COPY.
+            Binary ///< Length-prefixed UTF-8 cells with a NULL bitmap per row; see ExportEncoder.
+        };
+
+        /**
+         * @brief Options of OdbcWrapper::exportTo().
+         */
+        struct ExportOptions {
+            static constexpr size_t DEFAULT_BLOCK_BYTES = 1024 * 1024; ///< Bytes per write when none is given.
+
+            bool        header = true; ///< Writes the column names as the first CSV or TSV line.
+            SQLULEN     rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE; ///< Rows fetched per round trip.
+            SQLLEN      columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS; ///< Widest cell, in characters; longer values are read with SQLGetData.
+            size_t      blockBytes = DEFAULT_BLOCK_BYTES; ///< Bytes per write; rounded up to ExportEncoder::ALIGNMENT.
+        };
+
+        /**
+         * @brief Outcome of OdbcWrapper::exportTo().
+         */
+        struct ExportStats {
+            std::uint64_t   rows = 0; ///< Rows written.
+            std::uint64_t   bytes = 0; ///< Bytes written.
+        };
+
+        /**
+         * @class ExportEncoder
+         * @brief Encodes fetched rowsets as UTF-8 text or binary rows and writes them in large aligned blocks.
+         *
+         * Cells are transcoded from the bound UTF-16 into an output buffer aligned to
+         * ALIGNMENT. Whenever a full block has accumulated, exactly one block is written,
+         * so every write but the last is a whole number of blocks from an aligned address
+         * at an aligned file offset. Files are opened unbuffered, so those writes reach
+         * the operating system as they are.
+         *
+         * The binary format starts with the magic bytes "ODBX", a version byte (1), the
+         * column count as a little-endian uint16 and, per column, its name as a uint16
+         * byte length followed by UTF-8. Each row is a NULL bitmap of (columns + 7) / 8
+         * bytes, least significant bit first, followed by every non-NULL cell as a LEB128
+         * byte length followed by UTF-8.
+         */
+        class ExportEncoder {
+        public:
+            static constexpr size_t ALIGNMENT = 4096; ///< Alignment of the output buffer, blocks and file offsets.
+
+        private:
+            struct AlignedDelete {
+                void operator()(char* data) const { ::operator delete[](data, std::align_val_t(ALIGNMENT)); }
+            };
+
+            std::FILE*                          m_file = nullptr; ///< Unbuffered output file, owned.
+            ExportFormat                        m_format; ///< Format written.
+            size_t                              m_blockBytes; ///< Bytes per write.
+            std::unique_ptr<char[], AlignedDelete> m_buffer; ///< Aligned output buffer.
+            size_t                              m_capacity = 0; ///< Size of m_buffer.
+            size_t                              m_used = 0; ///< Bytes of m_buffer not yet written.
+            std::string                         m_scratch; ///< Transcoded cell, reused across cells.
+            ExportStats                         m_stats; ///< Rows and bytes written so far.
+            std::atomic<bool>                   m_failed{false}; ///< Set once a write failed; read by the fetch thread.
+
+            /**
+             * @brief Ensures room for `bytes` more bytes, writing whole blocks or growing the buffer.
+             */
+            char* reserve(size_t bytes);
+
+            /**
+             * @brief Writes every whole block in the buffer and keeps the remainder.
+             */
+            void writeBlocks();
+
+            /**
+             * @brief Appends a UTF-8 field with the escaping of the text formats.
+             */
+            void appendText(const std::string& text, bool isNull);
+
+        public:
+            /**
+             * @brief Opens the output file.
+             *
+             * @param path The file to create or truncate.
+             * @param format The format to write.
+             * @param blockBytes The bytes per write; rounded up to ALIGNMENT.
+             * @throws std::runtime_error if the file cannot be opened.
+             */
+            ExportEncoder(const std::string& path, ExportFormat format, size_t blockBytes = ExportOptions::DEFAULT_BLOCK_BYTES);
+
+            /**
+             * @brief Closes the file, discarding rows not yet written if finish() was not called.
+             */
+            ~ExportEncoder();
+
+            ExportEncoder(const ExportEncoder&) = delete;
+            ExportEncoder& operator=(const ExportEncoder&) = delete;
+
+            /**
+             * @brief Writes the column names: the header line of the text formats, or the binary file header.
+             *
+             * @param names The column names.
+             * @param textHeader Whether the text formats get a header line; the binary header is always written.
+             */
+            void writeHeader(const std::vector<std::wstring>& names, bool textHeader = true);
+
+            /**
+             * @brief Encodes every row of a fetched rowset.
+             *
+             * @param rowset A buffer bound with RowsetBuffer::bind(), holding a fetched rowset.
+             */
+            void encode(const RowsetBuffer& rowset);
+
+            /**
+             * @brief Writes the remaining bytes and closes the file.
+             *
+             * @return False if any write failed.
+             */
+            bool finish();
+
+            /**
+             * @brief Checks whether a write has failed; encoding continues, but nothing more is written.
+             */
+            bool failed() const { return m_failed.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief Retrieves the rows encoded and bytes written so far.
+             */
+            const ExportStats& stats() const { return m_stats; }
+        };
+    }
+}
+#endif // ODBC_EXPORT_ENCODER_H
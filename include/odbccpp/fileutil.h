@@ -0,0 +1,21 @@
+#ifndef ODBC_FILE_UTIL_H
+#define ODBC_FILE_UTIL_H
+
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief Moves a fully written temporary file over its target, replacing any existing file.
+         *
+         * Readers of the target see either the old or the new contents, never a partly written file.
+         *
+         * @param temporary The written file, in the same directory as the target.
+         * @param path The file to create or replace.
+         * @return True if the file was moved into place; otherwise the temporary file is removed
+         *         and the target is left as it was.
+         */
+        bool replaceFile(const std::string& temporary, const std::string& path);
+    }
+}
+#endif // ODBC_FILE_UTIL_H
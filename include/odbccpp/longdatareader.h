@@ -0,0 +1,153 @@
+#ifndef ODBC_LONG_DATA_READER_H
+#define ODBC_LONG_DATA_READER_H
+
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/textcodec.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        template <typename Backend>
+        class BasicOdbcWrapper;
+
+        /**
+         * @class BasicLongDataReader
+         * @brief Retrieves column values of any length with repeated SQLGetData calls.
+         *
+         * A value that does not fit the chunk buffer is returned by the driver in
+         * pieces; each piece is handed to a sink as soon as it arrives, so a value
+         * never has to be held in memory as a whole unless the caller collects it.
+         * When the driver reports the remaining length, the buffer grows to fetch the
+         * rest in as few calls as possible, up to MAX_CHUNK_BYTES. The buffer is kept
+         * between calls and reused for every column read through the same reader.
+         *
+         * The reader does not own the statement handle; a row must have been fetched
+         * with SQLFetch before its columns are read. `Backend` is the ODBC backend of the
+         * wrapper the reader belongs to, see BasicOdbcWrapper.
+         */
+        template <typename Backend>
+        class BasicLongDataReader {
+        public:
+            /**
+             * @brief Receives one chunk of a value. The data is only valid during the call.
+             */
+            using Sink = std::function<void(const unsigned char* data, size_t bytes)>;
+
+            static constexpr SQLLEN DEFAULT_CHUNK_BYTES = 8192; ///< Buffer size of the first SQLGetData call.
+            static constexpr SQLLEN MAX_CHUNK_BYTES = 1 << 20; ///< Upper bound the buffer grows to.
+
+        private:
+            BasicOdbcWrapper<Backend>*  m_wrapper = nullptr; ///< Wrapper used to report ODBC errors.
+            Backend*                    m_odbc = nullptr; ///< Non-owning pointer to the ODBC backend.
+            SQLHSTMT                    m_hStmt = SQL_NULL_HSTMT; ///< Statement handle positioned on a row.
+            std::vector<unsigned char>  m_buffer; ///< Chunk buffer, grown on demand.
+
+        public:
+            /**
+             * @brief Constructs a reader for a statement.
+             *
+             * @param wrapper The wrapper that owns the statement handle.
+             * @param odbc The ODBC backend used for SQLGetData.
+             * @param hStmt The statement handle.
+             * @param chunkBytes The buffer size of the first SQLGetData call for each value.
+             */
+            BasicLongDataReader(BasicOdbcWrapper<Backend>* wrapper, Backend* odbc, SQLHSTMT hStmt,
+                                SQLLEN chunkBytes = DEFAULT_CHUNK_BYTES);
+
+            /**
+             * @brief Streams a column of the current row to a sink, chunk by chunk.
+             *
+             * @param column The one-based column number.
+             * @param cType The C type to retrieve: SQL_C_BINARY, SQL_C_CHAR or SQL_C_WCHAR.
+             *              Character chunks are passed without their terminator.
+             * @param sink Receives each chunk in order.
+             * @return The total number of bytes passed to the sink, or SQL_NULL_DATA for NULL.
+             * @throws std::runtime_error if SQLGetData fails.
+             */
+            SQLLEN read(SQLUSMALLINT column, SQLSMALLINT cType, const Sink& sink);
+
+            /**
+             * @brief Reads a complete column of the current row as a wide string.
+             *
+             * @param column The one-based column number.
+             * @param out The string receiving the value; cleared for NULL.
+             * @return False if the value is NULL.
+             * @throws std::runtime_error if SQLGetData fails.
+             */
+            bool readString(SQLUSMALLINT column, std::wstring& out);
+        };
+
+        /**
+         * @brief Reader used by OdbcWrapper, calling the driver through OdbcInterface.
+         */
+        using LongDataReader = BasicLongDataReader<OdbcInterface>;
+
+        template <typename Backend>
+        BasicLongDataReader<Backend>::BasicLongDataReader(BasicOdbcWrapper<Backend>* wrapper, Backend* odbc, SQLHSTMT hStmt,
+                                                          SQLLEN chunkBytes)
+            : m_wrapper(wrapper), m_odbc(odbc), m_hStmt(hStmt) {
+            // Even, so that a chunk never ends in the middle of a SQLWCHAR, and large enough for a terminator.
+            chunkBytes = std::clamp<SQLLEN>(chunkBytes, 2 * sizeof(SQLWCHAR), MAX_CHUNK_BYTES);
+            m_buffer.resize(static_cast<size_t>(chunkBytes & ~SQLLEN(1)));
+        }
+
+        template <typename Backend>
+        SQLLEN BasicLongDataReader<Backend>::read(SQLUSMALLINT column, SQLSMALLINT cType, const Sink& sink) {
+            const SQLLEN terminator = cType == SQL_C_WCHAR ? static_cast<SQLLEN>(sizeof(SQLWCHAR))
+                                    : cType == SQL_C_CHAR ? 1 : 0;
+            SQLLEN total = 0;
+            for (;;) {
+                SQLLEN indicator = 0;
+                SQLRETURN ret = m_odbc->SQLGetData(m_hStmt, column, cType, m_buffer.data(),
+                                                   static_cast<SQLLEN>(m_buffer.size()), &indicator);
+                if (ret == SQL_NO_DATA) {
+                    break; // The previous call returned the last chunk
+                }
+                if (!SQL_SUCCEEDED(ret)) {
+                    m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                    break;
+                }
+                if (indicator == SQL_NULL_DATA) {
+                    return SQL_NULL_DATA;
+                }
+
+                // A truncated chunk (01004) fills the buffer up to the terminator; the indicator then
+                // holds the bytes left before this call, or SQL_NO_TOTAL if the driver does not know.
+                const SQLLEN capacity = static_cast<SQLLEN>(m_buffer.size()) - terminator;
+                const bool truncated = indicator == SQL_NO_TOTAL || indicator > capacity;
+                const SQLLEN bytes = truncated ? capacity : indicator;
+                sink(m_buffer.data(), static_cast<size_t>(bytes));
+                total += bytes;
+                if (!truncated) {
+                    break;
+                }
+
+                const SQLLEN wanted = indicator == SQL_NO_TOTAL ? static_cast<SQLLEN>(m_buffer.size()) * 2
+                                                                : indicator - capacity + terminator;
+                if (wanted > static_cast<SQLLEN>(m_buffer.size()) && m_buffer.size() < static_cast<size_t>(MAX_CHUNK_BYTES)) {
+                    m_buffer.resize(static_cast<size_t>(std::min<SQLLEN>((wanted + 1) & ~SQLLEN(1), MAX_CHUNK_BYTES)));
+                }
+            }
+            return total;
+        }
+
+        template <typename Backend>
+        bool BasicLongDataReader<Backend>::readString(SQLUSMALLINT column, std::wstring& out) {
+            // Decoded once complete, as a surrogate pair may be split between two chunks.
+            SqlWString text;
+            SQLLEN total = read(column, SQL_C_WCHAR, [&text](const unsigned char* data, size_t bytes) {
+                text.append(reinterpret_cast<const SQLWCHAR*>(data), bytes / sizeof(SQLWCHAR));
+            });
+            out = fromSqlWide(text.data(), text.size());
+            return total != SQL_NULL_DATA;
+        }
+
+        extern template class BasicLongDataReader<OdbcInterface>;
+    }
+}
+#endif // ODBC_LONG_DATA_READER_H
@@ -0,0 +1,145 @@
+#ifndef ODBC_METERED_ODBC_INTERFACE_H
+#define ODBC_METERED_ODBC_INTERFACE_H
+
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/odbcmetrics.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class MeteredOdbcInterface
+         * @brief OdbcInterface decorator that records latencies, row and byte counts and errors into OdbcMetrics.
+         *
+         * Wraps any backend, so metering is added where the wrapper is constructed:
+         *
+         *     auto metrics = std::make_shared<OdbcMetrics>();
+         *     OdbcWrapper db(std::make_unique<MeteredOdbcInterface>(std::make_unique<OdbcExecutor>(), metrics));
+         *
+         * Connects, executions and fetches are timed. Rows come from the rows-fetched
+         * pointer the caller set with SQL_ATTR_ROWS_FETCHED_PTR, or are one per fetch
+         * otherwise. Bytes are the lengths SQLGetData returns plus, after each fetch, the
+         * indicators of the bound columns. A call that fails is counted at once, and is
+         * attributed to a SQLSTATE when its first diagnostic record is read on the same
+         * thread. Asynchronous executions are timed from the first call that returned
+         * SQL_STILL_EXECUTING to the call that completed them.
+         *
+         * Recording into OdbcMetrics is lock-free. The bindings needed to count bytes are
+         * tracked per statement under a mutex, taken once per fetch and on binding changes.
+         */
+        class MeteredOdbcInterface final : public OdbcInterface {
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief A bound column's buffer lengths.
+             */
+            struct Binding {
+                SQLLEN*     indicators = nullptr; ///< Length/indicator buffer, or nullptr if unbound.
+                SQLLEN      bufferLength = 0; ///< Bytes per value.
+            };
+
+            /**
+             * @brief What the decorator knows about a statement handle.
+             */
+            struct StatementState {
+                SQLULEN*                rowsFetched = nullptr; ///< Caller's SQL_ATTR_ROWS_FETCHED_PTR.
+                SQLULEN                 rowBindType = SQL_BIND_BY_COLUMN; ///< SQL_ATTR_ROW_BIND_TYPE.
+                std::vector<Binding>    bindings; ///< Bound columns indexed by column number - 1.
+                bool                    executing = false; ///< Indicates an asynchronous execution in progress.
+                Clock::time_point       started; ///< Start of the asynchronous execution.
+            };
+
+            std::unique_ptr<OdbcInterface>                  m_inner; ///< Decorated backend.
+            std::shared_ptr<OdbcMetrics>                    m_metrics; ///< Metrics recorded into.
+            std::mutex                                      m_mutex; ///< Guards m_statements.
+            std::unordered_map<SQLHSTMT, StatementState>    m_statements; ///< Statements with bindings or async executions.
+            std::atomic<int>                                m_executing{0}; ///< Asynchronous executions in progress.
+
+            /**
+             * @brief Counts a failed call and marks it for attribution by the next SQLGetDiagRec on this thread.
+             */
+            SQLRETURN check(SQLRETURN ret);
+
+            /**
+             * @brief Records an execution, tracking asynchronous executions across polls.
+             */
+            SQLRETURN finishExecute(SQLHSTMT hStmt, Clock::time_point start, SQLRETURN ret);
+
+            /**
+             * @brief Records a fetch with the rows and bound bytes it returned.
+             */
+            SQLRETURN finishFetch(SQLHSTMT hStmt, Clock::time_point start, SQLRETURN ret);
+
+        public:
+            /**
+             * @brief Constructs a decorator over a backend.
+             *
+             * @param inner The backend that performs the calls.
+             * @param metrics The metrics to record into; may be shared with other decorators.
+             */
+            MeteredOdbcInterface(std::unique_ptr<OdbcInterface> inner, std::shared_ptr<OdbcMetrics> metrics);
+
+            /**
+             * @brief Retrieves the metrics recorded into.
+             */
+            const std::shared_ptr<OdbcMetrics>& getMetrics() const { return m_metrics; }
+
+            /**
+             * @brief Retrieves the decorated backend.
+             */
+            OdbcInterface* getInner() const { return m_inner.get(); }
+
+            SQLRETURN SQLAllocHandle(SQLSMALLINT HandleType, SQLHANDLE InputHandle, SQLHANDLE* OutputHandle) override;
+            SQLRETURN SQLSetEnvAttr(SQLHENV EnvironmentHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength) override;
+            SQLRETURN SQLConnect(SQLHDBC ConnectionHandle, SQLWCHAR* ServerName, SQLSMALLINT NameLength1,
+                                 SQLWCHAR* UserName, SQLSMALLINT NameLength2, SQLWCHAR* Authentication, SQLSMALLINT NameLength3) override;
+            SQLRETURN SQLConnectA(SQLHDBC ConnectionHandle, SQLCHAR* ServerName, SQLSMALLINT NameLength1,
+                                  SQLCHAR* UserName, SQLSMALLINT NameLength2, SQLCHAR* Authentication, SQLSMALLINT NameLength3) override;
+            SQLRETURN SQLDisconnect(SQLHDBC ConnectionHandle) override;
+            SQLRETURN SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) override;
+            SQLRETURN SQLExecDirect(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) override;
+            SQLRETURN SQLExecDirectA(SQLHSTMT StatementHandle, SQLCHAR* StatementText, SQLINTEGER TextLength) override;
+            SQLRETURN SQLNumResultCols(SQLHSTMT StatementHandle, SQLSMALLINT* ColumnCount) override;
+            SQLRETURN SQLFetch(SQLHSTMT StatementHandle) override;
+            SQLRETURN SQLGetData(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType,
+                                 SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) override;
+            SQLRETURN SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength) override;
+            SQLRETURN SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType,
+                                 SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) override;
+            SQLRETURN SQLFetchScroll(SQLHSTMT StatementHandle, SQLSMALLINT FetchOrientation, SQLLEN FetchOffset) override;
+            SQLRETURN SQLPrepare(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) override;
+            SQLRETURN SQLBindParameter(SQLHSTMT StatementHandle, SQLUSMALLINT ParameterNumber, SQLSMALLINT InputOutputType,
+                                       SQLSMALLINT ValueType, SQLSMALLINT ParameterType, SQLULEN ColumnSize,
+                                       SQLSMALLINT DecimalDigits, SQLPOINTER ParameterValuePtr, SQLLEN BufferLength,
+                                       SQLLEN* StrLen_or_IndPtr) override;
+            SQLRETURN SQLExecute(SQLHSTMT StatementHandle) override;
+            SQLRETURN SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) override;
+            SQLRETURN SQLCancel(SQLHSTMT StatementHandle) override;
+            SQLRETURN SQLMoreResults(SQLHSTMT StatementHandle) override;
+            SQLRETURN SQLGetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                        SQLINTEGER BufferLength, SQLINTEGER* StringLength) override;
+            SQLRETURN SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                        SQLINTEGER StringLength) override;
+            SQLRETURN SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT CompletionType) override;
+            SQLRETURN SQLDescribeCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLWCHAR* ColumnName,
+                                     SQLSMALLINT BufferLength, SQLSMALLINT* NameLength, SQLSMALLINT* DataType,
+                                     SQLULEN* ColumnSize, SQLSMALLINT* DecimalDigits, SQLSMALLINT* Nullable) override;
+            SQLRETURN SQLRowCount(SQLHSTMT StatementHandle, SQLLEN* RowCount) override;
+            SQLRETURN SQLSetPos(SQLHSTMT StatementHandle, SQLSETPOSIROW RowNumber, SQLUSMALLINT Operation,
+                                SQLUSMALLINT LockType) override;
+            SQLRETURN SQLGetInfo(SQLHDBC ConnectionHandle, SQLUSMALLINT InfoType, SQLPOINTER InfoValue,
+                                 SQLSMALLINT BufferLength, SQLSMALLINT* StringLength) override;
+            SQLRETURN SQLGetDiagRec(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT RecNumber,
+                                    SQLWCHAR* SQLState, SQLINTEGER* NativeError, SQLWCHAR* MessageText,
+                                    SQLSMALLINT BufferLength, SQLSMALLINT* TextLength) override;
+        };
+    }
+}
+#endif // ODBC_METERED_ODBC_INTERFACE_H
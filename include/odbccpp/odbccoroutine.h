@@ -0,0 +1,421 @@
+#ifndef ODBC_COROUTINE_H
+#define ODBC_COROUTINE_H
+
+#if !defined(__cpp_impl_coroutine)
+#error "odbccpp/odbccoroutine.h requires C++20 coroutines; configure with -DODBCCPP_ENABLE_COROUTINES=ON"
+#endif
+
+#include <odbccpp/odbcwrapper.h>
+#include <odbccpp/resultcursor.h>
+#include <odbccpp/statement.h>
+#include <odbclogger.h>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief Runs a piece of work later, on a thread of the caller's choosing.
+         *
+         * Coroutines waiting for the database are resumed through it, never directly on
+         * the reactor thread. The work must be queued, not run inline: the reactor calls
+         * the executor from its own thread, and a coroutine running there would stall the
+         * polling of every other call in flight.
+         */
+        using CoroutineExecutor = std::function<void(std::function<void()>)>;
+
+        template <typename T = void>
+        class Task;
+
+        namespace detail {
+            /**
+             * @brief Promise parts shared by every Task: lazy start and continuation on completion.
+             */
+            class TaskPromiseBase {
+            private:
+                struct FinalAwaiter {
+                    bool await_ready() const noexcept { return false; }
+
+                    template <typename Promise>
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                        std::coroutine_handle<> continuation = handle.promise().m_continuation;
+                        return continuation ? continuation : std::noop_coroutine();
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+
+            public:
+                std::coroutine_handle<>     m_continuation; ///< Coroutine awaiting the task.
+                std::exception_ptr          m_error; ///< Exception that escaped the task body.
+
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+                FinalAwaiter final_suspend() const noexcept { return {}; }
+                void unhandled_exception() noexcept { m_error = std::current_exception(); }
+
+                void rethrowIfFailed() const {
+                    if (m_error) {
+                        std::rethrow_exception(m_error);
+                    }
+                }
+            };
+
+            template <typename T>
+            class TaskPromise : public TaskPromiseBase {
+            private:
+                std::optional<T> m_value; ///< Value passed to co_return.
+
+            public:
+                Task<T> get_return_object() noexcept;
+
+                template <typename U>
+                void return_value(U&& value) { m_value.emplace(std::forward<U>(value)); }
+
+                T result() {
+                    rethrowIfFailed();
+                    return std::move(*m_value);
+                }
+            };
+
+            template <>
+            class TaskPromise<void> : public TaskPromiseBase {
+            public:
+                Task<void> get_return_object() noexcept;
+
+                void return_void() noexcept {}
+
+                void result() { rethrowIfFailed(); }
+            };
+
+            /**
+             * @brief Awaits an ODBC call run through OdbcWrapper::runAsync().
+             *
+             * If the call completes before the coroutine is suspended, the coroutine simply
+             * continues; otherwise the completion resumes it through the executor.
+             */
+            class AsyncCall {
+            private:
+                OdbcWrapper&                m_wrapper; ///< Wrapper running the call.
+                const CoroutineExecutor&    m_executor; ///< Executor the coroutine is resumed on.
+                SQLHSTMT                    m_hStmt; ///< Statement the call runs on.
+                AsyncReactor::Poll          m_call; ///< The call itself.
+                SQLRETURN                   m_ret = SQL_ERROR; ///< Final result of the call.
+                std::exception_ptr          m_error; ///< Exception raised by error handling.
+                std::atomic<bool>           m_handoff{false}; ///< Set by whichever of suspension and completion comes first.
+
+            public:
+                AsyncCall(OdbcWrapper& wrapper, const CoroutineExecutor& executor, SQLHSTMT hStmt, AsyncReactor::Poll call)
+                    : m_wrapper(wrapper), m_executor(executor), m_hStmt(hStmt), m_call(std::move(call)) {}
+
+                bool await_ready() const noexcept { return false; }
+
+                bool await_suspend(std::coroutine_handle<> awaiting) {
+                    m_wrapper.runAsync(m_hStmt, std::move(m_call), [this, awaiting](SQLRETURN ret, std::exception_ptr error) {
+                        m_ret = ret;
+                        m_error = error;
+                        if (m_handoff.exchange(true)) {
+                            m_executor([awaiting] { awaiting.resume(); });
+                        }
+                    });
+                    return !m_handoff.exchange(true);
+                }
+
+                SQLRETURN await_resume() const {
+                    if (m_error) {
+                        std::rethrow_exception(m_error);
+                    }
+                    return m_ret;
+                }
+            };
+
+            /**
+             * @brief Coroutine that owns a spawned task and frees itself when the task ends.
+             */
+            struct Detached {
+                struct promise_type {
+                    Detached get_return_object() noexcept {
+                        return Detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+                    }
+                    std::suspend_always initial_suspend() const noexcept { return {}; }
+                    std::suspend_never final_suspend() const noexcept { return {}; }
+                    void return_void() const noexcept {}
+                    void unhandled_exception() const noexcept {
+                        try {
+                            throw;
+                        } catch (const std::exception& e) {
+                            OdbcLogger::logError(std::string("Spawned task failed: ") + e.what());
+                        } catch (...) {
+                            OdbcLogger::logError("Spawned task failed with an unknown exception");
+                        }
+                    }
+                };
+
+                std::coroutine_handle<promise_type> handle; ///< The suspended coroutine.
+            };
+
+            inline Detached runDetached(Task<void> task);
+        }
+
+        /**
+         * @class Task
+         * @brief Lazily started coroutine producing a T, resumed by co_await.
+         *
+         * The body starts when the task is awaited and the awaiting coroutine continues
+         * when it finishes; exceptions propagate to the awaiting coroutine. Use spawn()
+         * to start a top-level task.
+         */
+        template <typename T>
+        class [[nodiscard]] Task {
+        public:
+            using promise_type = detail::TaskPromise<T>;
+
+        private:
+            std::coroutine_handle<promise_type> m_handle; ///< The suspended coroutine.
+
+        public:
+            explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+            Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+            Task& operator=(Task&& other) noexcept {
+                if (this != &other) {
+                    if (m_handle) {
+                        m_handle.destroy();
+                    }
+                    m_handle = std::exchange(other.m_handle, {});
+                }
+                return *this;
+            }
+
+            Task(const Task&) = delete;
+            Task& operator=(const Task&) = delete;
+
+            ~Task() {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+            }
+
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                m_handle.promise().m_continuation = awaiting;
+                return m_handle;
+            }
+
+            T await_resume() { return m_handle.promise().result(); }
+        };
+
+        namespace detail {
+            template <typename T>
+            Task<T> TaskPromise<T>::get_return_object() noexcept {
+                return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+            }
+
+            inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+                return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+            }
+
+            inline Detached runDetached(Task<void> task) {
+                co_await task;
+            }
+        }
+
+        /**
+         * @brief Starts a task on an executor without waiting for it.
+         *
+         * The task frees itself when it finishes. An exception escaping it is logged.
+         *
+         * @param executor The executor the task starts on.
+         * @param task The task to run.
+         */
+        inline void spawn(const CoroutineExecutor& executor, Task<void> task) {
+            std::coroutine_handle<> handle = detail::runDetached(std::move(task)).handle;
+            executor([handle] { handle.resume(); });
+        }
+
+        class CoroutineConnection;
+
+        /**
+         * @class RowStream
+         * @brief Asynchronous generator over the rows of a query, fetched one rowset at a time.
+         *
+         * `while (co_await rows.next())` suspends only when a new rowset has to be
+         * fetched; rows already in the rowset are handed out without suspending. The
+         * stream owns the statement, which goes back to the connection's free list when
+         * the stream is destroyed.
+         */
+        class RowStream {
+        public:
+            using Row = ResultCursor::Row; ///< A single row of column values.
+
+        private:
+            /**
+             * @brief Awaiter for the next row: ready when the rowset holds one, a fetch otherwise.
+             */
+            class NextRow {
+            private:
+                RowStream&                          m_stream; ///< Stream being advanced.
+                std::optional<bool>                 m_ready; ///< Outcome when no fetch was needed.
+                std::optional<detail::AsyncCall>    m_fetch; ///< Fetch of the next rowset.
+
+            public:
+                explicit NextRow(RowStream& stream) : m_stream(stream) {}
+
+                bool await_ready() {
+                    if (m_stream.m_cursor.done()) {
+                        m_ready = false;
+                    } else if (m_stream.m_cursor.nextBuffered()) {
+                        m_ready = true;
+                    }
+                    return m_ready.has_value();
+                }
+
+                bool await_suspend(std::coroutine_handle<> awaiting) {
+                    ResultCursor* cursor = &m_stream.m_cursor;
+                    m_fetch.emplace(*m_stream.m_wrapper, *m_stream.m_executor, m_stream.m_statement.getHStmt(),
+                                    [cursor]() { return cursor->fetchRowset(); });
+                    return m_fetch->await_suspend(awaiting);
+                }
+
+                bool await_resume() {
+                    if (m_ready) {
+                        return *m_ready;
+                    }
+                    SQLRETURN ret = SQL_ERROR;
+                    try {
+                        ret = m_fetch->await_resume();
+                    } catch (...) {
+                        m_stream.m_cursor.acceptRowset(SQL_ERROR);
+                        throw;
+                    }
+                    return m_stream.m_cursor.acceptRowset(ret);
+                }
+            };
+
+            OdbcWrapper*                m_wrapper = nullptr; ///< Wrapper running the fetches.
+            const CoroutineExecutor*    m_executor = nullptr; ///< Executor the coroutine is resumed on.
+            Statement                   m_statement; ///< Statement holding the result set.
+            ResultCursor                m_cursor; ///< Bound rowset buffers and the current row.
+
+        public:
+            /**
+             * @brief Constructs an empty stream that yields no rows.
+             */
+            RowStream() = default;
+
+            /**
+             * @brief Binds the pending result set of an executed statement.
+             *
+             * @param wrapper The wrapper the statement belongs to.
+             * @param executor The executor the coroutine is resumed on.
+             * @param statement The executed statement.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             */
+            RowStream(OdbcWrapper& wrapper, const CoroutineExecutor& executor, Statement statement, SQLULEN rowsetSize)
+                : m_wrapper(&wrapper), m_executor(&executor), m_statement(std::move(statement)),
+                  m_cursor(m_statement.openCursor(rowsetSize)) {}
+
+            RowStream(RowStream&&) noexcept = default;
+            RowStream& operator=(RowStream&&) noexcept = default;
+
+            /**
+             * @brief Advances to the next row; co_await yields false once the result set is exhausted.
+             */
+            NextRow next() { return NextRow(*this); }
+
+            /**
+             * @brief Retrieves the current row. NULL values are reported as "NULL".
+             */
+            const Row& row() const { return m_cursor.row(); }
+
+            /**
+             * @brief Retrieves the number of columns in the result set.
+             */
+            SQLSMALLINT columnCount() const { return m_cursor.columnCount(); }
+        };
+
+        /**
+         * @class CoroutineConnection
+         * @brief Coroutine front end to a connected OdbcWrapper.
+         *
+         * Every query runs on its own Statement in SQL_ATTR_ASYNC_ENABLE mode, polled by
+         * the wrapper's AsyncReactor, so many queries can be in flight on one connection
+         * without blocking a thread each. Awaiting coroutines are resumed on the executor.
+         *
+         * The wrapper is not thread-safe: with an executor running several threads, give
+         * each strand its own connection. The wrapper and this object must outlive every
+         * task and RowStream using them.
+         */
+        class CoroutineConnection {
+        private:
+            OdbcWrapper&        m_wrapper; ///< Connected wrapper the statements are created on.
+            CoroutineExecutor   m_executor; ///< Executor the coroutines are resumed on.
+
+            /**
+             * @brief Executes SQL text on a new statement.
+             *
+             * @throws std::runtime_error if not connected or if the execution fails.
+             */
+            Task<Statement> run(std::wstring sql) {
+                Statement statement = m_wrapper.createStatement();
+                if (!statement) {
+                    throw std::runtime_error("ODBC Error: Unable to create statement");
+                }
+                OdbcInterface* odbc = m_wrapper.getOdbcInterface();
+                SQLHSTMT hStmt = statement.getHStmt();
+                SqlWString text = toSqlWide(sql);
+                co_await detail::AsyncCall(m_wrapper, m_executor, hStmt, [odbc, hStmt, &text]() {
+                    return odbc->SQLExecDirect(hStmt, text.data(), SQL_NTS);
+                });
+                co_return std::move(statement);
+            }
+
+        public:
+            /**
+             * @brief Wraps a connected wrapper.
+             *
+             * @param wrapper The wrapper the queries run on.
+             * @param executor The executor the coroutines are resumed on.
+             */
+            CoroutineConnection(OdbcWrapper& wrapper, CoroutineExecutor executor)
+                : m_wrapper(wrapper), m_executor(std::move(executor)) {}
+
+            /**
+             * @brief Executes a query; co_await yields a stream over its rows.
+             *
+             * @param sql The SQL query to execute.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @throws std::runtime_error if not connected or if the query fails.
+             */
+            Task<RowStream> query(std::wstring sql, SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE) {
+                Statement statement = co_await run(std::move(sql));
+                co_return RowStream(m_wrapper, m_executor, std::move(statement), rowsetSize);
+            }
+
+            /**
+             * @brief Executes a statement that modifies data; co_await yields the affected row count.
+             *
+             * @param sql The SQL statement to execute.
+             * @throws std::runtime_error if not connected or if the statement fails.
+             */
+            Task<SQLLEN> execute(std::wstring sql) {
+                Statement statement = co_await run(std::move(sql));
+                co_return statement.rowCount();
+            }
+
+            /**
+             * @brief Retrieves the executor the coroutines are resumed on.
+             */
+            const CoroutineExecutor& executor() const { return m_executor; }
+        };
+    }
+}
+#endif // ODBC_COROUTINE_H
@@ -0,0 +1,164 @@
+#ifndef ODBC_DIAGNOSTIC_H
+#define ODBC_DIAGNOSTIC_H
+
+#include <odbccpp/odbcinterface.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief One diagnostic record, decoded to UTF-8.
+         */
+        struct Diagnostic {
+            std::string sqlState; ///< Five-character SQLSTATE, e.g. "08S01".
+            SQLINTEGER  nativeError = 0; ///< Driver-specific error code.
+            std::string message; ///< Diagnostic message.
+        };
+
+        /**
+         * @class OdbcException
+         * @brief Error raised for SQL_ERROR, carrying every diagnostic record of the failing handle.
+         *
+         * what() keeps the "ODBC Error: <message>" text of the first record, so code that
+         * catches std::runtime_error is unaffected; callers that need to classify the error
+         * use sqlState() and nativeError() instead of parsing the message.
+         */
+        class OdbcException : public std::runtime_error {
+        private:
+            std::vector<Diagnostic> m_diagnostics; ///< Records in the order the driver reported them.
+
+        public:
+            /**
+             * @brief Constructs an exception from decoded diagnostic records.
+             *
+             * @param what The exception message.
+             * @param diagnostics The records; may be empty if the driver reported none.
+             */
+            OdbcException(const std::string& what, std::vector<Diagnostic> diagnostics)
+                : std::runtime_error(what), m_diagnostics(std::move(diagnostics)) {}
+
+            /**
+             * @brief Retrieves the SQLSTATE of the first record, or an empty string if there is none.
+             */
+            const std::string& sqlState() const {
+                static const std::string none;
+                return m_diagnostics.empty() ? none : m_diagnostics.front().sqlState;
+            }
+
+            /**
+             * @brief Retrieves the two-character class of the first SQLSTATE, e.g. "08" for connection errors.
+             */
+            std::string_view sqlStateClass() const { return std::string_view(sqlState()).substr(0, 2); }
+
+            /**
+             * @brief Retrieves the native error code of the first record, or 0 if there is none.
+             */
+            SQLINTEGER nativeError() const { return m_diagnostics.empty() ? 0 : m_diagnostics.front().nativeError; }
+
+            /**
+             * @brief Retrieves all diagnostic records.
+             */
+            const std::vector<Diagnostic>& diagnostics() const { return m_diagnostics; }
+        };
+
+        /**
+         * @class OdbcDiagnostic
+         * @brief Reusable buffer for the diagnostic records of a handle, read with SQLGetDiagRec.
+         *
+         * collect() reads records 1..N into fixed-size SQLWCHAR buffers that are kept between
+         * calls, so reading diagnostics allocates nothing once the buffer has grown to the
+         * number of records a driver reports. Text is decoded to UTF-8 only when a record is
+         * logged or turned into an OdbcException.
+         */
+        class OdbcDiagnostic {
+        public:
+            static constexpr size_t MAX_RECORDS = 16; ///< Records read per handle; further records are ignored.
+
+            /**
+             * @brief A record as returned by SQLGetDiagRec.
+             */
+            struct Record {
+                SQLWCHAR    sqlState[6] = {0}; ///< SQLSTATE, NUL-terminated.
+                SQLINTEGER  nativeError = 0; ///< Driver-specific error code.
+                SQLWCHAR    message[SQL_MAX_MESSAGE_LENGTH] = {0}; ///< Message text, NUL-terminated and truncated to the buffer.
+
+                /**
+                 * @brief Decodes the SQLSTATE.
+                 */
+                std::string state() const;
+
+                /**
+                 * @brief Decodes the message.
+                 */
+                std::string text() const;
+            };
+
+        private:
+            std::vector<Record> m_records; ///< Record buffers, grown on demand and reused.
+            size_t              m_count = 0; ///< Records read by the last collect().
+
+        public:
+            /**
+             * @brief Reads the diagnostic records of a handle, replacing those read before.
+             *
+             * Reading stops at the first record number that does not return SQL_SUCCESS or
+             * SQL_SUCCESS_WITH_INFO (the latter meaning the message was truncated), or after
+             * MAX_RECORDS records.
+             *
+             * @param odbc The ODBC backend.
+             * @param handleType The type of the handle.
+             * @param handle The handle whose diagnostics are read.
+             * @return The number of records read.
+             */
+            template <typename Backend>
+            size_t collect(Backend& odbc, SQLSMALLINT handleType, SQLHANDLE handle) {
+                m_count = 0;
+                while (m_count < MAX_RECORDS) {
+                    if (m_records.size() == m_count) {
+                        m_records.emplace_back();
+                    }
+                    Record& record = m_records[m_count];
+                    record.sqlState[0] = 0;
+                    record.message[0] = 0;
+                    SQLSMALLINT length = 0;
+                    SQLRETURN ret = odbc.SQLGetDiagRec(handleType, handle, static_cast<SQLSMALLINT>(m_count + 1),
+                                                       record.sqlState, &record.nativeError, record.message,
+                                                       SQL_MAX_MESSAGE_LENGTH, &length);
+                    if (!SQL_SUCCEEDED(ret)) {
+                        break;
+                    }
+                    record.sqlState[5] = 0;
+                    record.message[SQL_MAX_MESSAGE_LENGTH - 1] = 0;
+                    m_count++;
+                }
+                return m_count;
+            }
+
+            /**
+             * @brief Retrieves the number of records read by the last collect().
+             */
+            size_t size() const { return m_count; }
+
+            /**
+             * @brief Retrieves a record read by the last collect().
+             *
+             * @param index The zero-based record index.
+             */
+            const Record& operator[](size_t index) const { return m_records[index]; }
+
+            /**
+             * @brief Decodes the records read by the last collect() into an exception.
+             *
+             * @return An OdbcException whose what() is "ODBC Error: " followed by the first message.
+             */
+            OdbcException toException() const;
+        };
+    }
+}
+#endif // ODBC_DIAGNOSTIC_H
@@ -58,6 +58,21 @@ namespace ps {
             virtual SQLRETURN SQLConnect(SQLHDBC ConnectionHandle, SQLWCHAR* ServerName, SQLSMALLINT NameLength1, 
                                          SQLWCHAR* UserName, SQLSMALLINT NameLength2, SQLWCHAR* Authentication, SQLSMALLINT NameLength3) = 0;
 
+            /**
+             * @brief Establishes a connection to a database through the narrow (ANSI/UTF-8) entry point.
+             * 
+             * @param ConnectionHandle The connection handle.
+             * @param ServerName The name of the server to connect to.
+             * @param NameLength1 The length of the server name in bytes.
+             * @param UserName The username for authentication.
+             * @param NameLength2 The length of the username in bytes.
+             * @param Authentication The password for authentication.
+             * @param NameLength3 The length of the password in bytes.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLConnectA(SQLHDBC ConnectionHandle, SQLCHAR* ServerName, SQLSMALLINT NameLength1,
+                                          SQLCHAR* UserName, SQLSMALLINT NameLength2, SQLCHAR* Authentication, SQLSMALLINT NameLength3) = 0;
+
             /**
              * @brief Disconnects from the database.
              * 
@@ -85,6 +100,16 @@ namespace ps {
              */
             virtual SQLRETURN SQLExecDirect(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) = 0;
 
+            /**
+             * @brief Executes a SQL statement directly through the narrow (ANSI/UTF-8) entry point.
+             * 
+             * @param StatementHandle The statement handle.
+             * @param StatementText The SQL statement to execute.
+             * @param TextLength The length of the SQL statement in bytes.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLExecDirectA(SQLHSTMT StatementHandle, SQLCHAR* StatementText, SQLINTEGER TextLength) = 0;
+
             /**
              * @brief Retrieves the number of result columns in a statement.
              * 
@@ -116,6 +141,157 @@ namespace ps {
             virtual SQLRETURN SQLGetData(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType, 
                                          SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) = 0;
 
+            /**
+             * @brief Sets an attribute on a statement handle.
+             *
+             * @param StatementHandle The statement handle.
+             * @param Attribute The attribute to set (e.g., SQL_ATTR_ROW_ARRAY_SIZE).
+             * @param Value The attribute value, or a pointer to it.
+             * @param StringLength The length of the value, or 0 for integer attributes.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength) = 0;
+
+            /**
+             * @brief Binds an application buffer to a result set column.
+             *
+             * @param StatementHandle The statement handle.
+             * @param ColumnNumber The column number to bind.
+             * @param TargetType The C data type of the target buffer.
+             * @param TargetValue Pointer to the target buffer, or nullptr to unbind the column.
+             * @param BufferLength The length of a single element of the target buffer in bytes.
+             * @param StrLen_or_Ind Pointer to the length/indicator buffer.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType,
+                                         SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) = 0;
+
+            /**
+             * @brief Fetches the specified rowset of data from the result set.
+             *
+             * @param StatementHandle The statement handle.
+             * @param FetchOrientation The type of fetch (e.g., SQL_FETCH_NEXT).
+             * @param FetchOffset The number of the row to fetch, depending on the orientation.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLFetchScroll(SQLHSTMT StatementHandle, SQLSMALLINT FetchOrientation, SQLLEN FetchOffset) = 0;
+
+            /**
+             * @brief Prepares a SQL statement for execution.
+             *
+             * @param StatementHandle The statement handle.
+             * @param StatementText The SQL statement to prepare.
+             * @param TextLength The length of the SQL statement.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLPrepare(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) = 0;
+
+            /**
+             * @brief Binds a buffer to a parameter marker in a SQL statement.
+             *
+             * @param StatementHandle The statement handle.
+             * @param ParameterNumber The one-based parameter number.
+             * @param InputOutputType The parameter direction (e.g., SQL_PARAM_INPUT).
+             * @param ValueType The C data type of the parameter buffer.
+             * @param ParameterType The SQL data type of the parameter.
+             * @param ColumnSize The column size of the parameter marker.
+             * @param DecimalDigits The decimal digits of the parameter marker.
+             * @param ParameterValuePtr Pointer to the parameter buffer.
+             * @param BufferLength The length of the parameter buffer in bytes.
+             * @param StrLen_or_IndPtr Pointer to the length/indicator buffer.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLBindParameter(SQLHSTMT StatementHandle, SQLUSMALLINT ParameterNumber, SQLSMALLINT InputOutputType,
+                                               SQLSMALLINT ValueType, SQLSMALLINT ParameterType, SQLULEN ColumnSize,
+                                               SQLSMALLINT DecimalDigits, SQLPOINTER ParameterValuePtr, SQLLEN BufferLength,
+                                               SQLLEN* StrLen_or_IndPtr) = 0;
+
+            /**
+             * @brief Executes a prepared statement using the current parameter bindings.
+             *
+             * @param StatementHandle The statement handle.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLExecute(SQLHSTMT StatementHandle) = 0;
+
+            /**
+             * @brief Stops processing on a statement, closes its cursor, or releases its bindings.
+             *
+             * @param StatementHandle The statement handle.
+             * @param Option The operation to perform (SQL_CLOSE, SQL_UNBIND or SQL_RESET_PARAMS).
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) = 0;
+
+            /**
+             * @brief Cancels the function running on a statement, which may be called from another thread.
+             *
+             * @param StatementHandle The statement handle.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLCancel(SQLHSTMT StatementHandle) = 0;
+
+            /**
+             * @brief Advances to the next result set or row count of an executed statement.
+             *
+             * @param StatementHandle The statement handle.
+             * @return SQLRETURN indicating success, SQL_NO_DATA when no results remain, or failure.
+             */
+            virtual SQLRETURN SQLMoreResults(SQLHSTMT StatementHandle) = 0;
+
+            /**
+             * @brief Retrieves the current value of a connection attribute.
+             *
+             * @param ConnectionHandle The connection handle.
+             * @param Attribute The attribute to retrieve (e.g., SQL_ATTR_CONNECTION_DEAD).
+             * @param Value Buffer that receives the attribute value.
+             * @param BufferLength Size of the buffer for string attributes.
+             * @param StringLength Pointer to store the length of a string attribute.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLGetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                                SQLINTEGER BufferLength, SQLINTEGER* StringLength) = 0;
+
+            /**
+             * @brief Sets a connection attribute.
+             *
+             * @param ConnectionHandle The connection handle.
+             * @param Attribute The attribute to set (e.g., SQL_ATTR_AUTOCOMMIT).
+             * @param Value The attribute value, or a pointer to it for string attributes.
+             * @param StringLength Length of a string attribute value.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                                SQLINTEGER StringLength) = 0;
+
+            /**
+             * @brief Commits or rolls back the transaction on a connection or on all connections of an environment.
+             *
+             * @param HandleType SQL_HANDLE_DBC or SQL_HANDLE_ENV.
+             * @param Handle The connection or environment handle.
+             * @param CompletionType SQL_COMMIT or SQL_ROLLBACK.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT CompletionType) = 0;
+
+            /**
+             * @brief Describes a column of the result set.
+             *
+             * @param StatementHandle The statement handle.
+             * @param ColumnNumber The one-based column number.
+             * @param ColumnName Buffer that receives the column name, or nullptr.
+             * @param BufferLength The length of the name buffer in characters.
+             * @param NameLength Pointer to store the length of the column name.
+             * @param DataType Pointer to store the SQL data type of the column.
+             * @param ColumnSize Pointer to store the column size.
+             * @param DecimalDigits Pointer to store the decimal digits of the column.
+             * @param Nullable Pointer to store whether the column allows NULL values.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLDescribeCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLWCHAR* ColumnName,
+                                             SQLSMALLINT BufferLength, SQLSMALLINT* NameLength, SQLSMALLINT* DataType,
+                                             SQLULEN* ColumnSize, SQLSMALLINT* DecimalDigits, SQLSMALLINT* Nullable) = 0;
+
             /**
              * @brief Retrieves the number of rows affected by an executed statement.
              * 
@@ -125,6 +301,31 @@ namespace ps {
              */
             virtual SQLRETURN SQLRowCount(SQLHSTMT StatementHandle, SQLLEN* RowCount) = 0;
 
+            /**
+             * @brief Positions the cursor on a row of the fetched rowset.
+             *
+             * @param StatementHandle The statement handle.
+             * @param RowNumber The one-based row within the rowset.
+             * @param Operation The operation to perform (e.g., SQL_POSITION).
+             * @param LockType The lock to take on the row (e.g., SQL_LOCK_NO_CHANGE).
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLSetPos(SQLHSTMT StatementHandle, SQLSETPOSIROW RowNumber, SQLUSMALLINT Operation,
+                                        SQLUSMALLINT LockType) = 0;
+
+            /**
+             * @brief Retrieves information about the driver and data source of a connection.
+             *
+             * @param ConnectionHandle The connection handle.
+             * @param InfoType The information to retrieve (e.g., SQL_GETDATA_EXTENSIONS).
+             * @param InfoValue Buffer that receives the information.
+             * @param BufferLength The length of the buffer in bytes, for string information.
+             * @param StringLength Pointer to store the length of string information.
+             * @return SQLRETURN indicating success or failure.
+             */
+            virtual SQLRETURN SQLGetInfo(SQLHDBC ConnectionHandle, SQLUSMALLINT InfoType, SQLPOINTER InfoValue,
+                                         SQLSMALLINT BufferLength, SQLSMALLINT* StringLength) = 0;
+
             /**
              * @brief Retrieves diagnostic information for the last ODBC function call.
              * 
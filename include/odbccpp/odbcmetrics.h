@@ -0,0 +1,216 @@
+#ifndef ODBC_METRICS_H
+#define ODBC_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief A copy of a LatencyHistogram taken at one moment.
+         */
+        struct HistogramSnapshot {
+            uint64_t                count = 0; ///< Recorded values.
+            uint64_t                sum = 0; ///< Sum of the recorded values in nanoseconds.
+            uint64_t                max = 0; ///< Largest recorded value in nanoseconds.
+            std::vector<uint64_t>   buckets; ///< Values per bucket, indexed like LatencyHistogram.
+
+            /**
+             * @brief Estimates a quantile from the buckets.
+             *
+             * @param q The quantile, from 0 to 1.
+             * @return The upper bound of the bucket holding the quantile in nanoseconds, at most max, or 0 if empty.
+             */
+            uint64_t quantile(double q) const;
+
+            /**
+             * @brief Counts the values in the buckets up to and including the one holding `nanos`.
+             *
+             * @param nanos The bound in nanoseconds.
+             */
+            uint64_t countAtOrBelow(uint64_t nanos) const;
+        };
+
+        /**
+         * @class LatencyHistogram
+         * @brief Lock-free latency histogram with HDR-style log-linear buckets.
+         *
+         * Values are nanoseconds. Each power-of-two range is split into SUB_BUCKETS linear
+         * buckets, so a value is resolved to within 1/SUB_BUCKETS (about 3%) of itself from
+         * 1 ns up to MAX_VALUE, about 36 minutes; larger values land in the last bucket.
+         * Recording is a few relaxed atomic increments and may run on any thread;
+         * snapshot() may run concurrently and sees each counter at some recent value.
+         */
+        class LatencyHistogram {
+        public:
+            static constexpr int        SUB_BUCKET_BITS = 5; ///< Log2 of the linear buckets per power of two.
+            static constexpr uint64_t   SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS; ///< Linear buckets per power of two.
+            static constexpr int        MAX_BITS = 41; ///< Bits of the largest value resolved.
+            static constexpr uint64_t   MAX_VALUE = (uint64_t(1) << MAX_BITS) - 1; ///< Largest value resolved, in nanoseconds.
+            static constexpr size_t     BUCKET_COUNT = SUB_BUCKETS * (MAX_BITS - SUB_BUCKET_BITS + 1); ///< Number of buckets.
+
+        private:
+            std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{}; ///< Values per bucket.
+            std::atomic<uint64_t>                           m_sum{0}; ///< Sum of the recorded values.
+            std::atomic<uint64_t>                           m_max{0}; ///< Largest recorded value.
+
+        public:
+            /**
+             * @brief Maps a value to its bucket.
+             *
+             * @param nanos The value in nanoseconds.
+             */
+            static size_t bucketIndex(uint64_t nanos);
+
+            /**
+             * @brief Retrieves the largest value that maps to a bucket, in nanoseconds.
+             *
+             * @param index The bucket index.
+             */
+            static uint64_t bucketUpperBound(size_t index);
+
+            /**
+             * @brief Records one value.
+             *
+             * @param nanos The value in nanoseconds.
+             */
+            void record(uint64_t nanos);
+
+            /**
+             * @brief Copies the current counts.
+             */
+            HistogramSnapshot snapshot() const;
+        };
+
+        /**
+         * @class SqlStateCounters
+         * @brief Lock-free counters keyed by SQLSTATE.
+         *
+         * States are packed into a 64-bit key and placed in a fixed open-addressing table
+         * by compare-and-swap, so counting never allocates or locks. Once CAPACITY distinct
+         * states have been seen, further new states are counted under "other".
+         */
+        class SqlStateCounters {
+        public:
+            static constexpr size_t CAPACITY = 64; ///< Distinct states counted on their own.
+
+        private:
+            std::array<std::atomic<uint64_t>, CAPACITY> m_keys{}; ///< Packed states; 0 marks a free slot.
+            std::array<std::atomic<uint64_t>, CAPACITY> m_counts{}; ///< Count per slot.
+            std::atomic<uint64_t>                       m_other{0}; ///< Count of states that found no slot.
+
+        public:
+            /**
+             * @brief Counts one occurrence of a state.
+             *
+             * @param sqlState The SQLSTATE; only its first five characters are used.
+             */
+            void increment(std::string_view sqlState);
+
+            /**
+             * @brief Copies the counts by state.
+             */
+            std::map<std::string, uint64_t> snapshot() const;
+        };
+
+        /**
+         * @brief A copy of all ODBC metrics taken at one moment.
+         */
+        struct MetricsSnapshot {
+            HistogramSnapshot               connect; ///< Latency of connection attempts.
+            HistogramSnapshot               execute; ///< Latency of statement executions.
+            HistogramSnapshot               fetch; ///< Latency of fetch calls, each returning one row or one rowset.
+            HistogramSnapshot               fetchPerRow; ///< Fetch latency divided by the rows the fetch returned.
+            uint64_t                        rows = 0; ///< Rows fetched.
+            uint64_t                        bytes = 0; ///< Bytes of column data fetched.
+            uint64_t                        errors = 0; ///< Calls that returned SQL_ERROR or SQL_INVALID_HANDLE.
+            std::map<std::string, uint64_t> errorsBySqlState; ///< Errors whose diagnostics were read, by SQLSTATE.
+            uint64_t                        retries = 0; ///< Retries made by a retry policy.
+            std::map<std::string, uint64_t> retriesBySqlState; ///< Retries by the SQLSTATE that caused them.
+        };
+
+        /**
+         * @class OdbcMetrics
+         * @brief Lock-free latency histograms and counters for ODBC calls.
+         *
+         * Usually fed by a MeteredOdbcInterface wrapped around the backend; retries are
+         * reported by a RetryPolicy whose onRetry calls recordRetry(). Every record method
+         * may run on any thread without locking, and snapshot() is the pull API. One
+         * instance may be shared by all connections of a pool.
+         */
+        class OdbcMetrics {
+        private:
+            LatencyHistogram        m_connect; ///< Latency of connection attempts.
+            LatencyHistogram        m_execute; ///< Latency of statement executions.
+            LatencyHistogram        m_fetch; ///< Latency of fetch calls.
+            LatencyHistogram        m_fetchPerRow; ///< Fetch latency per row.
+            std::atomic<uint64_t>   m_rows{0}; ///< Rows fetched.
+            std::atomic<uint64_t>   m_bytes{0}; ///< Bytes of column data fetched.
+            std::atomic<uint64_t>   m_errors{0}; ///< Failed calls.
+            SqlStateCounters        m_errorStates; ///< Failed calls by SQLSTATE.
+            std::atomic<uint64_t>   m_retries{0}; ///< Retries.
+            SqlStateCounters        m_retryStates; ///< Retries by SQLSTATE.
+
+        public:
+            /**
+             * @brief Records a connection attempt.
+             *
+             * @param nanos The time the attempt took.
+             */
+            void recordConnect(uint64_t nanos) { m_connect.record(nanos); }
+
+            /**
+             * @brief Records a statement execution.
+             *
+             * @param nanos The time the execution took.
+             */
+            void recordExecute(uint64_t nanos) { m_execute.record(nanos); }
+
+            /**
+             * @brief Records a fetch call and the rows it returned.
+             *
+             * @param nanos The time the fetch took.
+             * @param rows The rows returned; the per-row latency is only recorded if this is positive.
+             */
+            void recordFetch(uint64_t nanos, uint64_t rows);
+
+            /**
+             * @brief Adds bytes of column data fetched.
+             *
+             * @param bytes The number of bytes.
+             */
+            void recordBytes(uint64_t bytes) { m_bytes.fetch_add(bytes, std::memory_order_relaxed); }
+
+            /**
+             * @brief Counts a failed call whose diagnostics may be attributed later with recordErrorState().
+             */
+            void recordError() { m_errors.fetch_add(1, std::memory_order_relaxed); }
+
+            /**
+             * @brief Attributes a failed call to the SQLSTATE of its first diagnostic record.
+             *
+             * @param sqlState The SQLSTATE.
+             */
+            void recordErrorState(std::string_view sqlState) { m_errorStates.increment(sqlState); }
+
+            /**
+             * @brief Counts a retry.
+             *
+             * @param sqlState The SQLSTATE of the error that caused it.
+             */
+            void recordRetry(std::string_view sqlState);
+
+            /**
+             * @brief Copies all metrics.
+             */
+            MetricsSnapshot snapshot() const;
+        };
+    }
+}
+#endif // ODBC_METRICS_H
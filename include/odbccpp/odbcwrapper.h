@@ -1,9 +1,26 @@
 #ifndef ODBC_WRAPPER_H
 #define ODBC_WRAPPER_H
 
+#include <odbccpp/asyncreactor.h>
+#include <odbccpp/basicodbcwrapper.h>
+#include <odbccpp/columnarresult.h>
+#include <odbccpp/exportencoder.h>
 #include <odbccpp/odbcinterface.h>
+#include <odbccpp/prefetchcursor.h>
+#include <odbccpp/querycache.h>
+#include <odbccpp/resultcursor.h>
+#include <odbccpp/resultset.h>
+#include <odbccpp/retrypolicy.h>
+#include <odbccpp/statement.h>
+#include <odbccpp/statementcache.h>
 
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
@@ -16,23 +33,146 @@ namespace ps {
          * This class simplifies the use of ODBC by managing handles, connections,
          * and queries, while providing an interface for executing SQL commands and
          * retrieving results.
+         *
+         * The ODBC implementation is chosen at run time through OdbcInterface; connection
+         * handling, execution and row-by-row retrieval come from BasicOdbcWrapper, which
+         * can also be used directly with a compile-time backend to avoid virtual dispatch.
+         *
+         * With a RetryPolicy set, executions that fail with a transient SQLSTATE are
+         * retried with exponential backoff, and a lost connection is reopened with the
+         * credentials of the last connect(). Only idempotent work is retried, and never
+         * inside a transaction, whose earlier statements the failure rolled back.
          */
-        class OdbcWrapper {
+        class OdbcWrapper : public BasicOdbcWrapper<OdbcInterface> {
+        public:
+            static constexpr size_t MAX_FREE_STATEMENTS = 16; ///< Idle statement handles kept for reuse.
+
+            /**
+             * @brief Receives the final result of runAsync() and the exception error handling raised for it, if any.
+             */
+            using AsyncCompletion = std::function<void(SQLRETURN, std::exception_ptr)>;
+
         private:
-            SQLHENV                         m_hEnv = SQL_NULL_HENV; ///< ODBC environment handle.
-            SQLHDBC                         m_hDbc = SQL_NULL_HDBC; ///< ODBC connection handle.
-            SQLHSTMT                        m_hStmt = SQL_NULL_HSTMT; ///< ODBC statement handle.
-            bool                            m_connected = false; ///< Indicates whether the connection is active.
-            std::unique_ptr<OdbcInterface>  m_odbc = nullptr; ///< Pointer to the ODBC interface implementation.
+            StatementCache                  m_statementCache; ///< Prepared statements keyed by SQL text.
+            std::vector<SQLHSTMT>           m_freeStatements; ///< Closed statement handles ready for reuse by createStatement().
+            uint64_t                        m_generation = 0; ///< Incremented by every disconnect(), invalidating leased handles.
+            std::shared_ptr<AsyncReactor>   m_reactor; ///< Reactor polling asynchronous executions, created on first use.
+            RetryPolicy                     m_retryPolicy; ///< Which failed executions are retried.
+            std::function<bool()>           m_reconnect; ///< Repeats the last connect() with the same credentials.
+            std::shared_ptr<QueryCache>     m_queryCache; ///< Results of executeCachedQuery(), or nullptr if caching is off.
+            std::optional<SQLUINTEGER>      m_getDataExtensions; ///< SQL_GETDATA_EXTENSIONS of the connection, read on first use.
         
             /**
-             * @brief Handles ODBC errors by retrieving diagnostic information.
-             * 
-             * @param handle The ODBC handle where the error occurred.
-             * @param handleType The type of the handle (e.g., environment, connection, statement).
-             * @param retCode The return code from the ODBC function.
+             * @brief Takes back a handle from a Statement, closing its cursor and resetting its parameters.
+             *
+             * Handles from an earlier connection are dropped, as the driver freed them on disconnect.
+             * Beyond MAX_FREE_STATEMENTS idle handles, the handle is freed instead.
+             *
+             * @param hStmt The statement handle.
+             * @param generation The connection generation the handle was allocated in.
+             */
+            void recycleStatement(SQLHSTMT hStmt, uint64_t generation);
+
+            /**
+             * @brief Executes SQL text on a statement through runAsync().
+             *
+             * @param hStmt The statement handle to execute on.
+             * @param sql The SQL text to execute.
+             * @param noDataSucceeds Whether SQL_NO_DATA counts as success.
+             * @return A future holding the outcome, or the exception thrown by handleError().
+             */
+            std::future<bool> executeAsync(SQLHSTMT hStmt, const std::wstring& sql, bool noDataSucceeds);
+
+            /**
+             * @brief Fetches every remaining rowset into a bound buffer, passes each to `consume` and unbinds the buffer.
+             *
+             * @param hStmt The statement handle the buffer is bound to.
+             * @param rowset The bound buffer.
+             * @param consume Receives the buffer after each fetch that returned rows.
+             */
+            void drainRowsets(SQLHSTMT hStmt, RowsetBuffer& rowset, const std::function<void(const RowsetBuffer&)>& consume);
+
+            /**
+             * @brief Fetches the pending result set of a statement into a ResultSet.
+             *
+             * @param hStmt The statement handle holding the result set.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param spill The memory budget beyond which rows spill to a temporary file.
+             * @return The rows; empty if the columns cannot be bound.
              */
-            void handleError(SQLHANDLE handle, SQLSMALLINT handleType, SQLRETURN retCode);
+            ResultSet fetchRows(SQLHSTMT hStmt, SQLULEN rowsetSize, const SpillOptions& spill = SpillOptions());
+
+            /**
+             * @brief Fetches the pending result set of a statement into a ColumnarResult.
+             *
+             * @param hStmt The statement handle holding the result set.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return The columns; empty if the columns cannot be bound.
+             */
+            ColumnarResult fetchColumns(SQLHSTMT hStmt, SQLULEN rowsetSize);
+
+            /**
+             * @brief Decides whether a failed attempt is retried and waits out the backoff if so.
+             *
+             * @param error The error the attempt failed with.
+             * @param idempotent Whether the work may safely run more than once.
+             * @param canReconnect Whether the work survives a reconnect, which invalidates statement handles.
+             * @param attempt The one-based number of the failed attempt.
+             * @param reconnect Set if the connection must be reopened before the next attempt.
+             * @return True if the work should run again.
+             */
+            bool prepareRetry(const OdbcException& error, bool idempotent, bool canReconnect, int attempt, bool& reconnect);
+
+            /**
+             * @brief Reopens the connection with the credentials of the last connect().
+             *
+             * @throws OdbcException if the connection cannot be reopened.
+             */
+            void reconnect();
+
+            /**
+             * @brief Runs `operation`, repeating it as the retry policy allows when it throws an OdbcException.
+             */
+            template <typename Operation>
+            auto runWithRetry(bool idempotent, bool canReconnect, Operation&& operation) -> decltype(operation()) {
+                bool reconnectFirst = false;
+                for (int attempt = 1;; attempt++) {
+                    try {
+                        if (reconnectFirst) {
+                            reconnectFirst = false;
+                            reconnect();
+                        }
+                        return operation();
+                    } catch (const OdbcException& error) {
+                        if (!prepareRetry(error, idempotent, canReconnect, attempt, reconnectFirst)) {
+                            throw;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Fetches the pending result set of a statement as UTF-8 strings.
+             *
+             * @param hStmt The statement handle holding the result set.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return The rows; empty if the columns cannot be bound.
+             */
+            std::vector<std::vector<std::string>> fetchUtf8Rows(SQLHSTMT hStmt, SQLULEN rowsetSize);
+
+            /**
+             * @brief Retrieves the SQL_GETDATA_EXTENSIONS bitmask of the connection's driver, for RowsetBuffer.
+             *
+             * Queried with SQLGetInfo once per connection; a driver that cannot tell counts as supporting none.
+             */
+            SQLUINTEGER getDataExtensions();
+
+            friend class ResultCursor;
+            friend class PrefetchCursor;
+            friend class PreparedStatement;
+            friend class Statement;
+            friend class BatchedTransaction;
+            friend class ParallelQuery;
         
         public:
             /**
@@ -45,85 +185,394 @@ namespace ps {
             /**
              * @brief Destroys the OdbcWrapper object and releases resources.
              */
-            ~OdbcWrapper();
+            ~OdbcWrapper() override;
+
+            using BasicOdbcWrapper::fetchResults;
 
             /**
-             * @brief Initializes the ODBC environment and allocates necessary handles.
+             * @brief Establishes a connection and keeps the credentials for reconnects by the retry policy.
+             *
+             * @param dsn The Data Source Name (DSN) for the database.
+             * @param user The username for authentication.
+             * @param password The password for authentication.
+             * @return True if the connection is successful, false otherwise.
              */
-            void initialize();
+            bool connect(const std::wstring& dsn, const std::wstring& user, const std::wstring& password) override;
 
             /**
-             * @brief Establishes a connection to the database.
-             * 
+             * @brief Establishes a connection with UTF-8 credentials and keeps them for reconnects by the retry policy.
+             *
              * @param dsn The Data Source Name (DSN) for the database.
              * @param user The username for authentication.
              * @param password The password for authentication.
              * @return True if the connection is successful, false otherwise.
              */
-            bool connect(const std::wstring& dsn, const std::wstring& user, const std::wstring& password);
+            bool connect(std::string_view dsn, std::string_view user, std::string_view password) override;
 
             /**
-             * @brief Disconnects from the database and releases the connection handle.
+             * @brief Executes a SQL query that retrieves data, retrying it as the retry policy allows.
+             *
+             * @param query The SQL query to execute.
+             * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails and is not retried, or fails on every attempt.
              */
-            void disconnect();
+            bool executeQuery(const std::wstring& query) override;
 
             /**
-             * @brief Executes a SQL query that retrieves data.
-             * 
+             * @brief Executes UTF-8 SQL text that retrieves data, retrying it as the retry policy allows.
+             *
+             * @param query The SQL query to execute; it need not be NUL-terminated.
+             * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails and is not retried, or fails on every attempt.
+             */
+            bool executeQuery(std::string_view query) override;
+
+            /**
+             * @brief Executes a SQL query that modifies data, as a non-idempotent one that is never retried.
+             *
              * @param query The SQL query to execute.
              * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails.
              */
-            bool executeQuery(const std::wstring& query);
+            bool executeUpdate(const std::wstring& query) override { return executeUpdate(query, false); }
 
             /**
              * @brief Executes a SQL query that modifies data.
-             * 
+             *
              * @param query The SQL query to execute.
+             * @param idempotent Whether running the query twice has the same effect as running it once;
+             *                   only then is it retried.
              * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails and is not retried, or fails on every attempt.
              */
-            bool executeUpdate(const std::wstring& query);
+            bool executeUpdate(const std::wstring& query, bool idempotent);
 
             /**
-             * @brief Fetches the results of the last executed query.
-             * 
+             * @brief Executes UTF-8 SQL text that modifies data, as a non-idempotent one that is never retried.
+             *
+             * @param query The SQL query to execute; it need not be NUL-terminated.
+             * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails.
+             */
+            bool executeUpdate(std::string_view query) override { return executeUpdate(query, false); }
+
+            /**
+             * @brief Executes UTF-8 SQL text that modifies data.
+             *
+             * @param query The SQL query to execute; it need not be NUL-terminated.
+             * @param idempotent Whether running the query twice has the same effect as running it once;
+             *                   only then is it retried.
+             * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails and is not retried, or fails on every attempt.
+             */
+            bool executeUpdate(std::string_view query, bool idempotent);
+
+            /**
+             * @brief Executes a SQL query that modifies data, then drops cached results carrying any of the tags.
+             *
+             * Within a transaction the results are dropped before the commit, so a reader on
+             * another connection sharing the cache can still cache the old rows until then;
+             * invalidate the tags again after commit() in that case.
+             *
+             * @param query The SQL query to execute.
+             * @param tags The tags to invalidate, e.g. the tables the query writes.
+             * @param idempotent Whether running the query twice has the same effect as running it once;
+             *                   only then is it retried.
+             * @return True if the query executes successfully, false otherwise.
+             * @throws OdbcException if the query fails and is not retried, or fails on every attempt.
+             */
+            bool executeUpdateAndInvalidate(const std::wstring& query, const std::vector<std::string>& tags,
+                                            bool idempotent = false);
+
+            /**
+             * @brief Executes a SQL query and fetches all its rows, answering from the query cache when possible.
+             *
+             * The key is the normalized SQL text plus the parameter values. On a miss the
+             * query runs, prepared with its parameters bound if there are any, and the
+             * fetched rows are added to the cache under the given tags. Without a cache set
+             * every call runs the query. Cached queries are retried like executeQuery().
+             *
+             * @param sql The SQL text, using `?` parameter markers if parameters are given.
+             * @param params The values bound to the parameter markers.
+             * @param tags The tags that invalidate the result, e.g. the tables the query reads.
+             * @param ttl The time to live of the result, or zero for the cache's default.
+             * @return The rows, shared with the cache; empty if not connected or the query fails.
+             * @throws OdbcException if the query fails and is not retried, or fails on every attempt.
+             */
+            std::shared_ptr<const ResultSet> executeCachedQuery(const std::wstring& sql,
+                                                                const std::vector<QueryParameter>& params = {},
+                                                                const std::vector<std::string>& tags = {},
+                                                                std::chrono::milliseconds ttl = std::chrono::milliseconds::zero());
+
+            /**
+             * @brief Sets the cache used by executeCachedQuery(); it may be shared by wrappers connected to the same database.
+             *
+             * @param cache The cache, or nullptr to turn caching off.
+             */
+            void setQueryCache(std::shared_ptr<QueryCache> cache) { m_queryCache = std::move(cache); }
+
+            /**
+             * @brief Retrieves the query cache, including its hit ratio, or nullptr if caching is off.
+             */
+            const std::shared_ptr<QueryCache>& getQueryCache() const { return m_queryCache; }
+
+            /**
+             * @brief Sets which failed executions are retried; the default policy retries nothing.
+             *
+             * @param policy The retry policy.
+             */
+            void setRetryPolicy(RetryPolicy policy) { m_retryPolicy = std::move(policy); }
+
+            /**
+             * @brief Retrieves the retry policy.
+             */
+            const RetryPolicy& getRetryPolicy() const { return m_retryPolicy; }
+
+            /**
+             * @brief Runs a unit of work under the retry policy.
+             *
+             * The work is repeated when it throws an OdbcException the policy retries,
+             * reconnecting first for a lost connection. Since reconnecting frees every
+             * statement handle, the work must create its statements itself.
+             *
+             * @param operation The work; its result is returned.
+             * @param idempotent Whether the work may safely run more than once.
+             * @throws OdbcException if the work fails and is not retried, or fails on every attempt.
+             */
+            template <typename Operation>
+            auto withRetry(Operation&& operation, bool idempotent = true) -> decltype(operation()) {
+                return runWithRetry(idempotent, true, std::forward<Operation>(operation));
+            }
+
+            /**
+             * @brief Disconnects from the database and releases the connection handle.
+             *
+             * Also waits for an asynchronous execution in progress on the wrapper's statement,
+             * and frees the prepared statements and idle statement handles.
+             */
+            void disconnect() override;
+
+            /**
+             * @brief Executes a SQL query without blocking the calling thread.
+             *
+             * The statement is put in SQL_ATTR_ASYNC_ENABLE mode and the reactor polls it
+             * until the driver stops returning SQL_STILL_EXECUTING. Do not use the wrapper's
+             * statement until the future is ready; then fetch the results as usual. Drivers
+             * without asynchronous support execute the query before this call returns.
+             *
+             * @param query The SQL query to execute.
+             * @return A future holding true on success and false on failure or if not connected;
+             *         it rethrows the OdbcException executeQuery() would throw.
+             */
+            std::future<bool> executeQueryAsync(const std::wstring& query);
+
+            /**
+             * @brief Runs an ODBC call on a statement in asynchronous mode without blocking.
+             *
+             * Enables SQL_ATTR_ASYNC_ENABLE and makes the first call. If it returns
+             * SQL_STILL_EXECUTING the reactor repeats it until it completes; otherwise, or
+             * if the driver rejects asynchronous mode, `done` runs before this call returns.
+             * Asynchronous mode is switched off again before `done` runs. Failures other than
+             * SQL_NO_DATA go through the usual error handling, and an exception it throws is
+             * passed to `done` instead of being thrown.
+             *
+             * This is the building block of executeQueryAsync(); the statement must not be used
+             * by anyone else until `done` has run.
+             *
+             * @param hStmt The statement handle.
+             * @param call Makes the call; it is repeated with the same arguments.
+             * @param done Receives the final result, on the reactor thread or the calling thread.
+             */
+            void runAsync(SQLHSTMT hStmt, AsyncReactor::Poll call, AsyncCompletion done);
+
+            /**
+             * @brief Uses the given reactor for asynchronous executions, for example one shared by many connections.
+             *
+             * @param reactor The reactor; nullptr creates a private one on first use.
+             */
+            void setAsyncReactor(std::shared_ptr<AsyncReactor> reactor) { m_reactor = std::move(reactor); }
+
+            /**
+             * @brief Retrieves the reactor used for asynchronous executions, or nullptr if none is in use yet.
+             */
+            const std::shared_ptr<AsyncReactor>& getAsyncReactor() const { return m_reactor; }
+
+            /**
+             * @brief Fetches the results of the last executed query using a block cursor.
+             *
+             * Columns are bound once with SQLBindCol and SQL_ATTR_ROW_ARRAY_SIZE is set to
+             * `rowsetSize`, so each SQLFetchScroll round trip returns up to `rowsetSize` rows.
+             * NULL values are reported as "NULL", as with fetchResults().
+             *
+             * Values of any length are returned whole: a column wider than `columnChars`
+             * or of unknown size is bound with a cell of `columnChars` characters and its
+             * longer values are read again with SQLGetData, or, if the driver cannot do so
+             * with a block cursor, it is read with SQLGetData at one row per round trip
+             * (see RowsetBuffer).
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param columnChars The widest cell, in characters.
              * @return A vector of rows, where each row is a vector of strings representing column values.
+             * @throws OdbcException if binding or fetching fails, or a value is truncated.
              */
-            std::vector<std::vector<std::wstring>> fetchResults();
+            std::vector<std::vector<std::wstring>> fetchResults(SQLULEN rowsetSize,
+                                                                SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
 
             /**
-             * @brief Checks if the database connection is active.
-             * 
-             * @return True if connected, false otherwise.
+             * @brief Fetches the results of the last executed query into a slab-backed ResultSet.
+             *
+             * Returns the same values as fetchResults(rowsetSize), but the cell text is packed
+             * into a few large slabs instead of one std::wstring per cell and one vector per
+             * row, so loading a large result costs a handful of allocations and freeing it a
+             * handful of deallocations.
+             *
+             * With a memory budget in `spill`, rows beyond the budget are written to a
+             * memory-mapped temporary file rather than the heap, so results larger than RAM
+             * can be loaded and still be read at random through the same ResultSet interface.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param spill The memory budget and spill file settings; by default nothing spills.
+             * @return The rows, or an empty result set if not connected.
+             * @throws std::runtime_error if binding or fetching fails, or the spill file cannot be written.
              */
-            bool isConnected() const { return m_connected; }
+            ResultSet fetchResultSet(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                     const SpillOptions& spill = SpillOptions());
 
             /**
-             * @brief Retrieves the ODBC interface implementation.
-             * 
-             * @return A pointer to the ODBC interface implementation.
+             * @brief Fetches the results of the last executed query as UTF-8 strings.
+             *
+             * Every column is bound as SQL_C_CHAR with RowsetBuffer::bindUtf8(), so the
+             * driver's text is copied into the result as is, without going through SQLWCHAR
+             * or std::wstring. NULL values are reported as "NULL", as with fetchResults().
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return The rows, or no rows if not connected.
+             * @throws std::runtime_error if binding or fetching fails.
              */
-            OdbcInterface* getOdbcInterface() const { return m_odbc.get(); }
+            std::vector<std::vector<std::string>> fetchResultsUtf8(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
 
             /**
-             * @brief Retrieves the ODBC environment handle.
-             * 
-             * @return The ODBC environment handle.
+             * @brief Fetches the results of the last executed query into contiguous typed columns.
+             *
+             * The columns are bound to native C types as with openTypedCursor(), and each
+             * fetched rowset is appended to the columns straight from the bound arrays,
+             * without building rows of strings first. The result uses the Apache Arrow
+             * memory layout and can be handed to Arrow consumers with ColumnarResult::exportArrow().
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return The columns, or an empty result if not connected.
+             * @throws std::runtime_error if binding or fetching fails.
              */
-            SQLHENV getHEnv() const { return m_hEnv; }
+            ColumnarResult fetchColumnar(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
 
             /**
-             * @brief Retrieves the ODBC connection handle.
-             * 
-             * @return The ODBC connection handle.
+             * @brief Writes the results of the last executed query to a file as CSV, TSV or binary rows.
+             *
+             * Fetching and encoding overlap: two rowset buffers alternate between the calling
+             * thread, which fills one with SQLFetchScroll, and an encoder thread, which turns
+             * the other into UTF-8 and writes it out in large aligned blocks (see
+             * ExportEncoder). The buffers are handed over through lock-free single-producer
+             * single-consumer queues. The file is written under `path + ".tmp"` and renamed
+             * to `path` once complete, so readers never see a partial export. Columns wider
+             * than ExportOptions::columnChars and unknown-size columns are read whole as in
+             * RowsetBuffer; a value the driver truncates fails the export.
+             *
+             * @param path The file to create or replace.
+             * @param format The file format.
+             * @param options The header line, rowset size, cell width and write block size.
+             * @return The rows and bytes written, or zeros if not connected.
+             * @throws std::runtime_error if the file cannot be written.
+             * @throws OdbcException if describing, binding or fetching fails, or a value is truncated.
+             */
+            ExportStats exportTo(const std::string& path, ExportFormat format, const ExportOptions& options = ExportOptions());
+
+            /**
+             * @brief Opens a forward-only cursor over the results of the last executed query.
+             *
+             * Unlike fetchResults(), rows are fetched lazily one rowset at a time and handed out
+             * through a single reused row buffer, so memory use does not grow with the result set.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param columnChars The widest cell, in characters; see fetchResults() for longer values.
+             * @return A cursor over the pending result set, or an empty cursor if not connected.
              */
-            SQLHDBC getHDbc() const { return m_hDbc; }
+            ResultCursor openCursor(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                    SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
 
             /**
-             * @brief Retrieves the ODBC statement handle.
+             * @brief Opens a forward-only cursor whose columns are bound to native C types.
+             *
+             * Each column is described once with SQLDescribeCol; integers and floating point
+             * values are then fetched without any string conversion. Read the values of each
+             * row through ResultCursor::current().
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return A cursor over the pending result set, or an empty cursor if not connected.
+             */
+            ResultCursor openTypedCursor(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
+
+            /**
+             * @brief Opens a forward-only cursor whose rowsets are fetched ahead by a background thread.
+             *
+             * Meant for consumers doing heavy work per row: up to `options.depth` rowsets
+             * are fetched while the current one is processed, so round trips overlap with
+             * the consumer's work. Stop early with PrefetchCursor::cancel() or by destroying
+             * the cursor, which cancels the fetch in progress with SQLCancel.
+             *
+             * @param options The prefetch depth, rowset size and column binding.
+             * @return A cursor over the pending result set, or an empty cursor if not connected.
+             * @throws OdbcException if the columns cannot be bound.
+             */
+            PrefetchCursor openPrefetchCursor(const PrefetchOptions& options = PrefetchOptions());
+
+            /**
+             * @brief Creates a statement with its own handle, so several result sets can be open at once.
+             *
+             * The handle is taken from the connection's free list of closed handles, or
+             * allocated if the list is empty, and is returned to the list when the statement
+             * is destroyed.
+             *
+             * @return A statement, or an empty statement if not connected or the handle cannot be allocated.
+             */
+            Statement createStatement();
+
+            /**
+             * @brief Retrieves the number of closed statement handles waiting for reuse.
+             */
+            size_t freeStatementCount() const { return m_freeStatements.size(); }
+
+            /**
+             * @brief Prepares a SQL statement, reusing a cached one for the same SQL text.
+             *
+             * On a cache miss a new statement handle is allocated and prepared with
+             * SQLPrepare, and the statement is added to the LRU statement cache. Cached
+             * statements are shared, so callers must not interleave executions of the
+             * same SQL text. Every statement it returned, cached or already evicted, is
+             * closed by disconnect().
+             *
+             * @param sql The SQL text, using `?` parameter markers.
+             * @return The prepared statement, or nullptr if not connected.
+             */
+            std::shared_ptr<PreparedStatement> prepare(const std::wstring& sql);
+
+            /**
+             * @brief Sets the maximum number of prepared statements kept in the cache.
+             *
+             * @param capacity The new capacity; 0 disables caching.
+             */
+            void setStatementCacheCapacity(size_t capacity) { m_statementCache.setCapacity(capacity); }
+
+            /**
+             * @brief Retrieves the prepared statement cache, including its hit and miss counters.
+             */
+            const StatementCache& getStatementCache() const { return m_statementCache; }
+
+            /**
+             * @brief Retrieves the ODBC interface implementation.
              * 
-             * @return The ODBC statement handle.
+             * @return A pointer to the ODBC interface implementation.
              */
-            SQLHSTMT getHStmt() const { return m_hStmt; }
+            OdbcInterface* getOdbcInterface() const { return m_odbc.get(); }
         };
     }
 }
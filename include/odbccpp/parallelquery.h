@@ -0,0 +1,194 @@
+#ifndef ODBC_PARALLEL_QUERY_H
+#define ODBC_PARALLEL_QUERY_H
+
+#include <odbccpp/connectionpool.h>
+#include <odbccpp/resultset.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class Partitioning
+         * @brief Splits a query into partitions by a key column, as SQL predicates.
+         *
+         * Modulo partitioning suits keys without a known range. Partition `i` holds the
+         * rows whose key leaves a remainder of `i` or `-i`, so negative keys are covered
+         * too. Range partitioning splits [low, high] into equally wide ranges; the first
+         * and last partitions are open-ended, so keys outside the range still land in
+         * one. In both schemes the first partition also holds NULL keys.
+         *
+         * The column is inserted into the SQL text as given, so it must be a trusted
+         * identifier or expression, never user input.
+         */
+        class Partitioning {
+        public:
+            /**
+             * @brief How rows are assigned to partitions.
+             */
+            enum class Scheme {
+                Modulo, ///< By the remainder of the key divided by the partition count.
+                Range ///< By equally wide key ranges.
+            };
+
+        private:
+            Scheme          m_scheme = Scheme::Modulo; ///< How rows are assigned.
+            std::wstring    m_column; ///< Key column or expression.
+            size_t          m_count = 1; ///< Number of partitions.
+            std::int64_t    m_low = 0; ///< Lowest key of a range partitioning.
+            std::int64_t    m_high = 0; ///< Highest key of a range partitioning.
+
+            Partitioning(Scheme scheme, std::wstring column, size_t count, std::int64_t low, std::int64_t high);
+
+            /**
+             * @brief Retrieves the first key of a range partition.
+             */
+            std::int64_t rangeStart(size_t partition) const;
+
+        public:
+            /**
+             * @brief Partitions by the remainder of an integer key.
+             *
+             * @param column The key column.
+             * @param count The number of partitions.
+             * @throws std::invalid_argument if count is 0.
+             */
+            static Partitioning modulo(std::wstring column, size_t count);
+
+            /**
+             * @brief Partitions an integer key range into equally wide ranges.
+             *
+             * @param column The key column.
+             * @param low The lowest expected key.
+             * @param high The highest expected key.
+             * @param count The number of partitions.
+             * @throws std::invalid_argument if count is 0 or high is below low.
+             */
+            static Partitioning range(std::wstring column, std::int64_t low, std::int64_t high, size_t count);
+
+            /**
+             * @brief Retrieves the partitioning scheme.
+             */
+            Scheme scheme() const { return m_scheme; }
+
+            /**
+             * @brief Retrieves the number of partitions.
+             */
+            size_t count() const { return m_count; }
+
+            /**
+             * @brief Builds the predicate selecting the rows of a partition, in parentheses.
+             *
+             * @param partition The zero-based partition index.
+             */
+            std::wstring predicate(size_t partition) const;
+        };
+
+        /**
+         * @class ParallelQuery
+         * @brief Runs a query as several partitions, each on its own pooled connection.
+         *
+         * The SQL text marks where the partition predicate goes with PLACEHOLDER, e.g.
+         * `SELECT id, name FROM orders WHERE {partition} ORDER BY id`. Each partition runs
+         * on a connection leased from the pool and is fetched one rowset at a time. Each
+         * rowset is copied into a ResultSet on that partition's thread, so the client-side
+         * work of several partitions runs on several cores.
+         *
+         * forEachRow() delivers rows in no particular order, calling the callback from the
+         * worker threads concurrently. forEachRowOrdered() merges the partitions, each
+         * sorted by the same ORDER BY, into one sorted stream on the calling thread; each
+         * partition buffers a few rowsets ahead of the merge.
+         *
+         * If a partition fails or the callback throws, the other partitions stop at their
+         * next rowset, their cursors are closed, and the first exception is rethrown.
+         */
+        class ParallelQuery {
+        public:
+            static constexpr const wchar_t* PLACEHOLDER = L"{partition}"; ///< Marks where the partition predicate goes.
+            static constexpr size_t QUEUE_DEPTH = 4; ///< Rowsets a partition buffers ahead of the merge.
+
+            /**
+             * @brief Receives one row; the row is only valid during the call.
+             */
+            using RowCallback = std::function<void(const ResultSet::Row&)>;
+
+            /**
+             * @brief Returns true if the first row sorts before the second.
+             */
+            using RowOrder = std::function<bool(const ResultSet::Row&, const ResultSet::Row&)>;
+
+        private:
+            ConnectionPool&     m_pool; ///< Pool the partition connections are leased from.
+            std::wstring        m_sql; ///< SQL text containing PLACEHOLDER.
+            Partitioning        m_partitioning; ///< How the query is split.
+            SQLULEN             m_rowsetSize; ///< Rows fetched per round trip.
+
+            /**
+             * @brief Runs a partition on a leased connection, passing each fetched rowset to a consumer.
+             *
+             * The cursor is closed afterwards even if the consumer throws.
+             */
+            void runPartition(OdbcWrapper& connection, size_t partition,
+                              const std::function<void(ResultSet&&)>& consume) const;
+
+        public:
+            /**
+             * @brief Constructs a partitioned query.
+             *
+             * @param pool The pool to lease connections from; it must outlive the query.
+             * @param sql The SQL text, containing PLACEHOLDER at least once.
+             * @param partitioning How the query is split.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @throws std::invalid_argument if the SQL text has no PLACEHOLDER.
+             */
+            ParallelQuery(ConnectionPool& pool, std::wstring sql, Partitioning partitioning,
+                          SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
+
+            /**
+             * @brief Builds the SQL text of a partition.
+             *
+             * @param partition The zero-based partition index.
+             */
+            std::wstring partitionQuery(size_t partition) const;
+
+            /**
+             * @brief Runs every partition and delivers the rows in no particular order.
+             *
+             * Partitions run on as many worker threads as the pool's maximum size allows,
+             * each worker keeping its lease for the partitions it takes on.
+             *
+             * @param onRow Called for every row from the worker threads, concurrently; it must be thread-safe.
+             * @return The number of rows delivered.
+             * @throws The first exception raised by a partition or the callback.
+             */
+            size_t forEachRow(const RowCallback& onRow);
+
+            /**
+             * @brief Runs every partition at once and delivers the rows merged into one sorted stream.
+             *
+             * @param before The order every partition is sorted in, matching the query's ORDER BY.
+             * @param onRow Called for every row on the calling thread, in order.
+             * @return The number of rows delivered.
+             * @throws std::invalid_argument if the pool cannot hold a connection for every partition.
+             * @throws The first exception raised by a partition or the callback.
+             */
+            size_t forEachRowOrdered(const RowOrder& before, const RowCallback& onRow);
+
+            /**
+             * @brief Makes an order on one column, for forEachRowOrdered().
+             *
+             * NULLs sort first, or last when descending, as in SQL Server and MySQL. Text is
+             * compared by code point, which matches binary collations only.
+             *
+             * @param column The zero-based column index.
+             * @param numeric Compares the values as numbers instead of as text.
+             * @param descending Reverses the order.
+             */
+            static RowOrder orderBy(size_t column, bool numeric = false, bool descending = false);
+        };
+    }
+}
+#endif // ODBC_PARALLEL_QUERY_H
@@ -0,0 +1,124 @@
+#ifndef ODBC_PARAMETER_BATCH_H
+#define ODBC_PARAMETER_BATCH_H
+
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/textcodec.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @struct BatchResult
+         * @brief Outcome of executing a statement once for a whole ParameterBatch.
+         */
+        struct BatchResult {
+            SQLLEN                      rowCount = 0; ///< Total rows affected across all parameter sets.
+            SQLULEN                     processed = 0; ///< Parameter sets processed (SQL_ATTR_PARAMS_PROCESSED_PTR).
+            std::vector<SQLUSMALLINT>   status; ///< Per parameter set status (SQL_ATTR_PARAM_STATUS_PTR).
+
+            /**
+             * @brief Counts the parameter sets whose status is SQL_PARAM_ERROR.
+             */
+            size_t failedRows() const {
+                size_t failed = 0;
+                for (SQLUSMALLINT s : status) {
+                    failed += (s == SQL_PARAM_ERROR) ? 1 : 0;
+                }
+                return failed;
+            }
+        };
+
+        /**
+         * @class ParameterBatch
+         * @brief Column-wise parameter arrays for executing a statement with SQL_ATTR_PARAMSET_SIZE.
+         *
+         * Each parameter marker is backed by one contiguous value array and one indicator
+         * array with an element per row, which is the layout ODBC expects for column-wise
+         * parameter binding. A column takes its type from the first value set on it; rows
+         * that are never set are sent as NULL.
+         */
+        class ParameterBatch {
+        public:
+            /**
+             * @brief Value and indicator arrays for a single parameter marker.
+             */
+            struct Column {
+                SQLSMALLINT                         cType = SQL_C_DEFAULT; ///< C type of the value array.
+                SQLSMALLINT                         sqlType = SQL_UNKNOWN_TYPE; ///< SQL type of the parameter marker.
+                SQLULEN                             columnSize = 0; ///< Column size reported to the driver.
+                SQLSMALLINT                         decimalDigits = 0; ///< Decimal digits reported to the driver.
+                std::vector<SQLBIGINT>              ints; ///< Values of an integer column.
+                std::vector<SQLDOUBLE>              doubles; ///< Values of a floating point column.
+                std::vector<SQL_TIMESTAMP_STRUCT>   timestamps; ///< Values of a timestamp column.
+                std::vector<SqlWString>             strings; ///< Values of a string column in UTF-16, before packing.
+                std::vector<SQLWCHAR>               packed; ///< Fixed-width string array built by pack().
+                SQLLEN                              stride = 0; ///< Bytes per element of the bound value array.
+                std::vector<SQLLEN>                 indicators; ///< Length/indicator value per row.
+            };
+
+        private:
+            size_t              m_rows; ///< Number of parameter sets.
+            std::vector<Column> m_columns; ///< Columns indexed by parameter marker position - 1.
+
+            /**
+             * @brief Returns a column, creating or typing it on first use.
+             *
+             * @throws std::out_of_range if the index or row is out of range.
+             * @throws std::invalid_argument if the column already holds another type.
+             */
+            Column& column(SQLUSMALLINT index, size_t row, SQLSMALLINT cType, SQLSMALLINT sqlType);
+
+        public:
+            /**
+             * @brief Constructs an empty batch with a fixed number of rows.
+             *
+             * @param rows The number of parameter sets sent in one execution.
+             */
+            explicit ParameterBatch(size_t rows) : m_rows(rows) {}
+
+            /**
+             * @brief Sets an integer value (SQL_BIGINT).
+             */
+            void setInt(SQLUSMALLINT index, size_t row, std::int64_t value);
+
+            /**
+             * @brief Sets a floating point value (SQL_DOUBLE).
+             */
+            void setDouble(SQLUSMALLINT index, size_t row, double value);
+
+            /**
+             * @brief Sets a string value (SQL_WVARCHAR).
+             */
+            void setString(SQLUSMALLINT index, size_t row, const std::wstring& value);
+
+            /**
+             * @brief Sets a timestamp value (SQL_TYPE_TIMESTAMP).
+             */
+            void setTimestamp(SQLUSMALLINT index, size_t row, const SQL_TIMESTAMP_STRUCT& value);
+
+            /**
+             * @brief Sets a value to SQL NULL. The column must already have a type.
+             */
+            void setNull(SQLUSMALLINT index, size_t row);
+
+            /**
+             * @brief Packs string columns into fixed-width arrays ready for binding.
+             */
+            void pack();
+
+            /**
+             * @brief Retrieves the number of parameter sets.
+             */
+            size_t rows() const { return m_rows; }
+
+            /**
+             * @brief Retrieves the columns, indexed by parameter marker position - 1.
+             */
+            std::vector<Column>& columns() { return m_columns; }
+        };
+    }
+}
+#endif // ODBC_PARAMETER_BATCH_H
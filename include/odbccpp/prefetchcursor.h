@@ -0,0 +1,207 @@
+#ifndef ODBC_PREFETCH_CURSOR_H
+#define ODBC_PREFETCH_CURSOR_H
+
+#include <odbccpp/resultcursor.h>
+#include <odbccpp/rowsetbuffer.h>
+#include <odbccpp/rowview.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+namespace ps {
+    namespace odbc {
+        class OdbcWrapper;
+
+        /**
+         * @brief Options of a PrefetchCursor.
+         */
+        struct PrefetchOptions {
+            static constexpr size_t DEFAULT_DEPTH = 4; ///< Rowsets kept fetched ahead when none is given.
+
+            size_t          depth = DEFAULT_DEPTH; ///< Rowsets fetched ahead of the consumer; at least one.
+            SQLULEN         rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE; ///< Rows fetched per round trip.
+            SQLLEN          columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS; ///< Widest cell, in characters; longer values are read with SQLGetData.
+            ColumnBinding   binding = ColumnBinding::Text; ///< Whether columns are bound as text or as native C types.
+        };
+
+        /**
+         * @brief Counters of a PrefetchCursor, telling which side of the pipeline is the bottleneck.
+         */
+        struct PrefetchStats {
+            uint64_t                    rowsets = 0; ///< Rowsets fetched by the background thread.
+            uint64_t                    rows = 0; ///< Rows fetched by the background thread.
+            std::chrono::nanoseconds    consumerStall{0}; ///< Time the consumer waited for a fetched rowset.
+            std::chrono::nanoseconds    producerStall{0}; ///< Time the fetch thread waited for the consumer to free a buffer.
+        };
+
+        /**
+         * @class PrefetchCursor
+         * @brief Forward-only cursor whose rowsets are fetched ahead by a background thread.
+         *
+         * depth + 1 rowset buffers are bound once. A dedicated thread fetches into every
+         * free buffer and queues it on a ring of ready rowsets, so up to `depth` rowsets
+         * wait fetched while the consumer works through the current one, and network
+         * latency overlaps with per-row processing. The consumer hands each buffer back
+         * when it moves on to the next rowset. The statement's bindings are switched to
+         * a buffer with RowsetBuffer::rebind() before each fetch.
+         *
+         * Rows are read like those of a ResultCursor: through row() with
+         * ColumnBinding::Text, or through current() with ColumnBinding::Native. Fetch
+         * errors are raised by next() once the consumer reaches them; warnings are logged
+         * on the fetch thread.
+         *
+         * Stopping early with cancel(), or destroying the cursor, interrupts a fetch in
+         * progress with SQLCancel, joins the fetch thread and closes the cursor with
+         * SQLFreeStmt(SQL_CLOSE), leaving the handle ready for the next execution. The
+         * OdbcWrapper that opened the cursor must outlive it, and the statement handle must
+         * not be used otherwise while the cursor is open.
+         */
+        class PrefetchCursor {
+        public:
+            using Row = ResultCursor::Row; ///< A single row of column values.
+
+            /**
+             * @class iterator
+             * @brief Input iterator over the rows of a PrefetchCursor.
+             */
+            class iterator {
+            private:
+                PrefetchCursor* m_cursor = nullptr; ///< Cursor being iterated, or nullptr at the end.
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = Row;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Row*;
+                using reference = const Row&;
+
+                iterator() = default;
+                explicit iterator(PrefetchCursor* cursor) : m_cursor(cursor) {}
+
+                reference operator*() const { return m_cursor->row(); }
+                pointer operator->() const { return &m_cursor->row(); }
+
+                iterator& operator++() {
+                    if (!m_cursor->next()) {
+                        m_cursor = nullptr;
+                    }
+                    return *this;
+                }
+
+                void operator++(int) { ++*this; }
+
+                bool operator==(const iterator& other) const { return m_cursor == other.m_cursor; }
+                bool operator!=(const iterator& other) const { return m_cursor != other.m_cursor; }
+            };
+
+        private:
+            struct Pipeline;
+
+            std::unique_ptr<Pipeline>   m_pipeline; ///< Buffers, rings and fetch thread, or nullptr for an empty cursor.
+            RowsetBuffer*               m_rowset = nullptr; ///< Rowset being consumed, or nullptr between rowsets.
+            Row                         m_row; ///< Reused buffer holding the current row.
+            ColumnBinding               m_binding = ColumnBinding::Text; ///< How the columns are bound.
+            SQLULEN                     m_current = 0; ///< Index of the current row within the rowset.
+            bool                        m_started = false; ///< Indicates whether the first row was requested.
+            bool                        m_done = true; ///< Indicates whether the result set is exhausted or cancelled.
+
+            /**
+             * @brief Copies the current rowset row into the row buffer.
+             */
+            void loadRow();
+
+        public:
+            /**
+             * @brief Constructs an empty cursor that yields no rows.
+             */
+            PrefetchCursor();
+
+            /**
+             * @brief Binds the buffers and starts fetching the pending result set of a statement.
+             *
+             * @param wrapper The wrapper that owns the statement handle.
+             * @param odbc The ODBC interface used for binding, fetching and cancelling.
+             * @param hStmt The statement handle holding the result set.
+             * @param options The prefetch depth, rowset size, cell width and column binding.
+             * @throws OdbcException if the columns cannot be bound.
+             */
+            PrefetchCursor(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt,
+                           const PrefetchOptions& options = PrefetchOptions());
+
+            /**
+             * @brief Cancels the cursor if it was not read to the end.
+             */
+            ~PrefetchCursor();
+
+            PrefetchCursor(PrefetchCursor&& other) noexcept;
+            PrefetchCursor& operator=(PrefetchCursor&& other) noexcept;
+
+            /**
+             * @brief Advances to the next row, waiting for the fetch thread when the current rowset is used up.
+             *
+             * @return True if a row is available, false once the result set is exhausted or the cursor is cancelled.
+             * @throws OdbcException if the fetch of the next rowset failed.
+             */
+            bool next();
+
+            /**
+             * @brief Stops fetching: cancels a fetch in progress with SQLCancel, joins the fetch thread and closes the cursor.
+             *
+             * Does nothing if the cursor is empty or already stopped. Rows not yet read are discarded.
+             */
+            void cancel();
+
+            /**
+             * @brief Checks whether the result set is exhausted or the cursor was cancelled.
+             */
+            bool done() const { return m_done; }
+
+            /**
+             * @brief Retrieves the current row. NULL values are reported as "NULL".
+             *
+             * Only filled with ColumnBinding::Text.
+             */
+            const Row& row() const { return m_row; }
+
+            /**
+             * @brief Retrieves a typed view of the current row, valid until the cursor moves to the next rowset.
+             */
+            RowView current() const { return m_rowset ? RowView(m_rowset, m_current) : RowView(); }
+
+            /**
+             * @brief Checks whether a column of the current row is NULL.
+             *
+             * @param col The zero-based column index.
+             */
+            bool isNull(SQLSMALLINT col) const { return current().isNull(col); }
+
+            /**
+             * @brief Retrieves the number of columns in the result set.
+             */
+            SQLSMALLINT columnCount() const;
+
+            /**
+             * @brief Retrieves the rowsets fetched so far and the time each side spent waiting for the other.
+             *
+             * A consumer stall much larger than the producer stall means fetching is the
+             * bottleneck and a larger depth or rowset size may help; the reverse means the
+             * consumer is, and prefetching further ahead only costs memory.
+             */
+            PrefetchStats stats() const;
+
+            /**
+             * @brief Returns an iterator at the current row, fetching the first row if needed.
+             */
+            iterator begin();
+
+            /**
+             * @brief Returns the end iterator.
+             */
+            iterator end() { return iterator(); }
+        };
+    }
+}
+#endif // ODBC_PREFETCH_CURSOR_H
@@ -0,0 +1,243 @@
+#ifndef ODBC_PREPARED_STATEMENT_H
+#define ODBC_PREPARED_STATEMENT_H
+
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/parameterbatch.h>
+#include <odbccpp/resultcursor.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        class OdbcWrapper;
+
+        /**
+         * @class PreparedStatement
+         * @brief A SQL statement prepared once with SQLPrepare and executed many times.
+         *
+         * Each prepared statement owns its own statement handle, separate from the
+         * wrapper's handle used by executeQuery() and executeUpdate(). Parameters are
+         * set by their one-based marker position with typed setters, and are bound to
+         * the statement with SQLBindParameter only when their storage changes, so
+         * re-executing with new values costs a single SQLExecute round trip.
+         *
+         * Instances are normally obtained from OdbcWrapper::prepare(), which caches
+         * them by SQL text. The wrapper must outlive any use of the statement; one that
+         * is merely still held after disconnect() was closed by the wrapper, so its
+         * destruction makes no further ODBC calls.
+         */
+        class PreparedStatement {
+        private:
+            /**
+             * @brief Storage and binding state for a single parameter.
+             */
+            struct Parameter {
+                SQLSMALLINT             cType = SQL_C_DEFAULT; ///< C type of the bound buffer.
+                SQLSMALLINT             sqlType = SQL_UNKNOWN_TYPE; ///< SQL type of the parameter marker.
+                SQLULEN                 columnSize = 0; ///< Column size reported to the driver.
+                SQLSMALLINT             decimalDigits = 0; ///< Decimal digits reported to the driver.
+                SQLBIGINT               intValue = 0; ///< Storage for integer parameters.
+                SQLDOUBLE               doubleValue = 0.0; ///< Storage for floating point parameters.
+                SQL_TIMESTAMP_STRUCT    timestampValue = {}; ///< Storage for timestamp parameters.
+                std::vector<SQLWCHAR>   textValue; ///< Null-terminated storage for string parameters.
+                SQLLEN                  indicator = SQL_NULL_DATA; ///< Length/indicator value.
+                bool                    bound = false; ///< Indicates whether the current storage is bound.
+            };
+
+            OdbcWrapper*            m_wrapper = nullptr; ///< Wrapper used to report ODBC errors.
+            OdbcInterface*          m_odbc = nullptr; ///< Non-owning pointer to the ODBC interface.
+            SQLHSTMT                m_hStmt = SQL_NULL_HSTMT; ///< Owned statement handle.
+            std::wstring            m_sql; ///< SQL text the statement was prepared from.
+            std::vector<Parameter>  m_params; ///< Parameter storage indexed by marker position - 1.
+            bool                    m_cursorOpen = false; ///< Indicates whether the last execution may have left a cursor open.
+            bool                    m_idempotent = false; ///< Indicates whether failed executions may be retried.
+
+            /**
+             * @brief Returns the storage for a parameter, growing the parameter list if needed.
+             *
+             * @param index The one-based parameter marker position.
+             * @param cType The C type that will be stored.
+             * @param sqlType The SQL type of the parameter marker.
+             * @return The parameter storage, marked as needing to be rebound if its type changed.
+             */
+            Parameter& parameter(SQLUSMALLINT index, SQLSMALLINT cType, SQLSMALLINT sqlType);
+
+            /**
+             * @brief Binds every parameter whose storage changed since the last execution.
+             *
+             * @return SQLRETURN of the first failing SQLBindParameter call, or SQL_SUCCESS.
+             */
+            SQLRETURN bindParameters();
+
+            /**
+             * @brief Releases batch parameter arrays and restores single-row execution.
+             */
+            void resetBatch();
+
+        public:
+            /**
+             * @brief Wraps an allocated statement handle.
+             *
+             * @param wrapper The wrapper used to report ODBC errors.
+             * @param odbc The ODBC interface used for all calls.
+             * @param hStmt The statement handle, which becomes owned by this object.
+             * @param sql The SQL text the statement is prepared from.
+             */
+            PreparedStatement(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt, std::wstring sql);
+
+            /**
+             * @brief Releases the statement handle.
+             */
+            ~PreparedStatement();
+
+            PreparedStatement(const PreparedStatement&) = delete;
+            PreparedStatement& operator=(const PreparedStatement&) = delete;
+
+            /**
+             * @brief Prepares the SQL text on the statement handle with SQLPrepare.
+             *
+             * @return True if the statement was prepared, false otherwise.
+             */
+            bool prepare();
+
+            /**
+             * @brief Sets an integer parameter (SQL_BIGINT).
+             *
+             * @param index The one-based parameter marker position.
+             * @param value The value to bind.
+             */
+            void setInt(SQLUSMALLINT index, std::int64_t value);
+
+            /**
+             * @brief Sets a floating point parameter (SQL_DOUBLE).
+             *
+             * @param index The one-based parameter marker position.
+             * @param value The value to bind.
+             */
+            void setDouble(SQLUSMALLINT index, double value);
+
+            /**
+             * @brief Sets a string parameter (SQL_WVARCHAR).
+             *
+             * @param index The one-based parameter marker position.
+             * @param value The value to bind.
+             */
+            void setString(SQLUSMALLINT index, const std::wstring& value);
+
+            /**
+             * @brief Sets a timestamp parameter (SQL_TYPE_TIMESTAMP).
+             *
+             * @param index The one-based parameter marker position.
+             * @param value The value to bind.
+             */
+            void setTimestamp(SQLUSMALLINT index, const SQL_TIMESTAMP_STRUCT& value);
+
+            /**
+             * @brief Sets a parameter to SQL NULL.
+             *
+             * @param index The one-based parameter marker position.
+             * @param sqlType The SQL type of the parameter marker.
+             */
+            void setNull(SQLUSMALLINT index, SQLSMALLINT sqlType = SQL_WVARCHAR);
+
+            /**
+             * @brief Executes the statement with the current parameter values.
+             *
+             * Any cursor left open by the previous execution is closed first. An idempotent
+             * statement is retried on transient errors as the wrapper's retry policy allows.
+             *
+             * @return True if the statement executes successfully, false otherwise.
+             */
+            bool execute() { return execute(m_idempotent); }
+
+            /**
+             * @brief Executes the statement with the current parameter values, overriding setIdempotent() for this call.
+             *
+             * Statements are shared through the wrapper's cache, so a caller that knows its
+             * execution is safe to repeat passes that here rather than marking the statement.
+             *
+             * @param idempotent True to retry transient errors on this execution.
+             * @return True if the statement executes successfully, false otherwise.
+             */
+            bool execute(bool idempotent);
+
+            /**
+             * @brief Marks whether executing this statement twice has the same effect as once, allowing retries.
+             *
+             * @param idempotent True to let execute() retry transient errors.
+             */
+            void setIdempotent(bool idempotent) { m_idempotent = idempotent; }
+
+            /**
+             * @brief Checks whether the statement is marked idempotent.
+             */
+            bool isIdempotent() const { return m_idempotent; }
+
+            /**
+             * @brief Executes the statement once for every row of a parameter batch.
+             *
+             * The batch columns are bound as parameter arrays with column-wise binding and
+             * SQL_ATTR_PARAMSET_SIZE, so the whole batch costs a single SQLExecute round
+             * trip. Row counts reported per parameter set are summed through SQLMoreResults.
+             * If the driver fails some rows but processes others, the diagnostics are logged
+             * and the per-row status is returned instead of throwing. Afterwards the
+             * statement is reset to single-row execution.
+             *
+             * @param batch The parameter arrays; string columns are packed before binding.
+             * @return The aggregate row count, processed count and per-row status.
+             */
+            BatchResult executeBatch(ParameterBatch& batch);
+
+            /**
+             * @brief Retrieves the number of rows affected by the last execution.
+             *
+             * @return The affected row count, or -1 if it is not available.
+             */
+            SQLLEN rowCount();
+
+            /**
+             * @brief Opens a forward-only cursor over the results of the last execution.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param columnChars The widest cell, in characters; see OdbcWrapper::fetchResults() for longer values.
+             */
+            ResultCursor openCursor(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                    SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
+
+            /**
+             * @brief Opens a forward-only cursor whose columns are bound to native C types.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             */
+            ResultCursor openTypedCursor(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
+
+            /**
+             * @brief Fetches all results of the last execution.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param columnChars The widest cell, in characters; see OdbcWrapper::fetchResults() for longer values.
+             * @return A vector of rows, where each row is a vector of strings representing column values.
+             */
+            std::vector<std::vector<std::wstring>> fetchResults(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                                                SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
+
+            /**
+             * @brief Releases the statement handle. Further use of the statement fails.
+             */
+            void close();
+
+            /**
+             * @brief Retrieves the SQL text of the statement.
+             */
+            const std::wstring& getSql() const { return m_sql; }
+
+            /**
+             * @brief Retrieves the statement handle.
+             */
+            SQLHSTMT getHStmt() const { return m_hStmt; }
+        };
+    }
+}
+#endif // ODBC_PREPARED_STATEMENT_H
@@ -0,0 +1,72 @@
+#ifndef ODBC_PROMETHEUS_EXPORTER_H
+#define ODBC_PROMETHEUS_EXPORTER_H
+
+#include <odbccpp/odbcmetrics.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class PrometheusExporter
+         * @brief Renders OdbcMetrics in the Prometheus text exposition format.
+         *
+         * Nothing is served over the network: exportNow() either hands the text to a
+         * callback, e.g. an existing HTTP endpoint, or writes it to a file for the node
+         * exporter's textfile collector. Files are written to a temporary name and renamed,
+         * so a scrape never reads a partial file. Latency histograms are exported in
+         * seconds with fixed 1-2.5-5 buckets from 100 ns to 10 s, aggregated from the
+         * finer HDR buckets.
+         */
+        class PrometheusExporter {
+        private:
+            std::shared_ptr<const OdbcMetrics>      m_metrics; ///< Metrics to export.
+            std::string                             m_prefix; ///< Prefix of every metric name.
+            std::string                             m_path; ///< File written by exportNow(), unless a sink is set.
+            std::function<void(const std::string&)> m_sink; ///< Receives the text from exportNow().
+
+        public:
+            /**
+             * @brief Constructs an exporter that writes a file.
+             *
+             * @param metrics The metrics to export.
+             * @param path The file to write, e.g. "/var/lib/node_exporter/odbc.prom".
+             * @param prefix The prefix of every metric name.
+             */
+            PrometheusExporter(std::shared_ptr<const OdbcMetrics> metrics, std::string path, std::string prefix = "odbc");
+
+            /**
+             * @brief Constructs an exporter that passes the text to a callback.
+             *
+             * @param metrics The metrics to export.
+             * @param sink The callback receiving the text.
+             * @param prefix The prefix of every metric name.
+             */
+            PrometheusExporter(std::shared_ptr<const OdbcMetrics> metrics, std::function<void(const std::string&)> sink,
+                               std::string prefix = "odbc");
+
+            /**
+             * @brief Renders a snapshot of the metrics.
+             */
+            std::string render() const;
+
+            /**
+             * @brief Renders a snapshot and writes it to the file or passes it to the callback.
+             *
+             * @return True if the text was delivered, false if the file could not be written.
+             */
+            bool exportNow() const;
+
+            /**
+             * @brief Renders a metrics snapshot in the text exposition format.
+             *
+             * @param snapshot The metrics.
+             * @param prefix The prefix of every metric name.
+             */
+            static std::string format(const MetricsSnapshot& snapshot, const std::string& prefix = "odbc");
+        };
+    }
+}
+#endif // ODBC_PROMETHEUS_EXPORTER_H
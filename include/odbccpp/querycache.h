@@ -0,0 +1,226 @@
+#ifndef ODBC_QUERY_CACHE_H
+#define ODBC_QUERY_CACHE_H
+
+#include <odbccpp/resultset.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief A parameter of a cached query: NULL, an integer, a floating point number or a string.
+         */
+        using QueryParameter = std::variant<std::nullptr_t, std::int64_t, double, std::wstring>;
+
+        /**
+         * @brief Counters of a QueryCache.
+         */
+        struct QueryCacheStats {
+            std::uint64_t   hits = 0; ///< Lookups answered from the cache.
+            std::uint64_t   misses = 0; ///< Lookups that found nothing, or an expired entry.
+            std::uint64_t   insertions = 0; ///< Results added.
+            std::uint64_t   evictions = 0; ///< Entries dropped to stay within the byte budget.
+            std::uint64_t   expirations = 0; ///< Entries dropped because their TTL had passed.
+            std::uint64_t   invalidations = 0; ///< Entries dropped by invalidate() or clear().
+            std::uint64_t   rejections = 0; ///< Results not cached because they exceed a shard's budget.
+            std::uint64_t   stale = 0; ///< Results not cached because one of their tags was invalidated while they were read.
+            size_t          entries = 0; ///< Entries currently cached.
+            size_t          bytes = 0; ///< Bytes currently held by cached results.
+
+            /**
+             * @brief Retrieves the fraction of lookups answered from the cache, or 0 if there were none.
+             */
+            double hitRatio() const {
+                const std::uint64_t lookups = hits + misses;
+                return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+            }
+        };
+
+        /**
+         * @class QueryCache
+         * @brief Thread-safe cache of query results with a TTL, an LRU byte budget and invalidation by tag.
+         *
+         * Results are keyed on the normalized SQL text plus the parameter values and are
+         * shared as immutable ResultSets, compacted into a single slab when inserted.
+         * Every entry carries the tags it was cached under, typically the tables it reads,
+         * and invalidate() drops all entries carrying a tag once one of those tables has
+         * been written.
+         *
+         * Keys are spread over independently locked shards, each holding its share of the
+         * byte budget and evicting its least recently used entries, so lookups from
+         * different threads rarely contend. Expired entries are dropped when looked up or
+         * when their shard needs room. Counters are atomic and read without locking.
+         *
+         * A cache may be shared by several wrappers, as long as they all connect to the
+         * same database. A reader takes generation() before running its query and passes
+         * it to insert(), which refuses the result if one of its tags was invalidated in
+         * the meantime, since the rows may predate the write that caused it.
+         */
+        class QueryCache {
+        public:
+            static constexpr size_t DEFAULT_BYTE_BUDGET = 64 * 1024 * 1024; ///< Bytes kept when no budget is given.
+            static constexpr size_t DEFAULT_SHARDS = 16; ///< Shards used when no count is given.
+            static constexpr std::uint64_t ANY_GENERATION = UINT64_MAX; ///< Inserts without checking for invalidations.
+
+            using Clock = std::chrono::steady_clock;
+
+        private:
+            /**
+             * @brief A cached result.
+             */
+            struct Entry {
+                std::wstring                        key; ///< Normalized SQL and parameters.
+                std::shared_ptr<const ResultSet>    result; ///< The cached rows.
+                std::vector<std::string>            tags; ///< Tags the result is invalidated by.
+                Clock::time_point                   expires; ///< Time after which the entry is stale.
+                size_t                              bytes = 0; ///< Bytes charged against the budget.
+            };
+
+            /**
+             * @brief An independently locked part of the cache.
+             */
+            struct Shard {
+                std::mutex                                                          mutex; ///< Guards the other members.
+                std::list<Entry>                                                    lru; ///< Entries from most to least recently used.
+                std::unordered_map<std::wstring_view, std::list<Entry>::iterator>   index; ///< Lookup by key, viewing each entry's own copy.
+                size_t                                                              bytes = 0; ///< Bytes held by the entries.
+            };
+
+            size_t                          m_shardBudget; ///< Bytes each shard may hold.
+            std::chrono::milliseconds       m_ttl; ///< Time to live of entries inserted without one.
+            std::unique_ptr<Shard[]>        m_shards; ///< The shards.
+            size_t                          m_shardCount; ///< Number of shards.
+            std::atomic<std::uint64_t>      m_hits{0}; ///< Lookups answered from the cache.
+            std::atomic<std::uint64_t>      m_misses{0}; ///< Lookups that found nothing usable.
+            std::atomic<std::uint64_t>      m_insertions{0}; ///< Results added.
+            std::atomic<std::uint64_t>      m_evictions{0}; ///< Entries dropped for room.
+            std::atomic<std::uint64_t>      m_expirations{0}; ///< Entries dropped as stale.
+            std::atomic<std::uint64_t>      m_invalidations{0}; ///< Entries dropped by tag or clear().
+            std::atomic<std::uint64_t>      m_rejections{0}; ///< Results too large to cache.
+            std::atomic<std::uint64_t>      m_stale{0}; ///< Results refused because a tag was invalidated while they were read.
+            std::atomic<size_t>             m_entries{0}; ///< Entries over all shards.
+            std::atomic<size_t>             m_bytes{0}; ///< Bytes over all shards.
+            std::atomic<std::uint64_t>      m_generation{0}; ///< Incremented by every invalidate() and clear().
+            mutable std::mutex              m_tagMutex; ///< Guards m_tagGenerations and m_clearGeneration.
+            std::unordered_map<std::string, std::uint64_t> m_tagGenerations; ///< Generation of each tag's last invalidation.
+            std::uint64_t                   m_clearGeneration = 0; ///< Generation of the last clear().
+
+            /**
+             * @brief Selects the shard holding a key.
+             */
+            Shard& shardFor(std::wstring_view key) const;
+
+            /**
+             * @brief Removes an entry from a locked shard.
+             */
+            void erase(Shard& shard, std::list<Entry>::iterator entry);
+
+            /**
+             * @brief Checks whether any of the tags was invalidated, or the cache cleared, after a generation.
+             */
+            bool invalidatedSince(const std::vector<std::string>& tags, std::uint64_t generation) const;
+
+            /**
+             * @brief Starts a new generation, recording it for a tag, or for every tag if none is given.
+             */
+            void advanceGeneration(const std::string* tag);
+
+        public:
+            /**
+             * @brief Constructs an empty cache.
+             *
+             * @param byteBudget The total bytes of results to keep, split evenly over the shards.
+             * @param ttl The time to live of results inserted without one.
+             * @param shards The number of independently locked shards.
+             */
+            explicit QueryCache(size_t byteBudget = DEFAULT_BYTE_BUDGET,
+                                std::chrono::milliseconds ttl = std::chrono::minutes(5),
+                                size_t shards = DEFAULT_SHARDS);
+
+            QueryCache(const QueryCache&) = delete;
+            QueryCache& operator=(const QueryCache&) = delete;
+
+            /**
+             * @brief Looks up a result and marks it as most recently used.
+             *
+             * @param key A key made by makeKey().
+             * @return The cached result, or nullptr on a miss or if the entry has expired.
+             */
+            std::shared_ptr<const ResultSet> find(std::wstring_view key);
+
+            /**
+             * @brief Retrieves the current invalidation generation, to be read before running a query to cache.
+             */
+            std::uint64_t generation() const { return m_generation.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Adds or replaces a result, evicting least recently used entries of its shard to make room.
+             *
+             * Any entry already cached under the key is dropped, even if the new result is not kept.
+             *
+             * @param key A key made by makeKey().
+             * @param result The result; it is compacted before it is shared.
+             * @param tags The tags that invalidate the result, e.g. the tables it reads.
+             * @param ttl The time to live, or zero for the cache's default.
+             * @param generation The generation() read before the result was queried; the result is not
+             *                   kept if one of its tags was invalidated since. ANY_GENERATION skips the check.
+             * @return The shared result, whether or not it was kept in the cache.
+             */
+            std::shared_ptr<const ResultSet> insert(std::wstring_view key, ResultSet result,
+                                                    const std::vector<std::string>& tags = {},
+                                                    std::chrono::milliseconds ttl = std::chrono::milliseconds::zero(),
+                                                    std::uint64_t generation = ANY_GENERATION);
+
+            /**
+             * @brief Drops every result carrying a tag.
+             *
+             * @param tag The tag, e.g. a table that was just written.
+             * @return The number of results dropped.
+             */
+            size_t invalidate(std::string_view tag);
+
+            /**
+             * @brief Drops every result.
+             */
+            void clear();
+
+            /**
+             * @brief Retrieves the counters.
+             */
+            QueryCacheStats stats() const;
+
+            /**
+             * @brief Normalizes SQL text so that formatting differences map to the same key.
+             *
+             * Runs of whitespace outside quoted literals, identifiers and `--` comments become
+             * a single space, and leading and trailing whitespace and a trailing semicolon are
+             * removed. A comment is kept as written up to and including its line break, since
+             * that break decides where the comment ends. Case is kept, since literals and
+             * some identifiers are case-sensitive.
+             *
+             * @param sql The SQL text.
+             */
+            static std::wstring normalize(std::wstring_view sql);
+
+            /**
+             * @brief Makes the cache key of a query.
+             *
+             * @param sql The SQL text.
+             * @param params The values bound to its parameter markers.
+             */
+            static std::wstring makeKey(std::wstring_view sql, const std::vector<QueryParameter>& params = {});
+        };
+    }
+}
+#endif // ODBC_QUERY_CACHE_H
@@ -0,0 +1,187 @@
+#ifndef ODBC_RESULT_CURSOR_H
+#define ODBC_RESULT_CURSOR_H
+
+#include <odbccpp/rowsetbuffer.h>
+#include <odbccpp/rowview.h>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        class OdbcWrapper;
+
+        /**
+         * @class ResultCursor
+         * @brief Forward-only, lazily fetched view over the result set of a statement.
+         *
+         * Rows are fetched one rowset at a time through a RowsetBuffer and exposed one
+         * row at a time through a single row buffer that is reused for every row, so
+         * memory use is bounded by the rowset size regardless of the result set size.
+         *
+         * The cursor is an input range: iterating it consumes the result set, and the
+         * row reference obtained from an iterator is only valid until it is advanced.
+         * With ColumnBinding::Native the string row buffer is not filled; typed values
+         * are read in place through current() instead.
+         * The OdbcWrapper that opened the cursor must outlive it, and no other statement
+         * may be executed on the same handle while the cursor is in use.
+         */
+        class ResultCursor {
+        public:
+            using Row = std::vector<std::wstring>; ///< A single row of column values.
+
+            /**
+             * @class iterator
+             * @brief Input iterator over the rows of a ResultCursor.
+             */
+            class iterator {
+            private:
+                ResultCursor* m_cursor = nullptr; ///< Cursor being iterated, or nullptr at the end.
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = Row;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Row*;
+                using reference = const Row&;
+
+                iterator() = default;
+                explicit iterator(ResultCursor* cursor) : m_cursor(cursor) {}
+
+                reference operator*() const { return m_cursor->row(); }
+                pointer operator->() const { return &m_cursor->row(); }
+
+                iterator& operator++() {
+                    if (!m_cursor->next()) {
+                        m_cursor = nullptr;
+                    }
+                    return *this;
+                }
+
+                void operator++(int) { ++*this; }
+
+                bool operator==(const iterator& other) const { return m_cursor == other.m_cursor; }
+                bool operator!=(const iterator& other) const { return m_cursor != other.m_cursor; }
+            };
+
+        private:
+            OdbcWrapper*                    m_wrapper = nullptr; ///< Wrapper used to report ODBC errors.
+            SQLHSTMT                        m_hStmt = SQL_NULL_HSTMT; ///< Statement handle holding the result set.
+            std::unique_ptr<RowsetBuffer>   m_rowset; ///< Bound rowset buffers, or nullptr for an empty cursor.
+            Row                             m_row; ///< Reused buffer holding the current row.
+            ColumnBinding                   m_binding = ColumnBinding::Text; ///< How the columns are bound.
+            SQLULEN                         m_current = 0; ///< Index of the current row within the rowset.
+            bool                            m_started = false; ///< Indicates whether the first row was requested.
+            bool                            m_done = true; ///< Indicates whether the result set is exhausted.
+
+            /**
+             * @brief Copies the current rowset row into the row buffer.
+             */
+            void loadRow();
+
+        public:
+            /**
+             * @brief Constructs an empty cursor that yields no rows.
+             */
+            ResultCursor() = default;
+
+            /**
+             * @brief Opens a cursor over the pending result set of a statement.
+             *
+             * @param wrapper The wrapper that owns the statement handle.
+             * @param odbc The ODBC interface used for binding and fetching.
+             * @param hStmt The statement handle holding the result set.
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param binding Whether columns are bound as text or as native C types.
+             * @param columnChars The widest cell, in characters; see RowsetBuffer for longer values.
+             */
+            ResultCursor(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt,
+                         SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                         ColumnBinding binding = ColumnBinding::Text,
+                         SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
+
+            ResultCursor(ResultCursor&&) noexcept = default;
+            ResultCursor& operator=(ResultCursor&&) noexcept = default;
+
+            /**
+             * @brief Advances to the next row, fetching a new rowset when needed.
+             *
+             * @return True if a row is available through row(), false once the result set is exhausted.
+             */
+            bool next();
+
+            /**
+             * @brief Advances to the next row of the current rowset without fetching.
+             *
+             * Together with fetchRowset() and acceptRowset() this lets a caller run the
+             * fetch itself, for example asynchronously; next() does all three.
+             *
+             * @return True if a row is available, false if the rowset is used up or the cursor is done.
+             */
+            bool nextBuffered();
+
+            /**
+             * @brief Fetches the next rowset into the bound buffers.
+             *
+             * @return SQLRETURN from SQLFetchScroll; SQL_STILL_EXECUTING in asynchronous mode,
+             *         SQL_NO_DATA for an empty or moved-from cursor.
+             */
+            SQLRETURN fetchRowset() { return m_rowset ? m_rowset->fetch() : SQL_NO_DATA; }
+
+            /**
+             * @brief Moves to the first row of a rowset fetched by fetchRowset(), without reporting errors.
+             *
+             * @param ret The final result of the fetch.
+             * @return True if a row is available, false once the result set is exhausted or the fetch failed.
+             */
+            bool acceptRowset(SQLRETURN ret);
+
+            /**
+             * @brief Checks whether the result set is exhausted.
+             */
+            bool done() const { return m_done; }
+
+            /**
+             * @brief Retrieves the current row. NULL values are reported as "NULL".
+             *
+             * Only filled with ColumnBinding::Text.
+             */
+            const Row& row() const { return m_row; }
+
+            /**
+             * @brief Retrieves a typed view of the current row, valid until the next rowset is fetched.
+             *
+             * The view is empty before the first row and after the end of the result set.
+             */
+            RowView current() const {
+                return (m_rowset && m_started && !m_done) ? RowView(m_rowset.get(), m_current) : RowView();
+            }
+
+            /**
+             * @brief Checks whether a column of the current row is NULL.
+             *
+             * @param col The zero-based column index.
+             */
+            bool isNull(SQLSMALLINT col) const { return current().isNull(col); }
+
+            /**
+             * @brief Retrieves the number of columns in the result set.
+             */
+            SQLSMALLINT columnCount() const { return m_rowset ? m_rowset->columnCount() : 0; }
+
+            /**
+             * @brief Returns an iterator at the current row, fetching the first row if needed.
+             */
+            iterator begin();
+
+            /**
+             * @brief Returns the end iterator.
+             */
+            iterator end() { return iterator(); }
+        };
+    }
+}
+#endif // ODBC_RESULT_CURSOR_H
@@ -0,0 +1,282 @@
+#ifndef ODBC_RESULT_SET_H
+#define ODBC_RESULT_SET_H
+
+#include <odbccpp/rowsetbuffer.h>
+#include <odbccpp/spillfile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief Memory budget of a ResultSet, beyond which rows spill to a memory-mapped temporary file.
+         */
+        struct SpillOptions {
+            size_t      memoryBudget = 0; ///< Bytes held in memory before rows spill; 0 never spills.
+            std::string directory; ///< Directory of the spill file; empty for TMPDIR, or /tmp if that is unset (GetTempPath on Windows).
+            size_t      segmentBytes = SpillFile::DEFAULT_SEGMENT_BYTES; ///< Bytes of the spill file mapped at a time.
+        };
+
+        /**
+         * @class ResultSet
+         * @brief A fully materialized result set whose cell text lives in a few large slabs.
+         *
+         * Cell values are copied one after another into slabs of `slabChars` characters
+         * with a bump pointer, and each cell is recorded in a flat cell table as a pointer
+         * and length, the cells of row `r` starting at `r * columnCount()`. Loading a
+         * result therefore allocates once per slab rather than once per cell and row, and
+         * dropping it frees everything in one pass over the slabs.
+         *
+         * Values are exposed as std::wstring_view, valid for the lifetime of the result
+         * set; moving the result set keeps them valid. NULL values read as "NULL", like
+         * with fetchResults(), and can be told apart with isNull().
+         *
+         * With a memory budget, the rows appended once memoryUsage() exceeds it are
+         * spilled instead: each is written to a SpillFile as one record of per-column
+         * end offsets followed by its text, and only a pointer to the record stays in
+         * memory. The file is mapped, so spilled rows are read in place through the same
+         * cell(), isNull() and Row interface, and their pages are written out and dropped
+         * by the kernel under memory pressure.
+         */
+        class ResultSet {
+        public:
+            static constexpr size_t DEFAULT_SLAB_CHARS = 64 * 1024; ///< Characters per slab when none is given.
+
+            /**
+             * @class Row
+             * @brief Non-owning view of one row of a ResultSet.
+             */
+            class Row {
+            private:
+                const ResultSet*    m_set = nullptr; ///< Result set holding the row.
+                size_t              m_row = 0; ///< Index of the row.
+
+            public:
+                Row() = default;
+                Row(const ResultSet* set, size_t row) : m_set(set), m_row(row) {}
+
+                /**
+                 * @brief Retrieves the number of columns.
+                 */
+                size_t size() const { return m_set->columnCount(); }
+
+                /**
+                 * @brief Retrieves the value of a column.
+                 *
+                 * @param col The zero-based column index.
+                 */
+                std::wstring_view operator[](size_t col) const { return m_set->cell(m_row, col); }
+
+                /**
+                 * @brief Checks whether a column is NULL.
+                 *
+                 * @param col The zero-based column index.
+                 */
+                bool isNull(size_t col) const { return m_set->isNull(m_row, col); }
+            };
+
+            /**
+             * @class iterator
+             * @brief Forward iterator over the rows of a ResultSet.
+             */
+            class iterator {
+            private:
+                Row                 m_row; ///< Row the iterator points at.
+                const ResultSet*    m_set = nullptr; ///< Result set being iterated.
+                size_t              m_index = 0; ///< Index of the row.
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Row;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Row*;
+                using reference = const Row&;
+
+                iterator() = default;
+                iterator(const ResultSet* set, size_t index) : m_row(set, index), m_set(set), m_index(index) {}
+
+                reference operator*() const { return m_row; }
+                pointer operator->() const { return &m_row; }
+
+                iterator& operator++() {
+                    m_row = Row(m_set, ++m_index);
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                bool operator==(const iterator& other) const { return m_index == other.m_index; }
+                bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+            };
+
+        private:
+            /**
+             * @brief Location of a cell's text; `data` is nullptr for NULL.
+             */
+            struct Cell {
+                const wchar_t*  data = nullptr;
+                size_t          length = 0;
+            };
+
+            std::vector<std::unique_ptr<wchar_t[]>> m_slabs; ///< Slabs holding the cell text.
+            size_t                                  m_slabChars = DEFAULT_SLAB_CHARS; ///< Characters per regular slab.
+            size_t                                  m_slabUsed = 0; ///< Characters used in the last slab.
+            size_t                                  m_slabCapacity = 0; ///< Characters available in the last slab.
+            size_t                                  m_allocatedChars = 0; ///< Characters allocated over all slabs.
+            std::vector<Cell>                       m_cells; ///< Cell table, row by row.
+            size_t                                  m_columns = 0; ///< Number of columns.
+            size_t                                  m_rows = 0; ///< Number of rows.
+            size_t                                  m_memoryRows = 0; ///< Rows in the cell table; the rest are spilled.
+            SpillOptions                            m_spillOptions; ///< Memory budget and spill file settings.
+            std::unique_ptr<SpillFile>              m_spill; ///< Spill file, created when the budget is first exceeded.
+            std::vector<const uint32_t*>            m_spilledRows; ///< Record of each spilled row, in row order.
+
+            static constexpr uint32_t SPILLED_NULL = 0x80000000u; ///< Flag on a spilled cell's end offset marking NULL.
+
+            /**
+             * @brief Reserves room for `chars` characters, starting a new slab if the last one is full.
+             *
+             * A value larger than a slab gets a slab of its own.
+             */
+            wchar_t* allocate(size_t chars);
+
+            /**
+             * @brief Writes row `row` of a rowset to the spill file, creating the file first if needed.
+             */
+            void spill(const RowsetBuffer& rowset, SQLULEN row);
+
+        public:
+            /**
+             * @brief Constructs an empty result set.
+             *
+             * @param columns The number of columns.
+             * @param slabChars The number of characters per slab.
+             */
+            explicit ResultSet(size_t columns = 0, size_t slabChars = DEFAULT_SLAB_CHARS);
+
+            /**
+             * @brief Constructs an empty result set that spills rows beyond a memory budget.
+             *
+             * @param columns The number of columns.
+             * @param spill The memory budget and spill file settings.
+             * @param slabChars The number of characters per slab.
+             */
+            ResultSet(size_t columns, const SpillOptions& spill, size_t slabChars = DEFAULT_SLAB_CHARS);
+
+            /**
+             * @brief Takes over the slabs of another result set, which is left empty.
+             */
+            ResultSet(ResultSet&& other) noexcept;
+            ResultSet& operator=(ResultSet&& other) noexcept;
+
+            /**
+             * @brief Appends the rows of the current rowset.
+             *
+             * @param rowset A buffer bound with RowsetBuffer::bind() for columnCount() columns, holding a fetched rowset.
+             * @throws std::runtime_error if a row must be spilled and the spill file cannot be created or grown.
+             */
+            void append(const RowsetBuffer& rowset);
+
+            /**
+             * @brief Retrieves the number of rows.
+             */
+            size_t rowCount() const { return m_rows; }
+
+            /**
+             * @brief Retrieves the number of columns.
+             */
+            size_t columnCount() const { return m_columns; }
+
+            /**
+             * @brief Checks whether the result set has no rows.
+             */
+            bool empty() const { return m_rows == 0; }
+
+            /**
+             * @brief Retrieves the value of a cell.
+             *
+             * @param row The zero-based row index.
+             * @param col The zero-based column index.
+             * @return The value, or "NULL" for NULL values.
+             */
+            std::wstring_view cell(size_t row, size_t col) const {
+                if (row >= m_memoryRows) {
+                    const uint32_t* ends = m_spilledRows[row - m_memoryRows];
+                    if (ends[col] & SPILLED_NULL) {
+                        return std::wstring_view(L"NULL");
+                    }
+                    const uint32_t begin = col == 0 ? 0 : ends[col - 1] & ~SPILLED_NULL;
+                    return std::wstring_view(reinterpret_cast<const wchar_t*>(ends + m_columns) + begin, ends[col] - begin);
+                }
+                const Cell& cell = m_cells[row * m_columns + col];
+                return cell.data ? std::wstring_view(cell.data, cell.length) : std::wstring_view(L"NULL");
+            }
+
+            /**
+             * @brief Checks whether a cell is NULL.
+             *
+             * @param row The zero-based row index.
+             * @param col The zero-based column index.
+             */
+            bool isNull(size_t row, size_t col) const {
+                if (row >= m_memoryRows) {
+                    return (m_spilledRows[row - m_memoryRows][col] & SPILLED_NULL) != 0;
+                }
+                return m_cells[row * m_columns + col].data == nullptr;
+            }
+
+            /**
+             * @brief Retrieves a row.
+             *
+             * @param row The zero-based row index.
+             */
+            Row operator[](size_t row) const { return Row(this, row); }
+
+            iterator begin() const { return iterator(this, 0); }
+            iterator end() const { return iterator(this, m_rows); }
+
+            /**
+             * @brief Retrieves the number of slabs allocated for cell text.
+             */
+            size_t slabCount() const { return m_slabs.size(); }
+
+            /**
+             * @brief Retrieves the bytes held in memory by the slabs, the cell table and the spilled row index.
+             */
+            size_t memoryUsage() const {
+                return sizeof(ResultSet) + m_allocatedChars * sizeof(wchar_t) + m_cells.capacity() * sizeof(Cell)
+                     + m_spilledRows.capacity() * sizeof(const uint32_t*);
+            }
+
+            /**
+             * @brief Retrieves the number of rows held in the spill file.
+             */
+            size_t spilledRowCount() const { return m_spilledRows.size(); }
+
+            /**
+             * @brief Retrieves the size of the spill file, or zero if nothing was spilled.
+             */
+            uint64_t spilledBytes() const { return m_spill ? m_spill->fileBytes() : 0; }
+
+            /**
+             * @brief Copies the cell text into a single slab of exactly the size needed and trims the cell table.
+             *
+             * Meant for results kept for a long time, such as cached ones, where the unused
+             * tail of the last slab would otherwise stay allocated. Spilled rows stay in the
+             * spill file; views of the other rows obtained before the call are invalidated.
+             */
+            void compact();
+        };
+    }
+}
+#endif // ODBC_RESULT_SET_H
@@ -0,0 +1,76 @@
+#ifndef ODBC_RETRY_POLICY_H
+#define ODBC_RETRY_POLICY_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief How an ODBC error is handled by the retry policy.
+         */
+        enum class ErrorClass {
+            Permanent, ///< Rethrown at once.
+            Transient, ///< Retried on the same connection, e.g. a deadlock victim (40001) or a query timeout (HYT00).
+            ConnectionLost ///< Retried after reconnecting, e.g. a communication link failure (08S01).
+        };
+
+        /**
+         * @struct RetryPolicy
+         * @brief Which errors are retried, how often and how long to wait in between.
+         *
+         * Errors are classified by SQLSTATE: `classification` is looked up with the full
+         * five-character SQLSTATE first and then with its two-character class, so "08"
+         * covers every connection exception not listed on its own. Unlisted states are
+         * permanent.
+         *
+         * The n-th retry waits `initialBackoff * multiplier^(n-1)`, capped at `maxBackoff`,
+         * of which the `jitter` fraction is drawn at random. With the default full jitter,
+         * clients that lost their connections at the same moment spread their reconnects
+         * over the whole interval instead of arriving together.
+         */
+        struct RetryPolicy {
+            int                                         maxAttempts = 1; ///< Executions per call including the first; 1 disables retries.
+            std::chrono::milliseconds                   initialBackoff{50}; ///< Wait before the first retry, before jitter.
+            std::chrono::milliseconds                   maxBackoff{5000}; ///< Upper bound on a single wait.
+            double                                      multiplier = 2.0; ///< Growth of the wait per retry.
+            double                                      jitter = 1.0; ///< Randomized fraction of each wait, from 0 (none) to 1 (full jitter).
+            std::unordered_map<std::string, ErrorClass> classification = defaultClassification(); ///< SQLSTATEs and SQLSTATE classes.
+            std::function<void(const std::string&, int)> onRetry; ///< Called with the SQLSTATE and failed attempt before each retry, e.g. to count retries.
+
+            /**
+             * @brief Retrieves the built-in SQLSTATE classification.
+             *
+             * Connection exceptions (class 08) and HYT01 reconnect; serialization failures
+             * and deadlocks (40001), 40P01 and HYT00 are transient. 40003 (statement
+             * completion unknown) is permanent, as the statement may have been executed.
+             */
+            static std::unordered_map<std::string, ErrorClass> defaultClassification();
+
+            /**
+             * @brief Classifies an SQLSTATE.
+             *
+             * @param sqlState The five-character SQLSTATE.
+             */
+            ErrorClass classify(const std::string& sqlState) const;
+
+            /**
+             * @brief Computes the wait before a retry.
+             *
+             * @param retry The one-based retry number.
+             * @param random A value in [0, 1) selecting the jittered part of the wait.
+             */
+            std::chrono::milliseconds backoff(int retry, double random) const;
+
+            /**
+             * @brief Computes the wait before a retry with a random jitter.
+             *
+             * @param retry The one-based retry number.
+             */
+            std::chrono::milliseconds backoff(int retry) const;
+        };
+    }
+}
+#endif // ODBC_RETRY_POLICY_H
@@ -0,0 +1,321 @@
+#ifndef ODBC_ROWSET_BUFFER_H
+#define ODBC_ROWSET_BUFFER_H
+
+#include <odbccpp/odbcinterface.h>
+
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief How result columns are bound to client buffers.
+         */
+        enum class ColumnBinding {
+            Text, ///< Every column as SQL_C_WCHAR.
+            Native ///< Integers as SQL_C_SBIGINT, floating point as SQL_C_DOUBLE, everything else as SQL_C_CHAR.
+        };
+
+        /**
+         * @class RowsetBuffer
+         * @brief Column-wise bound buffers for block cursor (multi-row) fetches.
+         *
+         * The buffer binds every result column of a statement into a contiguous array of
+         * `rowsetSize` elements and sets SQL_ATTR_ROW_ARRAY_SIZE, so a single
+         * SQLFetchScroll call returns up to `rowsetSize` rows instead of one SQLFetch
+         * plus one SQLGetData per column per row. bind() binds every column as
+         * SQL_C_WCHAR; bindUtf8() binds every column as SQL_C_CHAR holding UTF-8;
+         * bindNative() binds numeric columns to native C types so no string conversion
+         * takes place.
+         *
+         * Every bind call describes the columns once with SQLDescribeCol and sizes each
+         * cell from the column's type and size. A column of unknown size, such as a CLOB
+         * or JSON column, or one wider than the cell limit is long. If the driver reports
+         * SQL_GD_BLOCK and SQL_GD_BOUND in SQL_GETDATA_EXTENSIONS, a long column is bound
+         * with a cell of the limit, and after each fetch only the cells that overflowed
+         * are read again whole, by positioning on their row with SQLSetPos and reading
+         * with SQLGetData. Otherwise a long column is not bound: it and every later column
+         * are read with SQLGetData after each fetch, in as many pieces as the value needs,
+         * and the rowset size drops to one row. Values are therefore never cut short;
+         * should a driver still truncate a cell of a column that is not long, fetch() fails.
+         *
+         * The buffer does not own the statement handle. Bindings are released by
+         * unbind() or on destruction, which also restores a rowset size of one.
+         */
+        class RowsetBuffer {
+        public:
+            static constexpr SQLULEN DEFAULT_ROWSET_SIZE = 256; ///< Rows returned per fetch when none is given.
+            static constexpr SQLLEN DEFAULT_COLUMN_CHARS = 1024; ///< Widest cell, in characters; wider columns are long.
+            static constexpr SQLSMALLINT MAX_NAME_CHARS = 128; ///< Characters of a column name kept by bindNative().
+
+        private:
+            /**
+             * @brief Bound storage for a single result column.
+             */
+            struct Column {
+                SQLSMALLINT                 cType = SQL_C_WCHAR; ///< C type the column is bound as.
+                SQLSMALLINT                 sqlType = SQL_UNKNOWN_TYPE; ///< SQL type reported by SQLDescribeCol.
+                SQLULEN                     columnSize = 0; ///< Column size reported by SQLDescribeCol, 0 if unknown.
+                SQLSMALLINT                 decimalDigits = 0; ///< Decimal digits reported by SQLDescribeCol.
+                std::wstring                name; ///< Column name reported by SQLDescribeCol.
+                bool                        unbound = false; ///< Read with SQLGetData after each fetch instead of bound.
+                bool                        capped = false; ///< Bound with cells narrower than its values; overflowing cells are read again.
+                SQLLEN                      stride = 0; ///< Bytes per cell, including any terminator.
+                std::vector<unsigned char>  data; ///< rowsetSize cells of `stride` bytes each.
+                std::vector<SQLLEN>         indicators; ///< Length/indicator value for each row.
+                std::vector<std::vector<unsigned char>> overflow; ///< Whole values of the overflowing cells of a capped column, by row; empty for the others.
+            };
+
+            OdbcInterface*          m_odbc = nullptr; ///< Non-owning pointer to the ODBC interface.
+            SQLHSTMT                m_hStmt = SQL_NULL_HSTMT; ///< Statement handle the columns are bound to.
+            bool                    m_blockGetData = false; ///< Indicates whether SQLGetData can read bound columns of a block cursor.
+            SQLULEN                 m_rowsetSize = 0; ///< Number of rows requested per fetch.
+            SQLULEN                 m_rowsFetched = 0; ///< Rows returned by the last fetch (SQL_ATTR_ROWS_FETCHED_PTR).
+            std::vector<Column>     m_columns; ///< One entry per result column.
+            SQLSMALLINT             m_boundColumns = 0; ///< Number of leading columns bound with SQLBindCol.
+            bool                    m_bound = false; ///< Indicates whether every call of the last bind succeeded.
+            bool                    m_attached = false; ///< Indicates whether the statement may hold pointers into the buffer.
+            SQLSMALLINT             m_attachedColumns = 0; ///< Number of leading columns SQLBindCol has pointed at the arrays.
+            SQLRETURN               m_fetchResult = SQL_SUCCESS; ///< Result of the SQLFetchScroll call being completed.
+            SQLULEN                 m_readRow = 0; ///< Row whose overflowing cells are being read again.
+            bool                    m_positioned = false; ///< Indicates whether the cursor is positioned on m_readRow.
+            SQLSMALLINT             m_readColumn = 0; ///< Column being read with SQLGetData.
+            SQLLEN                  m_readBytes = 0; ///< Bytes of the column read so far.
+            bool                    m_reading = false; ///< Indicates whether reading unbound columns was suspended.
+
+            /**
+             * @brief Unbinds, sets the rowset size and describes every column with SQLDescribeCol.
+             *
+             * @return SQLRETURN of the first failing ODBC call, or SQL_SUCCESS.
+             */
+            SQLRETURN describe(SQLSMALLINT numCols, SQLULEN rowsetSize);
+
+            /**
+             * @brief Allocates the column arrays as already typed in m_columns and binds them.
+             *
+             * Long columns are capped if the driver can read bound columns of a block cursor
+             * with SQLGetData. Otherwise columns from the first long one on are left unbound,
+             * since SQLGetData can only read columns after the last bound one, and the rowset
+             * size is set to one.
+             *
+             * @return SQLRETURN of the first failing ODBC call, or SQL_SUCCESS.
+             */
+            SQLRETURN bindColumns();
+
+            /**
+             * @brief Checks whether the last rowset holds a character cell that did not fit its buffer.
+             */
+            bool truncated() const;
+
+            /**
+             * @brief Reads a character or binary value with SQLGetData in pieces, resuming after m_readBytes bytes.
+             *
+             * @param col The zero-based column index.
+             * @param value The buffer receiving the value, grown until the whole value fits.
+             * @param length Receives the bytes read, excluding the terminator, or SQL_NULL_DATA.
+             * @return SQL_STILL_EXECUTING in asynchronous mode, the SQLGetData result if it
+             *         failed, or otherwise SQL_SUCCESS.
+             */
+            SQLRETURN readPieces(SQLSMALLINT col, std::vector<unsigned char>& value, SQLLEN& length);
+
+            /**
+             * @brief Reads the overflowing cells of the capped columns again with SQLSetPos and SQLGetData, resuming where it stopped.
+             *
+             * @return SQL_STILL_EXECUTING in asynchronous mode, the result of a failing
+             *         SQLSetPos or SQLGetData call, or otherwise SQL_SUCCESS.
+             */
+            SQLRETURN readCapped();
+
+            /**
+             * @brief Reads the unbound columns of the fetched row with SQLGetData, resuming where it stopped.
+             *
+             * Character and binary columns are read in pieces, growing their buffer until
+             * the whole value fits; fixed-size columns are read with a single call.
+             *
+             * @return SQL_STILL_EXECUTING in asynchronous mode, the SQLGetData result if it
+             *         failed, or otherwise SQL_SUCCESS.
+             */
+            SQLRETURN readUnbound();
+
+        public:
+            /**
+             * @brief Constructs an unbound rowset buffer for a statement.
+             *
+             * @param odbc The ODBC interface used for binding and fetching.
+             * @param hStmt The statement handle whose result set will be fetched.
+             * @param getDataExtensions The SQL_GETDATA_EXTENSIONS bitmask of the connection's driver,
+             *        see OdbcWrapper::getDataExtensions(); 0 binds no long column.
+             */
+            RowsetBuffer(OdbcInterface* odbc, SQLHSTMT hStmt, SQLUINTEGER getDataExtensions = 0);
+
+            /**
+             * @brief Releases the column bindings, if any.
+             */
+            ~RowsetBuffer();
+
+            RowsetBuffer(const RowsetBuffer&) = delete;
+            RowsetBuffer& operator=(const RowsetBuffer&) = delete;
+
+            /**
+             * @brief Allocates the column arrays and binds them to the statement.
+             *
+             * Each cell holds as many characters as the text form of its column can take.
+             *
+             * @param numCols The number of result columns to bind.
+             * @param rowsetSize The number of rows to return per fetch (0 selects DEFAULT_ROWSET_SIZE).
+             * @param columnChars The widest cell, in characters; wider columns are long.
+             * @return SQLRETURN of the first failing ODBC call, or SQL_SUCCESS.
+             */
+            SQLRETURN bind(SQLSMALLINT numCols, SQLULEN rowsetSize = DEFAULT_ROWSET_SIZE,
+                           SQLLEN columnChars = DEFAULT_COLUMN_CHARS);
+
+            /**
+             * @brief Allocates the column arrays as SQL_C_CHAR and binds them to the statement.
+             *
+             * The driver or driver manager must use a UTF-8 client character set. Cells of
+             * character columns reserve four bytes per character.
+             *
+             * @param numCols The number of result columns to bind.
+             * @param rowsetSize The number of rows to return per fetch (0 selects DEFAULT_ROWSET_SIZE).
+             * @param columnBytes The widest cell, in bytes; wider columns are long.
+             * @return SQLRETURN of the first failing ODBC call, or SQL_SUCCESS.
+             */
+            SQLRETURN bindUtf8(SQLSMALLINT numCols, SQLULEN rowsetSize = DEFAULT_ROWSET_SIZE,
+                               SQLLEN columnBytes = DEFAULT_COLUMN_CHARS * static_cast<SQLLEN>(sizeof(SQLWCHAR)));
+
+            /**
+             * @brief Binds each column to a native C type.
+             *
+             * Exact numerics without a fractional part (up to 18 digits) are bound as
+             * SQL_C_SBIGINT, approximate numerics as SQL_C_DOUBLE and all other columns as
+             * SQL_C_CHAR sized from the described column size.
+             *
+             * @param numCols The number of result columns to bind.
+             * @param rowsetSize The number of rows to return per fetch (0 selects DEFAULT_ROWSET_SIZE).
+             * @param columnChars The widest character cell, in characters; wider columns are long.
+             * @return SQLRETURN of the first failing ODBC call, or SQL_SUCCESS.
+             */
+            SQLRETURN bindNative(SQLSMALLINT numCols, SQLULEN rowsetSize = DEFAULT_ROWSET_SIZE,
+                                 SQLLEN columnChars = DEFAULT_COLUMN_CHARS);
+
+            /**
+             * @brief Binds the arrays allocated by an earlier bind call to the statement again, without reallocating.
+             *
+             * Several buffers bound for the same statement can take turns this way, one
+             * being fetched into while the rows of another are still being read.
+             *
+             * The buffer only counts as bound once every call has succeeded. On failure the
+             * bindings made so far stay in place, so that the caller can read the failing
+             * call's diagnostics first; unbind() or the destructor releases them.
+             *
+             * @return SQLRETURN of the first failing ODBC call, or SQL_SUCCESS.
+             */
+            SQLRETURN rebind();
+
+            /**
+             * @brief Fetches the next rowset into the bound arrays and reads any overflowing cells and unbound columns.
+             *
+             * In asynchronous mode, call again with the same arguments while it returns
+             * SQL_STILL_EXECUTING; a suspended SQLGetData read resumes where it stopped.
+             *
+             * @return SQLRETURN from SQLFetchScroll; SQL_NO_DATA once the result set is exhausted,
+             *         SQL_ERROR if a bound value was truncated, leaving the fetch's 01004
+             *         diagnostics on the statement.
+             */
+            SQLRETURN fetch();
+
+            /**
+             * @brief Removes the column bindings and restores single-row fetching.
+             *
+             * Also releases what a failed bind call left on the statement. The calls clear
+             * the statement's diagnostics, so report a failure before unbinding.
+             */
+            void unbind();
+
+            /**
+             * @brief Retrieves the number of rows returned by the last fetch.
+             */
+            SQLULEN rowsFetched() const { return m_rowsFetched; }
+
+            /**
+             * @brief Retrieves the number of bound columns.
+             */
+            SQLSMALLINT columnCount() const { return static_cast<SQLSMALLINT>(m_columns.size()); }
+
+            /**
+             * @brief Retrieves the number of rows requested per fetch, one if any column is left unbound.
+             */
+            SQLULEN rowsetSize() const { return m_rowsetSize; }
+
+            /**
+             * @brief Checks whether a cell of the current rowset is NULL.
+             *
+             * @param row The zero-based row within the current rowset.
+             * @param col The zero-based column index.
+             * @return True if the cell is SQL NULL.
+             */
+            bool isNull(SQLULEN row, SQLSMALLINT col) const {
+                return m_columns[col].indicators[row] == SQL_NULL_DATA;
+            }
+
+            /**
+             * @brief Copies a cell of the current rowset into a wide string.
+             *
+             * The target string is assigned in place so that its capacity can be reused.
+             *
+             * @param row The zero-based row within the current rowset.
+             * @param col The zero-based column index.
+             * @param out The string receiving the cell value; cleared for NULL cells.
+             */
+            void getString(SQLULEN row, SQLSMALLINT col, std::wstring& out) const;
+
+            /**
+             * @brief Copies a SQL_C_CHAR cell of the current rowset into a string, without conversion.
+             *
+             * The target string is assigned in place so that its capacity can be reused.
+             *
+             * @param row The zero-based row within the current rowset.
+             * @param col The zero-based column index, bound as SQL_C_CHAR.
+             * @param out The string receiving the cell value; cleared for NULL cells.
+             */
+            void getString(SQLULEN row, SQLSMALLINT col, std::string& out) const;
+
+            /**
+             * @brief Retrieves the C type a column is bound as.
+             *
+             * @param col The zero-based column index.
+             */
+            SQLSMALLINT columnType(SQLSMALLINT col) const { return m_columns[col].cType; }
+
+            /**
+             * @brief Retrieves the name of a column reported by SQLDescribeCol.
+             *
+             * @param col The zero-based column index.
+             */
+            const std::wstring& columnName(SQLSMALLINT col) const { return m_columns[col].name; }
+
+            /**
+             * @brief Retrieves the bound storage of a cell of the current rowset.
+             *
+             * @param row The zero-based row within the current rowset.
+             * @param col The zero-based column index.
+             */
+            const unsigned char* cell(SQLULEN row, SQLSMALLINT col) const {
+                const Column& column = m_columns[col];
+                if (column.capped && !column.overflow[row].empty()) {
+                    return column.overflow[row].data();
+                }
+                return column.data.data() + row * column.stride;
+            }
+
+            /**
+             * @brief Retrieves the number of bytes of a character cell, excluding the terminator.
+             *
+             * @param row The zero-based row within the current rowset.
+             * @param col The zero-based column index.
+             */
+            SQLLEN cellLength(SQLULEN row, SQLSMALLINT col) const;
+        };
+    }
+}
+#endif // ODBC_ROWSET_BUFFER_H
@@ -0,0 +1,91 @@
+#ifndef ODBC_ROW_VIEW_H
+#define ODBC_ROW_VIEW_H
+
+#include <odbccpp/rowsetbuffer.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class RowView
+         * @brief Typed, non-owning view of one row of a RowsetBuffer.
+         *
+         * Values are read straight out of the bound column arrays without copying. A
+         * column bound as SQL_C_SBIGINT or SQL_C_DOUBLE is returned as is (or converted
+         * between the two); a character column is parsed when a number is requested.
+         * NULL cells are reported as std::nullopt.
+         *
+         * A view, and any std::string_view obtained from it, is only valid until the
+         * cursor it came from fetches the next rowset.
+         */
+        class RowView {
+        private:
+            const RowsetBuffer* m_rowset = nullptr; ///< Buffer holding the current rowset.
+            SQLULEN             m_row = 0; ///< Row within the rowset.
+
+            std::optional<int64_t> getInt64(SQLSMALLINT col) const;
+            std::optional<double> getDouble(SQLSMALLINT col) const;
+            std::optional<std::string_view> getStringView(SQLSMALLINT col) const;
+
+        public:
+            /**
+             * @brief Constructs an empty view with no columns.
+             */
+            RowView() = default;
+
+            /**
+             * @brief Constructs a view of a row of the current rowset.
+             *
+             * @param rowset The buffer holding the rowset.
+             * @param row The zero-based row within the rowset.
+             */
+            RowView(const RowsetBuffer* rowset, SQLULEN row) : m_rowset(rowset), m_row(row) {}
+
+            /**
+             * @brief Retrieves the number of columns.
+             */
+            SQLSMALLINT columnCount() const { return m_rowset ? m_rowset->columnCount() : 0; }
+
+            /**
+             * @brief Checks whether a column is NULL.
+             *
+             * An empty view, such as a cursor's current row before the first row or after
+             * the end, reports every column as NULL.
+             *
+             * @param col The zero-based column index.
+             */
+            bool isNull(SQLSMALLINT col) const { return !m_rowset || m_rowset->isNull(m_row, col); }
+
+            /**
+             * @brief Reads a column as `int64_t`, `double` or `std::string_view`.
+             *
+             * A std::string_view points into the bound buffer and is only available for
+             * columns bound as SQL_C_CHAR, i.e. with ColumnBinding::Native.
+             *
+             * @param col The zero-based column index.
+             * @return The value, or std::nullopt if the column is NULL.
+             * @throws std::invalid_argument if the column cannot be read as `T`.
+             */
+            template<typename T>
+            std::optional<T> get(SQLSMALLINT col) const {
+                static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double> || std::is_same_v<T, std::string_view>,
+                              "RowView::get supports int64_t, double and std::string_view");
+                if (isNull(col)) {
+                    return std::nullopt;
+                }
+                if constexpr (std::is_same_v<T, int64_t>) {
+                    return getInt64(col);
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return getDouble(col);
+                } else {
+                    return getStringView(col);
+                }
+            }
+        };
+    }
+}
+#endif // ODBC_ROW_VIEW_H
@@ -0,0 +1,102 @@
+#ifndef ODBC_SPILL_FILE_H
+#define ODBC_SPILL_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class SpillFile
+         * @brief Anonymous temporary file handed out as memory through shared mappings.
+         *
+         * The file is created in the given directory and removed as soon as it is closed,
+         * even after a crash: on POSIX systems it is unlinked straight away, on Windows it
+         * is opened with FILE_FLAG_DELETE_ON_CLOSE. It grows one segment at a time. Each
+         * segment's disk blocks are reserved first, so a full disk is reported here rather
+         * than as a fault on first write: with posix_fallocate on Linux, by writing into
+         * every page on macOS, and by moving the end of file on Windows. The segment is
+         * then mapped read-write with mmap or MapViewOfFile. Memory is handed out of the
+         * last segment with a bump pointer. As the pages are backed by the file rather
+         * than by swap, the system writes them out and drops them under memory pressure
+         * and reads them back on access.
+         *
+         * Segments are never moved or unmapped before destruction, so pointers into them
+         * stay valid for the lifetime of the file.
+         */
+        class SpillFile {
+        public:
+            static constexpr size_t DEFAULT_SEGMENT_BYTES = 64 * 1024 * 1024; ///< Bytes per segment when none is given.
+
+        private:
+            /**
+             * @brief One mapped range of the file.
+             */
+            struct Segment {
+                void*   data = nullptr;
+                size_t  bytes = 0;
+            };
+
+#ifdef _WIN32
+            void*                   m_file = nullptr; ///< Handle of the delete-on-close file.
+#else
+            int                     m_fd = -1; ///< Descriptor of the unlinked file.
+#endif
+            size_t                  m_segmentBytes; ///< Bytes per regular segment, a multiple of the page size (the allocation granularity on Windows).
+            std::vector<Segment>    m_segments; ///< Mapped segments, in file order.
+            size_t                  m_used = 0; ///< Bytes handed out of the last segment.
+            uint64_t                m_fileBytes = 0; ///< Current file size.
+
+            /**
+             * @brief Extends the file by a segment, reserving its disk space, and maps it.
+             */
+            void* mapSegment(size_t bytes);
+
+        public:
+            /**
+             * @brief Creates the temporary file, to be removed when it is closed.
+             *
+             * @param directory The directory to create it in; empty for TMPDIR, or /tmp if that is unset
+             *                  (GetTempPath on Windows).
+             * @param segmentBytes The bytes mapped at a time; rounded up to the page size, or to the
+             *                     allocation granularity on Windows.
+             * @throws std::runtime_error if the file cannot be created.
+             */
+            explicit SpillFile(const std::string& directory = std::string(), size_t segmentBytes = DEFAULT_SEGMENT_BYTES);
+
+            /**
+             * @brief Unmaps every segment and closes the file, which frees its disk space.
+             */
+            ~SpillFile();
+
+            SpillFile(const SpillFile&) = delete;
+            SpillFile& operator=(const SpillFile&) = delete;
+
+            /**
+             * @brief Reserves memory in the file, mapping a new segment if the last one is full.
+             *
+             * A request larger than a segment gets a segment of its own. The memory is
+             * zero-filled on first use.
+             *
+             * @param bytes The number of bytes.
+             * @param alignment The alignment of the returned address; at most the page size.
+             * @return The address, valid until the file is destroyed.
+             * @throws std::runtime_error if the file cannot be extended or mapped, e.g. when the disk is full.
+             */
+            void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+            /**
+             * @brief Retrieves the number of segments mapped.
+             */
+            size_t segmentCount() const { return m_segments.size(); }
+
+            /**
+             * @brief Retrieves the size of the file, including unused space at the end of each segment.
+             */
+            uint64_t fileBytes() const { return m_fileBytes; }
+        };
+    }
+}
+#endif // ODBC_SPILL_FILE_H
@@ -0,0 +1,102 @@
+#ifndef ODBC_SPSC_QUEUE_H
+#define ODBC_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class SpscQueue
+         * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+         *
+         * A ring of slots indexed by two ever-increasing counters: the producer alone
+         * advances the tail and the consumer alone advances the head, each publishing with
+         * a release store that the other side reads with an acquire load. Each side also
+         * keeps a private copy of the other's counter and only reloads it when the ring
+         * looks full or empty, so the shared cache lines are touched once per wrap rather
+         * than once per element. The counters sit on separate cache lines.
+         *
+         * Neither side blocks: tryPush() and tryPop() fail instead, and the caller decides
+         * whether to spin, yield or do other work.
+         */
+        template <typename T>
+        class SpscQueue {
+        public:
+            static constexpr size_t CACHE_LINE = 64; ///< Bytes kept between the producer's and consumer's data.
+
+        private:
+            std::unique_ptr<T[]>                    m_slots; ///< Ring storage.
+            size_t                                  m_mask; ///< Capacity - 1; the capacity is a power of two.
+            alignas(CACHE_LINE) std::atomic<size_t> m_head{0}; ///< Next slot to pop, advanced by the consumer.
+            size_t                                  m_cachedTail = 0; ///< Consumer's last view of m_tail.
+            alignas(CACHE_LINE) std::atomic<size_t> m_tail{0}; ///< Next slot to push, advanced by the producer.
+            size_t                                  m_cachedHead = 0; ///< Producer's last view of m_head.
+
+            static size_t roundUp(size_t capacity) {
+                size_t rounded = 1;
+                while (rounded < capacity) {
+                    rounded <<= 1;
+                }
+                return rounded;
+            }
+
+        public:
+            /**
+             * @brief Constructs an empty queue.
+             *
+             * @param capacity The minimum number of elements held; rounded up to a power of two.
+             */
+            explicit SpscQueue(size_t capacity) : m_slots(new T[roundUp(capacity)]), m_mask(roundUp(capacity) - 1) {}
+
+            SpscQueue(const SpscQueue&) = delete;
+            SpscQueue& operator=(const SpscQueue&) = delete;
+
+            /**
+             * @brief Appends an element; called by the producer only.
+             *
+             * @param value The element, moved from on success.
+             * @return False if the queue is full.
+             */
+            bool tryPush(T& value) {
+                const size_t tail = m_tail.load(std::memory_order_relaxed);
+                if (tail - m_cachedHead > m_mask) {
+                    m_cachedHead = m_head.load(std::memory_order_acquire);
+                    if (tail - m_cachedHead > m_mask) {
+                        return false;
+                    }
+                }
+                m_slots[tail & m_mask] = std::move(value);
+                m_tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Removes the oldest element; called by the consumer only.
+             *
+             * @param value Receives the element on success.
+             * @return False if the queue is empty.
+             */
+            bool tryPop(T& value) {
+                const size_t head = m_head.load(std::memory_order_relaxed);
+                if (head == m_cachedTail) {
+                    m_cachedTail = m_tail.load(std::memory_order_acquire);
+                    if (head == m_cachedTail) {
+                        return false;
+                    }
+                }
+                value = std::move(m_slots[head & m_mask]);
+                m_head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Retrieves the number of elements the queue holds when full.
+             */
+            size_t capacity() const { return m_mask + 1; }
+        };
+    }
+}
+#endif // ODBC_SPSC_QUEUE_H
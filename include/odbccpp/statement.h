@@ -0,0 +1,209 @@
+#ifndef ODBC_STATEMENT_H
+#define ODBC_STATEMENT_H
+
+#include <odbccpp/columnarresult.h>
+#include <odbccpp/odbcinterface.h>
+#include <odbccpp/prefetchcursor.h>
+#include <odbccpp/resultcursor.h>
+#include <odbccpp/resultset.h>
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        class OdbcWrapper;
+
+        /**
+         * @class Statement
+         * @brief Move-only statement with its own handle, independent of the wrapper's handle.
+         *
+         * Several statements can be open on one connection at the same time, so a cursor
+         * can stay open on one query while lookups run on another. Handles come from a
+         * per-connection free list kept by the wrapper: on destruction or release() the
+         * statement closes its cursor, drops its bindings and returns the handle to that
+         * list instead of freeing it.
+         *
+         * Instances are obtained from OdbcWrapper::createStatement(). The wrapper must
+         * outlive the statement; a statement that outlives a disconnect() simply drops
+         * its handle, which the driver already freed.
+         */
+        class Statement {
+        private:
+            OdbcWrapper*    m_wrapper = nullptr; ///< Wrapper the handle is returned to.
+            OdbcInterface*  m_odbc = nullptr; ///< Non-owning pointer to the ODBC interface.
+            SQLHSTMT        m_hStmt = SQL_NULL_HSTMT; ///< Leased statement handle.
+            uint64_t        m_generation = 0; ///< Connection generation the handle was allocated in.
+            bool            m_cursorOpen = false; ///< Indicates whether the last execution may have left a cursor open.
+            bool            m_idempotent = false; ///< Indicates whether failed executions may be retried.
+
+            /**
+             * @brief Records the outcome of an execution, throwing on SQL_ERROR.
+             *
+             * @param ret The return code of the execution.
+             * @return True if the statement executed successfully.
+             */
+            bool completeExecute(SQLRETURN ret);
+
+        public:
+            /**
+             * @brief Constructs an empty statement with no handle.
+             */
+            Statement() = default;
+
+            /**
+             * @brief Wraps a statement handle leased from a wrapper's free list.
+             *
+             * @param wrapper The wrapper the handle is returned to.
+             * @param odbc The ODBC interface used for all calls.
+             * @param hStmt The leased statement handle.
+             * @param generation The wrapper's connection generation at the time of the lease.
+             */
+            Statement(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt, uint64_t generation);
+
+            /**
+             * @brief Returns the handle to the wrapper's free list.
+             */
+            ~Statement();
+
+            Statement(Statement&& other) noexcept;
+            Statement& operator=(Statement&& other) noexcept;
+
+            Statement(const Statement&) = delete;
+            Statement& operator=(const Statement&) = delete;
+
+            /**
+             * @brief Executes a SQL statement directly, closing any cursor left by the previous one.
+             *
+             * An idempotent statement is retried on transient errors as the wrapper's retry
+             * policy allows. It is not retried after a lost connection, since reconnecting
+             * frees its handle.
+             *
+             * @param sql The SQL text to execute.
+             * @return True if the statement executed successfully, false otherwise.
+             */
+            bool execute(const std::wstring& sql);
+
+            /**
+             * @brief Executes UTF-8 SQL text through the driver's ANSI entry point.
+             *
+             * @param sql The SQL text to execute; it need not be NUL-terminated.
+             * @return True if the statement executed successfully, false otherwise.
+             */
+            bool execute(std::string_view sql);
+
+            /**
+             * @brief Executes a SQL statement without blocking, on the wrapper's reactor.
+             *
+             * Many statements can be in flight at once, on one connection or several. Do not
+             * use this statement until the future is ready; release() waits for it.
+             *
+             * @param sql The SQL text to execute.
+             * @return A future holding true on success and false on failure or without a handle.
+             */
+            std::future<bool> executeAsync(const std::wstring& sql);
+
+            /**
+             * @brief Marks whether executing this statement twice has the same effect as once, allowing retries.
+             *
+             * @param idempotent True to let execute() retry transient errors.
+             */
+            void setIdempotent(bool idempotent) { m_idempotent = idempotent; }
+
+            /**
+             * @brief Checks whether the statement is marked idempotent.
+             */
+            bool isIdempotent() const { return m_idempotent; }
+
+            /**
+             * @brief Retrieves the number of rows affected by the last execution.
+             *
+             * @return The affected row count, or -1 if it is not available.
+             */
+            SQLLEN rowCount();
+
+            /**
+             * @brief Opens a forward-only cursor over the results of the last execution.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param columnChars The widest cell, in characters; see OdbcWrapper::fetchResults() for longer values.
+             */
+            ResultCursor openCursor(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                    SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
+
+            /**
+             * @brief Opens a forward-only cursor whose columns are bound to native C types.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             */
+            ResultCursor openTypedCursor(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
+
+            /**
+             * @brief Opens a forward-only cursor whose rowsets are fetched ahead by a background thread.
+             *
+             * @param options The prefetch depth, rowset size and column binding.
+             */
+            PrefetchCursor openPrefetchCursor(const PrefetchOptions& options = PrefetchOptions());
+
+            /**
+             * @brief Fetches all results of the last execution.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param columnChars The widest cell, in characters; see OdbcWrapper::fetchResults() for longer values.
+             * @return A vector of rows, where each row is a vector of strings representing column values.
+             */
+            std::vector<std::vector<std::wstring>> fetchResults(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                                                SQLLEN columnChars = RowsetBuffer::DEFAULT_COLUMN_CHARS);
+
+            /**
+             * @brief Fetches all results of the last execution into a slab-backed ResultSet.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @param spill The memory budget beyond which rows spill to a temporary file; by default nothing spills.
+             * @return The rows, or an empty result set without a handle.
+             */
+            ResultSet fetchResultSet(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE,
+                                     const SpillOptions& spill = SpillOptions());
+
+            /**
+             * @brief Fetches all results of the last execution as UTF-8 strings.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return The rows, or no rows without a handle.
+             */
+            std::vector<std::vector<std::string>> fetchResultsUtf8(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
+
+            /**
+             * @brief Fetches all results of the last execution into contiguous typed columns.
+             *
+             * @param rowsetSize The number of rows to fetch per round trip.
+             * @return The columns, or an empty result without a handle.
+             */
+            ColumnarResult fetchColumnar(SQLULEN rowsetSize = RowsetBuffer::DEFAULT_ROWSET_SIZE);
+
+            /**
+             * @brief Closes the cursor of the last execution, if any, keeping the handle.
+             */
+            void closeCursor();
+
+            /**
+             * @brief Returns the handle to the wrapper's free list early. The statement becomes empty.
+             */
+            void release();
+
+            /**
+             * @brief Retrieves the statement handle.
+             */
+            SQLHSTMT getHStmt() const { return m_hStmt; }
+
+            /**
+             * @brief Checks whether the statement holds a handle.
+             */
+            explicit operator bool() const { return m_hStmt != SQL_NULL_HSTMT; }
+        };
+    }
+}
+#endif // ODBC_STATEMENT_H
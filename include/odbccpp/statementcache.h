@@ -0,0 +1,108 @@
+#ifndef ODBC_STATEMENT_CACHE_H
+#define ODBC_STATEMENT_CACHE_H
+
+#include <odbccpp/preparedstatement.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @class StatementCache
+         * @brief Least-recently-used cache of prepared statements keyed by their SQL text.
+         *
+         * Statements are shared: a statement evicted while a caller still holds it keeps
+         * its handle until the last reference is released or the cache is cleared, since
+         * the cache also tracks every statement it was given, cached or not. The cache is
+         * not thread-safe, matching the OdbcWrapper that owns it.
+         */
+        class StatementCache {
+        public:
+            static constexpr size_t DEFAULT_CAPACITY = 64; ///< Statements kept when no capacity is given.
+
+        private:
+            using Entry = std::shared_ptr<PreparedStatement>;
+
+            size_t                                                          m_capacity; ///< Maximum number of cached statements.
+            std::list<Entry>                                                m_lru; ///< Statements ordered from most to least recently used.
+            std::unordered_map<std::wstring_view, std::list<Entry>::iterator> m_index; ///< Lookup by SQL text, viewing each statement's own copy.
+            std::uint64_t                                                   m_hits = 0; ///< Lookups that found a cached statement.
+            std::uint64_t                                                   m_misses = 0; ///< Lookups that did not.
+            std::vector<std::weak_ptr<PreparedStatement>>                   m_issued; ///< Every statement inserted since the last clear(), evicted or not.
+            size_t                                                          m_pruneAt = DEFAULT_CAPACITY; ///< Size of m_issued at which expired entries are dropped.
+
+            /**
+             * @brief Evicts least recently used statements until the cache fits its capacity.
+             */
+            void trim();
+
+        public:
+            /**
+             * @brief Constructs an empty cache.
+             *
+             * @param capacity The maximum number of statements to keep; 0 disables caching.
+             */
+            explicit StatementCache(size_t capacity = DEFAULT_CAPACITY) : m_capacity(capacity) {}
+
+            /**
+             * @brief Looks up a statement and marks it as most recently used.
+             *
+             * @param sql The SQL text of the statement.
+             * @return The cached statement, or nullptr on a miss.
+             */
+            Entry find(const std::wstring& sql);
+
+            /**
+             * @brief Adds a statement, evicting the least recently used one if the cache is full.
+             *
+             * The statement is tracked for clear() even when caching is disabled.
+             *
+             * @param statement The statement to cache, keyed by its SQL text.
+             */
+            void insert(Entry statement);
+
+            /**
+             * @brief Closes and removes every cached statement.
+             *
+             * Statements still referenced elsewhere are closed as well, including ones
+             * already evicted, since their handles must not outlive the connection.
+             */
+            void clear();
+
+            /**
+             * @brief Changes the capacity, evicting statements if it shrinks.
+             *
+             * @param capacity The maximum number of statements to keep; 0 disables caching.
+             */
+            void setCapacity(size_t capacity);
+
+            /**
+             * @brief Retrieves the maximum number of cached statements.
+             */
+            size_t capacity() const { return m_capacity; }
+
+            /**
+             * @brief Retrieves the number of cached statements.
+             */
+            size_t size() const { return m_lru.size(); }
+
+            /**
+             * @brief Retrieves the number of lookups that found a cached statement.
+             */
+            std::uint64_t hits() const { return m_hits; }
+
+            /**
+             * @brief Retrieves the number of lookups that did not find a cached statement.
+             */
+            std::uint64_t misses() const { return m_misses; }
+        };
+    }
+}
+#endif // ODBC_STATEMENT_CACHE_H
@@ -0,0 +1,99 @@
+#ifndef ODBC_TEXT_CODEC_H
+#define ODBC_TEXT_CODEC_H
+
+#include <odbccpp/odbcinterface.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief A NUL-terminated string in the driver's wide encoding, UTF-16.
+         */
+        using SqlWString = std::basic_string<SQLWCHAR>;
+
+        /**
+         * @brief Passes UTF-8 text to an SQLCHAR input parameter, which the driver does not modify.
+         *
+         * @param text The text; pass its size as the length, since it need not be NUL-terminated.
+         */
+        inline SQLCHAR* sqlNarrow(std::string_view text) {
+            return const_cast<SQLCHAR*>(reinterpret_cast<const SQLCHAR*>(text.data()));
+        }
+
+        /**
+         * @brief Converts a wide string to the driver's wide encoding.
+         *
+         * `wchar_t` is UTF-32 on Linux and macOS but SQLWCHAR is UTF-16, so characters
+         * outside the Basic Multilingual Plane become surrogate pairs. Never pass
+         * `std::wstring::c_str()` to a SQLWCHAR parameter directly.
+         *
+         * @param text The text to convert.
+         * @return The converted text; `data()` can be passed with SQL_NTS.
+         */
+        SqlWString toSqlWide(std::wstring_view text);
+
+        /**
+         * @brief Converts text in the driver's wide encoding to a wide string.
+         *
+         * @param text The UTF-16 text.
+         * @param length The number of SQLWCHAR code units.
+         * @return The converted text; unpaired surrogates become U+FFFD.
+         */
+        std::wstring fromSqlWide(const SQLWCHAR* text, size_t length);
+
+        /**
+         * @brief Converts text in the driver's wide encoding into a caller-provided buffer.
+         *
+         * @param text The UTF-16 text.
+         * @param length The number of SQLWCHAR code units.
+         * @param out The buffer receiving the text; it must hold `length` characters.
+         * @return The number of characters written, fewer than `length` if there were surrogate pairs.
+         */
+        size_t fromSqlWide(const SQLWCHAR* text, size_t length, wchar_t* out);
+
+        /**
+         * @brief Counts the code units of a NUL-terminated SQLWCHAR string, stopping at `maxLength`.
+         *
+         * @param text The UTF-16 text.
+         * @param maxLength The size of the buffer holding it, in code units.
+         */
+        size_t sqlWideLength(const SQLWCHAR* text, size_t maxLength);
+
+        /**
+         * @brief Transcodes UTF-16 to UTF-8.
+         *
+         * Runs of ASCII are converted 16 code units at a time with SSE2 where available;
+         * other characters take a scalar path. Unpaired surrogates become U+FFFD.
+         *
+         * @param text The UTF-16 text.
+         * @param length The number of SQLWCHAR code units.
+         * @return The UTF-8 text.
+         */
+        std::string utf16ToUtf8(const SQLWCHAR* text, size_t length);
+
+        /**
+         * @brief Transcodes UTF-16 to UTF-8 into a caller-provided buffer.
+         *
+         * @param text The UTF-16 text.
+         * @param length The number of SQLWCHAR code units.
+         * @param out The buffer receiving the UTF-8 text; it must hold `length * 3` bytes.
+         * @return The number of bytes written.
+         */
+        size_t utf16ToUtf8(const SQLWCHAR* text, size_t length, char* out);
+
+        /**
+         * @brief Transcodes UTF-8 to UTF-16.
+         *
+         * Runs of ASCII are converted 16 bytes at a time with SSE2 where available; other
+         * characters take a scalar path. Malformed sequences become U+FFFD.
+         *
+         * @param text The UTF-8 text.
+         * @return The UTF-16 text.
+         */
+        SqlWString utf8ToUtf16(std::string_view text);
+    }
+}
+#endif // ODBC_TEXT_CODEC_H
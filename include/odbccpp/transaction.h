@@ -0,0 +1,183 @@
+#ifndef ODBC_TRANSACTION_H
+#define ODBC_TRANSACTION_H
+
+#include <odbccpp/odbcinterface.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        class OdbcWrapper;
+
+        /**
+         * @class Transaction
+         * @brief Scope guard for a transaction: begins it on construction and rolls it back unless committed.
+         *
+         * The guard covers every statement run on the wrapper's connection while it is
+         * alive, including those on Statement and PreparedStatement handles. The wrapper
+         * must outlive the guard.
+         */
+        class Transaction {
+        private:
+            OdbcWrapper*    m_wrapper = nullptr; ///< Wrapper whose connection runs the transaction.
+            bool            m_active = false; ///< Indicates whether the transaction has not been ended yet.
+
+        public:
+            /**
+             * @brief Begins a transaction on the wrapper's connection.
+             *
+             * @param wrapper The connected wrapper.
+             * @throws std::runtime_error if the wrapper is not connected, already in a transaction,
+             *         or the driver rejects manual-commit mode.
+             */
+            explicit Transaction(OdbcWrapper& wrapper);
+
+            /**
+             * @brief Rolls back the transaction if it was neither committed nor rolled back.
+             *
+             * A failing rollback is logged, not thrown.
+             */
+            ~Transaction();
+
+            Transaction(const Transaction&) = delete;
+            Transaction& operator=(const Transaction&) = delete;
+
+            /**
+             * @brief Commits the transaction and returns the connection to autocommit mode.
+             *
+             * A failed commit leaves the transaction active, so the destructor rolls it back.
+             *
+             * @return True on success, false if the transaction was already ended or the driver did not commit.
+             * @throws std::runtime_error if the commit fails with SQL_ERROR.
+             */
+            bool commit();
+
+            /**
+             * @brief Rolls back the transaction and returns the connection to autocommit mode.
+             *
+             * @return True on success, false if the transaction was already ended.
+             * @throws std::runtime_error if the rollback fails.
+             */
+            bool rollback();
+
+            /**
+             * @brief Checks whether the transaction is still in progress.
+             */
+            bool active() const { return m_active; }
+        };
+
+        /**
+         * @class BatchedTransaction
+         * @brief Groups a stream of writes into transactions committed every N statements or every T.
+         *
+         * Committing after each statement makes the server flush its log for every write.
+         * Keeping the connection in manual-commit mode and committing once per batch
+         * amortizes that cost over `batchSize` statements, while `maxDelay` bounds how long
+         * a write stays uncommitted. Both limits are checked as statements are recorded:
+         * there is no background timer, so an idle batch is committed by the next
+         * statement or by commit().
+         *
+         * Call commit() after the last write. A batch still open on destruction is
+         * rolled back, like with Transaction. The wrapper must outlive the batcher.
+         */
+        class BatchedTransaction {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+        private:
+            OdbcWrapper*                m_wrapper = nullptr; ///< Wrapper whose connection runs the transactions.
+            size_t                      m_batchSize = 0; ///< Statements per batch.
+            std::chrono::milliseconds   m_maxDelay; ///< Longest time the first statement of a batch stays uncommitted.
+            size_t                      m_pending = 0; ///< Statements in the current batch.
+            Clock::time_point           m_batchStart; ///< Time the first statement of the current batch was recorded.
+            uint64_t                    m_commits = 0; ///< Number of batches committed.
+            bool                        m_active = false; ///< Indicates whether the transaction has not been ended yet.
+
+            /**
+             * @brief Commits the current batch, staying in manual-commit mode for the next one.
+             */
+            void commitBatch();
+
+        public:
+            /**
+             * @brief Begins the first transaction on the wrapper's connection.
+             *
+             * @param wrapper The connected wrapper.
+             * @param batchSize The number of statements committed together; 0 is treated as 1.
+             * @param maxDelay The longest time a recorded statement waits for its commit.
+             * @throws std::runtime_error if the wrapper is not connected, already in a transaction,
+             *         or the driver rejects manual-commit mode.
+             */
+            BatchedTransaction(OdbcWrapper& wrapper, size_t batchSize,
+                               std::chrono::milliseconds maxDelay = std::chrono::milliseconds::max());
+
+            /**
+             * @brief Rolls back the current batch if commit() or rollback() was not called.
+             *
+             * A failing rollback is logged, not thrown.
+             */
+            ~BatchedTransaction();
+
+            BatchedTransaction(const BatchedTransaction&) = delete;
+            BatchedTransaction& operator=(const BatchedTransaction&) = delete;
+
+            /**
+             * @brief Executes a modifying statement on the wrapper and records it.
+             *
+             * @param query The SQL text to execute.
+             * @return True if the statement executed successfully, false otherwise.
+             * @throws std::runtime_error if the statement or a batch commit fails.
+             */
+            bool executeUpdate(const std::wstring& query);
+
+            /**
+             * @brief Records a statement executed by other means, such as a PreparedStatement, on the same connection.
+             *
+             * Commits the batch once it holds `batchSize` statements or its first statement
+             * is older than `maxDelay`.
+             *
+             * @throws std::runtime_error if the batch commit fails.
+             */
+            void recordStatement();
+
+            /**
+             * @brief Commits the current batch and returns the connection to autocommit mode.
+             *
+             * A failed commit keeps the batch pending and active, so the destructor rolls it back.
+             *
+             * @return True on success, false if already ended or the driver did not commit.
+             * @throws std::runtime_error if the commit fails with SQL_ERROR.
+             */
+            bool commit();
+
+            /**
+             * @brief Rolls back the current batch and returns the connection to autocommit mode.
+             *
+             * Batches committed earlier stay committed.
+             *
+             * @return True on success, false if already ended.
+             * @throws std::runtime_error if the rollback fails.
+             */
+            bool rollback();
+
+            /**
+             * @brief Retrieves the number of statements recorded since the last commit.
+             */
+            size_t pending() const { return m_pending; }
+
+            /**
+             * @brief Retrieves the number of batches committed so far, including by commit().
+             */
+            uint64_t commits() const { return m_commits; }
+
+            /**
+             * @brief Checks whether the batcher still holds the connection in manual-commit mode.
+             */
+            bool active() const { return m_active; }
+        };
+    }
+}
+#endif // ODBC_TRANSACTION_H
@@ -2,11 +2,44 @@
 #define ODBC_LOGGER_H
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <cstddef>
 #include <memory>
 #include <string>
 
+/**
+ * @def ODBCCPP_LOG_ACTIVE_LEVEL
+ * @brief Lowest log level compiled into the library, using the SPDLOG_LEVEL_* values.
+ *
+ * Messages below this level are removed by the preprocessor, including the evaluation
+ * of their arguments. Defaults to SPDLOG_LEVEL_INFO when NDEBUG is defined and to
+ * SPDLOG_LEVEL_TRACE otherwise. The runtime level set with OdbcLogger::setLevel()
+ * still filters whatever is compiled in.
+ */
+#ifndef ODBCCPP_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define ODBCCPP_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define ODBCCPP_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+#if ODBCCPP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define ODBC_LOG_TRACE(...) \
+    do { if (ps::odbc::OdbcLogger::shouldLog(spdlog::level::trace)) ps::odbc::OdbcLogger::logTrace(__VA_ARGS__); } while (0)
+#else
+#define ODBC_LOG_TRACE(...) (void)0
+#endif
+
+#if ODBCCPP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define ODBC_LOG_DEBUG(...) \
+    do { if (ps::odbc::OdbcLogger::shouldLog(spdlog::level::debug)) ps::odbc::OdbcLogger::logDebug(__VA_ARGS__); } while (0)
+#else
+#define ODBC_LOG_DEBUG(...) (void)0
+#endif
+
 namespace ps {
     namespace odbc {
         /**
@@ -14,10 +47,13 @@ namespace ps {
          * @brief Provides logging functionality for the ODBC wrapper.
          *
          * This class uses the spdlog library to log messages to a file and the console.
-         * It supports logging informational and error messages.
+         * It supports logging trace, debug, informational and error messages, either
+         * synchronously or through a background thread with initializeAsync().
          */
         class OdbcLogger {
         public:
+            static constexpr size_t DEFAULT_QUEUE_SIZE = 8192; ///< Queued messages in async mode.
+
             /**
              * @brief Initializes the logger with a specified log file path.
              * 
@@ -31,6 +67,83 @@ namespace ps {
                 spdlog::set_level(spdlog::level::info); // Set default log level
             }
 
+            /**
+             * @brief Initializes the logger to write through a background thread.
+             *
+             * Logging calls only format the message and enqueue it; the file is written by
+             * spdlog's thread pool. Call shutdown() before exit to drain the queue.
+             *
+             * @param logFilePath The path to the log file where logs will be written.
+             * @param queueSize The maximum number of queued messages.
+             * @param overflowPolicy Whether a full queue blocks the caller or drops the oldest message.
+             * @param threadCount The number of background threads writing the file.
+             */
+            static void initializeAsync(const std::string& logFilePath, size_t queueSize = DEFAULT_QUEUE_SIZE,
+                                        spdlog::async_overflow_policy overflowPolicy = spdlog::async_overflow_policy::block,
+                                        size_t threadCount = 1) {
+                spdlog::set_pattern("[%Y-%m-%d %H:%M:%S] [%l] %v");
+                spdlog::init_thread_pool(queueSize, threadCount);
+                auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logFilePath, true);
+                auto logger = std::make_shared<spdlog::async_logger>("OdbcLogger", fileSink, spdlog::thread_pool(), overflowPolicy);
+                spdlog::set_default_logger(logger);
+                spdlog::set_level(spdlog::level::info); // Set default log level
+            }
+
+            /**
+             * @brief Drains any queued messages and stops the background thread.
+             *
+             * Logging keeps working afterwards, synchronously and to the same file.
+             */
+            static void shutdown() {
+                auto sinks = spdlog::default_logger()->sinks();
+                auto level = spdlog::default_logger()->level();
+                spdlog::shutdown();
+                for (auto& sink : sinks) {
+                    sink->flush();
+                }
+
+                auto logger = std::make_shared<spdlog::logger>("OdbcLogger", sinks.begin(), sinks.end());
+                logger->set_pattern("[%Y-%m-%d %H:%M:%S] [%l] %v");
+                logger->set_level(level);
+                spdlog::set_default_logger(logger);
+            }
+
+            /**
+             * @brief Sets the runtime log level.
+             *
+             * @param level The lowest level that is written.
+             */
+            static void setLevel(spdlog::level::level_enum level) {
+                spdlog::set_level(level);
+            }
+
+            /**
+             * @brief Checks whether a message at the given level would be written.
+             *
+             * @param level The level to check.
+             */
+            static bool shouldLog(spdlog::level::level_enum level) {
+                return spdlog::default_logger_raw()->should_log(level);
+            }
+
+            /**
+             * @brief Logs a trace message. Prefer ODBC_LOG_TRACE, which compiles away.
+             *
+             * @param message The message to log.
+             */
+            static void logTrace(const std::string& message) {
+                spdlog::trace(message);
+            }
+
+            /**
+             * @brief Logs a debug message. Prefer ODBC_LOG_DEBUG, which compiles away.
+             *
+             * @param message The message to log.
+             */
+            static void logDebug(const std::string& message) {
+                spdlog::debug(message);
+            }
+
             /**
              * @brief Logs an informational message.
              * 
@@ -0,0 +1,95 @@
+#include <odbccpp/asyncreactor.h>
+#include <odbclogger.h>
+
+#include <exception>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        AsyncReactor::AsyncReactor(std::chrono::microseconds pollInterval)
+            : m_pollInterval(pollInterval) {
+        }
+
+        AsyncReactor::~AsyncReactor() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        void AsyncReactor::submit(SQLHSTMT hStmt, Poll poll, Completion complete) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_operations.push_back(Operation{hStmt, std::move(poll), std::move(complete)});
+                m_inFlight.insert(hStmt);
+                if (!m_thread.joinable()) {
+                    m_thread = std::thread(&AsyncReactor::run, this);
+                }
+            }
+            m_wake.notify_one();
+        }
+
+        void AsyncReactor::waitFor(SQLHSTMT hStmt) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (std::this_thread::get_id() == m_thread.get_id()) {
+                return; // Called from a completion: waiting here would keep the operation from ever finishing
+            }
+            m_completed.wait(lock, [this, hStmt] { return m_inFlight.count(hStmt) == 0; });
+        }
+
+        size_t AsyncReactor::pending() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_inFlight.size();
+        }
+
+        void AsyncReactor::run() {
+            std::vector<Operation> batch;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                m_wake.wait(lock, [this] { return m_stopping || !m_operations.empty(); });
+                if (m_operations.empty()) {
+                    return; // Stopping with nothing left in flight
+                }
+
+                batch.swap(m_operations);
+                lock.unlock();
+
+                std::vector<Operation> running;
+                for (Operation& operation : batch) {
+                    SQLRETURN ret = operation.poll();
+                    if (ret == SQL_STILL_EXECUTING) {
+                        running.push_back(std::move(operation));
+                        continue;
+                    }
+
+                    try {
+                        operation.complete(ret);
+                    } catch (const std::exception& e) {
+                        OdbcLogger::logError(std::string("Async completion threw: ") + e.what());
+                    } catch (...) {
+                        OdbcLogger::logError("Async completion threw an unknown exception");
+                    }
+                    std::lock_guard<std::mutex> guard(m_mutex);
+                    m_inFlight.erase(m_inFlight.find(operation.hStmt));
+                    m_completed.notify_all();
+                }
+                batch.clear();
+
+                lock.lock();
+                m_operations.insert(m_operations.end(), std::make_move_iterator(running.begin()),
+                                    std::make_move_iterator(running.end()));
+                if (!running.empty()) {
+                    // Operations submitted meanwhile are polled right away; otherwise back off
+                    m_wake.wait_for(lock, m_pollInterval,
+                                    [this, &running] { return m_operations.size() > running.size(); });
+                }
+            }
+        }
+    }
+}
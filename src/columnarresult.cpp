@@ -0,0 +1,220 @@
+#include <odbccpp/columnarresult.h>
+#include <odbccpp/textcodec.h>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            /**
+             * @brief Owns an exported column until the consumer releases its ArrowArray.
+             */
+            struct ExportedColumn {
+                ColumnarResult::Column  column;
+                const void*             buffers[3] = {nullptr, nullptr, nullptr};
+            };
+
+            /**
+             * @brief Owns the child arrays of an exported struct array.
+             */
+            struct ExportedStruct {
+                std::vector<ArrowArray>     children;
+                std::vector<ArrowArray*>    childPointers;
+                const void*                 buffers[1] = {nullptr};
+            };
+
+            /**
+             * @brief Owns the format and name strings of an exported field.
+             */
+            struct ExportedField {
+                std::string format;
+                std::string name;
+            };
+
+            /**
+             * @brief Owns the child schemas of an exported struct type.
+             */
+            struct ExportedStructType {
+                std::vector<ArrowSchema>    children;
+                std::vector<ArrowSchema*>   childPointers;
+            };
+
+            const char* formatOf(ColumnarType type) {
+                switch (type) {
+                    case ColumnarType::Int64:
+                        return "l";
+                    case ColumnarType::Float64:
+                        return "g";
+                    default:
+                        return "u";
+                }
+            }
+
+            void releaseColumn(ArrowArray* array) {
+                delete static_cast<ExportedColumn*>(array->private_data);
+                array->release = nullptr;
+            }
+
+            void releaseStruct(ArrowArray* array) {
+                ExportedStruct* exported = static_cast<ExportedStruct*>(array->private_data);
+                for (ArrowArray& child : exported->children) {
+                    if (child.release) { // Unless the consumer moved it out
+                        child.release(&child);
+                    }
+                }
+                delete exported;
+                array->release = nullptr;
+            }
+
+            void releaseField(ArrowSchema* schema) {
+                delete static_cast<ExportedField*>(schema->private_data);
+                schema->release = nullptr;
+            }
+
+            void releaseStructType(ArrowSchema* schema) {
+                ExportedStructType* exported = static_cast<ExportedStructType*>(schema->private_data);
+                for (ArrowSchema& child : exported->children) {
+                    if (child.release) {
+                        child.release(&child);
+                    }
+                }
+                delete exported;
+                schema->release = nullptr;
+            }
+        }
+
+        ColumnarResult::ColumnarResult(const RowsetBuffer& rowset) {
+            m_columns.resize(static_cast<size_t>(rowset.columnCount()));
+            for (SQLSMALLINT c = 0; c < rowset.columnCount(); c++) {
+                Column& column = m_columns[c];
+                switch (rowset.columnType(c)) {
+                    case SQL_C_SBIGINT:
+                        column.type = ColumnarType::Int64;
+                        break;
+                    case SQL_C_DOUBLE:
+                        column.type = ColumnarType::Float64;
+                        break;
+                    default:
+                        column.type = ColumnarType::Utf8;
+                        column.offsets.push_back(0);
+                        break;
+                }
+
+                SqlWString name = toSqlWide(rowset.columnName(c));
+                column.name = utf16ToUtf8(name.data(), name.size());
+            }
+        }
+
+        void ColumnarResult::append(const RowsetBuffer& rowset) {
+            const size_t count = static_cast<size_t>(rowset.rowsFetched());
+            for (size_t c = 0; c < m_columns.size(); c++) {
+                Column& column = m_columns[c];
+                const SQLSMALLINT col = static_cast<SQLSMALLINT>(c);
+
+                column.validity.resize((m_rows + count + 7) / 8, 0);
+                if (column.type != ColumnarType::Utf8) {
+                    // Bound by column, so the rowset's values are already one contiguous array.
+                    const size_t start = column.values.size();
+                    column.values.resize(start + count * sizeof(int64_t));
+                    std::memcpy(column.values.data() + start, rowset.cell(0, col), count * sizeof(int64_t));
+                    for (size_t r = 0; r < count; r++) {
+                        const size_t row = m_rows + r;
+                        if (rowset.isNull(r, col)) {
+                            std::memset(column.values.data() + start + r * sizeof(int64_t), 0, sizeof(int64_t));
+                            column.nullCount++;
+                        } else {
+                            column.validity[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+                        }
+                    }
+                    continue;
+                }
+
+                for (size_t r = 0; r < count; r++) {
+                    const size_t row = m_rows + r;
+                    if (rowset.isNull(r, col)) {
+                        column.nullCount++;
+                    } else {
+                        column.validity[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+                        const unsigned char* text = rowset.cell(r, col);
+                        column.values.insert(column.values.end(), text, text + rowset.cellLength(r, col));
+                    }
+                    if (column.values.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                        throw std::length_error("Text of column " + std::to_string(c) + " exceeds the 32-bit Arrow offsets");
+                    }
+                    column.offsets.push_back(static_cast<int32_t>(column.values.size()));
+                }
+            }
+            m_rows += count;
+        }
+
+        const int64_t* ColumnarResult::int64Values(size_t col) const {
+            if (m_columns[col].type != ColumnarType::Int64) {
+                throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " is not an Int64 column");
+            }
+            return reinterpret_cast<const int64_t*>(m_columns[col].values.data());
+        }
+
+        const double* ColumnarResult::doubleValues(size_t col) const {
+            if (m_columns[col].type != ColumnarType::Float64) {
+                throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " is not a Float64 column");
+            }
+            return reinterpret_cast<const double*>(m_columns[col].values.data());
+        }
+
+        std::string_view ColumnarResult::stringValue(size_t row, size_t col) const {
+            const Column& column = m_columns[col];
+            if (column.type != ColumnarType::Utf8) {
+                throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " is not a Utf8 column");
+            }
+            return std::string_view(reinterpret_cast<const char*>(column.values.data()) + column.offsets[row],
+                                    static_cast<size_t>(column.offsets[row + 1] - column.offsets[row]));
+        }
+
+        void ColumnarResult::exportArrow(ArrowArray* array, ArrowSchema* schema) {
+            const size_t numCols = m_columns.size();
+
+            ExportedStructType* structType = new ExportedStructType();
+            structType->children.resize(numCols);
+            ExportedStruct* exported = new ExportedStruct();
+            exported->children.resize(numCols);
+
+            for (size_t c = 0; c < numCols; c++) {
+                Column& source = m_columns[c];
+
+                ExportedField* field = new ExportedField{formatOf(source.type), source.name};
+                structType->children[c] = ArrowSchema{field->format.c_str(), field->name.c_str(), nullptr,
+                                                      ARROW_FLAG_NULLABLE, 0, nullptr, nullptr, &releaseField, field};
+                structType->childPointers.push_back(&structType->children[c]);
+
+                ExportedColumn* owner = new ExportedColumn{std::move(source)};
+                Column& column = owner->column;
+                if (column.values.empty()) {
+                    column.values.reserve(1); // Arrow consumers expect a data buffer even when it is empty
+                }
+                int64_t numBuffers = 2;
+                owner->buffers[0] = column.nullCount > 0 ? column.validity.data() : nullptr;
+                if (column.type == ColumnarType::Utf8) {
+                    owner->buffers[1] = column.offsets.data();
+                    owner->buffers[2] = column.values.data();
+                    numBuffers = 3;
+                } else {
+                    owner->buffers[1] = column.values.data();
+                }
+                exported->children[c] = ArrowArray{static_cast<int64_t>(m_rows), column.nullCount, 0, numBuffers, 0,
+                                                   owner->buffers, nullptr, nullptr, &releaseColumn, owner};
+                exported->childPointers.push_back(&exported->children[c]);
+            }
+
+            *schema = ArrowSchema{"+s", "", nullptr, 0, static_cast<int64_t>(numCols),
+                                  structType->childPointers.data(), nullptr, &releaseStructType, structType};
+            *array = ArrowArray{static_cast<int64_t>(m_rows), 0, 0, 1, static_cast<int64_t>(numCols), exported->buffers,
+                                exported->childPointers.data(), nullptr, &releaseStruct, exported};
+
+            m_columns.clear();
+            m_rows = 0;
+        }
+    }
+}
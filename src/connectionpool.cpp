@@ -0,0 +1,257 @@
+#include <odbccpp/connectionpool.h>
+#include <odbccpp/odbcexecutor.h>
+#include <odbclogger.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            constexpr size_t MAX_STRIPES = 16; ///< Upper bound on idle stripes, regardless of core count.
+        }
+
+        ConnectionPool::ConnectionPool(std::wstring dsn, std::wstring user, std::wstring password,
+                                       Config config, InterfaceFactory factory)
+            : m_dsn(std::move(dsn)), m_user(std::move(user)), m_password(std::move(password)),
+              m_config(config), m_factory(std::move(factory)) {
+            ODBC_LOG_TRACE("Entering ConnectionPool constructor");
+            if (m_config.maxSize == 0) {
+                throw std::invalid_argument("ODBC Error: connection pool maxSize must be at least 1");
+            }
+            m_config.minSize = std::min(m_config.minSize, m_config.maxSize);
+
+            m_stripeCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_STRIPES);
+            m_stripes = std::make_unique<Stripe[]>(m_stripeCount);
+
+            m_odbc = m_factory ? m_factory() : std::make_unique<OdbcExecutor>();
+            SQLRETURN ret = m_odbc->SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &m_hEnv);
+            if (!SQL_SUCCEEDED(ret)) {
+                throw std::runtime_error("ODBC Error: Unable to allocate pool environment");
+            }
+            ret = m_odbc->SQLSetEnvAttr(m_hEnv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+            if (!SQL_SUCCEEDED(ret)) {
+                m_odbc->SQLFreeHandle(SQL_HANDLE_ENV, m_hEnv);
+                throw std::runtime_error("ODBC Error: Unable to set ODBC version on pool environment");
+            }
+
+            try {
+                for (size_t i = 0; i < m_config.minSize && reserve(); i++) {
+                    Stripe& stripe = m_stripes[i % m_stripeCount];
+                    stripe.idle.push_back(Idle{open(), Clock::now()});
+                }
+            } catch (...) {
+                for (size_t i = 0; i < m_stripeCount; i++) {
+                    m_stripes[i].idle.clear();
+                }
+                m_odbc->SQLFreeHandle(SQL_HANDLE_ENV, m_hEnv);
+                throw;
+            }
+            ODBC_LOG_TRACE("Exiting ConnectionPool constructor");
+        }
+
+        ConnectionPool::~ConnectionPool() {
+            ODBC_LOG_TRACE("Entering ConnectionPool destructor");
+            for (size_t i = 0; i < m_stripeCount; i++) {
+                std::lock_guard<std::mutex> lock(m_stripes[i].mutex);
+                m_stripes[i].idle.clear();
+            }
+            if (m_hEnv != SQL_NULL_HENV) {
+                m_odbc->SQLFreeHandle(SQL_HANDLE_ENV, m_hEnv);
+            }
+            ODBC_LOG_TRACE("Exiting ConnectionPool destructor");
+        }
+
+        ConnectionPool::Stripe& ConnectionPool::homeStripe() const {
+            static std::atomic<size_t> nextSlot{0};
+            thread_local const size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+            return m_stripes[slot % m_stripeCount];
+        }
+
+        bool ConnectionPool::reserve() {
+            size_t current = m_size.load();
+            while (current < m_config.maxSize) {
+                if (m_size.compare_exchange_weak(current, current + 1)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::unique_ptr<OdbcWrapper> ConnectionPool::takeIdle(size_t& discarded) {
+            const size_t home = static_cast<size_t>(&homeStripe() - m_stripes.get());
+            for (size_t i = 0; i < m_stripeCount; i++) {
+                Stripe& stripe = m_stripes[(home + i) % m_stripeCount];
+                for (;;) {
+                    Idle item;
+                    {
+                        std::lock_guard<std::mutex> lock(stripe.mutex);
+                        if (stripe.idle.empty()) {
+                            break;
+                        }
+                        item = std::move(stripe.idle.back());
+                        stripe.idle.pop_back();
+                    }
+
+                    if (Clock::now() - item.since > m_config.idleTimeout) {
+                        // Same check-and-decrement as evictIdle, so concurrent callers cannot
+                        // both pass the minSize test and shrink the pool below it.
+                        size_t current = m_size.load();
+                        if (current > m_config.minSize && m_size.compare_exchange_strong(current, current - 1)) {
+                            item.connection.reset();
+                            discarded++;
+                            continue;
+                        }
+                    }
+                    if (m_config.validateOnCheckout && !item.connection->isAlive()) {
+                        discard(std::move(item.connection));
+                        discarded++;
+                        continue;
+                    }
+                    return std::move(item.connection);
+                }
+            }
+            return nullptr;
+        }
+
+        std::unique_ptr<OdbcWrapper> ConnectionPool::open() {
+            ODBC_LOG_TRACE("Entering ConnectionPool::open");
+            std::unique_ptr<OdbcWrapper> connection;
+            try {
+                connection = std::make_unique<OdbcWrapper>(m_factory ? m_factory() : nullptr);
+                connection->initialize(m_hEnv);
+                connection->setAsyncReactor(m_reactor);
+                if (!connection->connect(m_dsn, m_user, m_password)) {
+                    throw std::runtime_error("ODBC Error: Unable to open pooled connection");
+                }
+            } catch (...) {
+                connection.reset();
+                m_size--;
+                notifyWaiter();
+                throw;
+            }
+            ODBC_LOG_TRACE("Exiting ConnectionPool::open");
+            return connection;
+        }
+
+        void ConnectionPool::discard(std::unique_ptr<OdbcWrapper> connection) {
+            connection.reset();
+            m_size--;
+        }
+
+        void ConnectionPool::notifyWaiter() {
+            if (m_waiters.load() > 0) {
+                std::lock_guard<std::mutex> lock(m_waitMutex);
+                m_available.notify_one();
+            }
+        }
+
+        ConnectionPool::Lease ConnectionPool::acquire() {
+            ODBC_LOG_TRACE("Entering ConnectionPool::acquire");
+            size_t discarded = 0;
+            std::unique_ptr<OdbcWrapper> connection = takeIdle(discarded);
+            if (discarded > 0) {
+                notifyWaiter(); // Expired or dead connections freed slots
+            }
+
+            bool grow = !connection && reserve();
+            if (!connection && !grow) {
+                // Slow path: idle lists are rechecked under m_waitMutex, which release() takes
+                // before notifying, so a connection returned in between cannot be missed.
+                const Clock::time_point deadline = Clock::now() + m_config.acquireTimeout;
+                std::unique_lock<std::mutex> lock(m_waitMutex);
+                m_waiters++;
+                for (;;) {
+                    discarded = 0;
+                    connection = takeIdle(discarded);
+                    if (discarded > 0) {
+                        m_available.notify_all();
+                    }
+                    if (connection) {
+                        break;
+                    }
+                    if (reserve()) {
+                        grow = true;
+                        break;
+                    }
+                    if (Clock::now() >= deadline) {
+                        break;
+                    }
+                    m_available.wait_until(lock, deadline);
+                }
+                m_waiters--;
+            }
+
+            if (grow) {
+                connection = open();
+            }
+            if (!connection) {
+                OdbcLogger::logError("Timed out waiting for a pooled connection");
+                throw std::runtime_error("ODBC Error: Timed out waiting for a pooled connection");
+            }
+
+            ODBC_LOG_TRACE("Exiting ConnectionPool::acquire");
+            return Lease(this, std::move(connection));
+        }
+
+        void ConnectionPool::release(std::unique_ptr<OdbcWrapper> connection) {
+            if (connection->inTransaction()) {
+                // The next borrower must not inherit uncommitted work or manual-commit mode
+                try {
+                    connection->rollback();
+                } catch (const std::exception& e) {
+                    OdbcLogger::logError(std::string("Rollback of returned connection failed: ") + e.what());
+                    connection->disconnect();
+                }
+            }
+            if (!connection->isConnected()) {
+                discard(std::move(connection));
+            } else {
+                Stripe& stripe = homeStripe();
+                std::lock_guard<std::mutex> lock(stripe.mutex);
+                stripe.idle.push_back(Idle{std::move(connection), Clock::now()});
+            }
+            notifyWaiter();
+        }
+
+        size_t ConnectionPool::evictIdle() {
+            ODBC_LOG_TRACE("Entering ConnectionPool::evictIdle");
+            const Clock::time_point now = Clock::now();
+            std::vector<std::unique_ptr<OdbcWrapper>> expired;
+            for (size_t i = 0; i < m_stripeCount; i++) {
+                Stripe& stripe = m_stripes[i];
+                std::lock_guard<std::mutex> lock(stripe.mutex);
+                // Oldest connections sit at the front of each stripe.
+                auto it = stripe.idle.begin();
+                while (it != stripe.idle.end() && now - it->since > m_config.idleTimeout) {
+                    size_t current = m_size.load();
+                    if (current <= m_config.minSize || !m_size.compare_exchange_strong(current, current - 1)) {
+                        break;
+                    }
+                    expired.push_back(std::move(it->connection));
+                    ++it;
+                }
+                stripe.idle.erase(stripe.idle.begin(), it);
+            }
+
+            const size_t evicted = expired.size();
+            expired.clear(); // Disconnects outside of the stripe locks
+            if (evicted > 0) {
+                notifyWaiter();
+            }
+            ODBC_LOG_TRACE("Exiting ConnectionPool::evictIdle with " + std::to_string(evicted) + " closed");
+            return evicted;
+        }
+
+        size_t ConnectionPool::idleCount() const {
+            size_t count = 0;
+            for (size_t i = 0; i < m_stripeCount; i++) {
+                std::lock_guard<std::mutex> lock(m_stripes[i].mutex);
+                count += m_stripes[i].idle.size();
+            }
+            return count;
+        }
+    }
+}
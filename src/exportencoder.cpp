@@ -0,0 +1,231 @@
+#include <odbccpp/exportencoder.h>
+#include <odbccpp/textcodec.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            size_t roundUp(size_t bytes, size_t multiple) {
+                return (std::max<size_t>(bytes, 1) + multiple - 1) / multiple * multiple;
+            }
+
+            std::string toUtf8(const std::wstring& text) {
+                const SqlWString wide = toSqlWide(text);
+                return utf16ToUtf8(wide.data(), wide.size());
+            }
+        }
+
+        ExportEncoder::ExportEncoder(const std::string& path, ExportFormat format, size_t blockBytes)
+            : m_format(format), m_blockBytes(roundUp(blockBytes, ALIGNMENT)) {
+            m_file = std::fopen(path.c_str(), "wb");
+            if (!m_file) {
+                throw std::runtime_error("Export Error: Unable to open " + path);
+            }
+            // Whole blocks go straight to the operating system instead of through the stdio buffer
+            std::setvbuf(m_file, nullptr, _IONBF, 0);
+            m_capacity = m_blockBytes * 2;
+            m_buffer.reset(static_cast<char*>(::operator new[](m_capacity, std::align_val_t(ALIGNMENT))));
+        }
+
+        ExportEncoder::~ExportEncoder() {
+            if (m_file) {
+                std::fclose(m_file);
+            }
+        }
+
+        char* ExportEncoder::reserve(size_t bytes) {
+            if (m_used + bytes > m_capacity) {
+                writeBlocks();
+            }
+            if (m_used + bytes > m_capacity) {
+                // Only a cell larger than a block gets here
+                const size_t capacity = roundUp(std::max(m_used + bytes, m_capacity * 2), ALIGNMENT);
+                std::unique_ptr<char[], AlignedDelete> buffer(
+                    static_cast<char*>(::operator new[](capacity, std::align_val_t(ALIGNMENT))));
+                std::memcpy(buffer.get(), m_buffer.get(), m_used);
+                m_buffer = std::move(buffer);
+                m_capacity = capacity;
+            }
+            return m_buffer.get() + m_used;
+        }
+
+        void ExportEncoder::writeBlocks() {
+            const size_t whole = m_used / m_blockBytes * m_blockBytes;
+            if (whole == 0) {
+                return;
+            }
+            if (!m_failed) {
+                if (std::fwrite(m_buffer.get(), 1, whole, m_file) == whole) {
+                    m_stats.bytes += whole;
+                } else {
+                    m_failed = true;
+                }
+            }
+            std::memmove(m_buffer.get(), m_buffer.get() + whole, m_used - whole);
+            m_used -= whole;
+        }
+
+        void ExportEncoder::appendText(const std::string& text, bool isNull) {
+            if (m_format == ExportFormat::Csv) {
+                if (isNull) {
+                    return;
+                }
+                const bool quote = text.empty() || text.find_first_of(",\"\r\n") != std::string::npos;
+                char* target = reserve(text.size() * 2 + 2);
+                char* start = target;
+                if (quote) {
+                    *target++ = '"';
+                }
+                for (char c : text) {
+                    if (c == '"') {
+                        *target++ = '"';
+                    }
+                    *target++ = c;
+                }
+                if (quote) {
+                    *target++ = '"';
+                }
+                m_used += static_cast<size_t>(target - start);
+                return;
+            }
+
+            if (isNull) {
+                std::memcpy(reserve(2), "\\N", 2);
+                m_used += 2;
+                return;
+            }
+            char* target = reserve(text.size() * 2);
+            char* start = target;
+            for (char c : text) {
+                switch (c) {
+                    case '\\': *target++ = '\\'; *target++ = '\\'; break;
+                    case '\t': *target++ = '\\'; *target++ = 't'; break;
+                    case '\n': *target++ = '\\'; *target++ = 'n'; break;
+                    case '\r': *target++ = '\\'; *target++ = 'r'; break;
+                    default: *target++ = c; break;
+                }
+            }
+            m_used += static_cast<size_t>(target - start);
+        }
+
+        void ExportEncoder::writeHeader(const std::vector<std::wstring>& names, bool textHeader) {
+            if (m_format == ExportFormat::Binary) {
+                char* target = reserve(7);
+                std::memcpy(target, "ODBX\x01", 5);
+                target[5] = static_cast<char>(names.size() & 0xFF);
+                target[6] = static_cast<char>((names.size() >> 8) & 0xFF);
+                m_used += 7;
+                for (const std::wstring& name : names) {
+                    const std::string text = toUtf8(name);
+                    const size_t length = std::min<size_t>(text.size(), 0xFFFF);
+                    target = reserve(length + 2);
+                    target[0] = static_cast<char>(length & 0xFF);
+                    target[1] = static_cast<char>((length >> 8) & 0xFF);
+                    std::memcpy(target + 2, text.data(), length);
+                    m_used += length + 2;
+                }
+                return;
+            }
+            if (!textHeader) {
+                return;
+            }
+
+            const char separator = m_format == ExportFormat::Csv ? ',' : '\t';
+            for (size_t c = 0; c < names.size(); c++) {
+                if (c > 0) {
+                    *reserve(1) = separator;
+                    m_used++;
+                }
+                appendText(toUtf8(names[c]), false);
+            }
+            *reserve(1) = '\n';
+            m_used++;
+        }
+
+        void ExportEncoder::encode(const RowsetBuffer& rowset) {
+            const SQLULEN rows = rowset.rowsFetched();
+            const SQLSMALLINT columns = rowset.columnCount();
+            const char separator = m_format == ExportFormat::Csv ? ',' : '\t';
+            const size_t bitmapBytes = (static_cast<size_t>(columns) + 7) / 8;
+
+            for (SQLULEN r = 0; r < rows; r++) {
+                if (m_format == ExportFormat::Binary) {
+                    char* bitmap = reserve(bitmapBytes);
+                    std::memset(bitmap, 0, bitmapBytes);
+                    for (SQLSMALLINT c = 0; c < columns; c++) {
+                        if (rowset.isNull(r, c)) {
+                            bitmap[c / 8] = static_cast<char>(bitmap[c / 8] | (1 << (c % 8)));
+                        }
+                    }
+                    m_used += bitmapBytes;
+                }
+
+                for (SQLSMALLINT c = 0; c < columns; c++) {
+                    const bool isNull = rowset.isNull(r, c);
+                    if (!isNull) {
+                        const SQLWCHAR* text = reinterpret_cast<const SQLWCHAR*>(rowset.cell(r, c));
+                        const size_t length = static_cast<size_t>(rowset.cellLength(r, c)) / sizeof(SQLWCHAR);
+                        m_scratch.resize(length * 3);
+                        m_scratch.resize(utf16ToUtf8(text, length, &m_scratch[0]));
+                    }
+
+                    if (m_format == ExportFormat::Binary) {
+                        if (isNull) {
+                            continue;
+                        }
+                        char* target = reserve(m_scratch.size() + 10); // A 64-bit LEB128 length takes at most 10 bytes
+                        char* start = target;
+                        uint64_t length = m_scratch.size();
+                        do {
+                            const char byte = static_cast<char>(length & 0x7F);
+                            length >>= 7;
+                            *target++ = static_cast<char>(length ? (byte | 0x80) : byte);
+                        } while (length);
+                        std::memcpy(target, m_scratch.data(), m_scratch.size());
+                        m_used += static_cast<size_t>(target - start) + m_scratch.size();
+                        continue;
+                    }
+
+                    if (c > 0) {
+                        *reserve(1) = separator;
+                        m_used++;
+                    }
+                    // Not a conditional expression, whose std::string result would copy every cell
+                    if (isNull) {
+                        appendText({}, true);
+                    } else {
+                        appendText(m_scratch, false);
+                    }
+                }
+
+                if (m_format != ExportFormat::Binary) {
+                    *reserve(1) = '\n';
+                    m_used++;
+                }
+            }
+            m_stats.rows += rows;
+        }
+
+        bool ExportEncoder::finish() {
+            if (!m_file) {
+                return !m_failed;
+            }
+            if (!m_failed && m_used > 0) {
+                if (std::fwrite(m_buffer.get(), 1, m_used, m_file) == m_used) {
+                    m_stats.bytes += m_used;
+                } else {
+                    m_failed = true;
+                }
+            }
+            m_used = 0;
+            if (std::fclose(m_file) != 0) {
+                m_failed = true;
+            }
+            m_file = nullptr;
+            return !m_failed;
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#include <odbccpp/fileutil.h>
+
+#include <filesystem>
+#include <system_error>
+
+namespace ps {
+    namespace odbc {
+        bool replaceFile(const std::string& temporary, const std::string& path) {
+            // Unlike std::rename on Windows, std::filesystem::rename replaces an existing file
+            std::error_code error;
+            std::filesystem::rename(temporary, path, error);
+            if (error) {
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,8 @@
+#include <odbccpp/longdatareader.h>
+#include <odbccpp/odbcwrapper.h>
+
+namespace ps {
+    namespace odbc {
+        template class BasicLongDataReader<OdbcInterface>;
+    }
+}
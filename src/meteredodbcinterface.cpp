@@ -0,0 +1,303 @@
+#include <odbccpp/meteredodbcinterface.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            /// Decorator whose last failed call has not had its diagnostics read on this thread.
+            thread_local const MeteredOdbcInterface* t_pendingError = nullptr;
+
+            uint64_t elapsedNanos(std::chrono::steady_clock::time_point start) {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+
+            /**
+             * @brief Retrieves the bytes a driver wrote for a value from its length/indicator.
+             */
+            uint64_t valueBytes(SQLLEN indicator, SQLLEN bufferLength) {
+                if (indicator == SQL_NO_TOTAL) {
+                    return static_cast<uint64_t>(std::max<SQLLEN>(bufferLength, 0));
+                }
+                if (indicator < 0) {
+                    return 0; // SQL_NULL_DATA
+                }
+                return static_cast<uint64_t>(bufferLength > 0 ? std::min(indicator, bufferLength) : indicator);
+            }
+        }
+
+        MeteredOdbcInterface::MeteredOdbcInterface(std::unique_ptr<OdbcInterface> inner, std::shared_ptr<OdbcMetrics> metrics)
+            : m_inner(std::move(inner)), m_metrics(std::move(metrics)) {
+        }
+
+        SQLRETURN MeteredOdbcInterface::check(SQLRETURN ret) {
+            if (ret == SQL_ERROR || ret == SQL_INVALID_HANDLE) {
+                m_metrics->recordError();
+                t_pendingError = this;
+            }
+            return ret;
+        }
+
+        SQLRETURN MeteredOdbcInterface::finishExecute(SQLHSTMT hStmt, Clock::time_point start, SQLRETURN ret) {
+            if (ret == SQL_STILL_EXECUTING || m_executing.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (ret == SQL_STILL_EXECUTING) {
+                    StatementState& state = m_statements[hStmt];
+                    if (!state.executing) {
+                        state.executing = true;
+                        state.started = start;
+                        m_executing.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return ret;
+                }
+                auto it = m_statements.find(hStmt);
+                if (it != m_statements.end() && it->second.executing) {
+                    it->second.executing = false;
+                    start = it->second.started;
+                    m_executing.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+            m_metrics->recordExecute(elapsedNanos(start));
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::finishFetch(SQLHSTMT hStmt, Clock::time_point start, SQLRETURN ret) {
+            const uint64_t nanos = elapsedNanos(start);
+            if (ret == SQL_STILL_EXECUTING) {
+                return ret;
+            }
+
+            uint64_t rows = 0;
+            uint64_t bytes = 0;
+            if (SQL_SUCCEEDED(ret)) {
+                rows = 1;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_statements.find(hStmt);
+                if (it != m_statements.end()) {
+                    const StatementState& state = it->second;
+                    if (state.rowsFetched) {
+                        rows = *state.rowsFetched;
+                    }
+                    // Column-wise indicators are contiguous; row-wise ones are a row structure apart
+                    const size_t stride = state.rowBindType == SQL_BIND_BY_COLUMN ? sizeof(SQLLEN) : state.rowBindType;
+                    for (const Binding& binding : state.bindings) {
+                        if (!binding.indicators) {
+                            continue;
+                        }
+                        const unsigned char* indicators = reinterpret_cast<const unsigned char*>(binding.indicators);
+                        for (uint64_t row = 0; row < rows; row++) {
+                            bytes += valueBytes(*reinterpret_cast<const SQLLEN*>(indicators + row * stride), binding.bufferLength);
+                        }
+                    }
+                }
+            }
+            m_metrics->recordFetch(nanos, rows);
+            if (bytes > 0) {
+                m_metrics->recordBytes(bytes);
+            }
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLAllocHandle(SQLSMALLINT HandleType, SQLHANDLE InputHandle, SQLHANDLE* OutputHandle) {
+            return check(m_inner->SQLAllocHandle(HandleType, InputHandle, OutputHandle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLSetEnvAttr(SQLHENV EnvironmentHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                                      SQLINTEGER StringLength) {
+            return check(m_inner->SQLSetEnvAttr(EnvironmentHandle, Attribute, Value, StringLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLConnect(SQLHDBC ConnectionHandle, SQLWCHAR* ServerName, SQLSMALLINT NameLength1,
+                                                   SQLWCHAR* UserName, SQLSMALLINT NameLength2, SQLWCHAR* Authentication,
+                                                   SQLSMALLINT NameLength3) {
+            const Clock::time_point start = Clock::now();
+            SQLRETURN ret = m_inner->SQLConnect(ConnectionHandle, ServerName, NameLength1, UserName, NameLength2,
+                                                Authentication, NameLength3);
+            m_metrics->recordConnect(elapsedNanos(start));
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLConnectA(SQLHDBC ConnectionHandle, SQLCHAR* ServerName, SQLSMALLINT NameLength1,
+                                                    SQLCHAR* UserName, SQLSMALLINT NameLength2, SQLCHAR* Authentication,
+                                                    SQLSMALLINT NameLength3) {
+            const Clock::time_point start = Clock::now();
+            SQLRETURN ret = m_inner->SQLConnectA(ConnectionHandle, ServerName, NameLength1, UserName, NameLength2,
+                                                 Authentication, NameLength3);
+            m_metrics->recordConnect(elapsedNanos(start));
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLDisconnect(SQLHDBC ConnectionHandle) {
+            return check(m_inner->SQLDisconnect(ConnectionHandle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) {
+            if (HandleType == SQL_HANDLE_STMT) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_statements.find(Handle);
+                if (it != m_statements.end()) {
+                    if (it->second.executing) {
+                        m_executing.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                    m_statements.erase(it);
+                }
+            }
+            return check(m_inner->SQLFreeHandle(HandleType, Handle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLExecDirect(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) {
+            const Clock::time_point start = Clock::now();
+            return finishExecute(StatementHandle, start, m_inner->SQLExecDirect(StatementHandle, StatementText, TextLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLExecDirectA(SQLHSTMT StatementHandle, SQLCHAR* StatementText, SQLINTEGER TextLength) {
+            const Clock::time_point start = Clock::now();
+            return finishExecute(StatementHandle, start, m_inner->SQLExecDirectA(StatementHandle, StatementText, TextLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLNumResultCols(SQLHSTMT StatementHandle, SQLSMALLINT* ColumnCount) {
+            return check(m_inner->SQLNumResultCols(StatementHandle, ColumnCount));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLFetch(SQLHSTMT StatementHandle) {
+            const Clock::time_point start = Clock::now();
+            return finishFetch(StatementHandle, start, m_inner->SQLFetch(StatementHandle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLGetData(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType,
+                                                   SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) {
+            SQLRETURN ret = m_inner->SQLGetData(StatementHandle, ColumnNumber, TargetType, TargetValue, BufferLength, StrLen_or_Ind);
+            if (SQL_SUCCEEDED(ret) && StrLen_or_Ind) {
+                m_metrics->recordBytes(valueBytes(*StrLen_or_Ind, BufferLength));
+            }
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                                       SQLINTEGER StringLength) {
+            SQLRETURN ret = m_inner->SQLSetStmtAttr(StatementHandle, Attribute, Value, StringLength);
+            if (SQL_SUCCEEDED(ret) && (Attribute == SQL_ATTR_ROWS_FETCHED_PTR || Attribute == SQL_ATTR_ROW_BIND_TYPE)) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                StatementState& state = m_statements[StatementHandle];
+                if (Attribute == SQL_ATTR_ROWS_FETCHED_PTR) {
+                    state.rowsFetched = static_cast<SQLULEN*>(Value);
+                } else {
+                    state.rowBindType = reinterpret_cast<SQLULEN>(Value);
+                }
+            }
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType,
+                                                   SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) {
+            SQLRETURN ret = m_inner->SQLBindCol(StatementHandle, ColumnNumber, TargetType, TargetValue, BufferLength, StrLen_or_Ind);
+            if (SQL_SUCCEEDED(ret) && ColumnNumber > 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::vector<Binding>& bindings = m_statements[StatementHandle].bindings;
+                if (bindings.size() < ColumnNumber) {
+                    bindings.resize(ColumnNumber);
+                }
+                bindings[ColumnNumber - 1] = TargetValue ? Binding{StrLen_or_Ind, BufferLength} : Binding{};
+            }
+            return check(ret);
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLFetchScroll(SQLHSTMT StatementHandle, SQLSMALLINT FetchOrientation, SQLLEN FetchOffset) {
+            const Clock::time_point start = Clock::now();
+            return finishFetch(StatementHandle, start, m_inner->SQLFetchScroll(StatementHandle, FetchOrientation, FetchOffset));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLPrepare(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) {
+            return check(m_inner->SQLPrepare(StatementHandle, StatementText, TextLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLBindParameter(SQLHSTMT StatementHandle, SQLUSMALLINT ParameterNumber,
+                                                         SQLSMALLINT InputOutputType, SQLSMALLINT ValueType,
+                                                         SQLSMALLINT ParameterType, SQLULEN ColumnSize, SQLSMALLINT DecimalDigits,
+                                                         SQLPOINTER ParameterValuePtr, SQLLEN BufferLength,
+                                                         SQLLEN* StrLen_or_IndPtr) {
+            return check(m_inner->SQLBindParameter(StatementHandle, ParameterNumber, InputOutputType, ValueType, ParameterType,
+                                                   ColumnSize, DecimalDigits, ParameterValuePtr, BufferLength, StrLen_or_IndPtr));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLExecute(SQLHSTMT StatementHandle) {
+            const Clock::time_point start = Clock::now();
+            return finishExecute(StatementHandle, start, m_inner->SQLExecute(StatementHandle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
+            if (Option == SQL_UNBIND) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_statements.find(StatementHandle);
+                if (it != m_statements.end()) {
+                    it->second.bindings.clear();
+                }
+            }
+            return check(m_inner->SQLFreeStmt(StatementHandle, Option));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLCancel(SQLHSTMT StatementHandle) {
+            return check(m_inner->SQLCancel(StatementHandle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLMoreResults(SQLHSTMT StatementHandle) {
+            return check(m_inner->SQLMoreResults(StatementHandle));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLGetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                                          SQLINTEGER BufferLength, SQLINTEGER* StringLength) {
+            return check(m_inner->SQLGetConnectAttr(ConnectionHandle, Attribute, Value, BufferLength, StringLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                                                          SQLINTEGER StringLength) {
+            return check(m_inner->SQLSetConnectAttr(ConnectionHandle, Attribute, Value, StringLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT CompletionType) {
+            return check(m_inner->SQLEndTran(HandleType, Handle, CompletionType));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLDescribeCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLWCHAR* ColumnName,
+                                                       SQLSMALLINT BufferLength, SQLSMALLINT* NameLength, SQLSMALLINT* DataType,
+                                                       SQLULEN* ColumnSize, SQLSMALLINT* DecimalDigits, SQLSMALLINT* Nullable) {
+            return check(m_inner->SQLDescribeCol(StatementHandle, ColumnNumber, ColumnName, BufferLength, NameLength, DataType,
+                                                 ColumnSize, DecimalDigits, Nullable));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLRowCount(SQLHSTMT StatementHandle, SQLLEN* RowCount) {
+            return check(m_inner->SQLRowCount(StatementHandle, RowCount));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLSetPos(SQLHSTMT StatementHandle, SQLSETPOSIROW RowNumber, SQLUSMALLINT Operation,
+                                                  SQLUSMALLINT LockType) {
+            return check(m_inner->SQLSetPos(StatementHandle, RowNumber, Operation, LockType));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLGetInfo(SQLHDBC ConnectionHandle, SQLUSMALLINT InfoType, SQLPOINTER InfoValue,
+                                                   SQLSMALLINT BufferLength, SQLSMALLINT* StringLength) {
+            return check(m_inner->SQLGetInfo(ConnectionHandle, InfoType, InfoValue, BufferLength, StringLength));
+        }
+
+        SQLRETURN MeteredOdbcInterface::SQLGetDiagRec(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT RecNumber,
+                                                      SQLWCHAR* SQLState, SQLINTEGER* NativeError, SQLWCHAR* MessageText,
+                                                      SQLSMALLINT BufferLength, SQLSMALLINT* TextLength) {
+            SQLRETURN ret = m_inner->SQLGetDiagRec(HandleType, Handle, RecNumber, SQLState, NativeError, MessageText,
+                                                   BufferLength, TextLength);
+            if (RecNumber == 1 && t_pendingError == this) {
+                t_pendingError = nullptr;
+                if (SQL_SUCCEEDED(ret) && SQLState) {
+                    std::string state;
+                    for (size_t i = 0; i < 5 && SQLState[i] != 0; i++) {
+                        state.push_back(static_cast<char>(SQLState[i])); // SQLSTATEs are ASCII
+                    }
+                    m_metrics->recordErrorState(state);
+                }
+            }
+            return ret; // Diagnostic calls are not counted as errors themselves
+        }
+    }
+}
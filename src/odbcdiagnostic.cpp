@@ -0,0 +1,28 @@
+#include <odbccpp/odbcdiagnostic.h>
+#include <odbccpp/textcodec.h>
+
+namespace ps {
+    namespace odbc {
+        std::string OdbcDiagnostic::Record::state() const {
+            return utf16ToUtf8(sqlState, sqlWideLength(sqlState, 5));
+        }
+
+        std::string OdbcDiagnostic::Record::text() const {
+            return utf16ToUtf8(message, sqlWideLength(message, SQL_MAX_MESSAGE_LENGTH));
+        }
+
+        OdbcException OdbcDiagnostic::toException() const {
+            if (m_count == 0) {
+                return OdbcException("ODBC Error: Unable to retrieve diagnostic information", {});
+            }
+
+            std::vector<Diagnostic> diagnostics;
+            diagnostics.reserve(m_count);
+            for (size_t i = 0; i < m_count; i++) {
+                diagnostics.push_back(Diagnostic{m_records[i].state(), m_records[i].nativeError, m_records[i].text()});
+            }
+            const std::string what = "ODBC Error: " + diagnostics.front().message;
+            return OdbcException(what, std::move(diagnostics));
+        }
+    }
+}
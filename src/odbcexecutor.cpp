@@ -18,6 +18,11 @@ namespace ps {
             return ::SQLConnectW(ConnectionHandle, ServerName, NameLength1, UserName, NameLength2, Authentication, NameLength3);
         }
 
+        SQLRETURN OdbcExecutor::SQLConnectA(SQLHDBC ConnectionHandle, SQLCHAR* ServerName, SQLSMALLINT NameLength1,
+                            SQLCHAR* UserName, SQLSMALLINT NameLength2, SQLCHAR* Authentication, SQLSMALLINT NameLength3) {
+            return ::SQLConnectA(ConnectionHandle, ServerName, NameLength1, UserName, NameLength2, Authentication, NameLength3);
+        }
+
         SQLRETURN OdbcExecutor::SQLDisconnect(SQLHDBC ConnectionHandle) {
             return ::SQLDisconnect(ConnectionHandle);
         }
@@ -30,6 +35,10 @@ namespace ps {
             return ::SQLExecDirectW(StatementHandle, StatementText, TextLength);
         }
 
+        SQLRETURN OdbcExecutor::SQLExecDirectA(SQLHSTMT StatementHandle, SQLCHAR* StatementText, SQLINTEGER TextLength) {
+            return ::SQLExecDirectA(StatementHandle, StatementText, TextLength);
+        }
+
         SQLRETURN OdbcExecutor::SQLNumResultCols(SQLHSTMT StatementHandle, SQLSMALLINT* ColumnCount) {
             return ::SQLNumResultCols(StatementHandle, ColumnCount);
         }
@@ -43,10 +52,82 @@ namespace ps {
             return ::SQLGetData(StatementHandle, ColumnNumber, TargetType, TargetValue, BufferLength, StrLen_or_Ind);
         }
 
+        SQLRETURN OdbcExecutor::SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength) {
+            return ::SQLSetStmtAttr(StatementHandle, Attribute, Value, StringLength);
+        }
+
+        SQLRETURN OdbcExecutor::SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType,
+                            SQLPOINTER TargetValue, SQLLEN BufferLength, SQLLEN* StrLen_or_Ind) {
+            return ::SQLBindCol(StatementHandle, ColumnNumber, TargetType, TargetValue, BufferLength, StrLen_or_Ind);
+        }
+
+        SQLRETURN OdbcExecutor::SQLFetchScroll(SQLHSTMT StatementHandle, SQLSMALLINT FetchOrientation, SQLLEN FetchOffset) {
+            return ::SQLFetchScroll(StatementHandle, FetchOrientation, FetchOffset);
+        }
+
+        SQLRETURN OdbcExecutor::SQLPrepare(SQLHSTMT StatementHandle, SQLWCHAR* StatementText, SQLINTEGER TextLength) {
+            return ::SQLPrepareW(StatementHandle, StatementText, TextLength);
+        }
+
+        SQLRETURN OdbcExecutor::SQLBindParameter(SQLHSTMT StatementHandle, SQLUSMALLINT ParameterNumber, SQLSMALLINT InputOutputType,
+                            SQLSMALLINT ValueType, SQLSMALLINT ParameterType, SQLULEN ColumnSize,
+                            SQLSMALLINT DecimalDigits, SQLPOINTER ParameterValuePtr, SQLLEN BufferLength,
+                            SQLLEN* StrLen_or_IndPtr) {
+            return ::SQLBindParameter(StatementHandle, ParameterNumber, InputOutputType, ValueType, ParameterType,
+                                      ColumnSize, DecimalDigits, ParameterValuePtr, BufferLength, StrLen_or_IndPtr);
+        }
+
+        SQLRETURN OdbcExecutor::SQLExecute(SQLHSTMT StatementHandle) {
+            return ::SQLExecute(StatementHandle);
+        }
+
+        SQLRETURN OdbcExecutor::SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
+            return ::SQLFreeStmt(StatementHandle, Option);
+        }
+
+        SQLRETURN OdbcExecutor::SQLCancel(SQLHSTMT StatementHandle) {
+            return ::SQLCancel(StatementHandle);
+        }
+
+        SQLRETURN OdbcExecutor::SQLMoreResults(SQLHSTMT StatementHandle) {
+            return ::SQLMoreResults(StatementHandle);
+        }
+
+        SQLRETURN OdbcExecutor::SQLGetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                            SQLINTEGER BufferLength, SQLINTEGER* StringLength) {
+            return ::SQLGetConnectAttr(ConnectionHandle, Attribute, Value, BufferLength, StringLength);
+        }
+
+        SQLRETURN OdbcExecutor::SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value,
+                            SQLINTEGER StringLength) {
+            return ::SQLSetConnectAttr(ConnectionHandle, Attribute, Value, StringLength);
+        }
+
+        SQLRETURN OdbcExecutor::SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT CompletionType) {
+            return ::SQLEndTran(HandleType, Handle, CompletionType);
+        }
+
+        SQLRETURN OdbcExecutor::SQLDescribeCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLWCHAR* ColumnName,
+                            SQLSMALLINT BufferLength, SQLSMALLINT* NameLength, SQLSMALLINT* DataType,
+                            SQLULEN* ColumnSize, SQLSMALLINT* DecimalDigits, SQLSMALLINT* Nullable) {
+            return ::SQLDescribeColW(StatementHandle, ColumnNumber, ColumnName, BufferLength, NameLength, DataType,
+                                     ColumnSize, DecimalDigits, Nullable);
+        }
+
         SQLRETURN OdbcExecutor::SQLRowCount(SQLHSTMT StatementHandle, SQLLEN* RowCount) {
             return ::SQLRowCount(StatementHandle, RowCount);
         }
 
+        SQLRETURN OdbcExecutor::SQLSetPos(SQLHSTMT StatementHandle, SQLSETPOSIROW RowNumber, SQLUSMALLINT Operation,
+                            SQLUSMALLINT LockType) {
+            return ::SQLSetPos(StatementHandle, RowNumber, Operation, LockType);
+        }
+
+        SQLRETURN OdbcExecutor::SQLGetInfo(SQLHDBC ConnectionHandle, SQLUSMALLINT InfoType, SQLPOINTER InfoValue,
+                            SQLSMALLINT BufferLength, SQLSMALLINT* StringLength) {
+            return ::SQLGetInfoW(ConnectionHandle, InfoType, InfoValue, BufferLength, StringLength);
+        }
+
         SQLRETURN OdbcExecutor::SQLGetDiagRec(SQLSMALLINT HandleType, SQLHANDLE Handle, SQLSMALLINT RecNumber,
                             SQLWCHAR* SQLState, SQLINTEGER* NativeError, SQLWCHAR* MessageText,
                             SQLSMALLINT BufferLength, SQLSMALLINT* TextLength) {
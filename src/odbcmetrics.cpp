@@ -0,0 +1,168 @@
+#include <odbccpp/odbcmetrics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            /**
+             * @brief Packs up to five SQLSTATE characters into a non-zero key.
+             */
+            uint64_t packState(std::string_view sqlState) {
+                uint64_t key = 1; // Keeps empty states distinct from a free slot
+                for (size_t i = 0; i < 5; i++) {
+                    key = (key << 8) | (i < sqlState.size() ? static_cast<unsigned char>(sqlState[i]) : 0);
+                }
+                return key;
+            }
+
+            std::string unpackState(uint64_t key) {
+                std::string state;
+                for (int shift = 32; shift >= 0; shift -= 8) {
+                    const char c = static_cast<char>((key >> shift) & 0xFF);
+                    if (c != 0) {
+                        state.push_back(c);
+                    }
+                }
+                return state;
+            }
+
+            int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+                return 63 - __builtin_clzll(value);
+#else
+                int bit = 0;
+                while (value >>= 1) {
+                    bit++;
+                }
+                return bit;
+#endif
+            }
+        }
+
+        uint64_t HistogramSnapshot::quantile(double q) const {
+            if (count == 0) {
+                return 0;
+            }
+            const double clamped = std::clamp(q, 0.0, 1.0);
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < buckets.size(); i++) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    return std::min(LatencyHistogram::bucketUpperBound(i), max);
+                }
+            }
+            return max;
+        }
+
+        uint64_t HistogramSnapshot::countAtOrBelow(uint64_t nanos) const {
+            const size_t last = std::min(LatencyHistogram::bucketIndex(nanos), buckets.size() - 1);
+            uint64_t total = 0;
+            for (size_t i = 0; i <= last && i < buckets.size(); i++) {
+                total += buckets[i];
+            }
+            return total;
+        }
+
+        size_t LatencyHistogram::bucketIndex(uint64_t nanos) {
+            const uint64_t value = std::min(nanos, MAX_VALUE);
+            if (value < SUB_BUCKETS) {
+                return static_cast<size_t>(value);
+            }
+            // The top SUB_BUCKET_BITS + 1 bits select the bucket within the value's power of two
+            const int shift = highestBit(value) - SUB_BUCKET_BITS;
+            return static_cast<size_t>(SUB_BUCKETS * (shift + 1) + ((value >> shift) - SUB_BUCKETS));
+        }
+
+        uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+            if (index < SUB_BUCKETS) {
+                return index;
+            }
+            const uint64_t shift = index / SUB_BUCKETS - 1;
+            const uint64_t top = SUB_BUCKETS + index % SUB_BUCKETS;
+            return ((top + 1) << shift) - 1;
+        }
+
+        void LatencyHistogram::record(uint64_t nanos) {
+            m_buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+            m_sum.fetch_add(nanos, std::memory_order_relaxed);
+            uint64_t max = m_max.load(std::memory_order_relaxed);
+            while (nanos > max && !m_max.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {
+            }
+        }
+
+        HistogramSnapshot LatencyHistogram::snapshot() const {
+            HistogramSnapshot snapshot;
+            snapshot.buckets.resize(BUCKET_COUNT);
+            for (size_t i = 0; i < BUCKET_COUNT; i++) { // The count is derived, so it always matches the buckets
+                snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+                snapshot.count += snapshot.buckets[i];
+            }
+            snapshot.sum = m_sum.load(std::memory_order_relaxed);
+            snapshot.max = m_max.load(std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        void SqlStateCounters::increment(std::string_view sqlState) {
+            const uint64_t key = packState(sqlState);
+            size_t slot = static_cast<size_t>(key * 0x9E3779B97F4A7C15ull >> 58) % CAPACITY;
+            for (size_t probe = 0; probe < CAPACITY; probe++, slot = (slot + 1) % CAPACITY) {
+                uint64_t current = m_keys[slot].load(std::memory_order_acquire);
+                if (current == 0 && m_keys[slot].compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    current = key;
+                }
+                if (current == key) {
+                    m_counts[slot].fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            m_other.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::map<std::string, uint64_t> SqlStateCounters::snapshot() const {
+            std::map<std::string, uint64_t> counts;
+            for (size_t slot = 0; slot < CAPACITY; slot++) {
+                const uint64_t key = m_keys[slot].load(std::memory_order_acquire);
+                const uint64_t count = m_counts[slot].load(std::memory_order_relaxed);
+                if (key != 0 && count > 0) {
+                    counts[unpackState(key)] += count;
+                }
+            }
+            const uint64_t other = m_other.load(std::memory_order_relaxed);
+            if (other > 0) {
+                counts["other"] += other;
+            }
+            return counts;
+        }
+
+        void OdbcMetrics::recordFetch(uint64_t nanos, uint64_t rows) {
+            m_fetch.record(nanos);
+            if (rows > 0) {
+                m_rows.fetch_add(rows, std::memory_order_relaxed);
+                m_fetchPerRow.record(nanos / rows);
+            }
+        }
+
+        void OdbcMetrics::recordRetry(std::string_view sqlState) {
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+            m_retryStates.increment(sqlState);
+        }
+
+        MetricsSnapshot OdbcMetrics::snapshot() const {
+            MetricsSnapshot snapshot;
+            snapshot.connect = m_connect.snapshot();
+            snapshot.execute = m_execute.snapshot();
+            snapshot.fetch = m_fetch.snapshot();
+            snapshot.fetchPerRow = m_fetchPerRow.snapshot();
+            snapshot.rows = m_rows.load(std::memory_order_relaxed);
+            snapshot.bytes = m_bytes.load(std::memory_order_relaxed);
+            snapshot.errors = m_errors.load(std::memory_order_relaxed);
+            snapshot.errorsBySqlState = m_errorStates.snapshot();
+            snapshot.retries = m_retries.load(std::memory_order_relaxed);
+            snapshot.retriesBySqlState = m_retryStates.snapshot();
+            return snapshot;
+        }
+    }
+}
@@ -1,211 +1,603 @@
+#include <odbccpp/fileutil.h>
 #include <odbccpp/odbcexecutor.h>
 #include <odbccpp/odbcwrapper.h>
+#include <odbccpp/spscqueue.h>
 #include <odbclogger.h>
 
-#include <stdexcept>
-#include <codecvt> 
-#include <locale>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <type_traits>
+#include <variant>
 
 namespace ps {
     namespace odbc {
-        OdbcWrapper::OdbcWrapper(std::unique_ptr<OdbcInterface> odbcImpl) 
-            : m_odbc(odbcImpl ? std::move(odbcImpl) : std::make_unique<OdbcExecutor>()) {
-            OdbcLogger::logInfo("Entering OdbcWrapper constructor");
-            OdbcLogger::logInfo("Exiting OdbcWrapper constructor");
+        template class BasicOdbcWrapper<OdbcInterface>;
+
+        OdbcWrapper::OdbcWrapper(std::unique_ptr<OdbcInterface> odbcImpl)
+            : BasicOdbcWrapper(odbcImpl ? std::move(odbcImpl) : std::make_unique<OdbcExecutor>()) {
         }
 
         OdbcWrapper::~OdbcWrapper() {
-            OdbcLogger::logInfo("Entering OdbcWrapper destructor");
             disconnect();
-            if (m_odbc.get() != nullptr) {
-                if (m_hStmt != SQL_NULL_HSTMT) {
-                    m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, m_hStmt);
-                }
-                if (m_hDbc != SQL_NULL_HDBC) {
-                    m_odbc->SQLFreeHandle(SQL_HANDLE_DBC, m_hDbc);
+        }
+
+        void OdbcWrapper::disconnect() {
+            if (m_connected) {
+                if (m_reactor) {
+                    m_reactor->waitFor(m_hStmt);
                 }
-                if (m_hEnv != SQL_NULL_HENV) {
-                    m_odbc->SQLFreeHandle(SQL_HANDLE_ENV, m_hEnv);
+                m_statementCache.clear();
+                for (SQLHSTMT hStmt : m_freeStatements) {
+                    m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
                 }
-                
-                m_odbc.reset();
+                m_freeStatements.clear();
+                m_getDataExtensions.reset();
+                m_generation++;
             }
-            OdbcLogger::logInfo("Exiting OdbcWrapper destructor");
+            BasicOdbcWrapper::disconnect();
         }
 
-        void OdbcWrapper::handleError(SQLHANDLE handle, SQLSMALLINT handleType, SQLRETURN retCode) {
-            OdbcLogger::logInfo("Entering handleError");
-            SQLWCHAR sqlState[6], msg[SQL_MAX_MESSAGE_LENGTH];
-            SQLINTEGER nativeError;
-            SQLSMALLINT msgLen;
-            bool errorLogged = false;
+        bool OdbcWrapper::connect(const std::wstring& dsn, const std::wstring& user, const std::wstring& password) {
+            m_reconnect = [this, dsn, user, password]() { return BasicOdbcWrapper::connect(dsn, user, password); };
+            return BasicOdbcWrapper::connect(dsn, user, password);
+        }
 
-            while (m_odbc->SQLGetDiagRec(handleType, handle, 1, sqlState, &nativeError,
-                                msg, sizeof(msg) / sizeof(SQLWCHAR), &msgLen) == SQL_SUCCESS) {
-                errorLogged = true;
-                // Convert SQLWCHAR* to std::wstring for logging
-                std::wstring sqlStateStr(reinterpret_cast<wchar_t*>(sqlState));
-                std::wstring msgStr(reinterpret_cast<wchar_t*>(msg));
+        bool OdbcWrapper::connect(std::string_view dsn, std::string_view user, std::string_view password) {
+            m_reconnect = [this, dsn = std::string(dsn), user = std::string(user), password = std::string(password)]() {
+                return BasicOdbcWrapper::connect(std::string_view(dsn), std::string_view(user), std::string_view(password));
+            };
+            return BasicOdbcWrapper::connect(dsn, user, password);
+        }
 
-                // Convert std::wstring to std::string for spdlog (with error handling)
-                std::string sqlStateNarrow;
-                std::string msgNarrow;
-                try {
-                    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-                    sqlStateNarrow = converter.to_bytes(sqlStateStr);
-                    msgNarrow = converter.to_bytes(msgStr);
-                } catch (const std::exception&) {
-                    // Fallback to simple conversion if UTF-8 conversion fails
-                    sqlStateNarrow = std::string(sqlStateStr.begin(), sqlStateStr.end());
-                    msgNarrow = std::string(msgStr.begin(), msgStr.end());
+        bool OdbcWrapper::executeQuery(const std::wstring& query) {
+            return runWithRetry(true, true, [&]() { return BasicOdbcWrapper::executeQuery(query); });
+        }
+
+        bool OdbcWrapper::executeQuery(std::string_view query) {
+            return runWithRetry(true, true, [&]() { return BasicOdbcWrapper::executeQuery(query); });
+        }
+
+        bool OdbcWrapper::executeUpdate(const std::wstring& query, bool idempotent) {
+            return runWithRetry(idempotent, true, [&]() { return BasicOdbcWrapper::executeUpdate(query); });
+        }
+
+        bool OdbcWrapper::executeUpdate(std::string_view query, bool idempotent) {
+            return runWithRetry(idempotent, true, [&]() { return BasicOdbcWrapper::executeUpdate(query); });
+        }
+
+        bool OdbcWrapper::executeUpdateAndInvalidate(const std::wstring& query, const std::vector<std::string>& tags,
+                                                     bool idempotent) {
+            const bool updated = executeUpdate(query, idempotent);
+            if (updated && m_queryCache) {
+                for (const std::string& tag : tags) {
+                    m_queryCache->invalidate(tag);
                 }
+            }
+            return updated;
+        }
 
-                OdbcLogger::logError(fmt::format("SQLSTATE: {}, Message: {}, Native Error: {}",
-                                                sqlStateNarrow, msgNarrow, nativeError));
+        std::shared_ptr<const ResultSet> OdbcWrapper::executeCachedQuery(const std::wstring& sql,
+                                                                         const std::vector<QueryParameter>& params,
+                                                                         const std::vector<std::string>& tags,
+                                                                         std::chrono::milliseconds ttl) {
+            ODBC_LOG_TRACE("Entering executeCachedQuery");
+            std::wstring key;
+            std::uint64_t generation = QueryCache::ANY_GENERATION;
+            if (m_queryCache) {
+                key = QueryCache::makeKey(sql, params);
+                generation = m_queryCache->generation(); // Before the query runs, so a concurrent invalidation is noticed
+                if (std::shared_ptr<const ResultSet> cached = m_queryCache->find(key)) {
+                    ODBC_LOG_TRACE("Exiting executeCachedQuery with cached results");
+                    return cached;
+                }
+            }
+            if (!m_connected) {
+                spdlog::warn("Exiting executeCachedQuery with empty results (not connected)");
+                return std::make_shared<const ResultSet>();
+            }
 
-                if (retCode == SQL_ERROR) {
-                    throw std::runtime_error("ODBC Error: " + msgNarrow);
+            ResultSet result;
+            if (params.empty()) {
+                if (!executeQuery(sql)) {
+                    return std::make_shared<const ResultSet>();
+                }
+                result = fetchRows(m_hStmt, RowsetBuffer::DEFAULT_ROWSET_SIZE);
+            } else {
+                std::shared_ptr<PreparedStatement> statement = prepare(sql);
+                if (!statement) {
+                    return std::make_shared<const ResultSet>();
+                }
+                for (size_t i = 0; i < params.size(); i++) {
+                    const SQLUSMALLINT index = static_cast<SQLUSMALLINT>(i + 1);
+                    std::visit([&statement, index](const auto& value) {
+                        using T = std::decay_t<decltype(value)>;
+                        if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                            statement->setNull(index);
+                        } else if constexpr (std::is_same_v<T, std::int64_t>) {
+                            statement->setInt(index, value);
+                        } else if constexpr (std::is_same_v<T, double>) {
+                            statement->setDouble(index, value);
+                        } else {
+                            statement->setString(index, value);
+                        }
+                    }, params[i]);
                 }
+                // A query is safe to repeat; the shared statement keeps its own setting for other callers
+                if (!statement->execute(true)) {
+                    return std::make_shared<const ResultSet>();
+                }
+                result = fetchRows(statement->getHStmt(), RowsetBuffer::DEFAULT_ROWSET_SIZE);
             }
 
-            // If SQL_ERROR but couldn't get diagnostic info, still throw
-            if (retCode == SQL_ERROR && !errorLogged) {
-                OdbcLogger::logError("ODBC Error occurred but diagnostic information unavailable");
-                throw std::runtime_error("ODBC Error: Unable to retrieve diagnostic information");
+            ODBC_LOG_TRACE("Exiting executeCachedQuery with results");
+            if (!m_queryCache) {
+                return std::make_shared<const ResultSet>(std::move(result));
             }
+            return m_queryCache->insert(key, std::move(result), tags, ttl, generation);
+        }
 
-            OdbcLogger::logInfo("Exiting handleError");
+        bool OdbcWrapper::prepareRetry(const OdbcException& error, bool idempotent, bool canReconnect, int attempt,
+                                       bool& reconnect) {
+            if (!idempotent || m_inTransaction || attempt >= m_retryPolicy.maxAttempts) {
+                return false;
+            }
+            const ErrorClass errorClass = m_retryPolicy.classify(error.sqlState());
+            if (errorClass == ErrorClass::Permanent) {
+                return false;
+            }
+            if (errorClass == ErrorClass::ConnectionLost && (!canReconnect || !m_reconnect)) {
+                return false;
+            }
+
+            const std::chrono::milliseconds delay = m_retryPolicy.backoff(attempt);
+            spdlog::warn("Retrying after SQLSTATE {} in {} ms (attempt {} of {})", error.sqlState(), delay.count(),
+                         attempt + 1, m_retryPolicy.maxAttempts);
+            if (m_retryPolicy.onRetry) {
+                m_retryPolicy.onRetry(error.sqlState(), attempt);
+            }
+            std::this_thread::sleep_for(delay);
+            reconnect = errorClass == ErrorClass::ConnectionLost;
+            return true;
         }
 
-        void OdbcWrapper::initialize() {
-            OdbcLogger::logInfo("Entering initialize");
-            SQLRETURN ret = m_odbc->SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &m_hEnv);
-            if (SQL_SUCCEEDED(ret)) {
-                ret = m_odbc->SQLSetEnvAttr(m_hEnv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
-                if (SQL_SUCCEEDED(ret)) {
-                    ret = m_odbc->SQLAllocHandle(SQL_HANDLE_DBC, m_hEnv, &m_hDbc);
-                    if (!SQL_SUCCEEDED(ret)) {
-                        handleError(m_hEnv, SQL_HANDLE_ENV, ret);
+        void OdbcWrapper::reconnect() {
+            ODBC_LOG_DEBUG("Reconnecting after a lost connection");
+            disconnect();
+            if (!m_reconnect()) {
+                throw OdbcException("ODBC Error: Unable to reconnect", {});
+            }
+        }
+
+        std::future<bool> OdbcWrapper::executeQueryAsync(const std::wstring& query) {
+            ODBC_LOG_TRACE("Entering executeQueryAsync");
+            if (!m_connected) {
+                spdlog::warn("Exiting executeQueryAsync with failure (not connected)");
+                std::promise<bool> failed;
+                failed.set_value(false);
+                return failed.get_future();
+            }
+
+            ODBC_LOG_TRACE("Exiting executeQueryAsync");
+            return executeAsync(m_hStmt, query, false);
+        }
+
+        std::future<bool> OdbcWrapper::executeAsync(SQLHSTMT hStmt, const std::wstring& sql, bool noDataSucceeds) {
+            auto promise = std::make_shared<std::promise<bool>>();
+            std::future<bool> future = promise->get_future();
+
+            // The call is repeated with the same arguments until it completes, so the text must stay put
+            auto text = std::make_shared<SqlWString>(toSqlWide(sql));
+            OdbcInterface* odbc = m_odbc.get();
+            runAsync(hStmt, [odbc, hStmt, text]() { return odbc->SQLExecDirect(hStmt, text->data(), SQL_NTS); },
+                     [promise, noDataSucceeds](SQLRETURN ret, std::exception_ptr error) {
+                         if (error) {
+                             promise->set_exception(error);
+                         } else {
+                             promise->set_value(SQL_SUCCEEDED(ret) || (noDataSucceeds && ret == SQL_NO_DATA));
+                         }
+                     });
+            return future;
+        }
+
+        void OdbcWrapper::runAsync(SQLHSTMT hStmt, AsyncReactor::Poll call, AsyncCompletion done) {
+            const bool async = SQL_SUCCEEDED(m_odbc->SQLSetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE,
+                                                                    (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0));
+            auto complete = [this, hStmt, async, done = std::move(done)](SQLRETURN ret) {
+                // Any call on the handle clears its diagnostics, so they are read before async mode is switched off
+                std::exception_ptr error;
+                if (!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA) {
+                    try {
+                        handleError(hStmt, SQL_HANDLE_STMT, ret);
+                    } catch (...) {
+                        error = std::current_exception();
                     }
-                } else {
-                    handleError(m_hEnv, SQL_HANDLE_ENV, ret);
                 }
-            } else {
-                handleError(SQL_NULL_HANDLE, SQL_HANDLE_ENV, ret);
+                if (async) {
+                    m_odbc->SQLSetStmtAttr(hStmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, 0);
+                }
+                done(ret, error);
+            };
+
+            SQLRETURN ret = call();
+            if (ret != SQL_STILL_EXECUTING) {
+                complete(ret);
+                return;
+            }
+
+            if (!m_reactor) {
+                m_reactor = std::make_shared<AsyncReactor>();
             }
-            OdbcLogger::logInfo("Exiting initialize");
+            m_reactor->submit(hStmt, std::move(call), std::move(complete));
         }
 
-        bool OdbcWrapper::connect(const std::wstring& dsn, const std::wstring& user, const std::wstring& password) {
-            OdbcLogger::logInfo("Entering connect");
-            SQLRETURN ret = m_odbc->SQLConnect(m_hDbc, (SQLWCHAR*)dsn.c_str(), SQL_NTS,
-                                    (SQLWCHAR*)user.c_str(), SQL_NTS,
-                                    (SQLWCHAR*)password.c_str(), SQL_NTS);
+        std::vector<std::vector<std::wstring>> OdbcWrapper::fetchResults(SQLULEN rowsetSize, SQLLEN columnChars) {
+            ODBC_LOG_TRACE("Entering fetchResults (bulk)");
+            std::vector<std::vector<std::wstring>> results;
+            if (!m_connected) {
+                spdlog::warn("Exiting fetchResults (bulk) with empty results (not connected)");
+                return results;
+            }
 
-            if (SQL_SUCCEEDED(ret)) {
-                m_connected = true;
-                m_odbc->SQLAllocHandle(SQL_HANDLE_STMT, m_hDbc, &m_hStmt);
+            ResultCursor cursor(this, m_odbc.get(), m_hStmt, rowsetSize, ColumnBinding::Text, columnChars);
+            for (const auto& row : cursor) {
+                results.push_back(row);
+            }
 
-                // Handle SQL_SUCCESS_WITH_INFO to log warnings
-                if (ret == SQL_SUCCESS_WITH_INFO) {
-                    handleError(m_hDbc, SQL_HANDLE_DBC, ret);
-                }
+            ODBC_LOG_TRACE("Exiting fetchResults (bulk) with results");
+            return results;
+        }
 
-                OdbcLogger::logInfo("Exiting connect with success");
-                return true;
+        ResultCursor OdbcWrapper::openCursor(SQLULEN rowsetSize, SQLLEN columnChars) {
+            ODBC_LOG_TRACE("Entering openCursor");
+            if (!m_connected) {
+                spdlog::warn("Exiting openCursor with empty cursor (not connected)");
+                return ResultCursor();
             }
 
-            handleError(m_hDbc, SQL_HANDLE_DBC, ret);
-            OdbcLogger::logInfo("Exiting connect with failure");
-            return false;
+            ResultCursor cursor(this, m_odbc.get(), m_hStmt, rowsetSize, ColumnBinding::Text, columnChars);
+            ODBC_LOG_TRACE("Exiting openCursor");
+            return cursor;
         }
 
-        void OdbcWrapper::disconnect() {
-            OdbcLogger::logInfo("Entering disconnect");
-            if (m_connected) {
-                OdbcLogger::logInfo("Deallocating resources");
-                if (m_hStmt != SQL_NULL_HSTMT) {
-                    OdbcLogger::logInfo("Freeing statement handle");
-                    m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, m_hStmt);
-                    m_hStmt = SQL_NULL_HSTMT;
-                }
-        
-                if (m_hDbc != SQL_NULL_HDBC) {
-                    OdbcLogger::logInfo("Disconnecting from database");
-                    m_odbc->SQLDisconnect(m_hDbc);
-                }
-                
-                m_connected = false;
+        PrefetchCursor OdbcWrapper::openPrefetchCursor(const PrefetchOptions& options) {
+            ODBC_LOG_TRACE("Entering openPrefetchCursor");
+            if (!m_connected) {
+                spdlog::warn("Exiting openPrefetchCursor with empty cursor (not connected)");
+                return PrefetchCursor();
             }
-            OdbcLogger::logInfo("Exiting disconnect");
+
+            PrefetchCursor cursor(this, m_odbc.get(), m_hStmt, options);
+            ODBC_LOG_TRACE("Exiting openPrefetchCursor");
+            return cursor;
         }
 
-        bool OdbcWrapper::executeQuery(const std::wstring& query) {
-            OdbcLogger::logInfo("Entering executeQuery");
+        ResultCursor OdbcWrapper::openTypedCursor(SQLULEN rowsetSize) {
+            ODBC_LOG_TRACE("Entering openTypedCursor");
             if (!m_connected) {
-                spdlog::warn("Exiting executeQuery with failure (not connected)");
-                return false;
+                spdlog::warn("Exiting openTypedCursor with empty cursor (not connected)");
+                return ResultCursor();
             }
 
-            SQLRETURN ret = m_odbc->SQLExecDirect(m_hStmt, (SQLWCHAR*)query.c_str(), SQL_NTS);
-            if (SQL_SUCCEEDED(ret)) {
-                OdbcLogger::logInfo("Exiting executeQuery with success");
-                return true;
+            ResultCursor cursor(this, m_odbc.get(), m_hStmt, rowsetSize, ColumnBinding::Native);
+            ODBC_LOG_TRACE("Exiting openTypedCursor");
+            return cursor;
+        }
+
+        ColumnarResult OdbcWrapper::fetchColumnar(SQLULEN rowsetSize) {
+            ODBC_LOG_TRACE("Entering fetchColumnar");
+            if (!m_connected) {
+                spdlog::warn("Exiting fetchColumnar with empty results (not connected)");
+                return ColumnarResult();
             }
 
-            handleError(m_hStmt, SQL_HANDLE_STMT, ret);
-            OdbcLogger::logInfo("Exiting executeQuery with failure");
-            return false;
+            ColumnarResult result = fetchColumns(m_hStmt, rowsetSize);
+            ODBC_LOG_TRACE("Exiting fetchColumnar with results");
+            return result;
         }
 
-        std::vector<std::vector<std::wstring>> OdbcWrapper::fetchResults() {
-            OdbcLogger::logInfo("Entering fetchResults");
-            std::vector<std::vector<std::wstring>> results;
+        ColumnarResult OdbcWrapper::fetchColumns(SQLHSTMT hStmt, SQLULEN rowsetSize) {
+            SQLSMALLINT numCols = 0;
+            m_odbc->SQLNumResultCols(hStmt, &numCols);
+
+            RowsetBuffer rowset(m_odbc.get(), hStmt, getDataExtensions());
+            SQLRETURN ret = rowset.bindNative(numCols, rowsetSize);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(hStmt, SQL_HANDLE_STMT, ret); // The buffer unbinds on the way out, after this
+                return ColumnarResult();
+            }
+
+            ColumnarResult result(rowset);
+            drainRowsets(hStmt, rowset, [&result](const RowsetBuffer& fetched) { result.append(fetched); });
+            return result;
+        }
+
+        namespace {
+            /**
+             * @brief Waits for the other pipeline stage: yields at first, then sleeps so a slow fetch does not burn a core.
+             */
+            void backOff(int& spins) {
+                if (++spins < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+        }
+
+        ExportStats OdbcWrapper::exportTo(const std::string& path, ExportFormat format, const ExportOptions& options) {
+            ODBC_LOG_TRACE("Entering exportTo");
             if (!m_connected) {
-                spdlog::warn("Exiting fetchResults with empty results (not connected)");
-                return results;
+                spdlog::warn("Exiting exportTo with no rows (not connected)");
+                return ExportStats();
             }
 
-            SQLSMALLINT numCols;
+            SQLSMALLINT numCols = 0;
             m_odbc->SQLNumResultCols(m_hStmt, &numCols);
 
-            while (m_odbc->SQLFetch(m_hStmt) == SQL_SUCCESS) {
-                std::vector<std::wstring> row;
-                for (SQLSMALLINT i = 1; i <= numCols; i++) {
-                    SQLWCHAR buffer[1024];
-                    SQLLEN indicator;
-                    m_odbc->SQLGetData(m_hStmt, i, SQL_C_WCHAR, buffer, sizeof(buffer), &indicator);
-                    
-                    if (indicator != SQL_NULL_DATA) {
-                        row.push_back(std::wstring(reinterpret_cast<wchar_t*>(buffer)));
-                    } else {
-                        row.push_back(L"NULL");
+            RowsetBuffer first(m_odbc.get(), m_hStmt, getDataExtensions());
+            RowsetBuffer second(m_odbc.get(), m_hStmt, getDataExtensions());
+            SQLRETURN ret = first.bind(numCols, options.rowsetSize, options.columnChars);
+            if (SQL_SUCCEEDED(ret)) {
+                ret = second.bind(numCols, options.rowsetSize, options.columnChars);
+            }
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(m_hStmt, SQL_HANDLE_STMT, ret); // The buffers unbind on the way out, after this
+                return ExportStats();
+            }
+
+            std::vector<std::wstring> names;
+            for (SQLSMALLINT i = 0; i < numCols; i++) {
+                names.push_back(first.columnName(i));
+            }
+
+            const std::string temporary = path + ".tmp";
+            ExportEncoder encoder(temporary, format, options.blockBytes);
+            encoder.writeHeader(names, options.header);
+
+            // Buffers travel fetch -> filled -> encoder -> drained -> fetch; nullptr in filled ends the export.
+            SpscQueue<RowsetBuffer*> filled(4);
+            SpscQueue<RowsetBuffer*> drained(4);
+            RowsetBuffer* buffer = &first;
+            drained.tryPush(buffer);
+            buffer = &second;
+            drained.tryPush(buffer);
+
+            std::exception_ptr encodeError;
+            std::atomic<bool> encoderStopped{false};
+            std::thread writer([&]() {
+                try {
+                    RowsetBuffer* rowset = nullptr;
+                    for (int spins = 0;; spins = 0) {
+                        while (!filled.tryPop(rowset)) {
+                            backOff(spins);
+                        }
+                        if (!rowset) {
+                            break;
+                        }
+                        encoder.encode(*rowset);
+                        drained.tryPush(rowset);
                     }
+                } catch (...) {
+                    encodeError = std::current_exception();
                 }
-                results.push_back(row);
+                encoderStopped = true;
+            });
+
+            // The writer has to be stopped and joined on every path, so a throwing fetch is rethrown after the join.
+            std::exception_ptr fetchError;
+            ret = SQL_SUCCESS;
+            try {
+                for (int spins = 0;; spins = 0) {
+                    RowsetBuffer* rowset = nullptr;
+                    while (!drained.tryPop(rowset) && !encoderStopped) {
+                        backOff(spins);
+                    }
+                    if (!rowset || encoderStopped || encoder.failed()) {
+                        break;
+                    }
+                    ret = rowset->rebind();
+                    if (SQL_SUCCEEDED(ret)) {
+                        ret = rowset->fetch();
+                    }
+                    if (!SQL_SUCCEEDED(ret) || rowset->rowsFetched() == 0) {
+                        break;
+                    }
+                    filled.tryPush(rowset);
+                }
+            } catch (...) {
+                fetchError = std::current_exception();
             }
+            RowsetBuffer* end = nullptr;
+            filled.tryPush(end);
+            writer.join();
 
-            OdbcLogger::logInfo("Exiting fetchResults with results");
+            const bool written = encoder.finish();
+            if (fetchError || encodeError) {
+                std::remove(temporary.c_str());
+                std::rethrow_exception(fetchError ? fetchError : encodeError);
+            }
+            if (!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA) {
+                std::remove(temporary.c_str());
+                handleError(m_hStmt, SQL_HANDLE_STMT, ret); // Before unbinding, which clears the diagnostics
+                return ExportStats();
+            }
+            first.unbind();
+            second.unbind();
+            if (!written || !replaceFile(temporary, path)) {
+                std::remove(temporary.c_str());
+                throw std::runtime_error("Export Error: Unable to write " + path);
+            }
+
+            ODBC_LOG_TRACE("Exiting exportTo with " + std::to_string(encoder.stats().rows) + " rows");
+            return encoder.stats();
+        }
+
+        ResultSet OdbcWrapper::fetchResultSet(SQLULEN rowsetSize, const SpillOptions& spill) {
+            ODBC_LOG_TRACE("Entering fetchResultSet");
+            if (!m_connected) {
+                spdlog::warn("Exiting fetchResultSet with empty results (not connected)");
+                return ResultSet();
+            }
+
+            ResultSet result = fetchRows(m_hStmt, rowsetSize, spill);
+            ODBC_LOG_TRACE("Exiting fetchResultSet with results");
+            return result;
+        }
+
+        ResultSet OdbcWrapper::fetchRows(SQLHSTMT hStmt, SQLULEN rowsetSize, const SpillOptions& spill) {
+            SQLSMALLINT numCols = 0;
+            m_odbc->SQLNumResultCols(hStmt, &numCols);
+
+            RowsetBuffer rowset(m_odbc.get(), hStmt, getDataExtensions());
+            SQLRETURN ret = rowset.bind(numCols, rowsetSize);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(hStmt, SQL_HANDLE_STMT, ret); // The buffer unbinds on the way out, after this
+                return ResultSet();
+            }
+
+            ResultSet result(static_cast<size_t>(rowset.columnCount()), spill);
+            drainRowsets(hStmt, rowset, [&result](const RowsetBuffer& fetched) { result.append(fetched); });
+            return result;
+        }
+
+        std::vector<std::vector<std::string>> OdbcWrapper::fetchResultsUtf8(SQLULEN rowsetSize) {
+            ODBC_LOG_TRACE("Entering fetchResultsUtf8");
+            if (!m_connected) {
+                spdlog::warn("Exiting fetchResultsUtf8 with empty results (not connected)");
+                return {};
+            }
+
+            std::vector<std::vector<std::string>> results = fetchUtf8Rows(m_hStmt, rowsetSize);
+            ODBC_LOG_TRACE("Exiting fetchResultsUtf8 with results");
             return results;
         }
 
-        bool OdbcWrapper::executeUpdate(const std::wstring& query) {
-            OdbcLogger::logInfo("Entering executeUpdate");
+        std::vector<std::vector<std::string>> OdbcWrapper::fetchUtf8Rows(SQLHSTMT hStmt, SQLULEN rowsetSize) {
+            SQLSMALLINT numCols = 0;
+            m_odbc->SQLNumResultCols(hStmt, &numCols);
+
+            std::vector<std::vector<std::string>> results;
+            RowsetBuffer rowset(m_odbc.get(), hStmt, getDataExtensions());
+            SQLRETURN ret = rowset.bindUtf8(numCols, rowsetSize);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(hStmt, SQL_HANDLE_STMT, ret); // The buffer unbinds on the way out, after this
+                return results;
+            }
+
+            drainRowsets(hStmt, rowset, [&results](const RowsetBuffer& fetched) {
+                for (SQLULEN r = 0; r < fetched.rowsFetched(); r++) {
+                    std::vector<std::string>& row = results.emplace_back(static_cast<size_t>(fetched.columnCount()));
+                    for (SQLSMALLINT c = 0; c < fetched.columnCount(); c++) {
+                        if (fetched.isNull(r, c)) {
+                            row[c] = "NULL";
+                        } else {
+                            fetched.getString(r, c, row[c]);
+                        }
+                    }
+                }
+            });
+            return results;
+        }
+
+        SQLUINTEGER OdbcWrapper::getDataExtensions() {
+            if (!m_getDataExtensions) {
+                SQLUINTEGER extensions = 0;
+                SQLRETURN ret = m_odbc->SQLGetInfo(m_hDbc, SQL_GETDATA_EXTENSIONS, &extensions, sizeof(extensions), nullptr);
+                m_getDataExtensions = SQL_SUCCEEDED(ret) ? extensions : 0;
+            }
+            return *m_getDataExtensions;
+        }
+
+        void OdbcWrapper::drainRowsets(SQLHSTMT hStmt, RowsetBuffer& rowset,
+                                       const std::function<void(const RowsetBuffer&)>& consume) {
+            SQLRETURN ret = SQL_SUCCESS;
+            while (SQL_SUCCEEDED(ret = rowset.fetch()) && rowset.rowsFetched() > 0) {
+                consume(rowset);
+            }
+            if (!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA) {
+                handleError(hStmt, SQL_HANDLE_STMT, ret); // Before unbinding, which clears the diagnostics
+            }
+            rowset.unbind();
+        }
+
+        Statement OdbcWrapper::createStatement() {
+            ODBC_LOG_TRACE("Entering createStatement");
             if (!m_connected) {
-                spdlog::warn("Exiting executeUpdate with failure (not connected)");
-                return false;
+                spdlog::warn("Exiting createStatement with empty statement (not connected)");
+                return Statement();
+            }
+
+            SQLHSTMT hStmt = SQL_NULL_HSTMT;
+            if (!m_freeStatements.empty()) {
+                hStmt = m_freeStatements.back();
+                m_freeStatements.pop_back();
+            } else {
+                SQLRETURN ret = m_odbc->SQLAllocHandle(SQL_HANDLE_STMT, m_hDbc, &hStmt);
+                if (!SQL_SUCCEEDED(ret)) {
+                    handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+                    ODBC_LOG_TRACE("Exiting createStatement with failure");
+                    return Statement();
+                }
             }
 
-            SQLRETURN ret = m_odbc->SQLExecDirect(m_hStmt, (SQLWCHAR*)query.c_str(), SQL_NTS);
+            ODBC_LOG_TRACE("Exiting createStatement");
+            return Statement(this, m_odbc.get(), hStmt, m_generation);
+        }
+
+        void OdbcWrapper::recycleStatement(SQLHSTMT hStmt, uint64_t generation) {
+            if (m_reactor) {
+                m_reactor->waitFor(hStmt);
+            }
+            if (!m_connected || generation != m_generation) {
+                return;
+            }
+            if (m_freeStatements.size() >= MAX_FREE_STATEMENTS) {
+                m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+                return;
+            }
+
+            SQLRETURN ret = m_odbc->SQLFreeStmt(hStmt, SQL_CLOSE);
             if (SQL_SUCCEEDED(ret)) {
-                m_odbc->SQLRowCount(m_hStmt, nullptr); // Consume results if any
-                OdbcLogger::logInfo("Exiting executeUpdate with success");
-                return true;
+                ret = m_odbc->SQLFreeStmt(hStmt, SQL_RESET_PARAMS);
+            }
+            if (SQL_SUCCEEDED(ret)) {
+                m_freeStatements.push_back(hStmt);
+            } else {
+                m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+            }
+        }
+
+        std::shared_ptr<PreparedStatement> OdbcWrapper::prepare(const std::wstring& sql) {
+            ODBC_LOG_TRACE("Entering prepare");
+            if (!m_connected) {
+                spdlog::warn("Exiting prepare with failure (not connected)");
+                return nullptr;
+            }
+
+            std::shared_ptr<PreparedStatement> statement = m_statementCache.find(sql);
+            if (statement) {
+                ODBC_LOG_TRACE("Exiting prepare with cached statement");
+                return statement;
+            }
+
+            SQLHSTMT hStmt = SQL_NULL_HSTMT;
+            SQLRETURN ret = m_odbc->SQLAllocHandle(SQL_HANDLE_STMT, m_hDbc, &hStmt);
+            if (!SQL_SUCCEEDED(ret)) {
+                handleError(m_hDbc, SQL_HANDLE_DBC, ret);
+                ODBC_LOG_TRACE("Exiting prepare with failure");
+                return nullptr;
+            }
+
+            statement = std::make_shared<PreparedStatement>(this, m_odbc.get(), hStmt, sql);
+            if (!statement->prepare()) {
+                ODBC_LOG_TRACE("Exiting prepare with failure");
+                return nullptr;
             }
 
-            handleError(m_hStmt, SQL_HANDLE_STMT, ret);
-            OdbcLogger::logInfo("Exiting executeUpdate with failure");
-            return false;
+            m_statementCache.insert(statement);
+            ODBC_LOG_TRACE("Exiting prepare with new statement");
+            return statement;
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,370 @@
+#include <odbccpp/parallelquery.h>
+#include <odbclogger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cwchar>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            /**
+             * @brief Thrown from a partition's consumer to stop it once another partition has failed.
+             */
+            struct Stopped {};
+
+            /**
+             * @brief Collects the first exception of a run and tells the partitions to stop.
+             */
+            class Failure {
+            private:
+                std::mutex          m_mutex; ///< Guards m_error.
+                std::exception_ptr  m_error; ///< First exception raised.
+                std::atomic<bool>   m_stopped{false}; ///< Set once an exception was raised.
+
+            public:
+                void record(std::exception_ptr error) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_error) {
+                        m_error = std::move(error);
+                    }
+                    m_stopped.store(true);
+                }
+
+                bool stopped() const { return m_stopped.load(); }
+
+                void rethrow() {
+                    if (m_error) {
+                        std::rethrow_exception(m_error);
+                    }
+                }
+            };
+
+            /**
+             * @brief Bounded queue of rowsets from one partition to the merge.
+             */
+            struct Channel {
+                std::mutex              mutex; ///< Guards the other members.
+                std::condition_variable changed; ///< Signalled on push, pop, finish and stop.
+                std::deque<ResultSet>   rowsets; ///< Fetched rowsets not yet merged.
+                bool                    finished = false; ///< Set once the partition has no more rows.
+            };
+
+            bool parseInteger(std::wstring_view text, long long& value) {
+                wchar_t buffer[32];
+                if (text.empty() || text.size() >= std::size(buffer)) {
+                    return false;
+                }
+                std::copy(text.begin(), text.end(), buffer);
+                buffer[text.size()] = 0;
+                wchar_t* end = nullptr;
+                errno = 0;
+                value = std::wcstoll(buffer, &end, 10);
+                return errno == 0 && *end == 0;
+            }
+
+            double parseDouble(std::wstring_view text) {
+                const std::wstring buffer(text);
+                return std::wcstod(buffer.c_str(), nullptr);
+            }
+
+            /**
+             * @brief Compares two numbers given as text, exactly for integers.
+             */
+            int compareNumbers(std::wstring_view a, std::wstring_view b) {
+                long long ia = 0;
+                long long ib = 0;
+                if (parseInteger(a, ia) && parseInteger(b, ib)) {
+                    return ia < ib ? -1 : (ia > ib ? 1 : 0);
+                }
+                const double da = parseDouble(a);
+                const double db = parseDouble(b);
+                return da < db ? -1 : (da > db ? 1 : 0);
+            }
+        }
+
+        Partitioning::Partitioning(Scheme scheme, std::wstring column, size_t count, std::int64_t low, std::int64_t high)
+            : m_scheme(scheme), m_column(std::move(column)), m_count(count), m_low(low), m_high(high) {
+            if (count == 0) {
+                throw std::invalid_argument("Partitioning needs at least one partition");
+            }
+            if (high < low) {
+                throw std::invalid_argument("Partitioning range is empty");
+            }
+        }
+
+        Partitioning Partitioning::modulo(std::wstring column, size_t count) {
+            return Partitioning(Scheme::Modulo, std::move(column), count, 0, 0);
+        }
+
+        Partitioning Partitioning::range(std::wstring column, std::int64_t low, std::int64_t high, size_t count) {
+            return Partitioning(Scheme::Range, std::move(column), count, low, high);
+        }
+
+        std::int64_t Partitioning::rangeStart(size_t partition) const {
+            // The span high - low + 1 overflows for the full int64 range, so it is divided before the one is added
+            const std::uint64_t distance = static_cast<std::uint64_t>(m_high) - static_cast<std::uint64_t>(m_low);
+            std::uint64_t step = distance / m_count;
+            std::uint64_t remainder = distance % m_count + 1;
+            if (remainder == m_count) {
+                step++;
+                remainder = 0;
+            }
+            const std::uint64_t extra = std::min<std::uint64_t>(partition, remainder);
+            return static_cast<std::int64_t>(static_cast<std::uint64_t>(m_low) + partition * step + extra);
+        }
+
+        std::wstring Partitioning::predicate(size_t partition) const {
+            if (m_count == 1) {
+                return L"(1 = 1)";
+            }
+
+            std::wstring condition;
+            if (m_scheme == Scheme::Modulo) {
+                // ODBC scalar function escape, translated by the driver to its own MOD syntax
+                const std::wstring remainder = std::to_wstring(partition);
+                condition = L"{fn MOD(" + m_column + L", " + std::to_wstring(m_count) + L")} IN (" + remainder +
+                            L", -" + remainder + L")";
+            } else if (partition == 0) {
+                condition = m_column + L" < " + std::to_wstring(rangeStart(1));
+            } else if (partition + 1 == m_count) {
+                condition = m_column + L" >= " + std::to_wstring(rangeStart(partition));
+            } else {
+                condition = m_column + L" >= " + std::to_wstring(rangeStart(partition)) + L" AND " + m_column +
+                            L" < " + std::to_wstring(rangeStart(partition + 1));
+            }
+            if (partition == 0) {
+                condition += L" OR " + m_column + L" IS NULL";
+            }
+            return L"(" + condition + L")";
+        }
+
+        ParallelQuery::ParallelQuery(ConnectionPool& pool, std::wstring sql, Partitioning partitioning, SQLULEN rowsetSize)
+            : m_pool(pool), m_sql(std::move(sql)), m_partitioning(std::move(partitioning)), m_rowsetSize(rowsetSize) {
+            if (m_sql.find(PLACEHOLDER) == std::wstring::npos) {
+                throw std::invalid_argument("Parallel query SQL has no {partition} placeholder");
+            }
+        }
+
+        std::wstring ParallelQuery::partitionQuery(size_t partition) const {
+            const std::wstring_view placeholder(PLACEHOLDER);
+            const std::wstring predicate = m_partitioning.predicate(partition);
+            std::wstring sql = m_sql;
+            for (size_t pos = sql.find(placeholder); pos != std::wstring::npos;
+                 pos = sql.find(placeholder, pos + predicate.size())) {
+                sql.replace(pos, placeholder.size(), predicate);
+            }
+            return sql;
+        }
+
+        void ParallelQuery::runPartition(OdbcWrapper& connection, size_t partition,
+                                         const std::function<void(ResultSet&&)>& consume) const {
+            ODBC_LOG_DEBUG("Running partition " + std::to_string(partition + 1) + " of " + std::to_string(m_partitioning.count()));
+            if (!connection.executeQuery(partitionQuery(partition))) {
+                throw std::runtime_error("ODBC Error: Partition query failed (not connected)");
+            }
+
+            OdbcInterface* odbc = connection.m_odbc.get();
+            const SQLHSTMT hStmt = connection.m_hStmt;
+            try {
+                SQLSMALLINT numCols = 0;
+                odbc->SQLNumResultCols(hStmt, &numCols);
+
+                RowsetBuffer rowset(odbc, hStmt, connection.getDataExtensions());
+                const SQLRETURN ret = rowset.bind(numCols, m_rowsetSize);
+                if (!SQL_SUCCEEDED(ret)) {
+                    connection.handleError(hStmt, SQL_HANDLE_STMT, ret); // The buffer unbinds on the way out, after this
+                } else {
+                    connection.drainRowsets(hStmt, rowset, [&](const RowsetBuffer& fetched) {
+                        ResultSet rows(static_cast<size_t>(fetched.columnCount()));
+                        rows.append(fetched);
+                        consume(std::move(rows));
+                    });
+                }
+            } catch (...) {
+                // Rows left unfetched must not block the next statement on the pooled connection
+                odbc->SQLFreeStmt(hStmt, SQL_CLOSE);
+                throw;
+            }
+            odbc->SQLFreeStmt(hStmt, SQL_CLOSE);
+        }
+
+        size_t ParallelQuery::forEachRow(const RowCallback& onRow) {
+            ODBC_LOG_TRACE("Entering ParallelQuery::forEachRow");
+            const size_t partitions = m_partitioning.count();
+            const size_t workers = std::max<size_t>(1, std::min(partitions, m_pool.getConfig().maxSize));
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> delivered{0};
+            Failure failure;
+
+            std::vector<std::thread> threads;
+            threads.reserve(workers);
+            for (size_t w = 0; w < workers; w++) {
+                threads.emplace_back([&]() {
+                    try {
+                        ConnectionPool::Lease lease;
+                        for (size_t partition = next++; partition < partitions && !failure.stopped(); partition = next++) {
+                            if (!lease) {
+                                lease = m_pool.acquire();
+                            }
+                            runPartition(*lease, partition, [&](ResultSet&& rows) {
+                                if (failure.stopped()) {
+                                    throw Stopped();
+                                }
+                                for (const ResultSet::Row& row : rows) {
+                                    onRow(row);
+                                }
+                                delivered += rows.rowCount();
+                            });
+                        }
+                    } catch (const Stopped&) {
+                    } catch (...) {
+                        failure.record(std::current_exception());
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            failure.rethrow();
+            ODBC_LOG_TRACE("Exiting ParallelQuery::forEachRow with results");
+            return delivered.load();
+        }
+
+        size_t ParallelQuery::forEachRowOrdered(const RowOrder& before, const RowCallback& onRow) {
+            ODBC_LOG_TRACE("Entering ParallelQuery::forEachRowOrdered");
+            const size_t partitions = m_partitioning.count();
+            if (partitions > m_pool.getConfig().maxSize) {
+                // Every partition must be open at once for the merge to make progress
+                throw std::invalid_argument("Ordered parallel query needs a pool of at least one connection per partition");
+            }
+
+            std::vector<Channel> channels(partitions);
+            Failure failure;
+            auto stopAll = [&]() {
+                for (Channel& channel : channels) {
+                    std::lock_guard<std::mutex> lock(channel.mutex);
+                    channel.changed.notify_all();
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(partitions);
+            for (size_t p = 0; p < partitions; p++) {
+                threads.emplace_back([&, p]() {
+                    Channel& channel = channels[p];
+                    try {
+                        ConnectionPool::Lease lease = m_pool.acquire();
+                        runPartition(*lease, p, [&](ResultSet&& rows) {
+                            std::unique_lock<std::mutex> lock(channel.mutex);
+                            channel.changed.wait(lock, [&]() {
+                                return channel.rowsets.size() < QUEUE_DEPTH || failure.stopped();
+                            });
+                            if (failure.stopped()) {
+                                throw Stopped();
+                            }
+                            channel.rowsets.push_back(std::move(rows));
+                            channel.changed.notify_all();
+                        });
+                    } catch (const Stopped&) {
+                    } catch (...) {
+                        failure.record(std::current_exception());
+                        stopAll();
+                    }
+                    std::lock_guard<std::mutex> lock(channel.mutex);
+                    channel.finished = true;
+                    channel.changed.notify_all();
+                });
+            }
+
+            // The merge holds the rowset each partition is positioned in, and a heap of partitions by their current row
+            std::vector<ResultSet> heads(partitions);
+            std::vector<size_t> positions(partitions, 0);
+            auto advance = [&](size_t p) {
+                if (++positions[p] < heads[p].rowCount()) {
+                    return true;
+                }
+                Channel& channel = channels[p];
+                std::unique_lock<std::mutex> lock(channel.mutex);
+                channel.changed.wait(lock, [&]() {
+                    return !channel.rowsets.empty() || channel.finished || failure.stopped();
+                });
+                if (channel.rowsets.empty() || failure.stopped()) {
+                    return false;
+                }
+                heads[p] = std::move(channel.rowsets.front());
+                channel.rowsets.pop_front();
+                positions[p] = 0;
+                channel.changed.notify_all();
+                return true;
+            };
+            auto after = [&](size_t a, size_t b) {
+                // Ties go to the lower partition, so the merge is deterministic
+                const ResultSet::Row rowA = heads[a][positions[a]];
+                const ResultSet::Row rowB = heads[b][positions[b]];
+                if (before(rowB, rowA)) {
+                    return true;
+                }
+                return !before(rowA, rowB) && b < a;
+            };
+
+            size_t delivered = 0;
+            try {
+                std::priority_queue<size_t, std::vector<size_t>, decltype(after)> heap(after);
+                for (size_t p = 0; p < partitions; p++) {
+                    positions[p] = static_cast<size_t>(-1);
+                    if (advance(p)) {
+                        heap.push(p);
+                    }
+                }
+                while (!heap.empty() && !failure.stopped()) {
+                    const size_t p = heap.top();
+                    heap.pop();
+                    onRow(heads[p][positions[p]]);
+                    delivered++;
+                    if (advance(p)) {
+                        heap.push(p);
+                    }
+                }
+            } catch (...) {
+                failure.record(std::current_exception());
+                stopAll();
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            failure.rethrow();
+            ODBC_LOG_TRACE("Exiting ParallelQuery::forEachRowOrdered with results");
+            return delivered;
+        }
+
+        ParallelQuery::RowOrder ParallelQuery::orderBy(size_t column, bool numeric, bool descending) {
+            return [column, numeric, descending](const ResultSet::Row& a, const ResultSet::Row& b) {
+                const bool nullA = a.isNull(column);
+                const bool nullB = b.isNull(column);
+                int order = 0;
+                if (nullA || nullB) {
+                    order = nullA == nullB ? 0 : (nullA ? -1 : 1);
+                } else if (numeric) {
+                    order = compareNumbers(a[column], b[column]);
+                } else {
+                    order = a[column].compare(b[column]);
+                }
+                return descending ? order > 0 : order < 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include <odbccpp/parameterbatch.h>
+#include <odbccpp/textcodec.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ps {
+    namespace odbc {
+        ParameterBatch::Column& ParameterBatch::column(SQLUSMALLINT index, size_t row, SQLSMALLINT cType, SQLSMALLINT sqlType) {
+            if (index == 0 || row >= m_rows) {
+                throw std::out_of_range("ODBC Error: batch parameter index or row out of range");
+            }
+            if (index > m_columns.size()) {
+                m_columns.resize(index);
+            }
+
+            Column& col = m_columns[index - 1];
+            if (col.cType == SQL_C_DEFAULT) {
+                col.cType = cType;
+                col.sqlType = sqlType;
+                col.indicators.assign(m_rows, SQL_NULL_DATA);
+                switch (cType) {
+                    case SQL_C_SBIGINT:
+                        col.ints.resize(m_rows);
+                        col.stride = sizeof(SQLBIGINT);
+                        break;
+                    case SQL_C_DOUBLE:
+                        col.doubles.resize(m_rows);
+                        col.stride = sizeof(SQLDOUBLE);
+                        col.columnSize = 15;
+                        break;
+                    case SQL_C_TYPE_TIMESTAMP:
+                        col.timestamps.resize(m_rows);
+                        col.stride = sizeof(SQL_TIMESTAMP_STRUCT);
+                        col.columnSize = 27;
+                        col.decimalDigits = 7;
+                        break;
+                    case SQL_C_WCHAR:
+                        col.strings.resize(m_rows);
+                        break;
+                    default:
+                        break;
+                }
+            } else if (col.cType != cType) {
+                throw std::invalid_argument("ODBC Error: batch parameter type differs from earlier rows");
+            }
+            return col;
+        }
+
+        void ParameterBatch::setInt(SQLUSMALLINT index, size_t row, std::int64_t value) {
+            Column& col = column(index, row, SQL_C_SBIGINT, SQL_BIGINT);
+            col.ints[row] = static_cast<SQLBIGINT>(value);
+            col.indicators[row] = 0;
+        }
+
+        void ParameterBatch::setDouble(SQLUSMALLINT index, size_t row, double value) {
+            Column& col = column(index, row, SQL_C_DOUBLE, SQL_DOUBLE);
+            col.doubles[row] = value;
+            col.indicators[row] = 0;
+        }
+
+        void ParameterBatch::setString(SQLUSMALLINT index, size_t row, const std::wstring& value) {
+            Column& col = column(index, row, SQL_C_WCHAR, SQL_WVARCHAR);
+            col.strings[row] = toSqlWide(value);
+            col.indicators[row] = static_cast<SQLLEN>(col.strings[row].size() * sizeof(SQLWCHAR));
+        }
+
+        void ParameterBatch::setTimestamp(SQLUSMALLINT index, size_t row, const SQL_TIMESTAMP_STRUCT& value) {
+            Column& col = column(index, row, SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP);
+            col.timestamps[row] = value;
+            col.indicators[row] = 0;
+        }
+
+        void ParameterBatch::setNull(SQLUSMALLINT index, size_t row) {
+            if (index == 0 || index > m_columns.size() || m_columns[index - 1].cType == SQL_C_DEFAULT) {
+                throw std::invalid_argument("ODBC Error: batch parameter type unknown for NULL value");
+            }
+            Column& col = column(index, row, m_columns[index - 1].cType, m_columns[index - 1].sqlType);
+            col.indicators[row] = SQL_NULL_DATA;
+        }
+
+        void ParameterBatch::pack() {
+            for (Column& col : m_columns) {
+                if (col.cType != SQL_C_WCHAR) {
+                    continue;
+                }
+
+                size_t width = 1;
+                for (const SqlWString& value : col.strings) {
+                    width = std::max(width, value.size());
+                }
+
+                const size_t chars = width + 1;
+                col.columnSize = width;
+                col.stride = static_cast<SQLLEN>(chars * sizeof(SQLWCHAR));
+                col.packed.assign(m_rows * chars, 0);
+                for (size_t row = 0; row < m_rows; row++) {
+                    std::copy(col.strings[row].begin(), col.strings[row].end(), col.packed.begin() + row * chars);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,294 @@
+#include <odbccpp/prefetchcursor.h>
+#include <odbccpp/odbcwrapper.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ps {
+    namespace odbc {
+        /**
+         * @brief State shared by the consumer and the fetch thread; it stays put when the cursor is moved.
+         */
+        struct PrefetchCursor::Pipeline {
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief Fixed-capacity FIFO of buffers; each ring can hold every buffer, so push() never overflows.
+             */
+            struct Ring {
+                std::vector<RowsetBuffer*>  slots;
+                size_t                      head = 0;
+                size_t                      count = 0;
+
+                explicit Ring(size_t capacity) : slots(capacity) {}
+                bool empty() const { return count == 0; }
+                void push(RowsetBuffer* rowset) { slots[(head + count++) % slots.size()] = rowset; }
+
+                RowsetBuffer* pop() {
+                    RowsetBuffer* rowset = slots[head];
+                    head = (head + 1) % slots.size();
+                    count--;
+                    return rowset;
+                }
+            };
+
+            OdbcInterface*                              odbc; ///< Interface used for fetching and cancelling.
+            SQLHSTMT                                    hStmt; ///< Statement handle holding the result set.
+            std::function<void(SQLRETURN)>              report; ///< Logs diagnostics and throws OdbcException on SQL_ERROR.
+            std::vector<std::unique_ptr<RowsetBuffer>>  buffers; ///< Every bound buffer, depth + 1 of them.
+            std::mutex                                  mutex; ///< Guards the rings, the flags below and stats.
+            std::condition_variable                     readyChanged; ///< Signalled when a rowset is queued or fetching ends.
+            std::condition_variable                     freeChanged; ///< Signalled when a buffer is freed or fetching stops.
+            Ring                                        ready; ///< Fetched rowsets, oldest first.
+            Ring                                        free; ///< Buffers waiting to be fetched into.
+            bool                                        finished = false; ///< The fetch thread reached the end or an error.
+            std::atomic<bool>                           stopping{false}; ///< Set by cancel(); written under mutex.
+            std::exception_ptr                          error; ///< Failure of the last fetch, raised by next().
+            PrefetchStats                               stats; ///< Counters, guarded by mutex.
+            std::thread                                 thread; ///< Fetch thread running run().
+
+            Pipeline(OdbcInterface* odbc, SQLHSTMT hStmt, size_t buffers)
+                : odbc(odbc), hStmt(hStmt), ready(buffers), free(buffers) {}
+
+            /**
+             * @brief Fetches into free buffers and queues them as ready until the result set ends or stop is requested.
+             */
+            void run() {
+                for (;;) {
+                    RowsetBuffer* rowset = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        if (free.empty() && !stopping) {
+                            const Clock::time_point start = Clock::now();
+                            freeChanged.wait(lock, [this]() { return stopping || !free.empty(); });
+                            stats.producerStall += Clock::now() - start;
+                        }
+                        if (stopping) {
+                            return;
+                        }
+                        rowset = free.pop();
+                    }
+
+                    // Nothing may escape the thread, so exceptions end the fetching and are raised by next()
+                    SQLRETURN ret = SQL_ERROR;
+                    std::exception_ptr failure;
+                    try {
+                        ret = rowset->rebind();
+                        if (SQL_SUCCEEDED(ret)) {
+                            ret = rowset->fetch();
+                        }
+                        // A fetch interrupted by cancel() fails with HY008, which is expected and not reported
+                        if (((!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA) || ret == SQL_SUCCESS_WITH_INFO) && !stopping) {
+                            report(ret);
+                        }
+                    } catch (...) {
+                        ret = SQL_ERROR;
+                        failure = std::current_exception();
+                    }
+
+                    const bool last = !SQL_SUCCEEDED(ret) || rowset->rowsFetched() == 0;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (last) {
+                            free.push(rowset);
+                            finished = true;
+                            error = failure;
+                        } else {
+                            ready.push(rowset);
+                            stats.rowsets++;
+                            stats.rows += rowset->rowsFetched();
+                        }
+                    }
+                    readyChanged.notify_one();
+                    if (last) {
+                        return;
+                    }
+                }
+            }
+
+            /**
+             * @brief Joins the fetch thread and releases the statement's bindings.
+             */
+            void shutdown() {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+                for (const std::unique_ptr<RowsetBuffer>& buffer : buffers) {
+                    buffer->unbind();
+                }
+            }
+        };
+
+        PrefetchCursor::PrefetchCursor() = default;
+
+        PrefetchCursor::PrefetchCursor(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt,
+                                       const PrefetchOptions& options)
+            : m_binding(options.binding), m_done(false) {
+            SQLSMALLINT numCols = 0;
+            odbc->SQLNumResultCols(hStmt, &numCols);
+
+            const size_t depth = std::max<size_t>(options.depth, 1);
+            auto pipeline = std::make_unique<Pipeline>(odbc, hStmt, depth + 1);
+            SQLRETURN ret = SQL_SUCCESS;
+            const SQLUINTEGER getDataExtensions = wrapper->getDataExtensions();
+            for (size_t i = 0; i <= depth && SQL_SUCCEEDED(ret); i++) {
+                auto buffer = std::make_unique<RowsetBuffer>(odbc, hStmt, getDataExtensions);
+                ret = m_binding == ColumnBinding::Native ? buffer->bindNative(numCols, options.rowsetSize, options.columnChars)
+                                                         : buffer->bind(numCols, options.rowsetSize, options.columnChars);
+                pipeline->free.push(buffer.get());
+                pipeline->buffers.push_back(std::move(buffer));
+            }
+            if (!SQL_SUCCEEDED(ret)) {
+                // Unbinding clears the diagnostics, so the buffers are released after the error is reported
+                m_done = true;
+                try {
+                    wrapper->handleError(hStmt, SQL_HANDLE_STMT, ret);
+                } catch (...) {
+                    pipeline->shutdown();
+                    throw;
+                }
+                pipeline->shutdown();
+                return;
+            }
+
+            if (m_binding == ColumnBinding::Text) {
+                m_row.resize(numCols > 0 ? numCols : 0);
+            }
+            pipeline->report = [wrapper, hStmt](SQLRETURN result) { wrapper->handleError(hStmt, SQL_HANDLE_STMT, result); };
+            pipeline->thread = std::thread(&Pipeline::run, pipeline.get());
+            m_pipeline = std::move(pipeline);
+        }
+
+        PrefetchCursor::~PrefetchCursor() {
+            cancel();
+        }
+
+        PrefetchCursor::PrefetchCursor(PrefetchCursor&& other) noexcept
+            : m_pipeline(std::move(other.m_pipeline)),
+              m_rowset(std::exchange(other.m_rowset, nullptr)),
+              m_row(std::move(other.m_row)),
+              m_binding(other.m_binding),
+              m_current(std::exchange(other.m_current, 0)),
+              m_started(std::exchange(other.m_started, false)),
+              m_done(std::exchange(other.m_done, true)) {
+        }
+
+        PrefetchCursor& PrefetchCursor::operator=(PrefetchCursor&& other) noexcept {
+            if (this != &other) {
+                cancel();
+                m_pipeline = std::move(other.m_pipeline);
+                m_rowset = std::exchange(other.m_rowset, nullptr);
+                m_row = std::move(other.m_row);
+                m_binding = other.m_binding;
+                m_current = std::exchange(other.m_current, 0);
+                m_started = std::exchange(other.m_started, false);
+                m_done = std::exchange(other.m_done, true);
+            }
+            return *this;
+        }
+
+        bool PrefetchCursor::next() {
+            m_started = true;
+            if (m_done) {
+                return false;
+            }
+            if (m_rowset && m_current + 1 < m_rowset->rowsFetched()) {
+                m_current++;
+                loadRow();
+                return true;
+            }
+
+            Pipeline& pipeline = *m_pipeline;
+            std::unique_lock<std::mutex> lock(pipeline.mutex);
+            if (m_rowset) {
+                pipeline.free.push(std::exchange(m_rowset, nullptr));
+                pipeline.freeChanged.notify_one();
+            }
+            if (pipeline.ready.empty() && !pipeline.finished) {
+                const Pipeline::Clock::time_point start = Pipeline::Clock::now();
+                pipeline.readyChanged.wait(lock, [&pipeline]() { return !pipeline.ready.empty() || pipeline.finished; });
+                pipeline.stats.consumerStall += Pipeline::Clock::now() - start;
+            }
+
+            if (pipeline.ready.empty()) {
+                std::exception_ptr error = std::exchange(pipeline.error, nullptr);
+                lock.unlock();
+                m_done = true;
+                pipeline.shutdown();
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+                return false;
+            }
+            m_rowset = pipeline.ready.pop();
+            lock.unlock();
+
+            m_current = 0;
+            loadRow();
+            return true;
+        }
+
+        void PrefetchCursor::cancel() {
+            // A cursor that is done has already joined its fetch thread and released its bindings.
+            if (!m_pipeline || m_done) {
+                m_done = true;
+                return;
+            }
+            Pipeline& pipeline = *m_pipeline;
+            bool finished = false;
+            {
+                std::lock_guard<std::mutex> lock(pipeline.mutex);
+                pipeline.stopping = true;
+                finished = pipeline.finished;
+            }
+            pipeline.freeChanged.notify_one();
+
+            if (!finished) {
+                pipeline.odbc->SQLCancel(pipeline.hStmt); // Interrupts a fetch in progress
+            }
+            pipeline.shutdown();
+            pipeline.odbc->SQLFreeStmt(pipeline.hStmt, SQL_CLOSE); // Discards the rows not fetched
+            m_rowset = nullptr;
+            m_done = true;
+        }
+
+        SQLSMALLINT PrefetchCursor::columnCount() const {
+            return m_pipeline ? m_pipeline->buffers.front()->columnCount() : 0;
+        }
+
+        PrefetchStats PrefetchCursor::stats() const {
+            if (!m_pipeline) {
+                return PrefetchStats();
+            }
+            std::lock_guard<std::mutex> lock(m_pipeline->mutex);
+            return m_pipeline->stats;
+        }
+
+        PrefetchCursor::iterator PrefetchCursor::begin() {
+            if (!m_started) {
+                next();
+            }
+            return m_done ? iterator() : iterator(this);
+        }
+
+        void PrefetchCursor::loadRow() {
+            if (m_binding == ColumnBinding::Native) {
+                return;
+            }
+            for (SQLSMALLINT c = 0; c < static_cast<SQLSMALLINT>(m_row.size()); c++) {
+                if (m_rowset->isNull(m_current, c)) {
+                    m_row[c].assign(L"NULL");
+                } else {
+                    m_rowset->getString(m_current, c, m_row[c]);
+                }
+            }
+        }
+    }
+}
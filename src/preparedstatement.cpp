@@ -0,0 +1,313 @@
+#include <odbccpp/preparedstatement.h>
+#include <odbccpp/odbcwrapper.h>
+#include <odbccpp/textcodec.h>
+#include <odbclogger.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        PreparedStatement::PreparedStatement(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt, std::wstring sql)
+            : m_wrapper(wrapper), m_odbc(odbc), m_hStmt(hStmt), m_sql(std::move(sql)) {
+        }
+
+        PreparedStatement::~PreparedStatement() {
+            close();
+        }
+
+        bool PreparedStatement::prepare() {
+            ODBC_LOG_TRACE("Entering PreparedStatement::prepare");
+            SqlWString text = toSqlWide(m_sql);
+            SQLRETURN ret = m_odbc->SQLPrepare(m_hStmt, text.data(), SQL_NTS);
+            if (SQL_SUCCEEDED(ret)) {
+                if (ret == SQL_SUCCESS_WITH_INFO) {
+                    m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                }
+                ODBC_LOG_TRACE("Exiting PreparedStatement::prepare with success");
+                return true;
+            }
+
+            m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+            ODBC_LOG_TRACE("Exiting PreparedStatement::prepare with failure");
+            return false;
+        }
+
+        PreparedStatement::Parameter& PreparedStatement::parameter(SQLUSMALLINT index, SQLSMALLINT cType, SQLSMALLINT sqlType) {
+            if (index == 0) {
+                throw std::out_of_range("ODBC Error: parameter numbers start at 1");
+            }
+            if (index > m_params.size()) {
+                // Growing the vector moves every parameter, so all bound addresses become stale.
+                m_params.resize(index);
+                for (Parameter& param : m_params) {
+                    param.bound = false;
+                }
+            }
+
+            Parameter& param = m_params[index - 1];
+            if (param.cType != cType || param.sqlType != sqlType) {
+                param.cType = cType;
+                param.sqlType = sqlType;
+                param.bound = false;
+            }
+            return param;
+        }
+
+        void PreparedStatement::setInt(SQLUSMALLINT index, std::int64_t value) {
+            Parameter& param = parameter(index, SQL_C_SBIGINT, SQL_BIGINT);
+            param.intValue = static_cast<SQLBIGINT>(value);
+            param.indicator = 0;
+        }
+
+        void PreparedStatement::setDouble(SQLUSMALLINT index, double value) {
+            Parameter& param = parameter(index, SQL_C_DOUBLE, SQL_DOUBLE);
+            param.columnSize = 15;
+            param.doubleValue = value;
+            param.indicator = 0;
+        }
+
+        void PreparedStatement::setString(SQLUSMALLINT index, const std::wstring& value) {
+            Parameter& param = parameter(index, SQL_C_WCHAR, SQL_WVARCHAR);
+            const SQLWCHAR* previous = param.textValue.data();
+            const SqlWString text = toSqlWide(value);
+            const SQLULEN columnSize = std::max<SQLULEN>(text.size(), 1);
+
+            param.textValue.assign(text.begin(), text.end());
+            param.textValue.push_back(0);
+            param.indicator = static_cast<SQLLEN>(text.size() * sizeof(SQLWCHAR));
+            if (param.textValue.data() != previous || param.columnSize != columnSize) {
+                param.columnSize = columnSize;
+                param.bound = false;
+            }
+        }
+
+        void PreparedStatement::setTimestamp(SQLUSMALLINT index, const SQL_TIMESTAMP_STRUCT& value) {
+            Parameter& param = parameter(index, SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP);
+            param.columnSize = 27;
+            param.decimalDigits = 7;
+            param.timestampValue = value;
+            param.indicator = 0;
+        }
+
+        void PreparedStatement::setNull(SQLUSMALLINT index, SQLSMALLINT sqlType) {
+            Parameter& param = parameter(index, SQL_C_DEFAULT, sqlType);
+            param.columnSize = 1;
+            param.indicator = SQL_NULL_DATA;
+        }
+
+        SQLRETURN PreparedStatement::bindParameters() {
+            for (size_t i = 0; i < m_params.size(); i++) {
+                Parameter& param = m_params[i];
+                if (param.bound) {
+                    continue;
+                }
+
+                SQLPOINTER value = nullptr;
+                SQLLEN bufferLength = 0;
+                switch (param.cType) {
+                    case SQL_C_SBIGINT:
+                        value = &param.intValue;
+                        break;
+                    case SQL_C_DOUBLE:
+                        value = &param.doubleValue;
+                        break;
+                    case SQL_C_TYPE_TIMESTAMP:
+                        value = &param.timestampValue;
+                        break;
+                    case SQL_C_WCHAR:
+                        value = param.textValue.data();
+                        bufferLength = static_cast<SQLLEN>(param.textValue.size() * sizeof(SQLWCHAR));
+                        break;
+                    default:
+                        break;
+                }
+
+                SQLRETURN ret = m_odbc->SQLBindParameter(m_hStmt, static_cast<SQLUSMALLINT>(i + 1), SQL_PARAM_INPUT,
+                                                         param.cType, param.sqlType, param.columnSize, param.decimalDigits,
+                                                         value, bufferLength, &param.indicator);
+                if (!SQL_SUCCEEDED(ret)) {
+                    return ret;
+                }
+                param.bound = true;
+            }
+            return SQL_SUCCESS;
+        }
+
+        bool PreparedStatement::execute(bool idempotent) {
+            ODBC_LOG_TRACE("Entering PreparedStatement::execute");
+            if (m_cursorOpen) {
+                m_odbc->SQLFreeStmt(m_hStmt, SQL_CLOSE);
+                m_cursorOpen = false;
+            }
+
+            SQLRETURN ret = bindParameters();
+            if (!SQL_SUCCEEDED(ret)) {
+                m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                ODBC_LOG_TRACE("Exiting PreparedStatement::execute with failure");
+                return false;
+            }
+
+            // The cached statement is freed by a reconnect, so only transient errors are retried here
+            return m_wrapper->runWithRetry(idempotent, false, [this]() {
+                SQLRETURN ret = m_odbc->SQLExecute(m_hStmt);
+                if (SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA) {
+                    m_cursorOpen = true;
+                    if (ret == SQL_SUCCESS_WITH_INFO) {
+                        m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                    }
+                    ODBC_LOG_TRACE("Exiting PreparedStatement::execute with success");
+                    return true;
+                }
+
+                m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                ODBC_LOG_TRACE("Exiting PreparedStatement::execute with failure");
+                return false;
+            });
+        }
+
+        BatchResult PreparedStatement::executeBatch(ParameterBatch& batch) {
+            ODBC_LOG_TRACE("Entering PreparedStatement::executeBatch");
+            BatchResult result;
+            if (batch.rows() == 0) {
+                ODBC_LOG_TRACE("Exiting PreparedStatement::executeBatch with empty batch");
+                return result;
+            }
+
+            // Reject the batch before any attribute points the driver at the local result.
+            std::vector<ParameterBatch::Column>& columns = batch.columns();
+            for (size_t i = 0; i < columns.size(); i++) {
+                const SQLSMALLINT cType = columns[i].cType;
+                if (cType != SQL_C_SBIGINT && cType != SQL_C_DOUBLE && cType != SQL_C_TYPE_TIMESTAMP && cType != SQL_C_WCHAR) {
+                    throw std::invalid_argument("ODBC Error: batch parameter " + std::to_string(i + 1) + " has no values");
+                }
+            }
+
+            if (m_cursorOpen) {
+                m_odbc->SQLFreeStmt(m_hStmt, SQL_CLOSE);
+                m_cursorOpen = false;
+            }
+
+            batch.pack();
+            result.status.assign(batch.rows(), SQL_PARAM_UNUSED);
+
+            // The batch arrays replace any single-row bindings; they are rebound on the next execute().
+            for (Parameter& param : m_params) {
+                param.bound = false;
+            }
+
+            SQLRETURN ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)batch.rows(), 0);
+            }
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAM_STATUS_PTR, result.status.data(), 0);
+            }
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &result.processed, 0);
+            }
+
+            for (size_t i = 0; i < columns.size() && SQL_SUCCEEDED(ret); i++) {
+                ParameterBatch::Column& col = columns[i];
+                SQLPOINTER values = nullptr;
+                switch (col.cType) {
+                    case SQL_C_SBIGINT:
+                        values = col.ints.data();
+                        break;
+                    case SQL_C_DOUBLE:
+                        values = col.doubles.data();
+                        break;
+                    case SQL_C_TYPE_TIMESTAMP:
+                        values = col.timestamps.data();
+                        break;
+                    default: // SQL_C_WCHAR
+                        values = col.packed.data();
+                        break;
+                }
+
+                ret = m_odbc->SQLBindParameter(m_hStmt, static_cast<SQLUSMALLINT>(i + 1), SQL_PARAM_INPUT,
+                                               col.cType, col.sqlType, col.columnSize, col.decimalDigits,
+                                               values, col.stride, col.indicators.data());
+            }
+
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLExecute(m_hStmt);
+            }
+
+            // Drivers report SQL_ERROR when any parameter set fails, even if others were applied.
+            const bool partial = (ret == SQL_ERROR && result.processed > 0);
+            if (SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA || partial) {
+                if (ret == SQL_SUCCESS_WITH_INFO || partial) {
+                    m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, SQL_SUCCESS_WITH_INFO);
+                }
+
+                // Drivers without batch row counts report one count per parameter set.
+                SQLRETURN more = SQL_SUCCESS;
+                while (SQL_SUCCEEDED(more)) {
+                    SQLLEN count = 0;
+                    if (SQL_SUCCEEDED(m_odbc->SQLRowCount(m_hStmt, &count)) && count > 0) {
+                        result.rowCount += count;
+                    }
+                    more = m_odbc->SQLMoreResults(m_hStmt);
+                }
+            }
+
+            if (!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA && !partial) {
+                // Resetting clears the diagnostics, so the error is reported first; the arrays are still unbound on the way out
+                try {
+                    m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                } catch (...) {
+                    resetBatch();
+                    throw;
+                }
+                resetBatch();
+                ODBC_LOG_TRACE("Exiting PreparedStatement::executeBatch with failure");
+                return result;
+            }
+            resetBatch();
+
+            ODBC_LOG_TRACE("Exiting PreparedStatement::executeBatch with " + std::to_string(result.rowCount) + " rows affected");
+            return result;
+        }
+
+        void PreparedStatement::resetBatch() {
+            m_odbc->SQLFreeStmt(m_hStmt, SQL_RESET_PARAMS);
+            m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, nullptr, 0);
+            m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+            m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+        }
+
+        SQLLEN PreparedStatement::rowCount() {
+            SQLLEN count = -1;
+            if (!SQL_SUCCEEDED(m_odbc->SQLRowCount(m_hStmt, &count))) {
+                return -1;
+            }
+            return count;
+        }
+
+        ResultCursor PreparedStatement::openCursor(SQLULEN rowsetSize, SQLLEN columnChars) {
+            return ResultCursor(m_wrapper, m_odbc, m_hStmt, rowsetSize, ColumnBinding::Text, columnChars);
+        }
+
+        ResultCursor PreparedStatement::openTypedCursor(SQLULEN rowsetSize) {
+            return ResultCursor(m_wrapper, m_odbc, m_hStmt, rowsetSize, ColumnBinding::Native);
+        }
+
+        std::vector<std::vector<std::wstring>> PreparedStatement::fetchResults(SQLULEN rowsetSize, SQLLEN columnChars) {
+            std::vector<std::vector<std::wstring>> results;
+            for (const auto& row : openCursor(rowsetSize, columnChars)) {
+                results.push_back(row);
+            }
+            return results;
+        }
+
+        void PreparedStatement::close() {
+            if (m_hStmt != SQL_NULL_HSTMT) {
+                m_odbc->SQLFreeHandle(SQL_HANDLE_STMT, m_hStmt);
+                m_hStmt = SQL_NULL_HSTMT;
+                m_cursorOpen = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include <odbccpp/prometheusexporter.h>
+#include <odbccpp/fileutil.h>
+
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            /// Bucket bounds in nanoseconds: 1-2.5-5 steps from 100 ns to 10 s.
+            const uint64_t BUCKET_BOUNDS[] = {
+                100, 250, 500,
+                1000, 2500, 5000,
+                10000, 25000, 50000,
+                100000, 250000, 500000,
+                1000000, 2500000, 5000000,
+                10000000, 25000000, 50000000,
+                100000000, 250000000, 500000000,
+                1000000000, 2500000000, 5000000000,
+                10000000000
+            };
+
+            std::string seconds(uint64_t nanos) {
+                std::ostringstream text;
+                text.imbue(std::locale::classic());
+                text.precision(12);
+                text << static_cast<double>(nanos) / 1e9;
+                return text.str();
+            }
+
+            void writeHistogram(std::ostream& out, const std::string& name, const std::string& help,
+                                const HistogramSnapshot& histogram) {
+                out << "# HELP " << name << ' ' << help << '\n';
+                out << "# TYPE " << name << " histogram\n";
+                for (uint64_t bound : BUCKET_BOUNDS) {
+                    out << name << "_bucket{le=\"" << seconds(bound) << "\"} " << histogram.countAtOrBelow(bound) << '\n';
+                }
+                out << name << "_bucket{le=\"+Inf\"} " << histogram.count << '\n';
+                out << name << "_sum " << seconds(histogram.sum) << '\n';
+                out << name << "_count " << histogram.count << '\n';
+            }
+
+            void writeCounter(std::ostream& out, const std::string& name, const std::string& help, uint64_t value) {
+                out << "# HELP " << name << ' ' << help << '\n';
+                out << "# TYPE " << name << " counter\n";
+                out << name << ' ' << value << '\n';
+            }
+
+            void writeStateCounter(std::ostream& out, const std::string& name, const std::string& help,
+                                   const std::map<std::string, uint64_t>& counts, uint64_t total) {
+                out << "# HELP " << name << ' ' << help << '\n';
+                out << "# TYPE " << name << " counter\n";
+                uint64_t attributed = 0;
+                for (const auto& [state, count] : counts) {
+                    // SQLSTATEs are alphanumeric, so no label escaping is needed
+                    out << name << "{sqlstate=\"" << state << "\"} " << count << '\n';
+                    attributed += count;
+                }
+                if (total > attributed) {
+                    out << name << "{sqlstate=\"unknown\"} " << total - attributed << '\n';
+                }
+            }
+        }
+
+        PrometheusExporter::PrometheusExporter(std::shared_ptr<const OdbcMetrics> metrics, std::string path, std::string prefix)
+            : m_metrics(std::move(metrics)), m_prefix(std::move(prefix)), m_path(std::move(path)) {
+        }
+
+        PrometheusExporter::PrometheusExporter(std::shared_ptr<const OdbcMetrics> metrics,
+                                               std::function<void(const std::string&)> sink, std::string prefix)
+            : m_metrics(std::move(metrics)), m_prefix(std::move(prefix)), m_sink(std::move(sink)) {
+        }
+
+        std::string PrometheusExporter::render() const {
+            return format(m_metrics->snapshot(), m_prefix);
+        }
+
+        bool PrometheusExporter::exportNow() const {
+            const std::string text = render();
+            if (m_sink) {
+                m_sink(text);
+                return true;
+            }
+
+            const std::string temporary = m_path + ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                if (!file || !(file << text) || !file.flush()) {
+                    return false;
+                }
+            }
+            return replaceFile(temporary, m_path);
+        }
+
+        std::string PrometheusExporter::format(const MetricsSnapshot& snapshot, const std::string& prefix) {
+            std::ostringstream out;
+            out.imbue(std::locale::classic());
+            writeHistogram(out, prefix + "_connect_seconds", "Time taken by connection attempts.", snapshot.connect);
+            writeHistogram(out, prefix + "_execute_seconds", "Time taken by statement executions.", snapshot.execute);
+            writeHistogram(out, prefix + "_fetch_seconds", "Time taken by fetch calls.", snapshot.fetch);
+            writeHistogram(out, prefix + "_fetch_row_seconds", "Fetch time per row fetched.", snapshot.fetchPerRow);
+            writeCounter(out, prefix + "_rows_fetched_total", "Rows fetched.", snapshot.rows);
+            writeCounter(out, prefix + "_bytes_fetched_total", "Bytes of column data fetched.", snapshot.bytes);
+            writeStateCounter(out, prefix + "_errors_total", "ODBC calls that failed, by SQLSTATE.",
+                              snapshot.errorsBySqlState, snapshot.errors);
+            writeStateCounter(out, prefix + "_retries_total", "Retries, by the SQLSTATE that caused them.",
+                              snapshot.retriesBySqlState, snapshot.retries);
+            return out.str();
+        }
+    }
+}
@@ -0,0 +1,241 @@
+#include <odbccpp/querycache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        QueryCache::QueryCache(size_t byteBudget, std::chrono::milliseconds ttl, size_t shards)
+            : m_ttl(ttl), m_shardCount(std::max<size_t>(shards, 1)) {
+            m_shards.reset(new Shard[m_shardCount]);
+            m_shardBudget = byteBudget / m_shardCount;
+        }
+
+        QueryCache::Shard& QueryCache::shardFor(std::wstring_view key) const {
+            return m_shards[std::hash<std::wstring_view>()(key) % m_shardCount];
+        }
+
+        void QueryCache::erase(Shard& shard, std::list<Entry>::iterator entry) {
+            shard.bytes -= entry->bytes;
+            m_bytes.fetch_sub(entry->bytes, std::memory_order_relaxed);
+            m_entries.fetch_sub(1, std::memory_order_relaxed);
+            shard.index.erase(entry->key);
+            shard.lru.erase(entry);
+        }
+
+        bool QueryCache::invalidatedSince(const std::vector<std::string>& tags, std::uint64_t generation) const {
+            std::lock_guard<std::mutex> lock(m_tagMutex);
+            if (m_clearGeneration > generation) {
+                return true;
+            }
+            for (const std::string& tag : tags) {
+                auto it = m_tagGenerations.find(tag);
+                if (it != m_tagGenerations.end() && it->second > generation) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void QueryCache::advanceGeneration(const std::string* tag) {
+            std::lock_guard<std::mutex> lock(m_tagMutex);
+            const std::uint64_t generation = m_generation.load(std::memory_order_relaxed) + 1;
+            if (tag) {
+                m_tagGenerations[*tag] = generation;
+            } else {
+                m_clearGeneration = generation;
+            }
+            m_generation.store(generation, std::memory_order_release);
+        }
+
+        std::shared_ptr<const ResultSet> QueryCache::find(std::wstring_view key) {
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.index.find(key);
+            if (it == shard.index.end()) {
+                m_misses.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            if (it->second->expires <= Clock::now()) {
+                erase(shard, it->second);
+                m_expirations.fetch_add(1, std::memory_order_relaxed);
+                m_misses.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second->result;
+        }
+
+        std::shared_ptr<const ResultSet> QueryCache::insert(std::wstring_view key, ResultSet result,
+                                                           const std::vector<std::string>& tags,
+                                                           std::chrono::milliseconds ttl, std::uint64_t generation) {
+            result.compact();
+            const size_t bytes = result.memoryUsage() + key.size() * sizeof(wchar_t);
+            auto shared = std::make_shared<const ResultSet>(std::move(result));
+
+            const Clock::time_point now = Clock::now();
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto existing = shard.index.find(key);
+            if (existing != shard.index.end()) {
+                erase(shard, existing->second);
+            }
+
+            // Checked under the shard lock: an invalidation that starts after the check
+            // sweeps this shard only once the entry is in it
+            if (generation != ANY_GENERATION && invalidatedSince(tags, generation)) {
+                m_stale.fetch_add(1, std::memory_order_relaxed);
+                return shared;
+            }
+            if (bytes > m_shardBudget) {
+                m_rejections.fetch_add(1, std::memory_order_relaxed);
+                return shared;
+            }
+
+            if (shard.bytes + bytes > m_shardBudget) {
+                // Stale entries go first, wherever they are in the LRU order
+                for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+                    auto next = std::next(it);
+                    if (it->expires <= now) {
+                        erase(shard, it);
+                        m_expirations.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    it = next;
+                }
+                while (shard.bytes + bytes > m_shardBudget) {
+                    erase(shard, std::prev(shard.lru.end()));
+                    m_evictions.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            shard.lru.push_front(Entry{std::wstring(key), shared, tags,
+                                       now + (ttl > std::chrono::milliseconds::zero() ? ttl : m_ttl), bytes});
+            shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+            shard.bytes += bytes;
+            m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            m_entries.fetch_add(1, std::memory_order_relaxed);
+            m_insertions.fetch_add(1, std::memory_order_relaxed);
+            return shared;
+        }
+
+        size_t QueryCache::invalidate(std::string_view tag) {
+            const std::string name(tag);
+            advanceGeneration(&name);
+            size_t dropped = 0;
+            for (size_t s = 0; s < m_shardCount; s++) {
+                Shard& shard = m_shards[s];
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+                    auto next = std::next(it);
+                    if (std::find(it->tags.begin(), it->tags.end(), tag) != it->tags.end()) {
+                        erase(shard, it);
+                        dropped++;
+                    }
+                    it = next;
+                }
+            }
+            m_invalidations.fetch_add(dropped, std::memory_order_relaxed);
+            return dropped;
+        }
+
+        void QueryCache::clear() {
+            advanceGeneration(nullptr);
+            for (size_t s = 0; s < m_shardCount; s++) {
+                Shard& shard = m_shards[s];
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                m_invalidations.fetch_add(shard.lru.size(), std::memory_order_relaxed);
+                while (!shard.lru.empty()) {
+                    erase(shard, shard.lru.begin());
+                }
+            }
+        }
+
+        QueryCacheStats QueryCache::stats() const {
+            QueryCacheStats stats;
+            stats.hits = m_hits.load(std::memory_order_relaxed);
+            stats.misses = m_misses.load(std::memory_order_relaxed);
+            stats.insertions = m_insertions.load(std::memory_order_relaxed);
+            stats.evictions = m_evictions.load(std::memory_order_relaxed);
+            stats.expirations = m_expirations.load(std::memory_order_relaxed);
+            stats.invalidations = m_invalidations.load(std::memory_order_relaxed);
+            stats.rejections = m_rejections.load(std::memory_order_relaxed);
+            stats.stale = m_stale.load(std::memory_order_relaxed);
+            stats.entries = m_entries.load(std::memory_order_relaxed);
+            stats.bytes = m_bytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        std::wstring QueryCache::normalize(std::wstring_view sql) {
+            std::wstring normalized;
+            normalized.reserve(sql.size());
+            wchar_t quote = 0;
+            bool space = false;
+            for (wchar_t c : sql) {
+                if (quote) {
+                    normalized.push_back(c);
+                    // A doubled quote is an escaped quote: it closes and immediately reopens the literal
+                    if (c == quote) {
+                        quote = 0;
+                    }
+                    continue;
+                }
+                if (std::iswspace(static_cast<wint_t>(c))) {
+                    space = true;
+                    continue;
+                }
+                if (space && !normalized.empty()) {
+                    normalized.push_back(L' ');
+                }
+                space = false;
+                normalized.push_back(c);
+                if (c == L'\'' || c == L'"') {
+                    quote = c;
+                } else if (c == L'[') {
+                    quote = L']';
+                } else if (c == L'-' && normalized.size() >= 2 && normalized[normalized.size() - 2] == L'-') {
+                    quote = L'\n'; // A comment runs to the end of its line, which is kept so the next line stays code
+                }
+            }
+            if (!quote && !normalized.empty() && normalized.back() == L';') {
+                normalized.pop_back();
+                if (!normalized.empty() && normalized.back() == L' ') {
+                    normalized.pop_back();
+                }
+            }
+            return normalized;
+        }
+
+        std::wstring QueryCache::makeKey(std::wstring_view sql, const std::vector<QueryParameter>& params) {
+            std::wstring key = normalize(sql);
+            for (const QueryParameter& param : params) {
+                // Each value is tagged with its type and strings with their length, so no two lists encode alike
+                key.push_back(L'\x1f');
+                std::visit([&key](const auto& value) {
+                    using T = std::decay_t<decltype(value)>;
+                    if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                        key.push_back(L'N');
+                    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+                        key.push_back(L'I');
+                        key += std::to_wstring(value);
+                    } else if constexpr (std::is_same_v<T, double>) {
+                        std::uint64_t bits = 0;
+                        std::memcpy(&bits, &value, sizeof(bits));
+                        key.push_back(L'D');
+                        key += std::to_wstring(bits);
+                    } else {
+                        key.push_back(L'S');
+                        key += std::to_wstring(value.size());
+                        key.push_back(L':');
+                        key += value;
+                    }
+                }, param);
+            }
+            return key;
+        }
+    }
+}
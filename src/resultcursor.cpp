@@ -0,0 +1,93 @@
+#include <odbccpp/resultcursor.h>
+#include <odbccpp/odbcwrapper.h>
+
+namespace ps {
+    namespace odbc {
+        ResultCursor::ResultCursor(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt, SQLULEN rowsetSize,
+                                   ColumnBinding binding, SQLLEN columnChars)
+            : m_wrapper(wrapper), m_hStmt(hStmt), m_binding(binding), m_done(false) {
+            SQLSMALLINT numCols = 0;
+            odbc->SQLNumResultCols(m_hStmt, &numCols);
+
+            m_rowset = std::make_unique<RowsetBuffer>(odbc, m_hStmt, m_wrapper->getDataExtensions());
+            SQLRETURN ret = SQL_SUCCESS;
+            if (m_binding == ColumnBinding::Native) {
+                ret = m_rowset->bindNative(numCols, rowsetSize, columnChars);
+            } else {
+                m_row.resize(numCols > 0 ? numCols : 0);
+                ret = m_rowset->bind(numCols, rowsetSize, columnChars);
+            }
+            if (!SQL_SUCCEEDED(ret)) {
+                m_done = true;
+                m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret); // Before unbinding, which clears the diagnostics
+                m_rowset->unbind();
+            }
+        }
+
+        bool ResultCursor::next() {
+            if (nextBuffered()) {
+                return true;
+            }
+            if (m_done) {
+                return false;
+            }
+
+            SQLRETURN ret = fetchRowset();
+            if ((!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA) || ret == SQL_SUCCESS_WITH_INFO) {
+                // Before acceptRowset(), whose unbinding would clear the diagnostics
+                try {
+                    m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                } catch (...) {
+                    acceptRowset(SQL_ERROR);
+                    throw;
+                }
+            }
+            return acceptRowset(ret);
+        }
+
+        bool ResultCursor::nextBuffered() {
+            m_started = true;
+            if (m_done || !m_rowset || m_current + 1 >= m_rowset->rowsFetched()) {
+                return false;
+            }
+            m_current++;
+            loadRow();
+            return true;
+        }
+
+        bool ResultCursor::acceptRowset(SQLRETURN ret) {
+            if (!m_rowset) {
+                m_done = true;
+                return false;
+            }
+            if (!SQL_SUCCEEDED(ret) || m_rowset->rowsFetched() == 0) {
+                m_done = true;
+                m_rowset->unbind();
+                return false;
+            }
+            m_current = 0;
+            loadRow();
+            return true;
+        }
+
+        ResultCursor::iterator ResultCursor::begin() {
+            if (!m_started) {
+                next();
+            }
+            return m_done ? iterator() : iterator(this);
+        }
+
+        void ResultCursor::loadRow() {
+            if (m_binding == ColumnBinding::Native) {
+                return;
+            }
+            for (SQLSMALLINT c = 0; c < static_cast<SQLSMALLINT>(m_row.size()); c++) {
+                if (m_rowset->isNull(m_current, c)) {
+                    m_row[c].assign(L"NULL");
+                } else {
+                    m_rowset->getString(m_current, c, m_row[c]);
+                }
+            }
+        }
+    }
+}
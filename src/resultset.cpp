@@ -0,0 +1,163 @@
+#include <odbccpp/resultset.h>
+#include <odbccpp/textcodec.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        ResultSet::ResultSet(size_t columns, size_t slabChars)
+            : m_slabChars(std::max<size_t>(slabChars, 1)), m_columns(columns) {
+        }
+
+        ResultSet::ResultSet(size_t columns, const SpillOptions& spill, size_t slabChars)
+            : m_slabChars(std::max<size_t>(slabChars, 1)), m_columns(columns), m_spillOptions(spill) {
+        }
+
+        ResultSet::ResultSet(ResultSet&& other) noexcept
+            : m_slabs(std::move(other.m_slabs)),
+              m_slabChars(other.m_slabChars),
+              m_slabUsed(std::exchange(other.m_slabUsed, 0)),
+              m_slabCapacity(std::exchange(other.m_slabCapacity, 0)),
+              m_allocatedChars(std::exchange(other.m_allocatedChars, 0)),
+              m_cells(std::move(other.m_cells)),
+              m_columns(other.m_columns),
+              m_rows(std::exchange(other.m_rows, 0)),
+              m_memoryRows(std::exchange(other.m_memoryRows, 0)),
+              m_spillOptions(std::move(other.m_spillOptions)),
+              m_spill(std::move(other.m_spill)),
+              m_spilledRows(std::move(other.m_spilledRows)) {
+            other.m_slabs.clear();
+            other.m_cells.clear();
+            other.m_spilledRows.clear();
+        }
+
+        ResultSet& ResultSet::operator=(ResultSet&& other) noexcept {
+            if (this != &other) {
+                m_slabs = std::move(other.m_slabs);
+                m_slabChars = other.m_slabChars;
+                m_slabUsed = std::exchange(other.m_slabUsed, 0);
+                m_slabCapacity = std::exchange(other.m_slabCapacity, 0);
+                m_allocatedChars = std::exchange(other.m_allocatedChars, 0);
+                m_cells = std::move(other.m_cells);
+                m_columns = other.m_columns;
+                m_rows = std::exchange(other.m_rows, 0);
+                m_memoryRows = std::exchange(other.m_memoryRows, 0);
+                m_spillOptions = std::move(other.m_spillOptions);
+                m_spill = std::move(other.m_spill);
+                m_spilledRows = std::move(other.m_spilledRows);
+                other.m_slabs.clear();
+                other.m_cells.clear();
+                other.m_spilledRows.clear();
+            }
+            return *this;
+        }
+
+        wchar_t* ResultSet::allocate(size_t chars) {
+            if (m_slabs.empty() || chars > m_slabCapacity - m_slabUsed) {
+                if (chars > m_slabChars) {
+                    // Kept in front of the last slab, which stays open for the following cells.
+                    std::unique_ptr<wchar_t[]> slab(new wchar_t[chars]);
+                    wchar_t* data = slab.get();
+                    m_allocatedChars += chars;
+                    m_slabs.insert(m_slabs.empty() ? m_slabs.end() : m_slabs.end() - 1, std::move(slab));
+                    return data;
+                }
+                m_slabs.emplace_back(new wchar_t[m_slabChars]);
+                m_slabUsed = 0;
+                m_slabCapacity = m_slabChars;
+                m_allocatedChars += m_slabChars;
+            }
+            wchar_t* data = m_slabs.back().get() + m_slabUsed;
+            m_slabUsed += chars;
+            return data;
+        }
+
+        void ResultSet::spill(const RowsetBuffer& rowset, SQLULEN row) {
+            size_t chars = 0; // Reserved per UTF-16 code unit; surrogate pairs leave some unused
+            for (size_t c = 0; c < m_columns; c++) {
+                const SQLSMALLINT col = static_cast<SQLSMALLINT>(c);
+                if (!rowset.isNull(row, col)) {
+                    chars += static_cast<size_t>(rowset.cellLength(row, col)) / sizeof(SQLWCHAR);
+                }
+            }
+            if (chars >= SPILLED_NULL) {
+                throw std::runtime_error("Spill Error: Row too large to spill");
+            }
+            if (!m_spill) {
+                m_spill = std::make_unique<SpillFile>(m_spillOptions.directory, m_spillOptions.segmentBytes);
+            }
+
+            // Record: the end offset of each cell in characters, flagged for NULL, then the text of every cell.
+            uint32_t* ends = static_cast<uint32_t*>(m_spill->allocate(m_columns * sizeof(uint32_t) + chars * sizeof(wchar_t),
+                                                                       std::max(alignof(uint32_t), alignof(wchar_t))));
+            wchar_t* target = reinterpret_cast<wchar_t*>(ends + m_columns);
+            uint32_t end = 0;
+            for (size_t c = 0; c < m_columns; c++) {
+                const SQLSMALLINT col = static_cast<SQLSMALLINT>(c);
+                if (rowset.isNull(row, col)) {
+                    ends[c] = end | SPILLED_NULL;
+                    continue;
+                }
+                const SQLWCHAR* text = reinterpret_cast<const SQLWCHAR*>(rowset.cell(row, col));
+                const size_t length = static_cast<size_t>(rowset.cellLength(row, col)) / sizeof(SQLWCHAR);
+                end += static_cast<uint32_t>(fromSqlWide(text, length, target + end));
+                ends[c] = end;
+            }
+            m_spilledRows.push_back(ends);
+        }
+
+        void ResultSet::append(const RowsetBuffer& rowset) {
+            const SQLULEN count = rowset.rowsFetched();
+            if (!m_spill) {
+                m_cells.reserve(m_cells.size() + count * m_columns);
+            }
+            for (SQLULEN r = 0; r < count; r++) {
+                // Once a row has spilled, all later ones do too, so the rows in memory stay a prefix.
+                if (m_spillOptions.memoryBudget > 0 && (m_spill || memoryUsage() > m_spillOptions.memoryBudget)) {
+                    spill(rowset, r);
+                    m_rows++;
+                    continue;
+                }
+                for (size_t c = 0; c < m_columns; c++) {
+                    const SQLSMALLINT col = static_cast<SQLSMALLINT>(c);
+                    if (rowset.isNull(r, col)) {
+                        m_cells.push_back(Cell());
+                        continue;
+                    }
+                    const SQLWCHAR* text = reinterpret_cast<const SQLWCHAR*>(rowset.cell(r, col));
+                    const size_t length = static_cast<size_t>(rowset.cellLength(r, col)) / sizeof(SQLWCHAR);
+                    wchar_t* target = allocate(length); // Code units, at least as many as the decoded characters
+                    m_cells.push_back(Cell{target, fromSqlWide(text, length, target)});
+                }
+                m_memoryRows++;
+                m_rows++;
+            }
+        }
+
+        void ResultSet::compact() {
+            size_t chars = 0;
+            for (const Cell& cell : m_cells) {
+                chars += cell.length;
+            }
+
+            std::unique_ptr<wchar_t[]> slab(new wchar_t[std::max<size_t>(chars, 1)]);
+            wchar_t* target = slab.get();
+            for (Cell& cell : m_cells) {
+                if (cell.data) {
+                    std::copy(cell.data, cell.data + cell.length, target);
+                    cell.data = target;
+                    target += cell.length;
+                }
+            }
+
+            m_slabs.clear();
+            m_slabs.push_back(std::move(slab));
+            m_slabUsed = chars;
+            m_slabCapacity = std::max<size_t>(chars, 1);
+            m_allocatedChars = m_slabCapacity;
+            m_cells.shrink_to_fit();
+        }
+    }
+}
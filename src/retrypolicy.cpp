@@ -0,0 +1,40 @@
+#include <odbccpp/retrypolicy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace ps {
+    namespace odbc {
+        std::unordered_map<std::string, ErrorClass> RetryPolicy::defaultClassification() {
+            return {
+                {"08", ErrorClass::ConnectionLost},
+                {"08004", ErrorClass::Permanent}, // Server rejected the connection
+                {"HYT01", ErrorClass::ConnectionLost},
+                {"40001", ErrorClass::Transient},
+                {"40P01", ErrorClass::Transient},
+                {"HYT00", ErrorClass::Transient},
+            };
+        }
+
+        ErrorClass RetryPolicy::classify(const std::string& sqlState) const {
+            auto it = classification.find(sqlState);
+            if (it == classification.end() && sqlState.size() >= 2) {
+                it = classification.find(sqlState.substr(0, 2));
+            }
+            return it == classification.end() ? ErrorClass::Permanent : it->second;
+        }
+
+        std::chrono::milliseconds RetryPolicy::backoff(int retry, double random) const {
+            const double exponential = static_cast<double>(initialBackoff.count()) * std::pow(multiplier, std::max(retry - 1, 0));
+            const double capped = std::min(exponential, static_cast<double>(maxBackoff.count()));
+            const double fraction = std::clamp(jitter, 0.0, 1.0);
+            return std::chrono::milliseconds(static_cast<long long>(capped * (1.0 - fraction) + capped * fraction * random));
+        }
+
+        std::chrono::milliseconds RetryPolicy::backoff(int retry) const {
+            thread_local std::mt19937 generator(std::random_device{}());
+            return backoff(retry, std::uniform_real_distribution<double>(0.0, 1.0)(generator));
+        }
+    }
+}
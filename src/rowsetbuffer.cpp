@@ -0,0 +1,464 @@
+#include <odbccpp/rowsetbuffer.h>
+#include <odbccpp/textcodec.h>
+#include <odbclogger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace ps {
+    namespace odbc {
+        RowsetBuffer::RowsetBuffer(OdbcInterface* odbc, SQLHSTMT hStmt, SQLUINTEGER getDataExtensions)
+            : m_odbc(odbc), m_hStmt(hStmt),
+              m_blockGetData((getDataExtensions & SQL_GD_BLOCK) != 0 && (getDataExtensions & SQL_GD_BOUND) != 0) {
+        }
+
+        RowsetBuffer::~RowsetBuffer() {
+            unbind();
+        }
+
+        namespace {
+            /**
+             * @brief Computes how many characters the text form of a column takes.
+             *
+             * @param sqlType The SQL type reported by SQLDescribeCol.
+             * @param columnSize The column size reported by SQLDescribeCol.
+             * @return The character count, or 0 if the column has no known limit.
+             */
+            SQLULEN textChars(SQLSMALLINT sqlType, SQLULEN columnSize) {
+                switch (sqlType) {
+                    case SQL_BIT:
+                        return 1;
+                    case SQL_TINYINT:
+                        return 4;
+                    case SQL_SMALLINT:
+                        return 6;
+                    case SQL_INTEGER:
+                        return 11;
+                    case SQL_BIGINT:
+                        return 20;
+                    case SQL_REAL:
+                    case SQL_FLOAT:
+                    case SQL_DOUBLE:
+                        return 24;
+                    case SQL_DECIMAL:
+                    case SQL_NUMERIC:
+                        return columnSize > 0 ? columnSize + 2 : 0; // Sign and decimal point
+                    case SQL_BINARY:
+                    case SQL_VARBINARY:
+                    case SQL_LONGVARBINARY:
+                        return columnSize * 2; // Two hex digits per byte
+                    default:
+                        return columnSize; // Characters, or the display size of dates and times
+                }
+            }
+
+            /**
+             * @brief Retrieves the number of UTF-8 bytes reserved per character of a column.
+             */
+            SQLULEN utf8BytesPerChar(SQLSMALLINT sqlType) {
+                switch (sqlType) {
+                    case SQL_CHAR:
+                    case SQL_VARCHAR:
+                    case SQL_LONGVARCHAR:
+                    case SQL_WCHAR:
+                    case SQL_WVARCHAR:
+                    case SQL_WLONGVARCHAR:
+                        return 4;
+                    default:
+                        return 1; // Numbers, dates and hex digits are ASCII
+                }
+            }
+
+            /**
+             * @brief Retrieves the bytes a character cell reserves for its terminator; binary cells have none.
+             */
+            SQLLEN terminatorBytes(SQLSMALLINT cType) {
+                return cType == SQL_C_WCHAR ? static_cast<SQLLEN>(sizeof(SQLWCHAR)) : cType == SQL_C_CHAR ? 1 : 0;
+            }
+        }
+
+        SQLRETURN RowsetBuffer::describe(SQLSMALLINT numCols, SQLULEN rowsetSize) {
+            unbind();
+
+            m_rowsetSize = rowsetSize > 0 ? rowsetSize : DEFAULT_ROWSET_SIZE;
+            m_columns.assign(numCols > 0 ? numCols : 0, Column());
+            for (SQLSMALLINT i = 0; i < numCols; i++) {
+                Column& column = m_columns[i];
+                SQLSMALLINT nullable = 0;
+                SQLWCHAR name[MAX_NAME_CHARS + 1] = {0};
+                SQLSMALLINT nameLength = 0;
+                SQLRETURN ret = m_odbc->SQLDescribeCol(m_hStmt, static_cast<SQLUSMALLINT>(i + 1), name, MAX_NAME_CHARS + 1,
+                                                       &nameLength, &column.sqlType, &column.columnSize,
+                                                       &column.decimalDigits, &nullable);
+                if (!SQL_SUCCEEDED(ret)) {
+                    return ret;
+                }
+                column.name = fromSqlWide(name, std::clamp<SQLSMALLINT>(nameLength, 0, MAX_NAME_CHARS));
+            }
+            return SQL_SUCCESS;
+        }
+
+        SQLRETURN RowsetBuffer::bind(SQLSMALLINT numCols, SQLULEN rowsetSize, SQLLEN columnChars) {
+            SQLRETURN ret = describe(numCols, rowsetSize);
+            if (!SQL_SUCCEEDED(ret)) {
+                return ret;
+            }
+
+            const SQLULEN limit = static_cast<SQLULEN>(columnChars);
+            for (Column& column : m_columns) {
+                const SQLULEN chars = textChars(column.sqlType, column.columnSize);
+                column.cType = SQL_C_WCHAR;
+                column.unbound = chars == 0 || chars > limit;
+                column.stride = static_cast<SQLLEN>(((column.unbound ? limit : chars) + 1) * sizeof(SQLWCHAR));
+            }
+            return bindColumns();
+        }
+
+        SQLRETURN RowsetBuffer::bindUtf8(SQLSMALLINT numCols, SQLULEN rowsetSize, SQLLEN columnBytes) {
+            SQLRETURN ret = describe(numCols, rowsetSize);
+            if (!SQL_SUCCEEDED(ret)) {
+                return ret;
+            }
+
+            const SQLULEN limit = static_cast<SQLULEN>(columnBytes);
+            for (Column& column : m_columns) {
+                const SQLULEN bytes = textChars(column.sqlType, column.columnSize) * utf8BytesPerChar(column.sqlType);
+                column.cType = SQL_C_CHAR;
+                column.unbound = bytes == 0 || bytes > limit;
+                column.stride = static_cast<SQLLEN>((column.unbound ? limit : bytes) + 1);
+            }
+            return bindColumns();
+        }
+
+        SQLRETURN RowsetBuffer::bindNative(SQLSMALLINT numCols, SQLULEN rowsetSize, SQLLEN columnChars) {
+            SQLRETURN ret = describe(numCols, rowsetSize);
+            if (!SQL_SUCCEEDED(ret)) {
+                return ret;
+            }
+
+            const SQLULEN limit = static_cast<SQLULEN>(columnChars);
+            for (Column& column : m_columns) {
+                switch (column.sqlType) {
+                    case SQL_BIT:
+                    case SQL_TINYINT:
+                    case SQL_SMALLINT:
+                    case SQL_INTEGER:
+                    case SQL_BIGINT:
+                        column.cType = SQL_C_SBIGINT;
+                        column.stride = sizeof(SQLBIGINT);
+                        continue;
+                    case SQL_DECIMAL:
+                    case SQL_NUMERIC:
+                        if (column.decimalDigits == 0 && column.columnSize > 0 && column.columnSize <= 18) {
+                            column.cType = SQL_C_SBIGINT;
+                            column.stride = sizeof(SQLBIGINT);
+                            continue;
+                        }
+                        break;
+                    case SQL_REAL:
+                    case SQL_FLOAT:
+                    case SQL_DOUBLE:
+                        column.cType = SQL_C_DOUBLE;
+                        column.stride = sizeof(SQLDOUBLE);
+                        continue;
+                    default:
+                        break;
+                }
+
+                const SQLULEN chars = textChars(column.sqlType, column.columnSize);
+                column.cType = SQL_C_CHAR;
+                column.unbound = chars == 0 || chars > limit;
+                column.stride = static_cast<SQLLEN>((column.unbound ? limit : chars) * utf8BytesPerChar(column.sqlType) + 1);
+            }
+            return bindColumns();
+        }
+
+        SQLRETURN RowsetBuffer::bindColumns() {
+            if (m_blockGetData) {
+                // The cell holds the first columnChars characters; fetch() reads the rest of a longer value.
+                for (Column& column : m_columns) {
+                    column.capped = column.unbound;
+                    column.unbound = false;
+                }
+            }
+
+            m_boundColumns = 0;
+            while (m_boundColumns < columnCount() && !m_columns[m_boundColumns].unbound) {
+                m_boundColumns++;
+            }
+            if (m_boundColumns < columnCount()) {
+                static std::atomic<bool> logged{false};
+                if (m_rowsetSize > 1 && !logged.exchange(true)) {
+                    const SqlWString name = toSqlWide(m_columns[m_boundColumns].name);
+                    spdlog::warn("Column {} ({}) is too wide to bind and the driver cannot read bound columns of a block "
+                                 "cursor with SQLGetData; fetching one row at a time. Raise columnChars to bind it "
+                                 "(logged once)", m_boundColumns + 1, utf16ToUtf8(name.data(), name.size()));
+                }
+                // SQLGetData reads only columns after the last bound one, and only with one row per rowset.
+                m_rowsetSize = 1;
+                for (SQLSMALLINT i = m_boundColumns; i < columnCount(); i++) {
+                    m_columns[i].unbound = true;
+                }
+            }
+
+            for (Column& column : m_columns) {
+                column.data.assign(m_rowsetSize * column.stride, 0);
+                column.indicators.assign(m_rowsetSize, SQL_NULL_DATA);
+                column.overflow.assign(column.capped ? m_rowsetSize : 0, std::vector<unsigned char>());
+            }
+            return rebind();
+        }
+
+        SQLRETURN RowsetBuffer::rebind() {
+            m_rowsFetched = 0;
+            m_reading = false;
+            m_attached = true;
+            SQLRETURN ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)m_rowsetSize, 0);
+            }
+            if (SQL_SUCCEEDED(ret)) {
+                ret = m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &m_rowsFetched, 0);
+            }
+
+            SQLSMALLINT bound = 0;
+            while (SQL_SUCCEEDED(ret) && bound < m_boundColumns) {
+                Column& column = m_columns[bound];
+                ret = m_odbc->SQLBindCol(m_hStmt, static_cast<SQLUSMALLINT>(bound + 1), column.cType,
+                                         column.data.data(), column.stride, column.indicators.data());
+                if (SQL_SUCCEEDED(ret)) {
+                    bound++;
+                }
+            }
+            m_attachedColumns = std::max(m_attachedColumns, bound);
+            if (!SQL_SUCCEEDED(ret)) {
+                return ret; // Released by unbind(), once the caller has read the diagnostics
+            }
+            m_bound = true;
+            return ret;
+        }
+
+        SQLRETURN RowsetBuffer::fetch() {
+            if (!m_reading) {
+                m_rowsFetched = 0;
+                m_fetchResult = m_odbc->SQLFetchScroll(m_hStmt, SQL_FETCH_NEXT, 0);
+                if (!SQL_SUCCEEDED(m_fetchResult) || m_rowsFetched == 0) {
+                    return m_fetchResult;
+                }
+                // A driver truncating a bound value returns SQL_SUCCESS_WITH_INFO with SQLSTATE 01004.
+                if (m_fetchResult == SQL_SUCCESS_WITH_INFO && truncated()) {
+                    return SQL_ERROR;
+                }
+                for (Column& column : m_columns) {
+                    for (std::vector<unsigned char>& value : column.overflow) {
+                        value.clear();
+                    }
+                }
+                m_readRow = 0;
+                m_positioned = false;
+                m_readColumn = 0;
+                m_readBytes = 0;
+                m_reading = true;
+            }
+
+            SQLRETURN ret = readCapped();
+            if (ret == SQL_SUCCESS) {
+                ret = readUnbound();
+            }
+            if (ret != SQL_STILL_EXECUTING) {
+                m_reading = false;
+            }
+            return ret == SQL_SUCCESS ? m_fetchResult : ret;
+        }
+
+        bool RowsetBuffer::truncated() const {
+            for (SQLSMALLINT c = 0; c < m_boundColumns; c++) {
+                const Column& column = m_columns[c];
+                if (column.capped || (column.cType != SQL_C_WCHAR && column.cType != SQL_C_CHAR)) {
+                    continue;
+                }
+                const SQLLEN capacity = column.stride - terminatorBytes(column.cType);
+                for (SQLULEN r = 0; r < m_rowsFetched; r++) {
+                    const SQLLEN indicator = column.indicators[r];
+                    if (indicator == SQL_NO_TOTAL || indicator > capacity) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        SQLRETURN RowsetBuffer::readPieces(SQLSMALLINT col, std::vector<unsigned char>& value, SQLLEN& length) {
+            // Character data reserves room for the terminator the driver appends to every piece; binary data has none.
+            const SQLSMALLINT cType = m_columns[col].cType;
+            const SQLLEN unit = terminatorBytes(cType);
+            for (;;) {
+                SQLLEN indicator = 0;
+                const SQLLEN available = static_cast<SQLLEN>(value.size()) - m_readBytes;
+                SQLRETURN ret = m_odbc->SQLGetData(m_hStmt, static_cast<SQLUSMALLINT>(col + 1), cType,
+                                                   value.data() + m_readBytes, available, &indicator);
+                if (ret == SQL_STILL_EXECUTING || (!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA)) {
+                    return ret;
+                }
+                if (ret == SQL_NO_DATA) {
+                    break; // The previous call returned the last piece
+                }
+                if (indicator == SQL_NULL_DATA) {
+                    length = SQL_NULL_DATA;
+                    return SQL_SUCCESS;
+                }
+
+                // A truncated piece (01004) fills the buffer up to the terminator; the indicator then holds
+                // the bytes left before this call, or SQL_NO_TOTAL if the driver does not know.
+                const SQLLEN capacity = available - unit;
+                if (indicator != SQL_NO_TOTAL && indicator <= capacity) {
+                    m_readBytes += indicator;
+                    break;
+                }
+                m_readBytes += capacity;
+                const SQLLEN remaining = indicator == SQL_NO_TOTAL ? static_cast<SQLLEN>(value.size())
+                                                                   : indicator - capacity;
+                value.resize(static_cast<size_t>(m_readBytes + remaining + unit));
+            }
+            length = m_readBytes;
+            return SQL_SUCCESS;
+        }
+
+        SQLRETURN RowsetBuffer::readCapped() {
+            if (m_readRow == m_rowsFetched) {
+                return SQL_SUCCESS; // Resuming readUnbound()
+            }
+            for (; m_readRow < m_rowsFetched; m_readRow++) {
+                for (; m_readColumn < m_boundColumns; m_readColumn++, m_readBytes = 0) {
+                    Column& column = m_columns[m_readColumn];
+                    if (!column.capped) {
+                        continue;
+                    }
+                    SQLLEN& indicator = column.indicators[m_readRow];
+                    const SQLLEN unit = terminatorBytes(column.cType);
+                    if (indicator != SQL_NO_TOTAL && indicator <= column.stride - unit) {
+                        continue; // Fits its cell, or NULL
+                    }
+
+                    if (!m_positioned) {
+                        SQLRETURN ret = m_odbc->SQLSetPos(m_hStmt, static_cast<SQLSETPOSIROW>(m_readRow + 1),
+                                                          SQL_POSITION, SQL_LOCK_NO_CHANGE);
+                        if (ret == SQL_STILL_EXECUTING || !SQL_SUCCEEDED(ret)) {
+                            return ret;
+                        }
+                        m_positioned = true;
+                    }
+
+                    // The fetch reported the whole length, unless SQL_NO_TOTAL, so the value usually takes a single call.
+                    std::vector<unsigned char>& value = column.overflow[m_readRow];
+                    if (m_readBytes == 0) {
+                        value.resize(static_cast<size_t>((indicator == SQL_NO_TOTAL ? 2 * column.stride : indicator) + unit));
+                    }
+                    SQLLEN length = 0;
+                    SQLRETURN ret = readPieces(m_readColumn, value, length);
+                    if (ret != SQL_SUCCESS) {
+                        return ret;
+                    }
+                    indicator = length;
+                    if (length == SQL_NULL_DATA) {
+                        value.clear();
+                    }
+                }
+                m_readColumn = 0;
+                m_positioned = false;
+            }
+            m_readColumn = m_boundColumns;
+            return SQL_SUCCESS;
+        }
+
+        SQLRETURN RowsetBuffer::readUnbound() {
+            for (; m_readColumn < columnCount(); m_readColumn++, m_readBytes = 0) {
+                Column& column = m_columns[m_readColumn];
+                if (column.cType != SQL_C_WCHAR && column.cType != SQL_C_CHAR && column.cType != SQL_C_BINARY) {
+                    // Drivers ignore BufferLength for fixed-size types and return the whole value in one call.
+                    SQLLEN indicator = 0;
+                    SQLRETURN ret = m_odbc->SQLGetData(m_hStmt, static_cast<SQLUSMALLINT>(m_readColumn + 1), column.cType,
+                                                       column.data.data(), static_cast<SQLLEN>(column.data.size()), &indicator);
+                    if (ret == SQL_STILL_EXECUTING || !SQL_SUCCEEDED(ret)) {
+                        return ret;
+                    }
+                    column.indicators[0] = indicator;
+                    continue;
+                }
+
+                SQLRETURN ret = readPieces(m_readColumn, column.data, column.indicators[0]);
+                if (ret != SQL_SUCCESS) {
+                    return ret;
+                }
+                // The single cell spans the whole buffer, so cellLength() sees the complete value.
+                column.stride = static_cast<SQLLEN>(column.data.size());
+            }
+            return SQL_SUCCESS;
+        }
+
+        void RowsetBuffer::unbind() {
+            if (!m_attached) {
+                return;
+            }
+            for (SQLSMALLINT i = 0; i < m_attachedColumns; i++) {
+                m_odbc->SQLBindCol(m_hStmt, static_cast<SQLUSMALLINT>(i + 1), m_columns[i].cType, nullptr, 0, nullptr);
+            }
+            m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+            m_odbc->SQLSetStmtAttr(m_hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+            m_attached = false;
+            m_attachedColumns = 0;
+            m_bound = false;
+            m_reading = false;
+        }
+
+        void RowsetBuffer::getString(SQLULEN row, SQLSMALLINT col, std::wstring& out) const {
+            if (isNull(row, col)) {
+                out.clear();
+                return;
+            }
+
+            const SQLWCHAR* text = reinterpret_cast<const SQLWCHAR*>(cell(row, col));
+            const size_t length = static_cast<size_t>(cellLength(row, col)) / sizeof(SQLWCHAR);
+            out.resize(length);
+            out.resize(fromSqlWide(text, length, &out[0]));
+        }
+
+        void RowsetBuffer::getString(SQLULEN row, SQLSMALLINT col, std::string& out) const {
+            if (isNull(row, col)) {
+                out.clear();
+                return;
+            }
+
+            out.assign(reinterpret_cast<const char*>(cell(row, col)), static_cast<size_t>(cellLength(row, col)));
+        }
+
+        SQLLEN RowsetBuffer::cellLength(SQLULEN row, SQLSMALLINT col) const {
+            const Column& column = m_columns[col];
+            const SQLLEN indicator = column.indicators[row];
+            if (indicator == SQL_NULL_DATA) {
+                return 0;
+            }
+
+            // fetch() fails on truncation, but stay within the cell whatever the driver reports.
+            const SQLLEN unit = column.cType == SQL_C_WCHAR ? static_cast<SQLLEN>(sizeof(SQLWCHAR)) : 1;
+            const bool overflowed = column.capped && !column.overflow[row].empty();
+            const SQLLEN capacity = (overflowed ? static_cast<SQLLEN>(column.overflow[row].size()) : column.stride) - unit;
+            if (indicator >= 0) {
+                return std::min<SQLLEN>(indicator, capacity) / unit * unit;
+            }
+
+            SQLLEN length = 0;
+            const unsigned char* data = cell(row, col);
+            while (length < capacity) {
+                const bool terminator = unit == 1 ? data[length] == 0
+                                                  : *reinterpret_cast<const SQLWCHAR*>(data + length) == 0;
+                if (terminator) {
+                    break;
+                }
+                length += unit;
+            }
+            return length;
+        }
+    }
+}
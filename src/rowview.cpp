@@ -0,0 +1,143 @@
+#include <odbccpp/rowview.h>
+
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            constexpr size_t MAX_NUMBER_CHARS = 64; ///< Longest numeric text parsed from a wide character cell.
+
+            /**
+             * @brief Parses the whole of [first, last) as an integer.
+             */
+            bool parseText(const char* first, const char* last, int64_t& value) {
+                auto [end, ec] = std::from_chars(first, last, value);
+                return ec == std::errc() && end == last;
+            }
+
+            /**
+             * @brief Parses the whole of [first, last) as a floating-point number.
+             *
+             * Standard libraries without floating-point std::from_chars, such as libc++, use
+             * std::strtod on a bounded, NUL-terminated copy instead.
+             */
+            bool parseText(const char* first, const char* last, double& value) {
+#if defined(__cpp_lib_to_chars)
+                auto [end, ec] = std::from_chars(first, last, value);
+                return ec == std::errc() && end == last;
+#else
+                const size_t length = static_cast<size_t>(last - first);
+                // strtod skips leading whitespace that from_chars would reject
+                if (length == 0 || length > MAX_NUMBER_CHARS || std::isspace(static_cast<unsigned char>(*first))) {
+                    return false;
+                }
+                char text[MAX_NUMBER_CHARS + 1];
+                std::memcpy(text, first, length);
+                text[length] = '\0';
+                char* end = nullptr;
+                errno = 0;
+                value = std::strtod(text, &end);
+                return errno == 0 && end == text + length;
+#endif
+            }
+
+            /**
+             * @brief Parses a number from text, ignoring surrounding blanks such as CHAR padding.
+             */
+            template<typename T>
+            T parseNumber(const char* first, const char* last, SQLSMALLINT col) {
+                while (first < last && *first == ' ') {
+                    first++;
+                }
+                while (last > first && last[-1] == ' ') {
+                    last--;
+                }
+                T value{};
+                if (!parseText(first, last, value)) {
+                    throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " does not hold a number");
+                }
+                return value;
+            }
+
+            /**
+             * @brief Parses a number from a character cell bound as SQL_C_CHAR or SQL_C_WCHAR.
+             */
+            template<typename T>
+            T parseCell(const RowsetBuffer& rowset, SQLULEN row, SQLSMALLINT col) {
+                const unsigned char* cell = rowset.cell(row, col);
+                const SQLLEN length = rowset.cellLength(row, col);
+                if (rowset.columnType(col) == SQL_C_CHAR) {
+                    const char* text = reinterpret_cast<const char*>(cell);
+                    return parseNumber<T>(text, text + length, col);
+                }
+
+                // Numbers are ASCII, so narrowing each code unit is enough; anything else fails to parse.
+                const SQLWCHAR* wide = reinterpret_cast<const SQLWCHAR*>(cell);
+                const size_t chars = static_cast<size_t>(length) / sizeof(SQLWCHAR);
+                if (chars > MAX_NUMBER_CHARS) {
+                    throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " does not hold a number");
+                }
+                char text[MAX_NUMBER_CHARS];
+                for (size_t i = 0; i < chars; i++) {
+                    text[i] = wide[i] < 0x80 ? static_cast<char>(wide[i]) : '?';
+                }
+                return parseNumber<T>(text, text + chars, col);
+            }
+        }
+
+        std::optional<int64_t> RowView::getInt64(SQLSMALLINT col) const {
+            const unsigned char* cell = m_rowset->cell(m_row, col);
+            switch (m_rowset->columnType(col)) {
+                case SQL_C_SBIGINT: {
+                    SQLBIGINT value;
+                    std::memcpy(&value, cell, sizeof(value));
+                    return static_cast<int64_t>(value);
+                }
+                case SQL_C_DOUBLE: {
+                    SQLDOUBLE value;
+                    std::memcpy(&value, cell, sizeof(value));
+                    // 2^63 is exact as a double; NaN fails both comparisons.
+                    if (!(value >= -9223372036854775808.0 && value < 9223372036854775808.0)) {
+                        throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " holds a value outside the int64_t range");
+                    }
+                    return static_cast<int64_t>(value);
+                }
+                default:
+                    return parseCell<int64_t>(*m_rowset, m_row, col);
+            }
+        }
+
+        std::optional<double> RowView::getDouble(SQLSMALLINT col) const {
+            const unsigned char* cell = m_rowset->cell(m_row, col);
+            switch (m_rowset->columnType(col)) {
+                case SQL_C_DOUBLE: {
+                    SQLDOUBLE value;
+                    std::memcpy(&value, cell, sizeof(value));
+                    return value;
+                }
+                case SQL_C_SBIGINT: {
+                    SQLBIGINT value;
+                    std::memcpy(&value, cell, sizeof(value));
+                    return static_cast<double>(value);
+                }
+                default:
+                    return parseCell<double>(*m_rowset, m_row, col);
+            }
+        }
+
+        std::optional<std::string_view> RowView::getStringView(SQLSMALLINT col) const {
+            if (m_rowset->columnType(col) != SQL_C_CHAR) {
+                throw std::invalid_argument("ODBC Error: Column " + std::to_string(col) + " is not bound as character data");
+            }
+            return std::string_view(reinterpret_cast<const char*>(m_rowset->cell(m_row, col)),
+                                    static_cast<size_t>(m_rowset->cellLength(m_row, col)));
+        }
+    }
+}
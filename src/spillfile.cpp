@@ -0,0 +1,182 @@
+#include <odbccpp/spillfile.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ps {
+    namespace odbc {
+        namespace {
+#ifdef _WIN32
+            /**
+             * @brief Retrieves the granularity of mapped views, which file offsets of views must be a multiple of.
+             */
+            size_t pageSize() {
+                static const size_t size = [] {
+                    SYSTEM_INFO info;
+                    ::GetSystemInfo(&info);
+                    return static_cast<size_t>(info.dwAllocationGranularity);
+                }();
+                return size;
+            }
+
+            /**
+             * @brief Describes the calling thread's last Windows error.
+             */
+            std::string lastError() {
+                return "error " + std::to_string(::GetLastError());
+            }
+#else
+            size_t pageSize() {
+                static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+                return size;
+            }
+
+            /**
+             * @brief Reserves disk blocks for a range of the file, returning 0 or an errno value.
+             */
+            int reserve(int fd, off_t offset, off_t bytes) {
+#ifdef __APPLE__
+                // No posix_fallocate: extend the file, then write a byte into every page so its block is allocated
+                if (::ftruncate(fd, offset + bytes) != 0) {
+                    return errno;
+                }
+                const char zero = 0;
+                for (off_t at = offset; at < offset + bytes; at += static_cast<off_t>(pageSize())) {
+                    if (::pwrite(fd, &zero, 1, at) != 1) {
+                        return errno;
+                    }
+                }
+                return 0;
+#else
+                return ::posix_fallocate(fd, offset, bytes);
+#endif
+            }
+#endif
+
+            size_t roundUp(size_t bytes, size_t multiple) {
+                return (std::max<size_t>(bytes, 1) + multiple - 1) / multiple * multiple;
+            }
+        }
+
+#ifdef _WIN32
+        SpillFile::SpillFile(const std::string& directory, size_t segmentBytes)
+            : m_segmentBytes(roundUp(segmentBytes, pageSize())) {
+            std::string path = directory;
+            if (path.empty()) {
+                char tempPath[MAX_PATH + 1];
+                const DWORD length = ::GetTempPathA(sizeof(tempPath), tempPath);
+                path = length > 0 && length <= MAX_PATH ? std::string(tempPath, length) : std::string(".");
+            }
+
+            char name[MAX_PATH];
+            if (::GetTempFileNameA(path.c_str(), "odb", 0, name) == 0) {
+                throw std::runtime_error("Spill Error: Unable to create a file in " + path + ": " + lastError());
+            }
+            // Deleted by the system once the last handle is closed, even after a crash
+            m_file = ::CreateFileA(name, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                   FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) {
+                const std::string error = lastError();
+                ::DeleteFileA(name);
+                throw std::runtime_error(std::string("Spill Error: Unable to create ") + name + ": " + error);
+            }
+        }
+
+        SpillFile::~SpillFile() {
+            for (const Segment& segment : m_segments) {
+                ::UnmapViewOfFile(segment.data);
+            }
+            ::CloseHandle(m_file);
+        }
+#else
+        SpillFile::SpillFile(const std::string& directory, size_t segmentBytes)
+            : m_segmentBytes(roundUp(segmentBytes, pageSize())) {
+            std::string path = directory;
+            if (path.empty()) {
+                const char* tmpdir = std::getenv("TMPDIR");
+                path = tmpdir && *tmpdir ? tmpdir : "/tmp";
+            }
+            path += "/odbccpp-spill-XXXXXX";
+
+            m_fd = ::mkstemp(&path[0]);
+            if (m_fd < 0) {
+                throw std::runtime_error("Spill Error: Unable to create " + path + ": " + std::strerror(errno));
+            }
+            ::unlink(path.c_str());
+        }
+
+        SpillFile::~SpillFile() {
+            for (const Segment& segment : m_segments) {
+                ::munmap(segment.data, segment.bytes);
+            }
+            ::close(m_fd);
+        }
+#endif
+
+        void* SpillFile::allocate(size_t bytes, size_t alignment) {
+            size_t offset = (m_used + alignment - 1) / alignment * alignment;
+            if (m_segments.empty() || offset + bytes > m_segments.back().bytes) {
+                // The rest of the last segment stays unused; it was never touched, so it holds no memory.
+                const size_t segmentBytes = std::max(m_segmentBytes, roundUp(bytes, pageSize()));
+                m_segments.push_back(Segment{mapSegment(segmentBytes), segmentBytes});
+                m_fileBytes += segmentBytes;
+                offset = 0;
+            }
+            m_used = offset + bytes;
+            return static_cast<char*>(m_segments.back().data) + offset;
+        }
+
+#ifdef _WIN32
+        void* SpillFile::mapSegment(size_t bytes) {
+            // Extending the end of file allocates the clusters, so a full disk fails here
+            const uint64_t fileBytes = m_fileBytes + bytes;
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(fileBytes);
+            if (!::SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN) || !::SetEndOfFile(m_file)) {
+                throw std::runtime_error("Spill Error: Unable to extend spill file: " + lastError());
+            }
+
+            HANDLE mapping = ::CreateFileMappingA(m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(fileBytes >> 32),
+                                                  static_cast<DWORD>(fileBytes), nullptr);
+            if (!mapping) {
+                throw std::runtime_error("Spill Error: Unable to map spill file: " + lastError());
+            }
+            void* data = ::MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, static_cast<DWORD>(m_fileBytes >> 32),
+                                         static_cast<DWORD>(m_fileBytes), bytes);
+            const std::string error = data ? std::string() : lastError();
+            ::CloseHandle(mapping); // The view keeps the mapping alive
+            if (!data) {
+                throw std::runtime_error("Spill Error: Unable to map spill file: " + error);
+            }
+            return data;
+        }
+#else
+        void* SpillFile::mapSegment(size_t bytes) {
+            // Reserving the blocks up front reports a full disk here rather than as SIGBUS on first write
+            const int error = reserve(m_fd, static_cast<off_t>(m_fileBytes), static_cast<off_t>(bytes));
+            if (error != 0) {
+                throw std::runtime_error(std::string("Spill Error: Unable to extend spill file: ") + std::strerror(error));
+            }
+            void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, static_cast<off_t>(m_fileBytes));
+            if (data == MAP_FAILED) {
+                throw std::runtime_error(std::string("Spill Error: Unable to map spill file: ") + std::strerror(errno));
+            }
+            return data;
+        }
+#endif
+    }
+}
@@ -0,0 +1,166 @@
+#include <odbccpp/statement.h>
+#include <odbccpp/odbcwrapper.h>
+#include <odbclogger.h>
+
+#include <utility>
+
+namespace ps {
+    namespace odbc {
+        Statement::Statement(OdbcWrapper* wrapper, OdbcInterface* odbc, SQLHSTMT hStmt, uint64_t generation)
+            : m_wrapper(wrapper), m_odbc(odbc), m_hStmt(hStmt), m_generation(generation) {
+        }
+
+        Statement::~Statement() {
+            release();
+        }
+
+        Statement::Statement(Statement&& other) noexcept
+            : m_wrapper(other.m_wrapper), m_odbc(other.m_odbc),
+              m_hStmt(std::exchange(other.m_hStmt, static_cast<SQLHSTMT>(SQL_NULL_HSTMT))), m_generation(other.m_generation),
+              m_cursorOpen(std::exchange(other.m_cursorOpen, false)), m_idempotent(other.m_idempotent) {
+        }
+
+        Statement& Statement::operator=(Statement&& other) noexcept {
+            if (this != &other) {
+                release();
+                m_wrapper = other.m_wrapper;
+                m_odbc = other.m_odbc;
+                m_hStmt = std::exchange(other.m_hStmt, static_cast<SQLHSTMT>(SQL_NULL_HSTMT));
+                m_generation = other.m_generation;
+                m_cursorOpen = std::exchange(other.m_cursorOpen, false);
+                m_idempotent = other.m_idempotent;
+            }
+            return *this;
+        }
+
+        bool Statement::execute(const std::wstring& sql) {
+            ODBC_LOG_TRACE("Entering Statement::execute");
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                spdlog::warn("Exiting Statement::execute with failure (no statement handle)");
+                return false;
+            }
+            closeCursor();
+
+            SqlWString text = toSqlWide(sql);
+            return m_wrapper->runWithRetry(m_idempotent, false, [&]() {
+                return completeExecute(m_odbc->SQLExecDirect(m_hStmt, text.data(), SQL_NTS));
+            });
+        }
+
+        bool Statement::execute(std::string_view sql) {
+            ODBC_LOG_TRACE("Entering Statement::execute (UTF-8)");
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                spdlog::warn("Exiting Statement::execute with failure (no statement handle)");
+                return false;
+            }
+            closeCursor();
+
+            return m_wrapper->runWithRetry(m_idempotent, false, [&]() {
+                return completeExecute(m_odbc->SQLExecDirectA(m_hStmt, sqlNarrow(sql), static_cast<SQLINTEGER>(sql.size())));
+            });
+        }
+
+        bool Statement::completeExecute(SQLRETURN ret) {
+            if (SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA) {
+                m_cursorOpen = true;
+                if (ret == SQL_SUCCESS_WITH_INFO) {
+                    m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+                }
+                ODBC_LOG_TRACE("Exiting Statement::execute with success");
+                return true;
+            }
+
+            m_wrapper->handleError(m_hStmt, SQL_HANDLE_STMT, ret);
+            ODBC_LOG_TRACE("Exiting Statement::execute with failure");
+            return false;
+        }
+
+        std::future<bool> Statement::executeAsync(const std::wstring& sql) {
+            ODBC_LOG_TRACE("Entering Statement::executeAsync");
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                spdlog::warn("Exiting Statement::executeAsync with failure (no statement handle)");
+                std::promise<bool> failed;
+                failed.set_value(false);
+                return failed.get_future();
+            }
+            closeCursor();
+
+            m_cursorOpen = true;
+            ODBC_LOG_TRACE("Exiting Statement::executeAsync");
+            return m_wrapper->executeAsync(m_hStmt, sql, true);
+        }
+
+        SQLLEN Statement::rowCount() {
+            SQLLEN count = -1;
+            if (m_hStmt == SQL_NULL_HSTMT || !SQL_SUCCEEDED(m_odbc->SQLRowCount(m_hStmt, &count))) {
+                return -1;
+            }
+            return count;
+        }
+
+        ResultCursor Statement::openCursor(SQLULEN rowsetSize, SQLLEN columnChars) {
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                return ResultCursor();
+            }
+            return ResultCursor(m_wrapper, m_odbc, m_hStmt, rowsetSize, ColumnBinding::Text, columnChars);
+        }
+
+        PrefetchCursor Statement::openPrefetchCursor(const PrefetchOptions& options) {
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                return PrefetchCursor();
+            }
+            return PrefetchCursor(m_wrapper, m_odbc, m_hStmt, options);
+        }
+
+        ResultCursor Statement::openTypedCursor(SQLULEN rowsetSize) {
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                return ResultCursor();
+            }
+            return ResultCursor(m_wrapper, m_odbc, m_hStmt, rowsetSize, ColumnBinding::Native);
+        }
+
+        std::vector<std::vector<std::wstring>> Statement::fetchResults(SQLULEN rowsetSize, SQLLEN columnChars) {
+            std::vector<std::vector<std::wstring>> results;
+            for (const auto& row : openCursor(rowsetSize, columnChars)) {
+                results.push_back(row);
+            }
+            return results;
+        }
+
+        ResultSet Statement::fetchResultSet(SQLULEN rowsetSize, const SpillOptions& spill) {
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                return ResultSet();
+            }
+            return m_wrapper->fetchRows(m_hStmt, rowsetSize, spill);
+        }
+
+        std::vector<std::vector<std::string>> Statement::fetchResultsUtf8(SQLULEN rowsetSize) {
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                return {};
+            }
+            return m_wrapper->fetchUtf8Rows(m_hStmt, rowsetSize);
+        }
+
+        ColumnarResult Statement::fetchColumnar(SQLULEN rowsetSize) {
+            if (m_hStmt == SQL_NULL_HSTMT) {
+                return ColumnarResult();
+            }
+            return m_wrapper->fetchColumns(m_hStmt, rowsetSize);
+        }
+
+        void Statement::closeCursor() {
+            if (m_cursorOpen) {
+                m_odbc->SQLFreeStmt(m_hStmt, SQL_CLOSE);
+                m_cursorOpen = false;
+            }
+        }
+
+        void Statement::release() {
+            if (m_hStmt != SQL_NULL_HSTMT) {
+                m_wrapper->recycleStatement(m_hStmt, m_generation);
+                m_hStmt = SQL_NULL_HSTMT;
+                m_cursorOpen = false;
+            }
+        }
+    }
+}
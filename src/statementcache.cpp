@@ -0,0 +1,70 @@
+#include <odbccpp/statementcache.h>
+
+#include <algorithm>
+
+namespace ps {
+    namespace odbc {
+        StatementCache::Entry StatementCache::find(const std::wstring& sql) {
+            auto it = m_index.find(sql);
+            if (it == m_index.end()) {
+                m_misses++;
+                return nullptr;
+            }
+
+            m_hits++;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return *it->second;
+        }
+
+        void StatementCache::insert(Entry statement) {
+            if (!statement) {
+                return;
+            }
+
+            if (m_issued.size() >= m_pruneAt) {
+                m_issued.erase(std::remove_if(m_issued.begin(), m_issued.end(),
+                                              [](const std::weak_ptr<PreparedStatement>& issued) { return issued.expired(); }),
+                               m_issued.end());
+                m_pruneAt = std::max(DEFAULT_CAPACITY, m_issued.size() * 2);
+            }
+            m_issued.push_back(statement);
+            if (m_capacity == 0) {
+                return;
+            }
+
+            auto existing = m_index.find(statement->getSql());
+            if (existing != m_index.end()) {
+                m_lru.erase(existing->second);
+                m_index.erase(existing);
+            }
+
+            m_lru.push_front(std::move(statement));
+            m_index.emplace(m_lru.front()->getSql(), m_lru.begin());
+            trim();
+        }
+
+        void StatementCache::clear() {
+            for (const std::weak_ptr<PreparedStatement>& issued : m_issued) {
+                if (Entry statement = issued.lock()) {
+                    statement->close();
+                }
+            }
+            m_issued.clear();
+            m_pruneAt = DEFAULT_CAPACITY;
+            m_index.clear();
+            m_lru.clear();
+        }
+
+        void StatementCache::setCapacity(size_t capacity) {
+            m_capacity = capacity;
+            trim();
+        }
+
+        void StatementCache::trim() {
+            while (m_lru.size() > m_capacity) {
+                m_index.erase(m_lru.back()->getSql());
+                m_lru.pop_back();
+            }
+        }
+    }
+}
@@ -0,0 +1,219 @@
+#include <odbccpp/textcodec.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define ODBCCPP_HAVE_SSE2 1
+#endif
+
+namespace ps {
+    namespace odbc {
+        namespace {
+            constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+            bool isHighSurrogate(char32_t unit) { return unit >= 0xD800 && unit <= 0xDBFF; }
+            bool isLowSurrogate(char32_t unit) { return unit >= 0xDC00 && unit <= 0xDFFF; }
+
+            /**
+             * @brief Decodes the code point starting at `text[i]` and advances `i` past it.
+             */
+            char32_t decodeUtf16(const SQLWCHAR* text, size_t length, size_t& i) {
+                const char32_t unit = text[i++];
+                if (isHighSurrogate(unit)) {
+                    if (i < length && isLowSurrogate(text[i])) {
+                        return 0x10000 + ((unit - 0xD800) << 10) + (static_cast<char32_t>(text[i++]) - 0xDC00);
+                    }
+                    return REPLACEMENT_CHARACTER;
+                }
+                return isLowSurrogate(unit) ? REPLACEMENT_CHARACTER : unit;
+            }
+
+            void appendUtf16(SqlWString& out, char32_t codePoint) {
+                if (codePoint >= 0x10000) {
+                    codePoint -= 0x10000;
+                    out.push_back(static_cast<SQLWCHAR>(0xD800 + (codePoint >> 10)));
+                    out.push_back(static_cast<SQLWCHAR>(0xDC00 + (codePoint & 0x3FF)));
+                } else {
+                    out.push_back(static_cast<SQLWCHAR>(codePoint));
+                }
+            }
+
+            /**
+             * @brief Writes a code point as UTF-8 and returns the position after it.
+             */
+            char* encodeUtf8(char* out, char32_t codePoint) {
+                if (codePoint < 0x80) {
+                    *out++ = static_cast<char>(codePoint);
+                } else if (codePoint < 0x800) {
+                    *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                } else if (codePoint < 0x10000) {
+                    *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                    *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                } else {
+                    *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                    *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                return out;
+            }
+
+            /**
+             * @brief Decodes the UTF-8 sequence starting at `text[i]` and advances `i` past it.
+             *
+             * Overlong forms, surrogates and truncated sequences decode as U+FFFD, consuming one byte.
+             */
+            char32_t decodeUtf8(const unsigned char* text, size_t length, size_t& i) {
+                const unsigned char lead = text[i];
+                size_t extra = 0;
+                char32_t codePoint = 0;
+                char32_t minimum = 0;
+                if (lead < 0x80) {
+                    i++;
+                    return lead;
+                } else if ((lead & 0xE0) == 0xC0) {
+                    extra = 1;
+                    codePoint = lead & 0x1F;
+                    minimum = 0x80;
+                } else if ((lead & 0xF0) == 0xE0) {
+                    extra = 2;
+                    codePoint = lead & 0x0F;
+                    minimum = 0x800;
+                } else if ((lead & 0xF8) == 0xF0) {
+                    extra = 3;
+                    codePoint = lead & 0x07;
+                    minimum = 0x10000;
+                } else {
+                    i++;
+                    return REPLACEMENT_CHARACTER;
+                }
+
+                if (length - i <= extra) {
+                    i++;
+                    return REPLACEMENT_CHARACTER;
+                }
+                for (size_t k = 1; k <= extra; k++) {
+                    const unsigned char next = text[i + k];
+                    if ((next & 0xC0) != 0x80) {
+                        i++;
+                        return REPLACEMENT_CHARACTER;
+                    }
+                    codePoint = (codePoint << 6) | (next & 0x3F);
+                }
+                if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+                    i++;
+                    return REPLACEMENT_CHARACTER;
+                }
+                i += extra + 1;
+                return codePoint;
+            }
+        }
+
+        SqlWString toSqlWide(std::wstring_view text) {
+            SqlWString out;
+            out.reserve(text.size());
+            for (wchar_t c : text) {
+                appendUtf16(out, static_cast<char32_t>(c));
+            }
+            return out;
+        }
+
+        std::wstring fromSqlWide(const SQLWCHAR* text, size_t length) {
+            std::wstring out(length, L'\0');
+            out.resize(fromSqlWide(text, length, &out[0]));
+            return out;
+        }
+
+        size_t fromSqlWide(const SQLWCHAR* text, size_t length, wchar_t* out) {
+            size_t written = 0;
+            for (size_t i = 0; i < length;) {
+                if constexpr (sizeof(wchar_t) == sizeof(SQLWCHAR)) {
+                    out[written++] = static_cast<wchar_t>(text[i++]);
+                } else {
+                    out[written++] = static_cast<wchar_t>(decodeUtf16(text, length, i));
+                }
+            }
+            return written;
+        }
+
+        size_t sqlWideLength(const SQLWCHAR* text, size_t maxLength) {
+            size_t length = 0;
+            while (length < maxLength && text[length] != 0) {
+                length++;
+            }
+            return length;
+        }
+
+        std::string utf16ToUtf8(const SQLWCHAR* text, size_t length) {
+            // Three bytes per code unit covers every case; a surrogate pair needs four bytes for two units.
+            std::string out(length * 3, '\0');
+            out.resize(utf16ToUtf8(text, length, &out[0]));
+            return out;
+        }
+
+        size_t utf16ToUtf8(const SQLWCHAR* text, size_t length, char* out) {
+            char* target = out;
+            size_t i = 0;
+            while (i < length) {
+#ifdef ODBCCPP_HAVE_SSE2
+                if (i + 16 <= length) {
+                    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+                    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + 8));
+                    const __m128i flags = _mm_and_si128(_mm_or_si128(low, high), _mm_set1_epi16(static_cast<short>(0xFF80)));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(flags, _mm_setzero_si128())) == 0xFFFF) {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_packus_epi16(low, high));
+                        target += 16;
+                        i += 16;
+                        continue;
+                    }
+                }
+#endif
+                // A block holding non-ASCII characters, or the tail, goes through the scalar path.
+                const size_t blockEnd = std::min(i + 16, length);
+                while (i < blockEnd) {
+                    target = encodeUtf8(target, decodeUtf16(text, length, i));
+                }
+            }
+            return static_cast<size_t>(target - out);
+        }
+
+        SqlWString utf8ToUtf16(std::string_view text) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+            const size_t length = text.size();
+            SqlWString out(length, 0); // One code unit per byte at most
+            SQLWCHAR* target = &out[0];
+            size_t i = 0;
+            while (i < length) {
+#ifdef ODBCCPP_HAVE_SSE2
+                if (i + 16 <= length) {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+                    if (_mm_movemask_epi8(chunk) == 0) {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_unpacklo_epi8(chunk, _mm_setzero_si128()));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 8), _mm_unpackhi_epi8(chunk, _mm_setzero_si128()));
+                        target += 16;
+                        i += 16;
+                        continue;
+                    }
+                }
+#endif
+                const size_t blockEnd = std::min(i + 16, length);
+                while (i < blockEnd) {
+                    char32_t codePoint = decodeUtf8(bytes, length, i);
+                    if (codePoint >= 0x10000) {
+                        codePoint -= 0x10000;
+                        *target++ = static_cast<SQLWCHAR>(0xD800 + (codePoint >> 10));
+                        *target++ = static_cast<SQLWCHAR>(0xDC00 + (codePoint & 0x3FF));
+                    } else {
+                        *target++ = static_cast<SQLWCHAR>(codePoint);
+                    }
+                }
+            }
+            out.resize(static_cast<size_t>(target - out.data()));
+            return out;
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include <odbccpp/transaction.h>
+#include <odbccpp/odbcwrapper.h>
+#include <odbclogger.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ps {
+    namespace odbc {
+        Transaction::Transaction(OdbcWrapper& wrapper)
+            : m_wrapper(&wrapper) {
+            if (!wrapper.beginTransaction()) {
+                throw std::runtime_error("Cannot begin transaction: not connected or a transaction is already in progress");
+            }
+            m_active = true;
+        }
+
+        Transaction::~Transaction() {
+            if (m_active) {
+                try {
+                    m_wrapper->rollback();
+                } catch (const std::exception& e) {
+                    OdbcLogger::logError(std::string("Rollback of unfinished transaction failed: ") + e.what());
+                }
+            }
+        }
+
+        bool Transaction::commit() {
+            if (!m_active) {
+                spdlog::warn("Exiting Transaction::commit with failure (transaction already ended)");
+                return false;
+            }
+            // Only a successful commit disarms the guard; otherwise the destructor still rolls back
+            if (!m_wrapper->commit()) {
+                return false;
+            }
+            m_active = false;
+            return true;
+        }
+
+        bool Transaction::rollback() {
+            if (!m_active) {
+                spdlog::warn("Exiting Transaction::rollback with failure (transaction already ended)");
+                return false;
+            }
+            m_active = false;
+            return m_wrapper->rollback();
+        }
+
+        BatchedTransaction::BatchedTransaction(OdbcWrapper& wrapper, size_t batchSize, std::chrono::milliseconds maxDelay)
+            : m_wrapper(&wrapper), m_batchSize(std::max<size_t>(batchSize, 1)), m_maxDelay(maxDelay) {
+            if (!wrapper.beginTransaction()) {
+                throw std::runtime_error("Cannot begin transaction: not connected or a transaction is already in progress");
+            }
+            m_active = true;
+        }
+
+        BatchedTransaction::~BatchedTransaction() {
+            if (m_active) {
+                try {
+                    m_wrapper->rollback();
+                } catch (const std::exception& e) {
+                    OdbcLogger::logError(std::string("Rollback of unfinished batch failed: ") + e.what());
+                }
+            }
+        }
+
+        bool BatchedTransaction::executeUpdate(const std::wstring& query) {
+            if (!m_wrapper->executeUpdate(query)) {
+                return false;
+            }
+            recordStatement();
+            return true;
+        }
+
+        void BatchedTransaction::recordStatement() {
+            if (!m_active) {
+                spdlog::warn("Exiting BatchedTransaction::recordStatement (transaction already ended)");
+                return;
+            }
+
+            const Clock::time_point now = Clock::now();
+            if (m_pending++ == 0) {
+                m_batchStart = now;
+            }
+            // Compared in milliseconds, so that the default maxDelay does not overflow
+            if (m_pending >= m_batchSize ||
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - m_batchStart) >= m_maxDelay) {
+                commitBatch();
+            }
+        }
+
+        void BatchedTransaction::commitBatch() {
+            ODBC_LOG_TRACE("Entering BatchedTransaction::commitBatch");
+            if (!m_wrapper->endTransaction(SQL_COMMIT, true)) {
+                // The statements stay pending, so the next recorded statement or commit() tries again
+                ODBC_LOG_TRACE("Exiting BatchedTransaction::commitBatch with failure");
+                return;
+            }
+            m_commits++;
+            m_pending = 0;
+            ODBC_LOG_TRACE("Exiting BatchedTransaction::commitBatch");
+        }
+
+        bool BatchedTransaction::commit() {
+            if (!m_active) {
+                spdlog::warn("Exiting BatchedTransaction::commit with failure (transaction already ended)");
+                return false;
+            }
+            // Only a successful commit disarms the guard; otherwise the destructor still rolls back
+            if (!m_wrapper->commit()) {
+                return false;
+            }
+            m_active = false;
+            if (m_pending > 0) {
+                m_commits++;
+            }
+            m_pending = 0;
+            return true;
+        }
+
+        bool BatchedTransaction::rollback() {
+            if (!m_active) {
+                spdlog::warn("Exiting BatchedTransaction::rollback with failure (transaction already ended)");
+                return false;
+            }
+            m_active = false;
+            m_pending = 0;
+            return m_wrapper->rollback();
+        }
+    }
+}
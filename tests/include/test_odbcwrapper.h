@@ -6,7 +6,17 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace ps::odbc;
 
@@ -36,6 +46,11 @@ namespace ps {
              */
             MOCK_METHOD7(SQLConnect, SQLRETURN(SQLHDBC, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT));
 
+            /**
+             * @brief Mock method for SQLConnectA.
+             */
+            MOCK_METHOD7(SQLConnectA, SQLRETURN(SQLHDBC, SQLCHAR*, SQLSMALLINT, SQLCHAR*, SQLSMALLINT, SQLCHAR*, SQLSMALLINT));
+
             /**
              * @brief Mock method for SQLDisconnect.
              */
@@ -51,6 +66,11 @@ namespace ps {
              */
             MOCK_METHOD3(SQLExecDirect, SQLRETURN(SQLHSTMT, SQLWCHAR*, SQLINTEGER));
 
+            /**
+             * @brief Mock method for SQLExecDirectA.
+             */
+            MOCK_METHOD3(SQLExecDirectA, SQLRETURN(SQLHSTMT, SQLCHAR*, SQLINTEGER));
+
             /**
              * @brief Mock method for SQLNumResultCols.
              */
@@ -66,17 +86,538 @@ namespace ps {
              */
             MOCK_METHOD6(SQLGetData, SQLRETURN(SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN*));
 
+            /**
+             * @brief Mock method for SQLSetStmtAttr.
+             */
+            MOCK_METHOD4(SQLSetStmtAttr, SQLRETURN(SQLHSTMT, SQLINTEGER, SQLPOINTER, SQLINTEGER));
+
+            /**
+             * @brief Mock method for SQLBindCol.
+             */
+            MOCK_METHOD6(SQLBindCol, SQLRETURN(SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN*));
+
+            /**
+             * @brief Mock method for SQLFetchScroll.
+             */
+            MOCK_METHOD3(SQLFetchScroll, SQLRETURN(SQLHSTMT, SQLSMALLINT, SQLLEN));
+
+            /**
+             * @brief Mock method for SQLPrepare.
+             */
+            MOCK_METHOD3(SQLPrepare, SQLRETURN(SQLHSTMT, SQLWCHAR*, SQLINTEGER));
+
+            /**
+             * @brief Mock method for SQLBindParameter.
+             */
+            MOCK_METHOD10(SQLBindParameter, SQLRETURN(SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLULEN, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN*));
+
+            /**
+             * @brief Mock method for SQLExecute.
+             */
+            MOCK_METHOD1(SQLExecute, SQLRETURN(SQLHSTMT));
+
+            /**
+             * @brief Mock method for SQLFreeStmt.
+             */
+            MOCK_METHOD2(SQLFreeStmt, SQLRETURN(SQLHSTMT, SQLUSMALLINT));
+
+            /**
+             * @brief Mock method for SQLCancel.
+             */
+            MOCK_METHOD1(SQLCancel, SQLRETURN(SQLHSTMT));
+
+            /**
+             * @brief Mock method for SQLMoreResults.
+             */
+            MOCK_METHOD1(SQLMoreResults, SQLRETURN(SQLHSTMT));
+
+            /**
+             * @brief Mock method for SQLGetConnectAttr.
+             */
+            MOCK_METHOD5(SQLGetConnectAttr, SQLRETURN(SQLHDBC, SQLINTEGER, SQLPOINTER, SQLINTEGER, SQLINTEGER*));
+
+            /**
+             * @brief Mock method for SQLSetConnectAttr.
+             */
+            MOCK_METHOD4(SQLSetConnectAttr, SQLRETURN(SQLHDBC, SQLINTEGER, SQLPOINTER, SQLINTEGER));
+
+            /**
+             * @brief Mock method for SQLEndTran.
+             */
+            MOCK_METHOD3(SQLEndTran, SQLRETURN(SQLSMALLINT, SQLHANDLE, SQLSMALLINT));
+
+            /**
+             * @brief Mock method for SQLDescribeCol.
+             */
+            MOCK_METHOD9(SQLDescribeCol, SQLRETURN(SQLHSTMT, SQLUSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLSMALLINT*, SQLSMALLINT*, SQLULEN*, SQLSMALLINT*, SQLSMALLINT*));
+
             /**
              * @brief Mock method for SQLRowCount.
              */
             MOCK_METHOD2(SQLRowCount, SQLRETURN(SQLHSTMT, SQLLEN*));
 
+            /**
+             * @brief Mock method for SQLSetPos.
+             */
+            MOCK_METHOD4(SQLSetPos, SQLRETURN(SQLHSTMT, SQLSETPOSIROW, SQLUSMALLINT, SQLUSMALLINT));
+
+            /**
+             * @brief Mock method for SQLGetInfo.
+             */
+            MOCK_METHOD5(SQLGetInfo, SQLRETURN(SQLHDBC, SQLUSMALLINT, SQLPOINTER, SQLSMALLINT, SQLSMALLINT*));
+
             /**
              * @brief Mock method for SQLGetDiagRec.
              */
             MOCK_METHOD8(SQLGetDiagRec, SQLRETURN(SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR*, SQLINTEGER*, SQLWCHAR*, SQLSMALLINT, SQLSMALLINT*));
         };
 
+        /**
+         * @brief Copies a wide string into a SQLWCHAR buffer of `capacity` characters, as a driver returns text.
+         */
+        inline void copySqlWide(SQLWCHAR* target, const std::wstring& text, size_t capacity) {
+            const size_t chars = std::min(text.size(), capacity - 1);
+            std::copy(text.begin(), text.begin() + chars, target);
+            target[chars] = 0;
+        }
+
+        /**
+         * @class FakeBlockCursor
+         * @brief Emulates a driver serving a fixed result set through a block cursor.
+         *
+         * Installs default actions on the mock for SQLSetStmtAttr, SQLBindCol and SQLFetchScroll
+         * that record the rowset size and column bindings and fill the bound SQL_C_WCHAR,
+         * SQL_C_CHAR, SQL_C_SBIGINT and SQL_C_DOUBLE arrays, so tests can assert how many fetch
+         * round trips a result set needed. Values that do not fit a bound cell are truncated
+         * with SQL_SUCCESS_WITH_INFO. Columns left unbound are served through SQLGetData from
+         * the last fetched row, character ones in buffer-sized pieces and numeric ones whole
+         * on every call, whatever the buffer length. SQLSetPos with SQL_POSITION moves
+         * SQLGetData to another row of the rowset, and SQLGetInfo reports the
+         * SQL_GETDATA_EXTENSIONS given to setGetDataExtensions(), none by default.
+         *
+         * SQLDescribeCol reports the given SQL types, or SQL_WVARCHAR if none are given, naming
+         * the columns "c1", "c2" and so on. Character columns report the size of their longest
+         * value (at least 64), long character columns a size of 0.
+         */
+        class FakeBlockCursor {
+        public:
+            using Row = std::vector<std::optional<std::wstring>>; ///< std::nullopt marks an SQL NULL cell.
+
+        private:
+            struct Binding {
+                SQLSMALLINT type = SQL_C_WCHAR;
+                SQLPOINTER  buffer = nullptr;
+                SQLLEN      length = 0;
+                SQLLEN*     indicators = nullptr;
+            };
+
+            std::vector<Row>                m_rows; ///< Rows served by the fake driver.
+            std::vector<SQLSMALLINT>        m_sqlTypes; ///< SQL type of each column, empty for SQL_WVARCHAR.
+            std::map<SQLUSMALLINT, SQLULEN> m_columnSizes; ///< Column sizes overriding the reported ones.
+            std::map<SQLUSMALLINT, size_t>  m_readOffsets; ///< Bytes of each unbound column returned by SQLGetData.
+            size_t                          m_position = 0; ///< Index of the next row to return.
+            size_t                          m_rowsetStart = 0; ///< Index of the first row of the last rowset.
+            size_t                          m_current = 0; ///< Index of the row SQLGetData reads.
+            SQLUINTEGER                     m_getDataExtensions = 0; ///< SQL_GETDATA_EXTENSIONS reported by SQLGetInfo.
+            SQLULEN                         m_rowArraySize = 1; ///< Current SQL_ATTR_ROW_ARRAY_SIZE.
+            SQLULEN*                        m_rowsFetched = nullptr; ///< Current SQL_ATTR_ROWS_FETCHED_PTR.
+            std::map<SQLUSMALLINT, Binding> m_bindings; ///< Active column bindings.
+            int                             m_roundTrips = 0; ///< Number of SQLFetchScroll calls.
+            std::chrono::milliseconds       m_latency{0}; ///< Delay of every SQLFetchScroll call.
+
+            SQLRETURN fetchScroll() {
+                m_roundTrips++;
+                if (m_latency.count() > 0) {
+                    std::this_thread::sleep_for(m_latency);
+                }
+                size_t count = std::min<size_t>(m_rowArraySize, m_rows.size() - m_position);
+                if (m_rowsFetched) {
+                    *m_rowsFetched = count;
+                }
+                if (count == 0) {
+                    return SQL_NO_DATA;
+                }
+                m_readOffsets.clear();
+                m_rowsetStart = m_position;
+                m_current = m_position + count - 1;
+                bool truncated = false;
+                for (size_t r = 0; r < count; r++) {
+                    const Row& row = m_rows[m_position + r];
+                    for (const auto& [col, binding] : m_bindings) {
+                        const std::optional<std::wstring>& cell = row.at(col - 1);
+                        if (!cell) {
+                            binding.indicators[r] = SQL_NULL_DATA;
+                            continue;
+                        }
+                        char* element = static_cast<char*>(binding.buffer) + r * binding.length;
+                        if (binding.type == SQL_C_SBIGINT) {
+                            SQLBIGINT value = std::stoll(*cell);
+                            std::memcpy(element, &value, sizeof(value));
+                            binding.indicators[r] = sizeof(value);
+                        } else if (binding.type == SQL_C_DOUBLE) {
+                            SQLDOUBLE value = std::stod(*cell);
+                            std::memcpy(element, &value, sizeof(value));
+                            binding.indicators[r] = sizeof(value);
+                        } else if (binding.type == SQL_C_CHAR) {
+                            size_t chars = std::min<size_t>(cell->size(), binding.length - 1);
+                            std::transform(cell->begin(), cell->begin() + chars, element,
+                                           [](wchar_t c) { return static_cast<char>(c); });
+                            element[chars] = 0;
+                            binding.indicators[r] = static_cast<SQLLEN>(cell->size());
+                            truncated = truncated || chars < cell->size();
+                        } else {
+                            const SqlWString units = toSqlWide(*cell);
+                            SQLWCHAR* target = reinterpret_cast<SQLWCHAR*>(element);
+                            size_t chars = std::min<size_t>(units.size(), binding.length / sizeof(SQLWCHAR) - 1);
+                            std::copy(units.begin(), units.begin() + chars, target);
+                            target[chars] = 0;
+                            binding.indicators[r] = static_cast<SQLLEN>(units.size() * sizeof(SQLWCHAR));
+                            truncated = truncated || chars < units.size();
+                        }
+                    }
+                }
+                m_position += count;
+                return truncated ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+            }
+
+            SQLRETURN getData(SQLUSMALLINT col, SQLSMALLINT type, SQLPOINTER buffer, SQLLEN length, SQLLEN* indicator) {
+                const std::optional<std::wstring>& cell = m_rows.at(m_current).at(col - 1);
+                if (!cell) {
+                    *indicator = SQL_NULL_DATA;
+                    return SQL_SUCCESS;
+                }
+                if (type == SQL_C_SBIGINT || type == SQL_C_DOUBLE) {
+                    // Like many drivers, ignores the buffer length and returns the whole value on every call.
+                    if (type == SQL_C_SBIGINT) {
+                        const SQLBIGINT value = std::stoll(*cell);
+                        std::memcpy(buffer, &value, sizeof(value));
+                    } else {
+                        const SQLDOUBLE value = std::stod(*cell);
+                        std::memcpy(buffer, &value, sizeof(value));
+                    }
+                    *indicator = 8;
+                    return SQL_SUCCESS;
+                }
+                std::vector<unsigned char> bytes;
+                if (type == SQL_C_CHAR) {
+                    std::transform(cell->begin(), cell->end(), std::back_inserter(bytes),
+                                   [](wchar_t c) { return static_cast<unsigned char>(c); });
+                } else {
+                    const SqlWString units = toSqlWide(*cell);
+                    const unsigned char* data = reinterpret_cast<const unsigned char*>(units.data());
+                    bytes.assign(data, data + units.size() * sizeof(SQLWCHAR));
+                }
+                size_t& offset = m_readOffsets[col];
+                if (offset > 0 && offset == bytes.size()) {
+                    return SQL_NO_DATA;
+                }
+                const size_t terminator = type == SQL_C_CHAR ? 1 : sizeof(SQLWCHAR);
+                const size_t remaining = bytes.size() - offset;
+                const size_t count = std::min(remaining, static_cast<size_t>(length) - terminator);
+                unsigned char* target = static_cast<unsigned char*>(buffer);
+                std::memcpy(target, bytes.data() + offset, count);
+                std::memset(target + count, 0, terminator);
+                *indicator = static_cast<SQLLEN>(remaining);
+                offset += count;
+                return count < remaining ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+            }
+
+            SQLULEN columnSize(SQLUSMALLINT col, SQLSMALLINT type) const {
+                auto it = m_columnSizes.find(col);
+                if (it != m_columnSizes.end()) {
+                    return it->second;
+                }
+                if (type != SQL_CHAR && type != SQL_VARCHAR && type != SQL_WCHAR && type != SQL_WVARCHAR) {
+                    return 0;
+                }
+                size_t longest = 64;
+                for (const Row& row : m_rows) {
+                    if (row.at(col - 1)) {
+                        longest = std::max(longest, toSqlWide(*row.at(col - 1)).size());
+                    }
+                }
+                return longest;
+            }
+
+        public:
+            /**
+             * @brief Installs the fake driver behaviour on a mock.
+             *
+             * @param mock The mock whose block cursor entry points are emulated.
+             * @param rows The rows to serve.
+             * @param sqlTypes The SQL type of each column reported by SQLDescribeCol, if any.
+             */
+            FakeBlockCursor(MockOdbcInterface& mock, std::vector<Row> rows, std::vector<SQLSMALLINT> sqlTypes = {})
+                : m_rows(std::move(rows)), m_sqlTypes(std::move(sqlTypes)) {
+                ON_CALL(mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER) {
+                        if (attribute == SQL_ATTR_ROW_ARRAY_SIZE) {
+                            m_rowArraySize = reinterpret_cast<SQLULEN>(value);
+                        } else if (attribute == SQL_ATTR_ROWS_FETCHED_PTR) {
+                            m_rowsFetched = static_cast<SQLULEN*>(value);
+                        }
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLUSMALLINT col, SQLSMALLINT type, SQLPOINTER buffer, SQLLEN length, SQLLEN* indicators) {
+                        if (buffer) {
+                            m_bindings[col] = Binding{type, buffer, length, indicators};
+                        } else {
+                            m_bindings.erase(col);
+                        }
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLSMALLINT, SQLLEN) { return fetchScroll(); });
+                ON_CALL(mock, SQLGetData(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLUSMALLINT col, SQLSMALLINT type, SQLPOINTER buffer, SQLLEN length, SQLLEN* indicator) {
+                        return getData(col, type, buffer, length, indicator);
+                    });
+                ON_CALL(mock, SQLSetPos(testing::_, testing::_, SQL_POSITION, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLSETPOSIROW row, SQLUSMALLINT, SQLUSMALLINT) {
+                        m_current = m_rowsetStart + row - 1;
+                        m_readOffsets.clear();
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(mock, SQLGetInfo(testing::_, SQL_GETDATA_EXTENSIONS, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHDBC, SQLUSMALLINT, SQLPOINTER value, SQLSMALLINT, SQLSMALLINT*) {
+                        *static_cast<SQLUINTEGER*>(value) = m_getDataExtensions;
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLUSMALLINT col, SQLWCHAR* name, SQLSMALLINT, SQLSMALLINT* nameLength,
+                                          SQLSMALLINT* type, SQLULEN* size, SQLSMALLINT* digits, SQLSMALLINT* nullable) {
+                        if (name && nameLength) {
+                            const std::wstring columnName = L"c" + std::to_wstring(col);
+                            std::copy(columnName.begin(), columnName.end(), name);
+                            name[columnName.size()] = 0;
+                            *nameLength = static_cast<SQLSMALLINT>(columnName.size());
+                        }
+                        *type = m_sqlTypes.empty() ? SQL_WVARCHAR : m_sqlTypes.at(col - 1);
+                        *size = columnSize(col, *type);
+                        *digits = 0;
+                        *nullable = SQL_NULLABLE;
+                        return SQL_SUCCESS;
+                    });
+            }
+
+            /**
+             * @brief Makes SQLDescribeCol report a size for a column, like a driver that misreports or cannot tell it.
+             *
+             * @param col The one-based column number.
+             * @param size The reported column size; 0 for unknown.
+             */
+            void setColumnSize(SQLUSMALLINT col, SQLULEN size) { m_columnSizes[col] = size; }
+
+            /**
+             * @brief Makes SQLGetInfo report a SQL_GETDATA_EXTENSIONS bitmask, such as SQL_GD_BLOCK | SQL_GD_BOUND.
+             */
+            void setGetDataExtensions(SQLUINTEGER extensions) { m_getDataExtensions = extensions; }
+
+            /**
+             * @brief Serves another result set from its first row, as after a new execution.
+             *
+             * @param rows The rows to serve.
+             */
+            void reset(std::vector<Row> rows) {
+                m_rows = std::move(rows);
+                m_position = 0;
+            }
+
+            /**
+             * @brief Makes every following SQLFetchScroll call take at least `latency`, like a network round trip.
+             */
+            void setLatency(std::chrono::milliseconds latency) { m_latency = latency; }
+
+            /**
+             * @brief Retrieves the number of SQLFetchScroll round trips made so far.
+             */
+            int roundTrips() const { return m_roundTrips; }
+
+            /**
+             * @brief Retrieves the most recently requested rowset size.
+             */
+            SQLULEN rowArraySize() const { return m_rowArraySize; }
+
+            /**
+             * @brief Retrieves the number of columns that are currently bound.
+             */
+            size_t boundColumns() const { return m_bindings.size(); }
+        };
+
+        /**
+         * @class FakeLongData
+         * @brief Emulates a driver returning a long value through repeated SQLGetData calls.
+         *
+         * Installs a default action for SQLGetData that serves the value of a column in
+         * buffer-sized pieces, returning SQL_SUCCESS_WITH_INFO while data is left and
+         * SQL_NO_DATA once it has all been returned, as a driver does for long columns.
+         */
+        class FakeLongData {
+        private:
+            std::optional<std::vector<unsigned char>>   m_value; ///< Bytes served, or std::nullopt for NULL.
+            bool                                        m_reportTotal; ///< Whether the remaining length is reported.
+            size_t                                      m_offset = 0; ///< Bytes returned so far.
+            int                                         m_calls = 0; ///< Number of SQLGetData calls.
+
+            SQLRETURN getData(SQLSMALLINT type, SQLPOINTER buffer, SQLLEN length, SQLLEN* indicator) {
+                m_calls++;
+                if (!m_value) {
+                    *indicator = SQL_NULL_DATA;
+                    return SQL_SUCCESS;
+                }
+                if (m_offset > 0 && m_offset == m_value->size()) {
+                    return SQL_NO_DATA;
+                }
+                const size_t terminator = type == SQL_C_WCHAR ? sizeof(SQLWCHAR) : type == SQL_C_CHAR ? 1 : 0;
+                const size_t remaining = m_value->size() - m_offset;
+                const size_t bytes = std::min(remaining, static_cast<size_t>(length) - terminator);
+                unsigned char* target = static_cast<unsigned char*>(buffer);
+                std::memcpy(target, m_value->data() + m_offset, bytes);
+                std::memset(target + bytes, 0, terminator);
+                *indicator = m_reportTotal ? static_cast<SQLLEN>(remaining) : SQL_NO_TOTAL;
+                if (bytes == remaining) {
+                    *indicator = static_cast<SQLLEN>(remaining);
+                }
+                m_offset += bytes;
+                return bytes < remaining ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+            }
+
+        public:
+            /**
+             * @brief Installs the fake driver behaviour on a mock.
+             *
+             * @param mock The mock whose SQLGetData is emulated.
+             * @param value The bytes of the value, or std::nullopt for NULL.
+             * @param reportTotal Whether the remaining length is reported instead of SQL_NO_TOTAL.
+             */
+            FakeLongData(MockOdbcInterface& mock, std::optional<std::vector<unsigned char>> value, bool reportTotal)
+                : m_value(std::move(value)), m_reportTotal(reportTotal) {
+                ON_CALL(mock, SQLGetData(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT type, SQLPOINTER buffer, SQLLEN length, SQLLEN* indicator) {
+                        return getData(type, buffer, length, indicator);
+                    });
+            }
+
+            /**
+             * @brief Encodes a wide string as the SQLWCHAR bytes a driver returns for SQL_C_WCHAR.
+             */
+            static std::vector<unsigned char> wide(const std::wstring& text) {
+                const SqlWString units = toSqlWide(text);
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(units.data());
+                return std::vector<unsigned char>(bytes, bytes + units.size() * sizeof(SQLWCHAR));
+            }
+
+            /**
+             * @brief Retrieves the number of SQLGetData calls made so far.
+             */
+            int calls() const { return m_calls; }
+        };
+
+        /**
+         * @class StillExecuting
+         * @brief Mock action emulating a driver running a call asynchronously.
+         *
+         * Returns SQL_STILL_EXECUTING for the first `polls` invocations and `result` from
+         * then on. Copies share their state, so the object can be handed to WillRepeatedly()
+         * and still be asked how often the call was made, from any thread.
+         */
+        class StillExecuting {
+        private:
+            struct State {
+                std::atomic<int> remaining; ///< SQL_STILL_EXECUTING results left to return.
+                std::atomic<int> calls{0}; ///< Number of invocations.
+            };
+
+            std::shared_ptr<State>  m_state; ///< State shared by all copies.
+            SQLRETURN               m_result; ///< Result once the call completes.
+
+        public:
+            /**
+             * @brief Creates the action.
+             *
+             * @param polls The number of SQL_STILL_EXECUTING results before completion.
+             * @param result The result returned once the call completes.
+             */
+            StillExecuting(int polls, SQLRETURN result)
+                : m_state(std::make_shared<State>()), m_result(result) {
+                m_state->remaining = polls;
+            }
+
+            template <typename... Args>
+            SQLRETURN operator()(Args...) const {
+                m_state->calls++;
+                return m_state->remaining-- > 0 ? SQL_STILL_EXECUTING : m_result;
+            }
+
+            /**
+             * @brief Retrieves the number of invocations so far.
+             */
+            int calls() const { return m_state->calls; }
+        };
+
+        /**
+         * @class StatementDiagnostics
+         * @brief Emulates the diagnostic area of statement handles.
+         *
+         * Installs SQLGetDiagRec for statement handles, reporting one record with the given
+         * SQLSTATE while it is posted and SQL_NO_DATA otherwise. As with a driver, a record is
+         * posted by a failing call and discarded by the next call on the handle; tests wrap
+         * the actions of both kinds of call with posting() and clearing(). Copies share their
+         * state, so actions stay valid on any thread.
+         */
+        class StatementDiagnostics {
+        private:
+            std::shared_ptr<std::atomic<bool>> m_posted; ///< Whether a record is available.
+
+        public:
+            /**
+             * @brief Installs SQLGetDiagRec on the mock.
+             *
+             * @param mock The mock to install the action on.
+             * @param sqlState The SQLSTATE of the record.
+             * @param nativeError The native error code of the record.
+             */
+            StatementDiagnostics(MockOdbcInterface& mock, std::wstring sqlState, SQLINTEGER nativeError)
+                : m_posted(std::make_shared<std::atomic<bool>>(false)) {
+                EXPECT_CALL(mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillRepeatedly([posted = m_posted, sqlState, nativeError](SQLSMALLINT, SQLHANDLE, SQLSMALLINT recNumber, SQLWCHAR* state,
+                                                                               SQLINTEGER* native, SQLWCHAR* messageText, SQLSMALLINT bufferLength,
+                                                                               SQLSMALLINT* textLength) -> SQLRETURN {
+                        if (recNumber > 1 || !*posted) {
+                            return SQL_NO_DATA;
+                        }
+                        copySqlWide(state, sqlState, 6);
+                        *native = nativeError;
+                        copySqlWide(messageText, L"Posted error", bufferLength);
+                        *textLength = static_cast<SQLSMALLINT>(std::wcslen(L"Posted error"));
+                        return SQL_SUCCESS;
+                    });
+            }
+
+            /**
+             * @brief Wraps an action so that an SQL_ERROR result posts the record.
+             */
+            template <typename Action>
+            auto posting(Action action) const {
+                return [posted = m_posted, action](auto... args) -> SQLRETURN {
+                    SQLRETURN ret = action(args...);
+                    *posted = ret == SQL_ERROR;
+                    return ret;
+                };
+            }
+
+            /**
+             * @brief Creates an action that discards the record and returns `result`.
+             */
+            auto clearing(SQLRETURN result) const {
+                return [posted = m_posted, result](auto...) -> SQLRETURN {
+                    *posted = false;
+                    return result;
+                };
+            }
+        };
+
         /**
          * @class OdbcWrapperTest
          * @brief Unit test fixture for testing the OdbcWrapper class.
@@ -90,7 +631,7 @@ namespace ps {
              * @brief Sets up the test environment.
              *
              * This method initializes the mock OdbcInterface and the OdbcWrapper instance.
-             * It also sets default behavior for the SQLGetDiagRec mock method.
+             * It also sets default behavior for the SQLGetDiagRec and SQLMoreResults mock methods.
              */
             void SetUp() override {
                 std::unique_ptr<MockOdbcInterface> t_mock = std::make_unique<MockOdbcInterface>();
@@ -99,21 +640,31 @@ namespace ps {
 
                 // Default behavior for SQLGetDiagRec
                 ON_CALL(*mock, SQLGetDiagRec(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
-                    .WillByDefault([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
+                    .WillByDefault([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT recNumber, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) -> SQLRETURN {
+                        if (recNumber > 1) {
+                            return SQL_NO_DATA; // A single record
+                        }
                         if (state) {
-                            std::wcsncpy(reinterpret_cast<wchar_t*>(state), L"HY000", 6); // Default SQL state
+                            copySqlWide(state, L"HY000", 6); // Default SQL state
                         }
                         if (nativeError) {
                             *nativeError = 12345; // Default error code
                         }
                         if (messageText && bufferLength > 0) {
-                            std::wcsncpy(reinterpret_cast<wchar_t*>(messageText), L"Default error message", bufferLength / sizeof(SQLWCHAR));
+                            copySqlWide(messageText, L"Default error message", bufferLength);
                             if (textLength) {
                                 *textLength = std::wcslen(L"Default error message");
                             }
                         }
                         return SQL_SUCCESS;
                     });
+                // handleError() reads records until SQL_NO_DATA, beyond the record tests set expectations for
+                EXPECT_CALL(*mock, SQLGetDiagRec(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .Times(testing::AnyNumber());
+
+                // Default behavior for SQLMoreResults: a single result
+                ON_CALL(*mock, SQLMoreResults(testing::_))
+                    .WillByDefault(testing::Return(SQL_NO_DATA));
             }
 
             /**
@@ -129,6 +680,60 @@ namespace ps {
             std::unique_ptr<OdbcWrapper> wrapper; ///< The OdbcWrapper instance under test.
             MockOdbcInterface* mock; ///< Non-owning pointer to the mock OdbcInterface for setting expectations.
         };
+
+        /**
+         * @class ConnectedOdbcWrapperTest
+         * @brief Fixture whose wrapper is connected before each test.
+         *
+         * Accepts any number of connects, disconnects, handle frees and SQLFreeStmt calls, so
+         * suites only set the expectations their tests are about. Statement handles are
+         * numbered from 1 in allocation order; the wrapper's own statement is handle 1.
+         */
+        class ConnectedOdbcWrapperTest : public OdbcWrapperTest {
+        protected:
+            void SetUp() override {
+                OdbcWrapperTest::SetUp();
+
+                EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+                EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                    .WillRepeatedly([this](SQLSMALLINT, SQLHANDLE, SQLHANDLE* stmtHandle) {
+                        *stmtHandle = reinterpret_cast<SQLHANDLE>(++nextHandle);
+                        allocations++;
+                        return SQL_SUCCESS;
+                    });
+                EXPECT_CALL(*mock, SQLDisconnect(testing::_))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+                EXPECT_CALL(*mock, SQLFreeHandle(testing::_, testing::_)).Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLFreeStmt(testing::_, testing::_))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+                wrapper->connect(L"MyDSN", L"user", L"pass"); // Takes statement handle 1
+            }
+
+            /**
+             * @brief Accepts the calls of a block cursor fetch over a result set of `columns` columns.
+             *
+             * Pair it with a FakeBlockCursor, which supplies the rows and column descriptions.
+             */
+            void expectBlockCursor(SQLSMALLINT columns) {
+                EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                    .WillRepeatedly([columns](SQLHSTMT, SQLSMALLINT* cols) { *cols = columns; return SQL_SUCCESS; });
+                EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            }
+
+            static SQLHSTMT handle(intptr_t value) { return reinterpret_cast<SQLHSTMT>(value); }
+
+            intptr_t nextHandle = 0; ///< Last statement handle value handed out.
+            int allocations = 0; ///< Statement handles allocated.
+        };
     }
 }
 
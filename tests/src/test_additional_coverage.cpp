@@ -97,13 +97,13 @@ namespace ps {
             EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
                 .WillOnce([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
                     if (state) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(state), L"HY000", 6);
+                        copySqlWide(state, L"HY000", 6);
                     }
                     if (nativeError) {
                         *nativeError = 12345;
                     }
                     if (messageText && bufferLength > 0) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(messageText), L"Update failed", bufferLength / sizeof(SQLWCHAR));
+                        copySqlWide(messageText, L"Update failed", bufferLength);
                         if (textLength) {
                             *textLength = std::wcslen(L"Update failed");
                         }
@@ -221,13 +221,13 @@ namespace ps {
             EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_DBC, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
                 .WillOnce([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
                     if (state) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(state), L"01000", 6);
+                        copySqlWide(state, L"01000", 6);
                     }
                     if (nativeError) {
                         *nativeError = 0;
                     }
                     if (messageText && bufferLength > 0) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(messageText), L"Connection succeeded with info", bufferLength / sizeof(SQLWCHAR));
+                        copySqlWide(messageText, L"Connection succeeded with info", bufferLength);
                         if (textLength) {
                             *textLength = std::wcslen(L"Connection succeeded with info");
                         }
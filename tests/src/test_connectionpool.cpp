@@ -0,0 +1,312 @@
+#include <test_odbcwrapper.h>
+#include <odbccpp/connectionpool.h>
+#include <odbclogger.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using ps::odbc::ConnectionPool;
+using ps::odbc::OdbcLogger;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class ConnectionPoolTest
+         * @brief Fixture whose pool connections are backed by permissive mocks sharing counters.
+         */
+        class ConnectionPoolTest : public ::testing::Test {
+        protected:
+            std::atomic<int>        envAllocs{0}; ///< Environment handles allocated.
+            std::atomic<int>        envFrees{0}; ///< Environment handles freed.
+            std::atomic<int>        connects{0}; ///< Successful SQLConnect calls.
+            std::atomic<int>        disconnects{0}; ///< SQLDisconnect calls.
+            std::atomic<int>        rollbacks{0}; ///< SQLEndTran calls rolling back.
+            std::atomic<bool>       reportDead{false}; ///< Makes SQL_ATTR_CONNECTION_DEAD report dead connections.
+            std::atomic<bool>       failConnect{false}; ///< Makes SQLConnect fail.
+            std::atomic<intptr_t>   nextHandle{0x100}; ///< Last handle value handed out.
+
+            /**
+             * @brief Creates a mock ODBC interface that records its calls in the fixture counters.
+             */
+            std::unique_ptr<odbc::OdbcInterface> makeInterface() {
+                auto mock = std::make_unique<testing::NiceMock<MockOdbcInterface>>();
+                ON_CALL(*mock, SQLAllocHandle(testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLSMALLINT type, SQLHANDLE, SQLHANDLE* handle) {
+                        if (type == SQL_HANDLE_ENV) {
+                            envAllocs++;
+                        }
+                        *handle = reinterpret_cast<SQLHANDLE>(nextHandle++);
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLFreeHandle(testing::_, testing::_))
+                    .WillByDefault([this](SQLSMALLINT type, SQLHANDLE) {
+                        if (type == SQL_HANDLE_ENV) {
+                            envFrees++;
+                        }
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLConnect(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHDBC, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT) {
+                        if (failConnect) {
+                            return SQL_ERROR;
+                        }
+                        connects++;
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLDisconnect(testing::_))
+                    .WillByDefault([this](SQLHDBC) {
+                        disconnects++;
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLGetConnectAttr(testing::_, SQL_ATTR_CONNECTION_DEAD, testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLHDBC, SQLINTEGER, SQLPOINTER value, SQLINTEGER, SQLINTEGER*) {
+                        *static_cast<SQLUINTEGER*>(value) = reportDead ? SQL_CD_TRUE : SQL_CD_FALSE;
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK))
+                    .WillByDefault([this](SQLSMALLINT, SQLHANDLE, SQLSMALLINT) {
+                        rollbacks++;
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLGetDiagRec(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault(testing::Return(SQL_NO_DATA));
+                return mock;
+            }
+
+            /**
+             * @brief Creates a pool whose connections use makeInterface().
+             */
+            std::unique_ptr<ConnectionPool> makePool(ConnectionPool::Config config) {
+                return std::make_unique<ConnectionPool>(L"MyDSN", L"user", L"pass", config,
+                                                        [this]() { return makeInterface(); });
+            }
+        };
+
+        /**
+         * @test Acquire_ReusesWarmConnection
+         * @brief Tests that a released connection is handed out again without reconnecting.
+         */
+        TEST_F(ConnectionPoolTest, Acquire_ReusesWarmConnection) {
+            OdbcLogger::logInfo("Entering Acquire_ReusesWarmConnection");
+
+            ConnectionPool::Config config;
+            config.minSize = 1;
+            config.maxSize = 2;
+            auto pool = makePool(config);
+            EXPECT_EQ(connects, 1);
+
+            odbc::OdbcWrapper* first = nullptr;
+            {
+                auto lease = pool->acquire();
+                ASSERT_TRUE(lease);
+                EXPECT_TRUE(lease->isConnected());
+                first = lease.get();
+                EXPECT_EQ(pool->idleCount(), 0u);
+            }
+
+            auto again = pool->acquire();
+            EXPECT_EQ(again.get(), first);
+            EXPECT_EQ(connects, 1);
+            EXPECT_EQ(pool->size(), 1u);
+
+            OdbcLogger::logInfo("Exiting Acquire_ReusesWarmConnection");
+        }
+
+        /**
+         * @test Acquire_SharesOneEnvironment
+         * @brief Tests that every pooled connection uses the pool's environment and none frees it.
+         */
+        TEST_F(ConnectionPoolTest, Acquire_SharesOneEnvironment) {
+            ConnectionPool::Config config;
+            config.minSize = 0;
+            config.maxSize = 3;
+            {
+                auto pool = makePool(config);
+                auto a = pool->acquire();
+                auto b = pool->acquire();
+                auto c = pool->acquire();
+                EXPECT_EQ(pool->size(), 3u);
+                EXPECT_EQ(a->getHEnv(), c->getHEnv());
+            }
+
+            EXPECT_EQ(envAllocs, 1);
+            EXPECT_EQ(envFrees, 1);
+            EXPECT_EQ(disconnects, 3);
+        }
+
+        /**
+         * @test Acquire_TimesOutWhenExhausted
+         * @brief Tests that acquire throws once maxSize connections are leased and none is returned.
+         */
+        TEST_F(ConnectionPoolTest, Acquire_TimesOutWhenExhausted) {
+            ConnectionPool::Config config;
+            config.maxSize = 1;
+            config.acquireTimeout = std::chrono::milliseconds(20);
+            auto pool = makePool(config);
+
+            auto held = pool->acquire();
+            EXPECT_THROW(pool->acquire(), std::runtime_error);
+            EXPECT_EQ(pool->size(), 1u);
+        }
+
+        /**
+         * @test Acquire_WaitsForRelease
+         * @brief Tests that a blocked acquire is woken by a connection being returned.
+         */
+        TEST_F(ConnectionPoolTest, Acquire_WaitsForRelease) {
+            ConnectionPool::Config config;
+            config.maxSize = 1;
+            config.acquireTimeout = std::chrono::seconds(10);
+            auto pool = makePool(config);
+
+            auto held = pool->acquire();
+            odbc::OdbcWrapper* connection = held.get();
+            odbc::OdbcWrapper* received = nullptr;
+            std::thread waiter([&]() {
+                auto lease = pool->acquire();
+                received = lease.get();
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            held.release();
+            waiter.join();
+
+            EXPECT_EQ(received, connection);
+            EXPECT_EQ(connects, 1);
+        }
+
+        /**
+         * @test Acquire_ReplacesDeadConnection
+         * @brief Tests that checkout validation discards a connection the driver reports as dead.
+         */
+        TEST_F(ConnectionPoolTest, Acquire_ReplacesDeadConnection) {
+            ConnectionPool::Config config;
+            config.minSize = 1;
+            config.maxSize = 1;
+            auto pool = makePool(config);
+
+            reportDead = true;
+            auto lease = pool->acquire();
+            reportDead = false;
+
+            EXPECT_EQ(connects, 2);
+            EXPECT_EQ(disconnects, 1);
+            EXPECT_EQ(pool->size(), 1u);
+        }
+
+        /**
+         * @test EvictIdle_ClosesExpiredConnectionsAboveMin
+         * @brief Tests that idle eviction keeps minSize connections open.
+         */
+        TEST_F(ConnectionPoolTest, EvictIdle_ClosesExpiredConnectionsAboveMin) {
+            ConnectionPool::Config config;
+            config.minSize = 1;
+            config.maxSize = 3;
+            config.idleTimeout = std::chrono::milliseconds(1);
+            auto pool = makePool(config);
+            {
+                auto a = pool->acquire();
+                auto b = pool->acquire();
+                auto c = pool->acquire();
+            }
+            EXPECT_EQ(pool->idleCount(), 3u);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            EXPECT_EQ(pool->evictIdle(), 2u);
+            EXPECT_EQ(pool->size(), 1u);
+            EXPECT_EQ(pool->idleCount(), 1u);
+            EXPECT_EQ(disconnects, 2);
+        }
+
+        /**
+         * @test Release_DiscardsDisconnectedConnection
+         * @brief Tests that a connection disconnected by its user is not returned to the idle list.
+         */
+        TEST_F(ConnectionPoolTest, Release_DiscardsDisconnectedConnection) {
+            ConnectionPool::Config config;
+            config.minSize = 1;
+            auto pool = makePool(config);
+            {
+                auto lease = pool->acquire();
+                lease->disconnect();
+            }
+
+            EXPECT_EQ(pool->size(), 0u);
+            EXPECT_EQ(pool->idleCount(), 0u);
+        }
+
+        /**
+         * @test Release_RollsBackOpenTransaction
+         * @brief Tests that a connection returned in the middle of a transaction is rolled back before reuse.
+         */
+        TEST_F(ConnectionPoolTest, Release_RollsBackOpenTransaction) {
+            ConnectionPool::Config config;
+            config.minSize = 1;
+            config.maxSize = 1;
+            auto pool = makePool(config);
+            {
+                auto lease = pool->acquire();
+                ASSERT_TRUE(lease->beginTransaction());
+            }
+
+            EXPECT_EQ(rollbacks, 1);
+            EXPECT_EQ(pool->idleCount(), 1u);
+            auto lease = pool->acquire();
+            EXPECT_FALSE(lease->inTransaction());
+        }
+
+        /**
+         * @test Constructor_ThrowsWhenConnectFails
+         * @brief Tests that a failing initial connection throws and releases the environment.
+         */
+        TEST_F(ConnectionPoolTest, Constructor_ThrowsWhenConnectFails) {
+            failConnect = true;
+            ConnectionPool::Config config;
+            config.minSize = 2;
+
+            EXPECT_THROW(makePool(config), std::runtime_error);
+            EXPECT_EQ(envFrees, 1);
+        }
+
+        /**
+         * @test Acquire_ConcurrentCheckoutsStayWithinMax
+         * @brief Tests that concurrent checkouts never exceed maxSize and never share a connection.
+         */
+        TEST_F(ConnectionPoolTest, Acquire_ConcurrentCheckoutsStayWithinMax) {
+            ConnectionPool::Config config;
+            config.minSize = 1;
+            config.maxSize = 4;
+            auto pool = makePool(config);
+
+            std::atomic<int> leased{0};
+            std::atomic<int> peak{0};
+            std::vector<std::thread> workers;
+            for (int t = 0; t < 8; t++) {
+                workers.emplace_back([&]() {
+                    for (int i = 0; i < 200; i++) {
+                        auto lease = pool->acquire();
+                        int now = ++leased;
+                        int seen = peak.load();
+                        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                        }
+                        --leased;
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            EXPECT_LE(peak, 4);
+            EXPECT_LE(pool->size(), 4u);
+            EXPECT_EQ(pool->idleCount(), pool->size());
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_connectionpool_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
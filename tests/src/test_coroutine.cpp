@@ -0,0 +1,205 @@
+#include <test_odbcwrapper.h>
+#include <odbccpp/odbccoroutine.h>
+#include <odbclogger.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+using ps::odbc::OdbcLogger;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class RunQueue
+         * @brief Single-threaded executor: posted work runs on the thread calling runUntil().
+         */
+        class RunQueue {
+        private:
+            std::mutex                          m_mutex; ///< Guards the queue.
+            std::condition_variable             m_ready; ///< Signalled when work is posted.
+            std::deque<std::function<void()>>   m_work; ///< Posted work, oldest first.
+            size_t                              m_posted = 0; ///< Number of items ever posted.
+
+        public:
+            /**
+             * @brief Returns an executor posting to this queue.
+             */
+            CoroutineExecutor executor() {
+                return [this](std::function<void()> work) {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_work.push_back(std::move(work));
+                        m_posted++;
+                    }
+                    m_ready.notify_one();
+                };
+            }
+
+            /**
+             * @brief Runs posted work until `done` holds, failing after a generous timeout.
+             */
+            void runUntil(const std::function<bool()>& done) {
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                while (!done()) {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    if (!m_ready.wait_until(lock, deadline, [this] { return !m_work.empty(); })) {
+                        FAIL() << "Timed out waiting for posted work";
+                    }
+                    std::function<void()> work = std::move(m_work.front());
+                    m_work.pop_front();
+                    lock.unlock();
+                    work();
+                }
+            }
+
+            /**
+             * @brief Retrieves the number of items posted so far.
+             */
+            size_t posted() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_posted;
+            }
+        };
+
+        /**
+         * @class CoroutineTest
+         * @brief Fixture that connects the wrapper, hands out distinct statement handles and runs coroutines.
+         */
+        class CoroutineTest : public ConnectedOdbcWrapperTest {
+        protected:
+            void SetUp() override {
+                ConnectedOdbcWrapperTest::SetUp();
+
+                EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+                connection = std::make_unique<CoroutineConnection>(*wrapper, queue.executor());
+            }
+
+            void TearDown() override {
+                connection.reset();
+                ConnectedOdbcWrapperTest::TearDown();
+            }
+
+            RunQueue queue; ///< Executor the coroutines run on.
+            std::unique_ptr<CoroutineConnection> connection; ///< Connection under test.
+        };
+
+        /**
+         * @test Query_StreamsRowsAcrossRowsets
+         * @brief Tests that a query suspends while executing and streams its rows rowset by rowset.
+         */
+        TEST_F(CoroutineTest, Query_StreamsRowsAcrossRowsets) {
+            OdbcLogger::logInfo("Entering Query_StreamsRowsAcrossRowsets");
+
+            FakeBlockCursor fake(*mock, {{L"1"}, {L"2"}, {L"3"}, {L"4"}, {L"5"}});
+            StillExecuting execution(3, SQL_SUCCESS);
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillRepeatedly(execution);
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+
+            std::vector<std::wstring> seen;
+            bool finished = false;
+            spawn(connection->executor(), [](CoroutineConnection& conn, std::vector<std::wstring>& seen, bool& finished) -> Task<> {
+                RowStream rows = co_await conn.query(L"SELECT id FROM orders", 2);
+                while (co_await rows.next()) {
+                    seen.push_back(rows.row()[0]);
+                }
+                finished = true;
+            }(*connection, seen, finished));
+            queue.runUntil([&finished] { return finished; });
+
+            EXPECT_EQ(seen, (std::vector<std::wstring>{L"1", L"2", L"3", L"4", L"5"}));
+            EXPECT_EQ(execution.calls(), 4);
+            EXPECT_EQ(fake.roundTrips(), 4); // Three rowsets and the final SQL_NO_DATA
+            EXPECT_GE(queue.posted(), 2u); // The start and at least the resumption after SQL_STILL_EXECUTING
+
+            OdbcLogger::logInfo("Exiting Query_StreamsRowsAcrossRowsets");
+        }
+
+        /**
+         * @test Query_FailureThrowsInCoroutine
+         * @brief Tests that an error reported after polling is thrown from co_await.
+         */
+        TEST_F(CoroutineTest, Query_FailureThrowsInCoroutine) {
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillRepeatedly(StillExecuting(2, SQL_ERROR));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AtLeast(1));
+
+            bool threw = false;
+            bool finished = false;
+            spawn(connection->executor(), [](CoroutineConnection& conn, bool& threw, bool& finished) -> Task<> {
+                try {
+                    co_await conn.query(L"SELECT * FROM missing_table");
+                } catch (const std::runtime_error&) {
+                    threw = true;
+                }
+                finished = true;
+            }(*connection, threw, finished));
+            queue.runUntil([&finished] { return finished; });
+
+            EXPECT_TRUE(threw);
+        }
+
+        /**
+         * @test Execute_ReturnsRowCountWithoutSuspending
+         * @brief Tests that a call completing immediately continues the coroutine without a round trip through the executor.
+         */
+        TEST_F(CoroutineTest, Execute_ReturnsRowCountWithoutSuspending) {
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLRowCount(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLLEN* count) { *count = 7; return SQL_SUCCESS; });
+
+            SQLLEN affected = -1;
+            spawn(connection->executor(), [](CoroutineConnection& conn, SQLLEN& affected) -> Task<> {
+                affected = co_await conn.execute(L"UPDATE orders SET shipped = 1 WHERE batch = 3");
+            }(*connection, affected));
+            queue.runUntil([&affected] { return affected != -1; });
+
+            EXPECT_EQ(affected, 7);
+            EXPECT_EQ(queue.posted(), 1u); // Only the start
+        }
+
+        /**
+         * @test Query_ManyInFlightOnOneConnection
+         * @brief Tests that many queries on one connection are in flight at once and all complete.
+         */
+        TEST_F(CoroutineTest, Query_ManyInFlightOnOneConnection) {
+            constexpr int QUERIES = 50;
+            FakeBlockCursor fake(*mock, {});
+            std::mutex pollsMutex;
+            std::map<SQLHSTMT, int> polls; // Every statement is still executing for its first three calls
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .WillRepeatedly([&pollsMutex, &polls](SQLHSTMT hStmt, SQLWCHAR*, SQLINTEGER) {
+                    std::lock_guard<std::mutex> lock(pollsMutex);
+                    return polls[hStmt]++ < 3 ? SQL_STILL_EXECUTING : SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillRepeatedly([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+
+            int completed = 0;
+            for (int i = 0; i < QUERIES; i++) {
+                spawn(connection->executor(), [](CoroutineConnection& conn, int& completed) -> Task<> {
+                    RowStream rows = co_await conn.query(L"SELECT id FROM sessions");
+                    while (co_await rows.next()) {
+                    }
+                    completed++;
+                }(*connection, completed));
+            }
+            queue.runUntil([&completed] { return completed == QUERIES; });
+
+            EXPECT_EQ(completed, QUERIES);
+            EXPECT_EQ(nextHandle, QUERIES + 1); // One handle per query in flight at the same time
+            EXPECT_EQ(wrapper->freeStatementCount(), OdbcWrapper::MAX_FREE_STATEMENTS);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_coroutine_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
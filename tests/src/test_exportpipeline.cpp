@@ -0,0 +1,298 @@
+#include <test_odbcwrapper.h>
+#include <odbccpp/spscqueue.h>
+#include <odbclogger.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using ps::odbc::ExportFormat;
+using ps::odbc::ExportOptions;
+using ps::odbc::ExportStats;
+using ps::odbc::OdbcException;
+using ps::odbc::OdbcLogger;
+using ps::odbc::SpscQueue;
+
+namespace ps {
+    namespace test {
+        /**
+         * @brief Reads a whole file as bytes.
+         */
+        std::string readFile(const std::string& path) {
+            std::ifstream file(path, std::ios::binary);
+            std::ostringstream content;
+            content << file.rdbuf();
+            return content.str();
+        }
+
+        /**
+         * @class ExportPipelineTest
+         * @brief Fixture that connects the wrapper so exportTo() reads the rows of a fake block cursor.
+         */
+        class ExportPipelineTest : public ConnectedOdbcWrapperTest {
+        protected:
+            std::string path; ///< Export file in the working directory, removed after the test.
+
+            void SetUp() override {
+                ConnectedOdbcWrapperTest::SetUp();
+                expectBlockCursor(2);
+
+                path = std::string("test_exportpipeline_")
+                     + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".out";
+            }
+
+            void TearDown() override {
+                std::remove(path.c_str());
+            }
+        };
+
+        /**
+         * @test Queue_PassesElementsInOrderBetweenThreads
+         * @brief Tests that the queue rounds its capacity up, reports full and empty, and keeps order between two threads.
+         */
+        TEST(SpscQueueTest, Queue_PassesElementsInOrderBetweenThreads) {
+            OdbcLogger::logInfo("Entering Queue_PassesElementsInOrderBetweenThreads");
+
+            SpscQueue<int> queue(3);
+            EXPECT_EQ(queue.capacity(), 4u);
+            for (int i = 0; i < 4; i++) {
+                EXPECT_TRUE(queue.tryPush(i));
+            }
+            int value = 99;
+            EXPECT_FALSE(queue.tryPush(value)); // Full
+            for (int i = 0; i < 4; i++) {
+                ASSERT_TRUE(queue.tryPop(value));
+                EXPECT_EQ(value, i);
+            }
+            EXPECT_FALSE(queue.tryPop(value)); // Empty
+
+            const int count = 100000;
+            std::thread producer([&queue]() {
+                for (int i = 0; i < count; i++) {
+                    int next = i;
+                    while (!queue.tryPush(next)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            bool ordered = true;
+            for (int expected = 0; expected < count; expected++) {
+                while (!queue.tryPop(value)) {
+                    std::this_thread::yield();
+                }
+                ordered = ordered && value == expected;
+            }
+            producer.join();
+            EXPECT_TRUE(ordered);
+
+            OdbcLogger::logInfo("Exiting Queue_PassesElementsInOrderBetweenThreads");
+        }
+
+        /**
+         * @test ExportTo_WritesCsvWithHeaderAndQuoting
+         * @brief Tests that CSV export writes a header, quotes special cells, transcodes to UTF-8 and leaves no temporary file.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_WritesCsvWithHeaderAndQuoting) {
+            OdbcLogger::logInfo("Entering ExportTo_WritesCsvWithHeaderAndQuoting");
+
+            FakeBlockCursor fake(*mock, {{L"1", L"plain"}, {L"2", L"a,\"b\""}, {L"3", L""}, {std::nullopt, L"line\nbreak"},
+                                         {L"5", L"café"}}, {SQL_VARCHAR, SQL_VARCHAR});
+            ExportOptions options;
+            options.rowsetSize = 2;
+
+            ExportStats stats = wrapper->exportTo(path, ExportFormat::Csv, options);
+            const std::string expected = "c1,c2\n1,plain\n2,\"a,\"\"b\"\"\"\n3,\"\"\n,\"line\nbreak\"\n5,caf\xC3\xA9\n";
+            EXPECT_EQ(readFile(path), expected);
+            EXPECT_EQ(stats.rows, 5u);
+            EXPECT_EQ(stats.bytes, expected.size());
+            EXPECT_EQ(fake.roundTrips(), 4);
+            EXPECT_EQ(fake.boundColumns(), 0u);
+            EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+
+            OdbcLogger::logInfo("Exiting ExportTo_WritesCsvWithHeaderAndQuoting");
+        }
+
+        /**
+         * @test ExportTo_WritesTsvWithEscapes
+         * @brief Tests that TSV export escapes tabs, line breaks and backslashes and writes NULL as \\N.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_WritesTsvWithEscapes) {
+            OdbcLogger::logInfo("Entering ExportTo_WritesTsvWithEscapes");
+
+            FakeBlockCursor fake(*mock, {{L"a\tb", std::nullopt}, {L"back\\slash", L"cr\rlf\n"}});
+            ExportOptions options;
+            options.header = false;
+
+            ExportStats stats = wrapper->exportTo(path, ExportFormat::Tsv, options);
+            EXPECT_EQ(readFile(path), "a\\tb\t\\N\nback\\\\slash\tcr\\rlf\\n\n");
+            EXPECT_EQ(stats.rows, 2u);
+
+            OdbcLogger::logInfo("Exiting ExportTo_WritesTsvWithEscapes");
+        }
+
+        /**
+         * @test ExportTo_WritesBinaryRows
+         * @brief Tests that binary export writes the header, column names, NULL flags and LEB128 lengths.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_WritesBinaryRows) {
+            OdbcLogger::logInfo("Entering ExportTo_WritesBinaryRows");
+
+            FakeBlockCursor fake(*mock, {{L"7", std::nullopt}, {L"", std::wstring(200, L'x')}}, {SQL_BIGINT, SQL_VARCHAR});
+            ExportOptions options;
+            options.rowsetSize = 1;
+
+            wrapper->exportTo(path, ExportFormat::Binary, options);
+            std::string expected("ODBX\x01\x02\x00", 7);
+            expected += std::string("\x02\x00" "c1" "\x02\x00" "c2", 8);
+            expected += std::string("\x02" "\x01" "7", 3); // Second cell NULL
+            expected += std::string("\x00" "\x00" "\xC8\x01", 4) + std::string(200, 'x'); // Empty string, then LEB128 200
+            EXPECT_EQ(readFile(path), expected);
+
+            OdbcLogger::logInfo("Exiting ExportTo_WritesBinaryRows");
+        }
+
+        /**
+         * @test ExportTo_WritesManyBlocks
+         * @brief Tests that an export spanning many aligned blocks and rowsets is written completely and in order.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_WritesManyBlocks) {
+            OdbcLogger::logInfo("Entering ExportTo_WritesManyBlocks");
+
+            std::vector<FakeBlockCursor::Row> rows;
+            std::string expected;
+            for (int i = 0; i < 5000; i++) {
+                rows.push_back({std::to_wstring(i), L"row " + std::to_wstring(i * 7)});
+                expected += std::to_string(i) + ",row " + std::to_string(i * 7) + "\n";
+            }
+            FakeBlockCursor fake(*mock, rows);
+            ExportOptions options;
+            options.header = false;
+            options.rowsetSize = 64;
+            options.blockBytes = 1; // Rounded up to one 4096 byte block
+
+            ExportStats stats = wrapper->exportTo(path, ExportFormat::Csv, options);
+            EXPECT_GT(expected.size(), 16u * 4096);
+            EXPECT_EQ(readFile(path), expected);
+            EXPECT_EQ(stats.rows, 5000u);
+            EXPECT_EQ(stats.bytes, expected.size());
+
+            OdbcLogger::logInfo("Exiting ExportTo_WritesManyBlocks");
+        }
+
+        /**
+         * @test ExportTo_WritesLongValuesWhole
+         * @brief Tests that a column of unknown size is exported whole rather than cut at the bound cell size.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_WritesLongValuesWhole) {
+            OdbcLogger::logInfo("Entering ExportTo_WritesLongValuesWhole");
+
+            const std::wstring document(10000, L'd');
+            FakeBlockCursor fake(*mock, {{L"1", document}, {L"2", std::nullopt}, {L"3", L"short"}}, {SQL_INTEGER, SQL_WLONGVARCHAR});
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 2, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AtLeast(3));
+            ExportOptions options;
+            options.header = false;
+
+            ExportStats stats = wrapper->exportTo(path, ExportFormat::Csv, options);
+            EXPECT_EQ(readFile(path), "1," + std::string(10000, 'd') + "\n2,\n3,short\n");
+            EXPECT_EQ(stats.rows, 3u);
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            OdbcLogger::logInfo("Exiting ExportTo_WritesLongValuesWhole");
+        }
+
+        /**
+         * @test ExportTo_FailsOnTruncatedValues
+         * @brief Tests that a value longer than its described column size fails the export instead of being written cut short.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_FailsOnTruncatedValues) {
+            OdbcLogger::logInfo("Entering ExportTo_FailsOnTruncatedValues");
+
+            FakeBlockCursor fake(*mock, {{L"1", L"fits"}, {L"2", L"much longer than described"}});
+            fake.setColumnSize(2, 8);
+
+            EXPECT_THROW(wrapper->exportTo(path, ExportFormat::Csv), std::runtime_error);
+            EXPECT_FALSE(std::ifstream(path).good());
+            EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            OdbcLogger::logInfo("Exiting ExportTo_FailsOnTruncatedValues");
+        }
+
+        /**
+         * @test ExportTo_ReplacesAnExistingFile
+         * @brief Tests that exporting to the path of an earlier export replaces its file.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_ReplacesAnExistingFile) {
+            OdbcLogger::logInfo("Entering ExportTo_ReplacesAnExistingFile");
+
+            ExportOptions options;
+            options.header = false;
+            FakeBlockCursor first(*mock, {{L"1", L"old"}, {L"2", L"old"}});
+            wrapper->exportTo(path, ExportFormat::Csv, options);
+            EXPECT_EQ(readFile(path), "1,old\n2,old\n");
+
+            FakeBlockCursor second(*mock, {{L"3", L"new"}});
+            ExportStats stats = wrapper->exportTo(path, ExportFormat::Csv, options);
+            EXPECT_EQ(readFile(path), "3,new\n");
+            EXPECT_EQ(stats.rows, 1u);
+            EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+
+            OdbcLogger::logInfo("Exiting ExportTo_ReplacesAnExistingFile");
+        }
+
+        /**
+         * @test ExportTo_FailsWithoutLeavingAFile
+         * @brief Tests that a failed export throws and leaves neither the file nor its temporary behind.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_FailsWithoutLeavingAFile) {
+            OdbcLogger::logInfo("Entering ExportTo_FailsWithoutLeavingAFile");
+
+            FakeBlockCursor fake(*mock, {{L"1", L"one"}});
+            EXPECT_THROW(wrapper->exportTo("missing-directory/export.csv", ExportFormat::Csv), std::runtime_error);
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_THROW(wrapper->exportTo(path, ExportFormat::Csv), OdbcException);
+            EXPECT_FALSE(std::ifstream(path).good());
+            EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            wrapper->disconnect();
+            ExportStats stats = wrapper->exportTo(path, ExportFormat::Csv); // Not connected
+            EXPECT_EQ(stats.rows, 0u);
+            EXPECT_FALSE(std::ifstream(path).good());
+
+            OdbcLogger::logInfo("Exiting ExportTo_FailsWithoutLeavingAFile");
+        }
+
+        /**
+         * @test ExportTo_StopsTheWriterWhenAFetchThrows
+         * @brief Tests that an exception thrown while fetching joins the writer, removes the temporary file and reaches the caller.
+         */
+        TEST_F(ExportPipelineTest, ExportTo_StopsTheWriterWhenAFetchThrows) {
+            OdbcLogger::logInfo("Entering ExportTo_StopsTheWriterWhenAFetchThrows");
+
+            FakeBlockCursor fake(*mock, {{L"1", L"one"}, {L"2", L"two"}, {L"3", L"three"}});
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0))
+                .WillOnce(testing::DoDefault())
+                .WillOnce(testing::Throw(std::bad_alloc()));
+            ExportOptions options;
+            options.rowsetSize = 1;
+
+            EXPECT_THROW(wrapper->exportTo(path, ExportFormat::Csv, options), std::bad_alloc);
+            EXPECT_FALSE(std::ifstream(path).good());
+            EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            OdbcLogger::logInfo("Exiting ExportTo_StopsTheWriterWhenAFetchThrows");
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_exportpipeline_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -180,6 +180,144 @@ namespace ps {
             SQLRETURN ret = executor->SQLRowCount(SQL_NULL_HSTMT, &rowCount);
             EXPECT_FALSE(SQL_SUCCEEDED(ret));
         }
+
+        /**
+         * @test SQLSetStmtAttr_NullHandle
+         * @brief Tests that SQLSetStmtAttr handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLSetStmtAttr_NullHandle) {
+            SQLRETURN ret = executor->SQLSetStmtAttr(SQL_NULL_HSTMT, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)16, 0);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLBindCol_NullHandle
+         * @brief Tests that SQLBindCol handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLBindCol_NullHandle) {
+            SQLWCHAR buffer[256];
+            SQLLEN indicator;
+            SQLRETURN ret = executor->SQLBindCol(SQL_NULL_HSTMT, 1, SQL_C_WCHAR, buffer, sizeof(buffer), &indicator);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLFetchScroll_NullHandle
+         * @brief Tests that SQLFetchScroll handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLFetchScroll_NullHandle) {
+            SQLRETURN ret = executor->SQLFetchScroll(SQL_NULL_HSTMT, SQL_FETCH_NEXT, 0);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLPrepare_NullHandle
+         * @brief Tests that SQLPrepare handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLPrepare_NullHandle) {
+            SQLRETURN ret = executor->SQLPrepare(SQL_NULL_HSTMT, (SQLWCHAR*)L"SELECT 1", SQL_NTS);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLBindParameter_NullHandle
+         * @brief Tests that SQLBindParameter handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLBindParameter_NullHandle) {
+            SQLBIGINT value = 42;
+            SQLLEN indicator = 0;
+            SQLRETURN ret = executor->SQLBindParameter(SQL_NULL_HSTMT, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT,
+                                                       0, 0, &value, 0, &indicator);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLExecute_NullHandle
+         * @brief Tests that SQLExecute handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLExecute_NullHandle) {
+            SQLRETURN ret = executor->SQLExecute(SQL_NULL_HSTMT);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLFreeStmt_NullHandle
+         * @brief Tests that SQLFreeStmt handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLFreeStmt_NullHandle) {
+            SQLRETURN ret = executor->SQLFreeStmt(SQL_NULL_HSTMT, SQL_CLOSE);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLMoreResults_NullHandle
+         * @brief Tests that SQLMoreResults handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLMoreResults_NullHandle) {
+            SQLRETURN ret = executor->SQLMoreResults(SQL_NULL_HSTMT);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLGetConnectAttr_NullHandle
+         * @brief Tests that SQLGetConnectAttr handles NULL connection handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLGetConnectAttr_NullHandle) {
+            SQLUINTEGER dead = SQL_CD_FALSE;
+            SQLRETURN ret = executor->SQLGetConnectAttr(SQL_NULL_HDBC, SQL_ATTR_CONNECTION_DEAD, &dead, 0, nullptr);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLSetConnectAttr_NullHandle
+         * @brief Tests that SQLSetConnectAttr handles NULL connection handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLSetConnectAttr_NullHandle) {
+            SQLRETURN ret = executor->SQLSetConnectAttr(SQL_NULL_HDBC, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLEndTran_NullHandle
+         * @brief Tests that SQLEndTran handles NULL connection handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLEndTran_NullHandle) {
+            SQLRETURN ret = executor->SQLEndTran(SQL_HANDLE_DBC, SQL_NULL_HDBC, SQL_COMMIT);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLDescribeCol_NullHandle
+         * @brief Tests that SQLDescribeCol handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLDescribeCol_NullHandle) {
+            SQLSMALLINT dataType = 0;
+            SQLULEN columnSize = 0;
+            SQLSMALLINT decimalDigits = 0;
+            SQLSMALLINT nullable = 0;
+            SQLRETURN ret = executor->SQLDescribeCol(SQL_NULL_HSTMT, 1, nullptr, 0, nullptr, &dataType, &columnSize,
+                                                     &decimalDigits, &nullable);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLSetPos_NullHandle
+         * @brief Tests that SQLSetPos handles NULL statement handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLSetPos_NullHandle) {
+            SQLRETURN ret = executor->SQLSetPos(SQL_NULL_HSTMT, 1, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
+
+        /**
+         * @test SQLGetInfo_NullHandle
+         * @brief Tests that SQLGetInfo handles NULL connection handles appropriately.
+         */
+        TEST_F(OdbcExecutorTest, SQLGetInfo_NullHandle) {
+            SQLUINTEGER extensions = 0;
+            SQLRETURN ret = executor->SQLGetInfo(SQL_NULL_HDBC, SQL_GETDATA_EXTENSIONS, &extensions, sizeof(extensions), nullptr);
+            EXPECT_FALSE(SQL_SUCCEEDED(ret));
+        }
     }
 }
 
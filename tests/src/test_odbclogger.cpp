@@ -0,0 +1,116 @@
+// Compile trace logging out of this translation unit, as a release build would
+#undef ODBCCPP_LOG_ACTIVE_LEVEL
+#define ODBCCPP_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_DEBUG
+
+#include <odbclogger.h>
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+using ps::odbc::OdbcLogger;
+
+namespace ps {
+    namespace test {
+        /**
+         * @brief Counts the lines of a log file.
+         */
+        static size_t countLines(const std::string& path) {
+            std::ifstream file(path);
+            std::string line;
+            size_t lines = 0;
+            while (std::getline(file, line)) {
+                lines++;
+            }
+            return lines;
+        }
+
+        /**
+         * @class OdbcLoggerTest
+         * @brief Fixture that restores the synchronous logger and runtime level after each test.
+         */
+        class OdbcLoggerTest : public ::testing::Test {
+        protected:
+            void TearDown() override {
+                OdbcLogger::initialize("logs/odbc_logger_test.log");
+            }
+        };
+
+        /**
+         * @test CompileTimeLevel_DropsTraceArguments
+         * @brief Tests that messages below ODBCCPP_LOG_ACTIVE_LEVEL are not even evaluated.
+         */
+        TEST_F(OdbcLoggerTest, CompileTimeLevel_DropsTraceArguments) {
+            int evaluated = 0;
+            auto message = [&evaluated]() {
+                evaluated++;
+                return std::string("message");
+            };
+
+            OdbcLogger::setLevel(spdlog::level::trace);
+            ODBC_LOG_TRACE(message());
+            EXPECT_EQ(evaluated, 0);
+
+            ODBC_LOG_DEBUG(message());
+            EXPECT_EQ(evaluated, 1);
+        }
+
+        /**
+         * @test RuntimeLevel_SkipsMessageConstruction
+         * @brief Tests that compiled-in messages below the runtime level are not built.
+         */
+        TEST_F(OdbcLoggerTest, RuntimeLevel_SkipsMessageConstruction) {
+            int evaluated = 0;
+            auto message = [&evaluated]() {
+                evaluated++;
+                return std::string("message");
+            };
+
+            OdbcLogger::setLevel(spdlog::level::info);
+            ODBC_LOG_DEBUG(message());
+            EXPECT_EQ(evaluated, 0);
+        }
+
+        /**
+         * @test AsyncMode_DrainsQueueOnShutdown
+         * @brief Tests that every queued message reaches the file once the logger is shut down.
+         */
+        TEST_F(OdbcLoggerTest, AsyncMode_DrainsQueueOnShutdown) {
+            const std::string path = "logs/odbc_logger_async_test.log";
+            OdbcLogger::initializeAsync(path, 64, spdlog::async_overflow_policy::block);
+            for (int i = 0; i < 1000; i++) {
+                OdbcLogger::logInfo("message " + std::to_string(i));
+            }
+            OdbcLogger::shutdown();
+
+            EXPECT_EQ(countLines(path), 1000u);
+
+            OdbcLogger::logInfo("after shutdown"); // Falls back to synchronous logging
+            spdlog::default_logger()->flush();
+            EXPECT_EQ(countLines(path), 1001u);
+        }
+
+        /**
+         * @test AsyncMode_OverrunOldestDoesNotBlock
+         * @brief Tests that a full queue drops messages instead of blocking with overrun_oldest.
+         */
+        TEST_F(OdbcLoggerTest, AsyncMode_OverrunOldestDoesNotBlock) {
+            const std::string path = "logs/odbc_logger_overrun_test.log";
+            OdbcLogger::initializeAsync(path, 8, spdlog::async_overflow_policy::overrun_oldest);
+            for (int i = 0; i < 10000; i++) {
+                OdbcLogger::logInfo("message " + std::to_string(i));
+            }
+            OdbcLogger::shutdown();
+
+            size_t lines = countLines(path);
+            EXPECT_GT(lines, 0u);
+            EXPECT_LE(lines, 10000u);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_logger_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
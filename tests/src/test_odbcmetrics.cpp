@@ -0,0 +1,321 @@
+#include <test_odbcwrapper.h>
+#include <odbccpp/meteredodbcinterface.h>
+#include <odbccpp/prometheusexporter.h>
+#include <odbclogger.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using ps::odbc::HistogramSnapshot;
+using ps::odbc::LatencyHistogram;
+using ps::odbc::MeteredOdbcInterface;
+using ps::odbc::MetricsSnapshot;
+using ps::odbc::OdbcException;
+using ps::odbc::OdbcLogger;
+using ps::odbc::OdbcMetrics;
+using ps::odbc::PrometheusExporter;
+using ps::odbc::RetryPolicy;
+using ps::odbc::SqlStateCounters;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class OdbcMetricsTest
+         * @brief Fixture that connects a wrapper over a MeteredOdbcInterface around the mock.
+         */
+        class OdbcMetricsTest : public ::testing::Test {
+        protected:
+            void SetUp() override {
+                auto t_mock = std::make_unique<MockOdbcInterface>();
+                mock = t_mock.get();
+                metrics = std::make_shared<OdbcMetrics>();
+                wrapper = std::make_unique<OdbcWrapper>(std::make_unique<MeteredOdbcInterface>(std::move(t_mock), metrics));
+
+                ON_CALL(*mock, SQLGetDiagRec(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault(testing::Return(SQL_NO_DATA));
+                ON_CALL(*mock, SQLMoreResults(testing::_)).WillByDefault(testing::Return(SQL_NO_DATA));
+                EXPECT_CALL(*mock, SQLGetDiagRec(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+                EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+                EXPECT_CALL(*mock, SQLDisconnect(testing::_)).Times(testing::AnyNumber());
+                EXPECT_CALL(*mock, SQLFreeHandle(testing::_, testing::_)).Times(testing::AnyNumber());
+
+                wrapper->connect(L"MyDSN", L"user", L"pass");
+            }
+
+            void TearDown() override {
+                wrapper.reset();
+                mock = nullptr;
+            }
+
+            MockOdbcInterface*              mock = nullptr; ///< The mock behind the decorator.
+            std::shared_ptr<OdbcMetrics>    metrics; ///< Metrics the decorator records into.
+            std::unique_ptr<OdbcWrapper>    wrapper; ///< Wrapper over the decorator.
+        };
+
+        /**
+         * @test Histogram_ResolvesValuesWithinBucketPrecision
+         * @brief Tests that every value maps to a bucket whose bound is within 1/32 of it, in increasing order.
+         */
+        TEST(LatencyHistogramTest, Histogram_ResolvesValuesWithinBucketPrecision) {
+            size_t previous = 0;
+            for (uint64_t value = 1; value < LatencyHistogram::MAX_VALUE; value = value * 9 / 8 + 1) {
+                const size_t index = LatencyHistogram::bucketIndex(value);
+                ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+                EXPECT_GE(index, previous);
+                EXPECT_GE(LatencyHistogram::bucketUpperBound(index), value);
+                EXPECT_LE(LatencyHistogram::bucketUpperBound(index) - value, value / LatencyHistogram::SUB_BUCKETS);
+                previous = index;
+            }
+            EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+        }
+
+        /**
+         * @test Histogram_ReportsQuantilesAndMax
+         * @brief Tests the quantiles, sum and max of a snapshot.
+         */
+        TEST(LatencyHistogramTest, Histogram_ReportsQuantilesAndMax) {
+            LatencyHistogram histogram;
+            EXPECT_EQ(histogram.snapshot().quantile(0.5), 0u);
+            for (uint64_t micros = 1; micros <= 100; micros++) {
+                histogram.record(micros * 1000);
+            }
+
+            HistogramSnapshot snapshot = histogram.snapshot();
+            EXPECT_EQ(snapshot.count, 100u);
+            EXPECT_EQ(snapshot.sum, 5050000u);
+            EXPECT_EQ(snapshot.max, 100000u);
+            EXPECT_NEAR(static_cast<double>(snapshot.quantile(0.5)), 50000.0, 50000.0 / 32);
+            EXPECT_NEAR(static_cast<double>(snapshot.quantile(0.99)), 99000.0, 99000.0 / 32);
+            EXPECT_EQ(snapshot.quantile(1.0), 100000u);
+            EXPECT_EQ(snapshot.countAtOrBelow(10000), 10u);
+        }
+
+        /**
+         * @test Histogram_CountsConcurrentRecords
+         * @brief Tests that records from several threads are all counted.
+         */
+        TEST(LatencyHistogramTest, Histogram_CountsConcurrentRecords) {
+            LatencyHistogram histogram;
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.emplace_back([&histogram, t]() {
+                    for (uint64_t i = 0; i < 10000; i++) {
+                        histogram.record(i * (t + 1));
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            HistogramSnapshot snapshot = histogram.snapshot();
+            EXPECT_EQ(snapshot.count, 40000u);
+            EXPECT_EQ(snapshot.max, 9999u * 4);
+        }
+
+        /**
+         * @test SqlStateCounters_CountsByStateAndOverflow
+         * @brief Tests counting by state and that states beyond the capacity are counted as "other".
+         */
+        TEST(LatencyHistogramTest, SqlStateCounters_CountsByStateAndOverflow) {
+            SqlStateCounters counters;
+            counters.increment("40001");
+            counters.increment("40001");
+            counters.increment("08S01");
+            for (size_t i = 0; i < SqlStateCounters::CAPACITY; i++) {
+                counters.increment("X" + std::to_string(1000 + i));
+            }
+
+            std::map<std::string, uint64_t> counts = counters.snapshot();
+            EXPECT_EQ(counts["40001"], 2u);
+            EXPECT_EQ(counts["08S01"], 1u);
+            EXPECT_EQ(counts["other"], 2u); // Two of the new states found the table full
+        }
+
+        /**
+         * @test Decorator_RecordsExecutionsAndErrorsBySqlState
+         * @brief Tests that executions are timed and a failure is attributed to its SQLSTATE once diagnosed.
+         */
+        TEST_F(OdbcMetricsTest, Decorator_RecordsExecutionsAndErrorsBySqlState) {
+            OdbcLogger::logInfo("Entering Decorator_RecordsExecutionsAndErrorsBySqlState");
+
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError,
+                             SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
+                    copySqlWide(state, L"42S02", 6);
+                    *nativeError = 208;
+                    copySqlWide(messageText, L"Invalid object name", bufferLength);
+                    *textLength = static_cast<SQLSMALLINT>(std::wcslen(L"Invalid object name"));
+                    return SQL_SUCCESS;
+                });
+
+            EXPECT_TRUE(wrapper->executeQuery(L"SELECT 1"));
+            EXPECT_THROW(wrapper->executeQuery(L"SELECT * FROM missing"), OdbcException);
+
+            MetricsSnapshot snapshot = metrics->snapshot();
+            EXPECT_EQ(snapshot.connect.count, 1u);
+            EXPECT_EQ(snapshot.execute.count, 2u);
+            EXPECT_EQ(snapshot.errors, 1u);
+            ASSERT_EQ(snapshot.errorsBySqlState.size(), 1u);
+            EXPECT_EQ(snapshot.errorsBySqlState["42S02"], 1u);
+
+            OdbcLogger::logInfo("Exiting Decorator_RecordsExecutionsAndErrorsBySqlState");
+        }
+
+        /**
+         * @test Decorator_CountsRowsAndBoundBytesPerRowset
+         * @brief Tests that block fetches report the rows from the rows-fetched pointer and the bytes of bound columns.
+         */
+        TEST_F(OdbcMetricsTest, Decorator_CountsRowsAndBoundBytesPerRowset) {
+            FakeBlockCursor fake(*mock, {{L"a1", L"b1"}, {L"a2", std::nullopt}, {L"a3", L"b3"}});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            EXPECT_EQ(wrapper->fetchResults(2).size(), 3u);
+
+            MetricsSnapshot snapshot = metrics->snapshot();
+            EXPECT_EQ(snapshot.fetch.count, 3u); // Two rowsets and the end of the result
+            EXPECT_EQ(snapshot.fetchPerRow.count, 2u);
+            EXPECT_EQ(snapshot.rows, 3u);
+            EXPECT_EQ(snapshot.bytes, 5 * 2 * sizeof(SQLWCHAR)); // Five non-NULL two-character cells
+        }
+
+        /**
+         * @test Decorator_CountsRowsAndBytesOfGetData
+         * @brief Tests that row-by-row fetches count one row per SQLFetch and the lengths SQLGetData returns.
+         */
+        TEST_F(OdbcMetricsTest, Decorator_CountsRowsAndBytesOfGetData) {
+            EXPECT_CALL(*mock, SQLFetch(testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 1, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN* indicator) {
+                    *indicator = 10;
+                    return SQL_SUCCESS;
+                })
+                .WillOnce([](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN* indicator) {
+                    *indicator = SQL_NULL_DATA;
+                    return SQL_SUCCESS;
+                });
+
+            SQLHSTMT hStmt = wrapper->getHStmt();
+            odbc::OdbcInterface* metered = wrapper->getOdbcInterface();
+            SQLLEN indicator = 0;
+            char buffer[32];
+            while (SQL_SUCCEEDED(metered->SQLFetch(hStmt))) {
+                metered->SQLGetData(hStmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &indicator);
+            }
+
+            MetricsSnapshot snapshot = metrics->snapshot();
+            EXPECT_EQ(snapshot.rows, 2u);
+            EXPECT_EQ(snapshot.bytes, 10u);
+        }
+
+        /**
+         * @test RetryPolicy_ReportsRetriesToMetrics
+         * @brief Tests that a retry policy's onRetry hook counts retries by SQLSTATE.
+         */
+        TEST_F(OdbcMetricsTest, RetryPolicy_ReportsRetriesToMetrics) {
+            RetryPolicy policy;
+            policy.maxAttempts = 2;
+            policy.initialBackoff = std::chrono::milliseconds(0);
+            policy.onRetry = [this](const std::string& sqlState, int) { metrics->recordRetry(sqlState); };
+            wrapper->setRetryPolicy(policy);
+
+            int calls = 0;
+            wrapper->withRetry([&calls]() {
+                if (++calls == 1) {
+                    throw OdbcException("ODBC Error: Deadlock", {{"40001", 1205, "Deadlock"}});
+                }
+                return true;
+            });
+
+            MetricsSnapshot snapshot = metrics->snapshot();
+            EXPECT_EQ(snapshot.retries, 1u);
+            EXPECT_EQ(snapshot.retriesBySqlState["40001"], 1u);
+        }
+
+        /**
+         * @test Prometheus_FormatsHistogramsAndCounters
+         * @brief Tests the text exposition of histograms, counters and SQLSTATE labels.
+         */
+        TEST(PrometheusExporterTest, Prometheus_FormatsHistogramsAndCounters) {
+            auto metrics = std::make_shared<OdbcMetrics>();
+            metrics->recordExecute(2000000); // 2 ms
+            metrics->recordFetch(300, 3);
+            metrics->recordError();
+            metrics->recordError();
+            metrics->recordErrorState("40001");
+
+            std::string received;
+            PrometheusExporter exporter(metrics, [&received](const std::string& text) { received = text; });
+            EXPECT_TRUE(exporter.exportNow());
+
+            EXPECT_NE(received.find("# TYPE odbc_execute_seconds histogram\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_execute_seconds_bucket{le=\"0.001\"} 0\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_execute_seconds_bucket{le=\"0.0025\"} 1\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_execute_seconds_bucket{le=\"+Inf\"} 1\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_execute_seconds_sum 0.002\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_fetch_row_seconds_count 1\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_rows_fetched_total 3\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_errors_total{sqlstate=\"40001\"} 1\n"), std::string::npos);
+            EXPECT_NE(received.find("odbc_errors_total{sqlstate=\"unknown\"} 1\n"), std::string::npos);
+        }
+
+        /**
+         * @test Prometheus_WritesFileAtomically
+         * @brief Tests that exporting to a file replaces it with the current text and leaves no temporary file.
+         */
+        TEST(PrometheusExporterTest, Prometheus_WritesFileAtomically) {
+            auto metrics = std::make_shared<OdbcMetrics>();
+            metrics->recordConnect(1000);
+            const std::string path = "test_odbcmetrics.prom";
+
+            PrometheusExporter exporter(metrics, path, "db");
+            ASSERT_TRUE(exporter.exportNow());
+
+            std::ifstream file(path);
+            std::stringstream text;
+            text << file.rdbuf();
+            EXPECT_EQ(text.str(), exporter.render());
+            EXPECT_NE(text.str().find("db_connect_seconds_count 1\n"), std::string::npos);
+            EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+            file.close();
+
+            metrics->recordConnect(1000);
+            ASSERT_TRUE(exporter.exportNow()); // Replaces the existing file
+            std::ifstream replaced(path);
+            text.str("");
+            text << replaced.rdbuf();
+            EXPECT_NE(text.str().find("db_connect_seconds_count 2\n"), std::string::npos);
+            replaced.close();
+            std::remove(path.c_str());
+
+            PrometheusExporter unwritable(metrics, "missing-directory/odbc.prom");
+            EXPECT_FALSE(unwritable.exportNow());
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_metrics_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
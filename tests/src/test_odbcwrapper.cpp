@@ -1,6 +1,7 @@
 #include <test_odbcwrapper.h>
 #include <odbclogger.h>
 #include <cwchar>
+#include <sstream>
 
 namespace ps {
     namespace test {
@@ -174,8 +175,8 @@ namespace ps {
                     const wchar_t* data = L"data1";
                     size_t data_len = std::wcslen(data) + 1; // Include null terminator
                     if (len >= static_cast<SQLLEN>(data_len * sizeof(SQLWCHAR))) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(buffer), data, data_len);
-                        *indicator = SQL_NTS;
+                        std::copy(data, data + data_len, static_cast<SQLWCHAR*>(buffer));
+                        *indicator = static_cast<SQLLEN>((data_len - 1) * sizeof(SQLWCHAR));
                     } else {
                         *indicator = SQL_NULL_DATA; // Indicate insufficient buffer
                     }
@@ -186,8 +187,8 @@ namespace ps {
                     const wchar_t* data = L"data2";
                     size_t data_len = std::wcslen(data) + 1; // Include null terminator
                     if (len >= static_cast<SQLLEN>(data_len * sizeof(SQLWCHAR))) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(buffer), data, data_len);
-                        *indicator = SQL_NTS;
+                        std::copy(data, data + data_len, static_cast<SQLWCHAR*>(buffer));
+                        *indicator = static_cast<SQLLEN>((data_len - 1) * sizeof(SQLWCHAR));
                     } else {
                         *indicator = SQL_NULL_DATA; // Indicate insufficient buffer
                     }
@@ -202,6 +203,35 @@ namespace ps {
             EXPECT_EQ(results[0][1], L"data2");
         }
 
+        /**
+         * @test FetchResults_CallsConcreteBackend
+         * @brief Tests that BasicOdbcWrapper connects, executes and fetches through a backend named at compile time.
+         */
+        TEST(BasicOdbcWrapperTest, FetchResults_CallsConcreteBackend) {
+            auto owned = std::make_unique<testing::NiceMock<MockOdbcInterface>>();
+            testing::NiceMock<MockOdbcInterface>& backend = *owned;
+            BasicOdbcWrapper<testing::NiceMock<MockOdbcInterface>> direct(std::move(owned));
+
+            EXPECT_CALL(backend, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(backend, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(backend, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+            EXPECT_CALL(backend, SQLFetch(testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            FakeLongData fake(backend, FakeLongData::wide(L"direct"), true);
+
+            direct.initialize();
+            ASSERT_TRUE(direct.connect(L"MyDSN", L"user", L"pass"));
+            ASSERT_TRUE(direct.executeQuery(L"SELECT name FROM users"));
+            auto results = direct.fetchResults();
+
+            ASSERT_EQ(results.size(), 1u);
+            EXPECT_EQ(results[0][0], L"direct");
+            EXPECT_EQ(direct.getBackend(), &backend);
+        }
+
         TEST_F(OdbcWrapperTest, FetchResults_NoData) {
             OdbcLogger::logInfo("Entering FetchResults_NoData");
 
@@ -322,8 +352,8 @@ namespace ps {
                     const wchar_t* data = L"data1";
                     size_t data_len = std::wcslen(data) + 1; // Include null terminator
                     if (len >= static_cast<SQLLEN>(data_len * sizeof(SQLWCHAR))) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(buffer), data, data_len);
-                        *indicator = SQL_NTS;
+                        std::copy(data, data + data_len, static_cast<SQLWCHAR*>(buffer));
+                        *indicator = static_cast<SQLLEN>((data_len - 1) * sizeof(SQLWCHAR));
                     } else {
                         *indicator = SQL_NULL_DATA; // Indicate insufficient buffer
                     }
@@ -334,8 +364,8 @@ namespace ps {
                     const wchar_t* data = L"data2";
                     size_t data_len = std::wcslen(data) + 1; // Include null terminator
                     if (len >= static_cast<SQLLEN>(data_len * sizeof(SQLWCHAR))) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(buffer), data, data_len);
-                        *indicator = SQL_NTS;
+                        std::copy(data, data + data_len, static_cast<SQLWCHAR*>(buffer));
+                        *indicator = static_cast<SQLLEN>((data_len - 1) * sizeof(SQLWCHAR));
                     } else {
                         *indicator = SQL_NULL_DATA; // Indicate insufficient buffer
                     }
@@ -384,8 +414,8 @@ namespace ps {
                     const wchar_t* data = L"data2";
                     size_t data_len = std::wcslen(data) + 1; // Include null terminator
                     if (len >= static_cast<SQLLEN>(data_len * sizeof(SQLWCHAR))) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(buffer), data, data_len);
-                        *indicator = SQL_NTS;
+                        std::copy(data, data + data_len, static_cast<SQLWCHAR*>(buffer));
+                        *indicator = static_cast<SQLLEN>((data_len - 1) * sizeof(SQLWCHAR));
                     } else {
                         *indicator = SQL_NULL_DATA; // Indicate insufficient buffer
                     }
@@ -408,13 +438,13 @@ namespace ps {
             EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_ENV, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
                 .WillOnce([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
                     if (state) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(state), L"HY000", 6); // Example SQL state
+                        copySqlWide(state, L"HY000", 6); // Example SQL state
                     }
                     if (nativeError) {
                         *nativeError = 12345; // Example error code
                     }
                     if (messageText && bufferLength > 0) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(messageText), L"Allocation failed", bufferLength / sizeof(SQLWCHAR));
+                        copySqlWide(messageText, L"Allocation failed", bufferLength);
                         if (textLength) {
                             *textLength = std::wcslen(L"Allocation failed");
                         }
@@ -457,13 +487,13 @@ namespace ps {
             EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
                 .WillOnce([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
                     if (state) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(state), L"HY000", 6); // Example SQL state
+                        copySqlWide(state, L"HY000", 6); // Example SQL state
                     }
                     if (nativeError) {
                         *nativeError = 12345; // Example error code
                     }
                     if (messageText && bufferLength > 0) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(messageText), L"Execution failed", bufferLength / sizeof(SQLWCHAR));
+                        copySqlWide(messageText, L"Execution failed", bufferLength);
                         if (textLength) {
                             *textLength = std::wcslen(L"Execution failed");
                         }
@@ -489,13 +519,13 @@ namespace ps {
             EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_DBC, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
                 .WillOnce([](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError, SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
                     if (state) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(state), L"HY000", 6); // Example SQL state
+                        copySqlWide(state, L"HY000", 6); // Example SQL state
                     }
                     if (nativeError) {
                         *nativeError = 12345; // Example error code
                     }
                     if (messageText && bufferLength > 0) {
-                        std::wcsncpy(reinterpret_cast<wchar_t*>(messageText), L"Connection failed", bufferLength / sizeof(SQLWCHAR));
+                        copySqlWide(messageText, L"Connection failed", bufferLength);
                         if (textLength) {
                             *textLength = std::wcslen(L"Connection failed");
                         }
@@ -550,6 +580,1138 @@ namespace ps {
 
             EXPECT_FALSE(wrapper->isConnected());
         }
+
+        /**
+         * @test FetchResultsBulk_FetchesRowsetsPerRoundTrip
+         * @brief Tests that the block cursor fetch returns several rows per SQLFetchScroll call.
+         *
+         * Five rows fetched with a rowset size of two must take three data round trips plus
+         * the final SQL_NO_DATA call, with no per-row SQLFetch or per-cell SQLGetData.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_FetchesRowsetsPerRoundTrip) {
+            OdbcLogger::logInfo("Entering FetchResultsBulk_FetchesRowsetsPerRoundTrip");
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor cursor(*mock, {
+                {L"1", L"alpha"}, {L"2", std::nullopt}, {L"3", L"gamma"}, {L"4", L"delta"}, {L"5", L"epsilon"}
+            });
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetch(testing::_)).Times(0);
+            EXPECT_CALL(*mock, SQLGetData(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+            auto results = wrapper->fetchResults(2);
+
+            ASSERT_EQ(results.size(), 5);
+            EXPECT_EQ(results[0][0], L"1");
+            EXPECT_EQ(results[0][1], L"alpha");
+            EXPECT_EQ(results[1][1], L"NULL");
+            EXPECT_EQ(results[4][0], L"5");
+            EXPECT_EQ(results[4][1], L"epsilon");
+            EXPECT_EQ(cursor.roundTrips(), 4);
+            EXPECT_EQ(cursor.rowArraySize(), 1); // Restored after the fetch
+            EXPECT_EQ(cursor.boundColumns(), 0); // Columns unbound after the fetch
+
+            OdbcLogger::logInfo("Exiting FetchResultsBulk_FetchesRowsetsPerRoundTrip");
+        }
+
+        /**
+         * @test FetchResultsBulk_FailsIfNotConnected
+         * @brief Tests that the block cursor fetch returns no rows when not connected.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_FailsIfNotConnected) {
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, testing::_, testing::_)).Times(0);
+
+            auto results = wrapper->fetchResults(64);
+            EXPECT_TRUE(results.empty());
+        }
+
+        /**
+         * @test FetchResultsBulk_BindFailureHandlesError
+         * @brief Tests that a failure to configure the block cursor is reported through handleError.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_BindFailureHandlesError) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLUSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLSMALLINT*, SQLSMALLINT* type, SQLULEN* size,
+                             SQLSMALLINT*, SQLSMALLINT*) {
+                    *type = SQL_WVARCHAR;
+                    *size = 32;
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ROW_BIND_TYPE, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ROW_ARRAY_SIZE, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0); // Nothing was bound
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, testing::_, testing::_)).Times(0);
+
+            EXPECT_THROW(wrapper->fetchResults(16), std::runtime_error);
+        }
+
+        /**
+         * @test FetchResultsBulk_PartialBindIsReleasedAfterReporting
+         * @brief Tests that when a column fails to bind, its error is reported before the columns bound so far are unbound.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_PartialBindIsReleasedAfterReporting) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(2)
+                .WillRepeatedly([](SQLHSTMT, SQLUSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLSMALLINT*, SQLSMALLINT* type, SQLULEN* size,
+                                   SQLSMALLINT*, SQLSMALLINT*) {
+                    *type = SQL_WVARCHAR;
+                    *size = 32;
+                    return SQL_SUCCESS;
+                });
+            // Unbinding discards the record, as it does with a driver
+            StatementDiagnostics diagnostics(*mock, L"HY090", 0);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_))
+                .WillRepeatedly(diagnostics.clearing(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 1, SQL_C_WCHAR, testing::NotNull(), testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 2, SQL_C_WCHAR, testing::NotNull(), testing::_, testing::_))
+                .WillOnce(diagnostics.posting([](auto...) { return SQL_ERROR; }));
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 1, SQL_C_WCHAR, nullptr, 0, nullptr))
+                .WillOnce(diagnostics.clearing(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 2, SQL_C_WCHAR, nullptr, 0, nullptr)).Times(0);
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, testing::_, testing::_)).Times(0);
+
+            try {
+                wrapper->fetchResults(16);
+                FAIL() << "Expected OdbcException";
+            } catch (const OdbcException& e) {
+                EXPECT_EQ(e.sqlState(), "HY090");
+            }
+        }
+
+        /**
+         * @test FetchResultsBulk_ReadsLongValuesWithGetData
+         * @brief Tests that a column of unknown size is read whole through SQLGetData, one row per fetch.
+         *
+         * A long column reports a size of 0, so the block cursor cannot size its cells; it must
+         * leave the column unbound and read values longer than any default cell in chunks.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_ReadsLongValuesWithGetData) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            const std::wstring document(5000, L'x');
+            FakeBlockCursor fake(*mock, {{L"1", document}, {L"2", std::nullopt}, {L"3", L"short"}}, {SQL_INTEGER, SQL_WLONGVARCHAR});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(2);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 1, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 2, testing::_, testing::_, testing::_, testing::_)).Times(0);
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 2, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AtLeast(4));
+
+            auto results = wrapper->fetchResults(16);
+
+            ASSERT_EQ(results.size(), 3u);
+            EXPECT_EQ(results[0][0], L"1");
+            EXPECT_EQ(results[0][1], document);
+            EXPECT_EQ(results[1][1], L"NULL");
+            EXPECT_EQ(results[2][1], L"short");
+            EXPECT_EQ(fake.roundTrips(), 4); // One row per fetch while a column is unbound
+            EXPECT_EQ(fake.boundColumns(), 0u);
+        }
+
+        /**
+         * @test FetchResultsBulk_RereadsOverflowingCellsWithBlockGetData
+         * @brief Tests that a driver with SQL_GD_BLOCK keeps the block cursor for a long column and reads only the overflowing cells again.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_RereadsOverflowingCellsWithBlockGetData) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            const std::wstring document(5000, L'x');
+            const std::wstring other(3000, L'y');
+            FakeBlockCursor fake(*mock, {{L"1", document}, {L"2", std::nullopt}, {L"3", L"short"}, {L"4", other}},
+                                 {SQL_INTEGER, SQL_WLONGVARCHAR});
+            fake.setGetDataExtensions(SQL_GD_BLOCK | SQL_GD_BOUND | SQL_GD_ANY_ORDER);
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(2);
+            EXPECT_CALL(*mock, SQLGetInfo(testing::_, SQL_GETDATA_EXTENSIONS, testing::_, testing::_, testing::_)).Times(1);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetPos(testing::_, 1, SQL_POSITION, SQL_LOCK_NO_CHANGE)).Times(1);
+            EXPECT_CALL(*mock, SQLSetPos(testing::_, 4, SQL_POSITION, SQL_LOCK_NO_CHANGE)).Times(1);
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 2, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(2);
+
+            auto results = wrapper->fetchResults(16);
+
+            ASSERT_EQ(results.size(), 4u);
+            EXPECT_EQ(results[0][1], document);
+            EXPECT_EQ(results[1][1], L"NULL");
+            EXPECT_EQ(results[2][1], L"short");
+            EXPECT_EQ(results[3][0], L"4");
+            EXPECT_EQ(results[3][1], other);
+            EXPECT_EQ(fake.roundTrips(), 2); // One rowset, then SQL_NO_DATA
+            EXPECT_EQ(fake.rowArraySize(), 1u); // Restored once the buffer unbinds
+        }
+
+        /**
+         * @test OpenCursor_ColumnCharsCapsCells
+         * @brief Tests that openCursor() sizes cells from its columnChars and reads longer values whole.
+         */
+        TEST_F(ConnectedOdbcWrapperTest, OpenCursor_ColumnCharsCapsCells) {
+            FakeBlockCursor fake(*mock, {{L"fits"}, {L"much longer than the cells"}});
+            fake.setGetDataExtensions(SQL_GD_BLOCK | SQL_GD_BOUND | SQL_GD_ANY_ORDER);
+            expectBlockCursor(1);
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 1, SQL_C_WCHAR, testing::NotNull(), (8 + 1) * static_cast<SQLLEN>(sizeof(SQLWCHAR)), testing::_))
+                .Times(1);
+            EXPECT_CALL(*mock, SQLSetPos(testing::_, 2, SQL_POSITION, SQL_LOCK_NO_CHANGE)).Times(1);
+
+            std::vector<std::wstring> values;
+            for (const auto& row : wrapper->openCursor(16, 8)) {
+                values.push_back(row[0]);
+            }
+
+            EXPECT_EQ(values, (std::vector<std::wstring>{L"fits", L"much longer than the cells"}));
+            EXPECT_EQ(fake.roundTrips(), 2);
+        }
+
+        /**
+         * @test FetchResultsBulk_TruncationHandlesError
+         * @brief Tests that a value longer than its described column size fails the fetch instead of coming back cut short.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultsBulk_TruncationHandlesError) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"1", L"fits"}, {L"2", L"much longer than described"}});
+            fake.setColumnSize(2, 8);
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillRepeatedly([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            EXPECT_THROW(wrapper->fetchResults(16), std::runtime_error);
+            EXPECT_EQ(fake.boundColumns(), 0u); // Unbound after the error
+
+            fake.reset({{L"1", L"fits"}, {L"2", L"much longer than described"}});
+            ResultCursor cursor = wrapper->openCursor(1);
+            ASSERT_TRUE(cursor.next());
+            EXPECT_EQ(cursor.row()[1], L"fits");
+            EXPECT_THROW(cursor.next(), std::runtime_error);
+            EXPECT_FALSE(cursor.next());
+        }
+
+        /**
+         * @test OpenCursor_StreamsRowsLazily
+         * @brief Tests that the cursor fetches one rowset at a time and reuses its row buffer.
+         *
+         * The first row must be available after a single round trip, and every row must be
+         * delivered through the same row buffer storage.
+         */
+        TEST_F(OdbcWrapperTest, OpenCursor_StreamsRowsLazily) {
+            OdbcLogger::logInfo("Entering OpenCursor_StreamsRowsLazily");
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"a1", L"b1"}, {L"a2", std::nullopt}, {L"a3", L"b3"}});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ResultCursor cursor = wrapper->openCursor(2);
+            EXPECT_EQ(fake.roundTrips(), 0); // Nothing fetched until iteration starts
+
+            auto it = cursor.begin();
+            ASSERT_NE(it, cursor.end());
+            EXPECT_EQ(fake.roundTrips(), 1);
+            EXPECT_EQ((*it)[0], L"a1");
+            const std::wstring* rowStorage = it->data();
+
+            ++it;
+            ASSERT_NE(it, cursor.end());
+            EXPECT_EQ((*it)[1], L"NULL");
+            EXPECT_TRUE(cursor.isNull(1));
+            EXPECT_EQ(it->data(), rowStorage);
+            EXPECT_EQ(fake.roundTrips(), 1);
+
+            ++it;
+            ASSERT_NE(it, cursor.end());
+            EXPECT_EQ((*it)[0], L"a3");
+            EXPECT_EQ(it->data(), rowStorage);
+            EXPECT_EQ(fake.roundTrips(), 2);
+
+            ++it;
+            EXPECT_EQ(it, cursor.end());
+            EXPECT_EQ(fake.roundTrips(), 3);
+            EXPECT_EQ(fake.boundColumns(), 0);
+
+            OdbcLogger::logInfo("Exiting OpenCursor_StreamsRowsLazily");
+        }
+
+        /**
+         * @test OpenCursor_EmptyIfNotConnected
+         * @brief Tests that a cursor opened without a connection yields no rows.
+         */
+        TEST_F(OdbcWrapperTest, OpenCursor_EmptyIfNotConnected) {
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_)).Times(0);
+
+            ResultCursor cursor = wrapper->openCursor();
+            EXPECT_EQ(cursor.begin(), cursor.end());
+        }
+
+        /**
+         * @test EmptyCursor_FetchesNothing
+         * @brief Tests that a default-constructed cursor reports no rows instead of touching a rowset.
+         */
+        TEST_F(OdbcWrapperTest, EmptyCursor_FetchesNothing) {
+            ResultCursor cursor;
+            EXPECT_EQ(cursor.fetchRowset(), SQL_NO_DATA);
+            EXPECT_FALSE(cursor.acceptRowset(SQL_SUCCESS));
+            EXPECT_FALSE(cursor.next());
+            EXPECT_TRUE(cursor.done());
+            EXPECT_EQ(cursor.columnCount(), 0);
+        }
+
+        /**
+         * @test OpenTypedCursor_ReadsNativeValues
+         * @brief Tests that described columns are bound to native C types and read in place.
+         */
+        TEST_F(OdbcWrapperTest, OpenTypedCursor_ReadsNativeValues) {
+            OdbcLogger::logInfo("Entering OpenTypedCursor_ReadsNativeValues");
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"9000000000", L"2.5", L"alpha"}, {std::nullopt, L"-1", std::nullopt}, {L"1", L"1e300", L"beta"}},
+                                 {SQL_BIGINT, SQL_DOUBLE, SQL_VARCHAR});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 3; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(3);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 1, SQL_C_SBIGINT, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 2, SQL_C_DOUBLE, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, 3, SQL_C_CHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ResultCursor cursor = wrapper->openTypedCursor(16);
+            EXPECT_TRUE(cursor.current().isNull(0)); // Empty view before the first row
+            ASSERT_TRUE(cursor.next());
+            RowView row = cursor.current();
+            EXPECT_EQ(row.get<int64_t>(0), 9000000000LL);
+            EXPECT_EQ(row.get<double>(1), 2.5);
+            EXPECT_EQ(row.get<std::string_view>(2), std::string_view("alpha"));
+            EXPECT_EQ(row.get<double>(0), 9000000000.0);
+
+            ASSERT_TRUE(cursor.next());
+            row = cursor.current();
+            EXPECT_FALSE(row.get<int64_t>(0).has_value());
+            EXPECT_EQ(row.get<int64_t>(1), -1);
+            EXPECT_FALSE(row.get<std::string_view>(2).has_value());
+
+            ASSERT_TRUE(cursor.next());
+            row = cursor.current();
+            EXPECT_THROW(row.get<int64_t>(1), std::invalid_argument); // Out of the int64_t range
+
+            EXPECT_FALSE(cursor.next());
+            EXPECT_FALSE(cursor.current().get<int64_t>(0).has_value());
+            EXPECT_EQ(fake.roundTrips(), 2);
+
+            OdbcLogger::logInfo("Exiting OpenTypedCursor_ReadsNativeValues");
+        }
+
+        /**
+         * @test OpenTypedCursor_ReadsFixedSizeColumnAfterLongColumnOnce
+         * @brief Tests that a BIGINT column after an oversized VARCHAR is read whole with a single SQLGetData.
+         *
+         * The fake driver returns fixed-size values again on every call instead of SQL_NO_DATA,
+         * so reading the column in character-sized pieces would write past the end of its cell.
+         */
+        TEST_F(OdbcWrapperTest, OpenTypedCursor_ReadsFixedSizeColumnAfterLongColumnOnce) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            const std::wstring document(5000, L'x');
+            FakeBlockCursor fake(*mock, {{document, L"9000000000"}, {L"short", std::nullopt}}, {SQL_VARCHAR, SQL_BIGINT});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(2);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 1, SQL_C_CHAR, testing::_, testing::_, testing::_)).Times(testing::AtLeast(2));
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 2, SQL_C_SBIGINT, testing::_, static_cast<SQLLEN>(sizeof(SQLBIGINT)), testing::_)).Times(2);
+
+            ResultCursor cursor = wrapper->openTypedCursor(16);
+            ASSERT_TRUE(cursor.next());
+            RowView row = cursor.current();
+            EXPECT_EQ(row.get<std::string_view>(0)->size(), document.size());
+            EXPECT_EQ(row.get<int64_t>(1), 9000000000LL);
+
+            ASSERT_TRUE(cursor.next());
+            row = cursor.current();
+            EXPECT_EQ(row.get<std::string_view>(0), std::string_view("short"));
+            EXPECT_FALSE(row.get<int64_t>(1).has_value());
+
+            EXPECT_FALSE(cursor.next());
+            EXPECT_EQ(fake.boundColumns(), 0u);
+        }
+
+        /**
+         * @test RowView_ParsesTextColumns
+         * @brief Tests that numbers are parsed from text-bound columns and that bad values throw.
+         */
+        TEST_F(OdbcWrapperTest, RowView_ParsesTextColumns) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"42", L"0.25", L"n/a"}});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 3; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(3);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ResultCursor cursor = wrapper->openCursor();
+            ASSERT_TRUE(cursor.next());
+            RowView row = cursor.current();
+            EXPECT_EQ(row.columnCount(), 3);
+            EXPECT_EQ(row.get<int64_t>(0), 42);
+            EXPECT_EQ(row.get<double>(1), 0.25);
+            EXPECT_THROW(row.get<int64_t>(1), std::invalid_argument);
+            EXPECT_THROW(row.get<double>(2), std::invalid_argument);
+            EXPECT_THROW(row.get<std::string_view>(2), std::invalid_argument); // Wide text has no narrow view
+        }
+
+        /**
+         * @test FetchResultSet_PacksCellsIntoOneSlab
+         * @brief Tests that a slab-backed result set holds the same values as fetchResults() and marks NULLs.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultSet_PacksCellsIntoOneSlab) {
+            OdbcLogger::logInfo("Entering FetchResultSet_PacksCellsIntoOneSlab");
+
+            EXPECT_TRUE(wrapper->fetchResultSet().empty()); // Not connected
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"1", L"alpha"}, {L"2", std::nullopt}, {L"3", L""}});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ResultSet results = wrapper->fetchResultSet(2);
+            EXPECT_EQ(fake.roundTrips(), 3);
+            EXPECT_EQ(fake.boundColumns(), 0u);
+            ASSERT_EQ(results.rowCount(), 3u);
+            EXPECT_EQ(results.columnCount(), 2u);
+            EXPECT_EQ(results.slabCount(), 1u);
+
+            EXPECT_EQ(results.cell(0, 1), L"alpha");
+            EXPECT_EQ(results[1][1], L"NULL");
+            EXPECT_TRUE(results[1].isNull(1));
+            EXPECT_FALSE(results[2].isNull(1));
+            EXPECT_EQ(results[2][1], L"");
+
+            std::vector<std::wstring> ids;
+            for (const ResultSet::Row& row : results) {
+                ids.emplace_back(row[0]);
+            }
+            EXPECT_EQ(ids, std::vector<std::wstring>({L"1", L"2", L"3"}));
+
+            OdbcLogger::logInfo("Exiting FetchResultSet_PacksCellsIntoOneSlab");
+        }
+
+        /**
+         * @test ResultSet_GivesOversizedValuesTheirOwnSlab
+         * @brief Tests that a value larger than a slab gets its own slab and that the next values still fill the open one.
+         */
+        TEST_F(OdbcWrapperTest, ResultSet_GivesOversizedValuesTheirOwnSlab) {
+            FakeBlockCursor fake(*mock, {{L"ab"}, {L"abcdefgh"}, {L"cd"}, {L"e"}});
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            RowsetBuffer rowset(mock, reinterpret_cast<SQLHSTMT>(0x1));
+            ASSERT_EQ(rowset.bind(1, 8), SQL_SUCCESS);
+            ASSERT_EQ(rowset.fetch(), SQL_SUCCESS);
+
+            ResultSet results(1, 4);
+            results.append(rowset);
+            EXPECT_EQ(results.slabCount(), 3u); // "ab" + "cd", "abcdefgh", "e"
+
+            ResultSet moved(std::move(results));
+            EXPECT_EQ(results.rowCount(), 0u);
+            EXPECT_EQ(moved[0][0], L"ab");
+            EXPECT_EQ(moved[1][0], L"abcdefgh");
+            EXPECT_EQ(moved[2][0], L"cd");
+            EXPECT_EQ(moved[3][0], L"e");
+        }
+
+        /**
+         * @test FetchResultSet_SpillsRowsBeyondMemoryBudget
+         * @brief Tests that rows beyond the memory budget go to a mapped spill file and read back like rows in memory.
+         */
+        TEST_F(OdbcWrapperTest, FetchResultSet_SpillsRowsBeyondMemoryBudget) {
+            OdbcLogger::logInfo("Entering FetchResultSet_SpillsRowsBeyondMemoryBudget");
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            std::vector<FakeBlockCursor::Row> rows;
+            for (int i = 0; i < 2000; i++) {
+                rows.push_back({std::to_wstring(i), i % 7 == 0 ? std::nullopt : std::optional<std::wstring>(L"value " + std::to_wstring(i)),
+                                std::wstring()});
+            }
+            FakeBlockCursor fake(*mock, rows);
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 3; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            SpillOptions spill;
+            spill.memoryBudget = 300 * 1024; // The first 64K-character slab plus the cells of several hundred rows
+            spill.segmentBytes = 4096;
+            ResultSet results = wrapper->fetchResultSet(100, spill);
+            ASSERT_EQ(results.rowCount(), 2000u);
+            EXPECT_GT(results.spilledRowCount(), 0u);
+            EXPECT_LT(results.spilledRowCount(), 2000u);
+            EXPECT_GT(results.spilledBytes(), 4096u); // Several segments
+            EXPECT_LE(results.memoryUsage(), spill.memoryBudget + 100 * 3 * 2 * sizeof(void*) + 2000 * sizeof(void*));
+
+            const std::wstring_view last = results[1999][1];
+            ResultSet moved(std::move(results));
+            EXPECT_EQ(last, L"value 1999");
+            for (size_t i = 0; i < moved.rowCount(); i++) {
+                ASSERT_EQ(moved[i][0], std::to_wstring(i));
+                ASSERT_EQ(moved[i].isNull(1), i % 7 == 0);
+                ASSERT_EQ(moved[i][1], i % 7 == 0 ? L"NULL" : L"value " + std::to_wstring(i));
+                ASSERT_EQ(moved[i][2], L"");
+                ASSERT_FALSE(moved[i].isNull(2));
+            }
+            size_t counted = 0;
+            for (const ResultSet::Row& row : moved) {
+                counted += row.size() == 3 ? 1 : 0;
+            }
+            EXPECT_EQ(counted, 2000u);
+
+            OdbcLogger::logInfo("Exiting FetchResultSet_SpillsRowsBeyondMemoryBudget");
+        }
+
+        /**
+         * @test ResultSet_ThrowsWhenSpillFileCannotBeCreated
+         * @brief Tests that a spill directory that does not exist is reported when the first row spills.
+         */
+        TEST_F(OdbcWrapperTest, ResultSet_ThrowsWhenSpillFileCannotBeCreated) {
+            FakeBlockCursor fake(*mock, {{L"a"}, {L"b"}});
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            RowsetBuffer rowset(mock, reinterpret_cast<SQLHSTMT>(0x1));
+            ASSERT_EQ(rowset.bind(1, 8), SQL_SUCCESS);
+            ASSERT_EQ(rowset.fetch(), SQL_SUCCESS);
+
+            SpillOptions spill;
+            spill.memoryBudget = 1; // Every row spills
+            spill.directory = "missing-directory";
+            ResultSet results(1, spill);
+            EXPECT_THROW(results.append(rowset), std::runtime_error);
+            EXPECT_EQ(results.rowCount(), 0u);
+        }
+
+        /**
+         * @test HandleError_ThrowsOdbcExceptionWithAllRecords
+         * @brief Tests that every diagnostic record is read, by record number, into a typed exception.
+         */
+        TEST_F(OdbcWrapperTest, HandleError_ThrowsOdbcExceptionWithAllRecords) {
+            OdbcLogger::logInfo("Entering HandleError_ThrowsOdbcExceptionWithAllRecords");
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            wrapper->connect(L"MyDSN", L"user", L"pass");
+
+            auto record = [](const wchar_t* sqlState, SQLINTEGER native, const wchar_t* text) {
+                return [=](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError,
+                           SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
+                    copySqlWide(state, sqlState, 6);
+                    *nativeError = native;
+                    copySqlWide(messageText, text, bufferLength);
+                    *textLength = static_cast<SQLSMALLINT>(std::wcslen(text));
+                    return SQL_SUCCESS;
+                };
+            };
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(record(L"08S01", 10054, L"Communication link failure"));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 2, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(record(L"01000", 0, L"Connection reset by peer"));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 3, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+
+            try {
+                wrapper->executeQuery(L"SELECT 1");
+                FAIL() << "Expected OdbcException";
+            } catch (const OdbcException& e) {
+                EXPECT_STREQ(e.what(), "ODBC Error: Communication link failure");
+                EXPECT_EQ(e.sqlState(), "08S01");
+                EXPECT_EQ(e.sqlStateClass(), "08");
+                EXPECT_EQ(e.nativeError(), 10054);
+                ASSERT_EQ(e.diagnostics().size(), 2u);
+                EXPECT_EQ(e.diagnostics()[1].sqlState, "01000");
+                EXPECT_EQ(e.diagnostics()[1].message, "Connection reset by peer");
+            }
+
+            OdbcLogger::logInfo("Exiting HandleError_ThrowsOdbcExceptionWithAllRecords");
+        }
+
+        /**
+         * @test OdbcDiagnostic_StopsAtRecordLimit
+         * @brief Tests that a driver reporting records without end is read up to MAX_RECORDS, and that no records still make an exception.
+         */
+        TEST_F(OdbcWrapperTest, OdbcDiagnostic_StopsAtRecordLimit) {
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_DBC, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(static_cast<int>(OdbcDiagnostic::MAX_RECORDS))
+                .WillRepeatedly(testing::Return(SQL_SUCCESS_WITH_INFO));
+
+            OdbcDiagnostic diagnostic;
+            EXPECT_EQ(diagnostic.collect(*mock, SQL_HANDLE_DBC, nullptr), OdbcDiagnostic::MAX_RECORDS);
+            EXPECT_EQ(diagnostic[0].text(), ""); // Nothing written by the driver
+
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_ENV, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            EXPECT_EQ(diagnostic.collect(*mock, SQL_HANDLE_ENV, nullptr), 0u);
+            OdbcException error = diagnostic.toException();
+            EXPECT_STREQ(error.what(), "ODBC Error: Unable to retrieve diagnostic information");
+            EXPECT_EQ(error.sqlState(), "");
+            EXPECT_EQ(error.nativeError(), 0);
+        }
+
+        /**
+         * @test TextCodec_TranscodesBetweenUtf8AndUtf16
+         * @brief Tests the UTF-8/UTF-16 transcoders on ASCII blocks, mixed text, surrogate pairs and malformed input.
+         */
+        TEST(TextCodecTest, TextCodec_TranscodesBetweenUtf8AndUtf16) {
+            const std::string ascii = "SELECT id, name FROM customers WHERE id > 42"; // Several 16-unit blocks plus a tail
+            SqlWString wide = utf8ToUtf16(ascii);
+            ASSERT_EQ(wide.size(), ascii.size());
+            EXPECT_EQ(wide[7], static_cast<SQLWCHAR>('i'));
+            EXPECT_EQ(utf16ToUtf8(wide.data(), wide.size()), ascii);
+
+            const std::string mixed = "name = 'Z\xC3\xBCrich \xE2\x82\xAC \xF0\x9F\x98\x80' AND padding = 'xxxxxxxxxxxx'";
+            wide = utf8ToUtf16(mixed);
+            EXPECT_EQ(wide[9], 0x00FC);
+            EXPECT_EQ(wide[15], 0x20AC);
+            EXPECT_EQ(wide[17], 0xD83D); // U+1F600 as a surrogate pair
+            EXPECT_EQ(wide[18], 0xDE00);
+            EXPECT_EQ(utf16ToUtf8(wide.data(), wide.size()), mixed);
+
+            EXPECT_EQ(toSqlWide(L"\U0001F600"), SqlWString({0xD83D, 0xDE00}));
+            EXPECT_EQ(fromSqlWide(wide.data() + 17, 2), std::wstring(L"\U0001F600"));
+
+            const SQLWCHAR loneSurrogate[] = {'a', 0xD800, 'b'};
+            EXPECT_EQ(utf16ToUtf8(loneSurrogate, 3), "a\xEF\xBF\xBD" "b");
+            EXPECT_EQ(utf8ToUtf16("a\xC0\xAF" "b"), SqlWString({'a', 0xFFFD, 0xFFFD, 'b'})); // Overlong '/'
+            EXPECT_EQ(utf8ToUtf16("\xE2\x82"), SqlWString({0xFFFD, 0xFFFD})); // Truncated
+
+            const SQLWCHAR state[6] = {'H', 'Y', '0', '0', '0', 'X'}; // Not terminated
+            EXPECT_EQ(sqlWideLength(state, 5), 5u);
+        }
+
+        /**
+         * @test Utf8Api_UsesAnsiEntryPoints
+         * @brief Tests that UTF-8 text is passed to SQLConnectA and SQLExecDirectA with explicit lengths and fetched as SQL_C_CHAR.
+         */
+        TEST_F(OdbcWrapperTest, Utf8Api_UsesAnsiEntryPoints) {
+            OdbcLogger::logInfo("Entering Utf8Api_UsesAnsiEntryPoints");
+
+            EXPECT_FALSE(wrapper->executeQuery(std::string_view("SELECT 1"))); // Not connected
+            EXPECT_TRUE(wrapper->fetchResultsUtf8().empty());
+
+            EXPECT_CALL(*mock, SQLConnectA(testing::_, testing::_, 5, testing::_, 4, testing::_, 4))
+                .WillOnce([](SQLHDBC, SQLCHAR* dsn, SQLSMALLINT dsnLength, SQLCHAR*, SQLSMALLINT, SQLCHAR*, SQLSMALLINT) {
+                    EXPECT_EQ(std::string(reinterpret_cast<char*>(dsn), dsnLength), "MyDSN");
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_TRUE(wrapper->connect("MyDSN", "user", "pass"));
+
+            const std::string sql = "SELECT name FROM cities WHERE name = 'K\xC3\xB6ln'; trailing text";
+            std::string executed;
+            EXPECT_CALL(*mock, SQLExecDirectA(testing::_, testing::_, 44))
+                .WillOnce([&executed](SQLHSTMT, SQLCHAR* text, SQLINTEGER length) {
+                    executed.assign(reinterpret_cast<char*>(text), length);
+                    return SQL_SUCCESS;
+                });
+            EXPECT_TRUE(wrapper->executeQuery(std::string_view(sql).substr(0, 44)));
+            EXPECT_EQ(executed, "SELECT name FROM cities WHERE name = 'K\xC3\xB6ln'");
+
+            // The wide overloads hand the driver UTF-16, whatever the size of wchar_t
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .WillOnce([](SQLHSTMT, SQLWCHAR* text, SQLINTEGER) {
+                    EXPECT_EQ(SqlWString(text), SqlWString({'-', '-', 0xD83D, 0xDE00}));
+                    return SQL_SUCCESS;
+                });
+            EXPECT_TRUE(wrapper->executeQuery(L"--\U0001F600"));
+
+            FakeBlockCursor fake(*mock, {{L"1", L"alpha"}, {L"2", std::nullopt}, {L"3", L""}});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, SQL_C_CHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            std::vector<std::vector<std::string>> results = wrapper->fetchResultsUtf8(2);
+            EXPECT_EQ(fake.roundTrips(), 3);
+            EXPECT_EQ(fake.boundColumns(), 0u);
+            EXPECT_EQ(results, std::vector<std::vector<std::string>>({{"1", "alpha"}, {"2", "NULL"}, {"3", ""}}));
+
+            OdbcLogger::logInfo("Exiting Utf8Api_UsesAnsiEntryPoints");
+        }
+
+        /**
+         * @test FetchColumnar_FillsTypedColumns
+         * @brief Tests that rowsets are appended to typed columns with validity bitmaps and text offsets.
+         */
+        TEST_F(OdbcWrapperTest, FetchColumnar_FillsTypedColumns) {
+            OdbcLogger::logInfo("Entering FetchColumnar_FillsTypedColumns");
+
+            EXPECT_EQ(wrapper->fetchColumnar().columnCount(), 0u); // Not connected
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"1", L"0.5", L"alpha"}, {std::nullopt, L"1.5", std::nullopt}, {L"3", std::nullopt, L"gamma"}},
+                                 {SQL_BIGINT, SQL_DOUBLE, SQL_VARCHAR});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 3; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(3);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ColumnarResult result = wrapper->fetchColumnar(2);
+            EXPECT_EQ(fake.roundTrips(), 3);
+            EXPECT_EQ(fake.boundColumns(), 0u);
+            ASSERT_EQ(result.columnCount(), 3u);
+            ASSERT_EQ(result.rowCount(), 3u);
+
+            EXPECT_EQ(result.column(0).name, "c1");
+            EXPECT_EQ(result.column(0).type, ColumnarType::Int64);
+            EXPECT_EQ(result.column(0).nullCount, 1);
+            EXPECT_EQ(result.column(0).validity, std::vector<uint8_t>({0b101}));
+            const int64_t* ids = result.int64Values(0);
+            EXPECT_EQ(std::vector<int64_t>(ids, ids + 3), std::vector<int64_t>({1, 0, 3}));
+
+            EXPECT_EQ(result.column(1).type, ColumnarType::Float64);
+            EXPECT_EQ(result.doubleValues(1)[1], 1.5);
+            EXPECT_TRUE(result.isNull(2, 1));
+            EXPECT_THROW(result.doubleValues(0), std::invalid_argument);
+
+            EXPECT_EQ(result.column(2).type, ColumnarType::Utf8);
+            EXPECT_EQ(result.column(2).offsets, std::vector<int32_t>({0, 5, 5, 10}));
+            EXPECT_EQ(result.stringValue(0, 2), "alpha");
+            EXPECT_TRUE(result.isNull(1, 2));
+            EXPECT_EQ(result.stringValue(2, 2), "gamma");
+            EXPECT_THROW(result.stringValue(0, 0), std::invalid_argument);
+
+            OdbcLogger::logInfo("Exiting FetchColumnar_FillsTypedColumns");
+        }
+
+        /**
+         * @test FetchColumnar_ExportsArrowArrays
+         * @brief Tests that a columnar result moves into Arrow C data interface structures that release their buffers.
+         */
+        TEST_F(OdbcWrapperTest, FetchColumnar_ExportsArrowArrays) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeBlockCursor fake(*mock, {{L"7", L"alpha"}, {L"8", std::nullopt}}, {SQL_INTEGER, SQL_VARCHAR});
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(2);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ColumnarResult result = wrapper->fetchColumnar();
+            const void* ids = result.int64Values(0);
+
+            ArrowArray array;
+            ArrowSchema schema;
+            result.exportArrow(&array, &schema);
+            EXPECT_EQ(result.columnCount(), 0u);
+
+            EXPECT_STREQ(schema.format, "+s");
+            ASSERT_EQ(schema.n_children, 2);
+            EXPECT_STREQ(schema.children[0]->format, "l");
+            EXPECT_STREQ(schema.children[0]->name, "c1");
+            EXPECT_STREQ(schema.children[1]->format, "u");
+            EXPECT_EQ(schema.children[1]->flags, ARROW_FLAG_NULLABLE);
+
+            EXPECT_EQ(array.length, 2);
+            ASSERT_EQ(array.n_children, 2);
+            const ArrowArray* idArray = array.children[0];
+            EXPECT_EQ(idArray->n_buffers, 2);
+            EXPECT_EQ(idArray->null_count, 0);
+            EXPECT_EQ(idArray->buffers[0], nullptr); // No validity bitmap without NULLs
+            EXPECT_EQ(idArray->buffers[1], ids); // Moved, not copied
+            const ArrowArray* nameArray = array.children[1];
+            EXPECT_EQ(nameArray->n_buffers, 3);
+            EXPECT_EQ(nameArray->null_count, 1);
+            EXPECT_EQ(static_cast<const uint8_t*>(nameArray->buffers[0])[0], 0b01);
+            EXPECT_EQ(static_cast<const int32_t*>(nameArray->buffers[1])[2], 5);
+            EXPECT_EQ(std::string(static_cast<const char*>(nameArray->buffers[2]), 5), "alpha");
+
+            array.release(&array);
+            schema.release(&schema);
+            EXPECT_EQ(array.release, nullptr);
+            EXPECT_EQ(schema.release, nullptr);
+        }
+
+        /**
+         * @test FetchResults_ReadsLongValuesInChunks
+         * @brief Tests that values longer than one SQLGetData buffer are returned in full.
+         *
+         * The first call returns a full buffer and reports the remaining length, after which
+         * the buffer grows so the rest arrives in a single further call.
+         */
+        TEST_F(OdbcWrapperTest, FetchResults_ReadsLongValuesInChunks) {
+            OdbcLogger::logInfo("Entering FetchResults_ReadsLongValuesInChunks");
+
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            std::wstring json = L"{\"data\": \"" + std::wstring(20000, L'x') + L"\"}";
+            FakeLongData fake(*mock, FakeLongData::wide(json), true);
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLFetch(testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 1, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(2);
+
+            wrapper->executeQuery(L"SELECT payload FROM documents");
+            auto results = wrapper->fetchResults();
+            ASSERT_EQ(results.size(), 1u);
+            EXPECT_EQ(results[0][0], json);
+
+            OdbcLogger::logInfo("Exiting FetchResults_ReadsLongValuesInChunks");
+        }
+
+        /**
+         * @test StreamColumn_WritesChunksToStream
+         * @brief Tests that a value of unknown length is streamed chunk by chunk until SQL_NO_DATA.
+         */
+        TEST_F(OdbcWrapperTest, StreamColumn_WritesChunksToStream) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            std::vector<unsigned char> blob(100000);
+            for (size_t i = 0; i < blob.size(); i++) {
+                blob[i] = static_cast<unsigned char>(i * 31);
+            }
+            FakeLongData fake(*mock, blob, false);
+            EXPECT_CALL(*mock, SQLFetch(testing::_)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 1, SQL_C_BINARY, testing::_, testing::_, testing::_))
+                .Times(testing::AtLeast(2));
+
+            ASSERT_TRUE(wrapper->fetchRow());
+            std::ostringstream out;
+            EXPECT_EQ(wrapper->streamColumn(1, out), static_cast<SQLLEN>(blob.size()));
+            const std::string written = out.str();
+            EXPECT_TRUE(std::equal(written.begin(), written.end(), blob.begin(), blob.end(),
+                                   [](char a, unsigned char b) { return static_cast<unsigned char>(a) == b; }));
+        }
+
+        /**
+         * @test StreamColumn_ReportsNull
+         * @brief Tests that a NULL value reaches no sink and is reported as SQL_NULL_DATA.
+         */
+        TEST_F(OdbcWrapperTest, StreamColumn_ReportsNull) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            FakeLongData fake(*mock, std::nullopt, false);
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 1, SQL_C_BINARY, testing::_, testing::_, testing::_)).Times(1);
+
+            size_t chunks = 0;
+            SQLLEN bytes = wrapper->streamColumn(1, [&chunks](const unsigned char*, size_t) { chunks++; });
+            EXPECT_EQ(bytes, SQL_NULL_DATA);
+            EXPECT_EQ(chunks, 0u);
+        }
+
+        /**
+         * @test ExecuteQueryAsync_PollsUntilComplete
+         * @brief Tests that the reactor repeats SQLExecDirect while it returns SQL_STILL_EXECUTING.
+         */
+        TEST_F(OdbcWrapperTest, ExecuteQueryAsync_PollsUntilComplete) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            testing::InSequence sequence;
+            StillExecuting execution(3, SQL_SUCCESS);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<SQLPOINTER>(SQL_ASYNC_ENABLE_ON), 0))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).Times(4).WillRepeatedly(execution);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<SQLPOINTER>(SQL_ASYNC_ENABLE_OFF), 0))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            std::future<bool> result = wrapper->executeQueryAsync(L"SELECT * FROM slow_report");
+            EXPECT_TRUE(result.get());
+            EXPECT_EQ(execution.calls(), 4);
+            EXPECT_NE(wrapper->getAsyncReactor(), nullptr);
+        }
+
+        /**
+         * @test ExecuteQueryAsync_FailureRethrowsFromFuture
+         * @brief Tests that an error reported after polling reaches the caller through the future.
+         */
+        TEST_F(OdbcWrapperTest, ExecuteQueryAsync_FailureRethrowsFromFuture) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            // Switching async mode off discards the record, as it does with a driver
+            StatementDiagnostics diagnostics(*mock, L"42S02", 208);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ASYNC_ENABLE, testing::_, 0))
+                .Times(2)
+                .WillRepeatedly(diagnostics.clearing(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .WillRepeatedly(diagnostics.posting(StillExecuting(2, SQL_ERROR)));
+
+            std::future<bool> result = wrapper->executeQueryAsync(L"SELECT * FROM missing_table");
+            try {
+                result.get();
+                FAIL() << "Expected OdbcException";
+            } catch (const OdbcException& e) {
+                EXPECT_EQ(e.sqlState(), "42S02");
+                EXPECT_EQ(e.nativeError(), 208);
+            }
+        }
+
+        /**
+         * @test ExecuteQueryAsync_RunsSynchronouslyWithoutDriverSupport
+         * @brief Tests that a driver rejecting SQL_ATTR_ASYNC_ENABLE gets a blocking execution and no reactor.
+         */
+        TEST_F(OdbcWrapperTest, ExecuteQueryAsync_RunsSynchronouslyWithoutDriverSupport) {
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLAllocHandle(SQL_HANDLE_STMT, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLDisconnect(nullptr)) // Handle NULL case
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            wrapper->connect(L"MyDSN", L"user", L"pass"); // Set isConnected to true
+
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ASYNC_ENABLE, testing::_, 0))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            std::future<bool> result = wrapper->executeQueryAsync(L"SELECT 1");
+            ASSERT_EQ(result.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+            EXPECT_TRUE(result.get());
+            EXPECT_EQ(wrapper->getAsyncReactor(), nullptr);
+        }
+
+        /**
+         * @test ExecuteQueryAsync_FailsIfNotConnected
+         * @brief Tests that the future is ready and false without a connection.
+         */
+        TEST_F(OdbcWrapperTest, ExecuteQueryAsync_FailsIfNotConnected) {
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, testing::_)).Times(0);
+
+            std::future<bool> result = wrapper->executeQueryAsync(L"SELECT 1");
+            EXPECT_FALSE(result.get());
+        }
     }
 }
 
@@ -0,0 +1,265 @@
+#include <test_odbcwrapper.h>
+#include <odbccpp/parallelquery.h>
+#include <odbclogger.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+
+using ps::odbc::ConnectionPool;
+using ps::odbc::OdbcException;
+using ps::odbc::OdbcLogger;
+using ps::odbc::ParallelQuery;
+using ps::odbc::Partitioning;
+using ps::odbc::ResultSet;
+using ps::odbc::RowsetBuffer;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class ParallelQueryTest
+         * @brief Fixture whose pooled connections serve the rows of each partition query through a fake block cursor.
+         */
+        class ParallelQueryTest : public ::testing::Test {
+        protected:
+            std::mutex                                                  mutex; ///< Guards fakes.
+            std::vector<std::unique_ptr<FakeBlockCursor>>               fakes; ///< One fake driver per connection.
+            std::map<std::wstring, std::vector<FakeBlockCursor::Row>>   results; ///< Rows served per SQL text.
+            std::atomic<int>                                            closes{0}; ///< SQLFreeStmt calls closing a cursor.
+            std::atomic<intptr_t>                                       nextHandle{0x100}; ///< Last handle value handed out.
+
+            /**
+             * @brief Creates a permissive mock that looks up the rows to serve by the executed SQL text.
+             */
+            std::unique_ptr<odbc::OdbcInterface> makeInterface() {
+                auto mock = std::make_unique<testing::NiceMock<MockOdbcInterface>>();
+                auto fake = std::make_unique<FakeBlockCursor>(*mock, std::vector<FakeBlockCursor::Row>());
+                FakeBlockCursor* cursor = fake.get();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    fakes.push_back(std::move(fake));
+                }
+                ON_CALL(*mock, SQLAllocHandle(testing::_, testing::_, testing::_))
+                    .WillByDefault([this](SQLSMALLINT, SQLHANDLE, SQLHANDLE* handle) {
+                        *handle = reinterpret_cast<SQLHANDLE>(nextHandle++);
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                    .WillByDefault([this, cursor](SQLHSTMT, SQLWCHAR* text, SQLINTEGER) {
+                        std::wstring sql;
+                        for (; *text; text++) {
+                            sql.push_back(static_cast<wchar_t>(*text));
+                        }
+                        auto it = results.find(sql);
+                        if (it == results.end()) {
+                            return SQL_ERROR;
+                        }
+                        cursor->reset(it->second);
+                        return SQL_SUCCESS;
+                    });
+                ON_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                    .WillByDefault([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+                ON_CALL(*mock, SQLFreeStmt(testing::_, SQL_CLOSE))
+                    .WillByDefault([this](SQLHSTMT, SQLUSMALLINT) { closes++; return SQL_SUCCESS; });
+                ON_CALL(*mock, SQLGetDiagRec(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillByDefault(testing::Return(SQL_NO_DATA));
+                return mock;
+            }
+
+            /**
+             * @brief Creates a pool of up to `maxSize` connections using makeInterface().
+             */
+            std::unique_ptr<ConnectionPool> makePool(size_t maxSize) {
+                ConnectionPool::Config config;
+                config.minSize = 0;
+                config.maxSize = maxSize;
+                config.validateOnCheckout = false;
+                return std::make_unique<ConnectionPool>(L"MyDSN", L"user", L"pass", config,
+                                                        [this]() { return makeInterface(); });
+            }
+
+            /**
+             * @brief Serves keys 0 to count - 1, plus a NULL key, split as the query's partitions select them.
+             */
+            void serveKeys(const ParallelQuery& query, size_t partitions, size_t count) {
+                for (size_t p = 0; p < partitions; p++) {
+                    std::vector<FakeBlockCursor::Row> rows;
+                    if (p == 0) {
+                        rows.push_back({std::nullopt, L"null"});
+                    }
+                    for (size_t key = p; key < count; key += partitions) {
+                        rows.push_back({std::to_wstring(key), L"name" + std::to_wstring(key)});
+                    }
+                    results[query.partitionQuery(p)] = rows;
+                }
+            }
+        };
+
+        /**
+         * @test Partitioning_BuildsPredicates
+         * @brief Tests that modulo and range partitions cover every key, with NULLs in the first partition.
+         */
+        TEST(PartitioningTest, Partitioning_BuildsPredicates) {
+            Partitioning modulo = Partitioning::modulo(L"id", 4);
+            EXPECT_EQ(modulo.predicate(0), L"({fn MOD(id, 4)} IN (0, -0) OR id IS NULL)");
+            EXPECT_EQ(modulo.predicate(3), L"({fn MOD(id, 4)} IN (3, -3))");
+
+            Partitioning range = Partitioning::range(L"id", 0, 9, 4); // Widths 3, 3, 2, 2
+            EXPECT_EQ(range.predicate(0), L"(id < 3 OR id IS NULL)");
+            EXPECT_EQ(range.predicate(1), L"(id >= 3 AND id < 6)");
+            EXPECT_EQ(range.predicate(2), L"(id >= 6 AND id < 8)");
+            EXPECT_EQ(range.predicate(3), L"(id >= 8)");
+
+            Partitioning wide = Partitioning::range(L"id", INT64_MIN, INT64_MAX, 2);
+            EXPECT_EQ(wide.predicate(1), L"(id >= 0)");
+            EXPECT_EQ(Partitioning::modulo(L"id", 1).predicate(0), L"(1 = 1)");
+
+            EXPECT_THROW(Partitioning::modulo(L"id", 0), std::invalid_argument);
+            EXPECT_THROW(Partitioning::range(L"id", 5, 4, 2), std::invalid_argument);
+        }
+
+        /**
+         * @test PartitionQuery_ReplacesEveryPlaceholder
+         * @brief Tests that the predicate is substituted for each placeholder and SQL without one is rejected.
+         */
+        TEST_F(ParallelQueryTest, PartitionQuery_ReplacesEveryPlaceholder) {
+            auto pool = makePool(2);
+            ParallelQuery query(*pool, L"SELECT id FROM a WHERE {partition} UNION ALL SELECT id FROM b WHERE {partition}",
+                                Partitioning::range(L"id", 0, 99, 2));
+            EXPECT_EQ(query.partitionQuery(1), L"SELECT id FROM a WHERE (id >= 50) UNION ALL SELECT id FROM b WHERE (id >= 50)");
+            EXPECT_THROW(ParallelQuery(*pool, L"SELECT id FROM a", Partitioning::modulo(L"id", 2)), std::invalid_argument);
+        }
+
+        /**
+         * @test ForEachRow_DeliversEveryPartition
+         * @brief Tests that all rows of all partitions are delivered when there are more partitions than connections.
+         */
+        TEST_F(ParallelQueryTest, ForEachRow_DeliversEveryPartition) {
+            OdbcLogger::logInfo("Entering ForEachRow_DeliversEveryPartition");
+
+            auto pool = makePool(2);
+            ParallelQuery query(*pool, L"SELECT id, name FROM t WHERE {partition}", Partitioning::modulo(L"id", 5), 3);
+            serveKeys(query, 5, 40);
+
+            std::mutex seenMutex;
+            std::multiset<std::wstring> seen;
+            const size_t delivered = query.forEachRow([&](const ResultSet::Row& row) {
+                std::lock_guard<std::mutex> lock(seenMutex);
+                seen.insert(row.isNull(0) ? L"NULL" : std::wstring(row[0]));
+            });
+
+            EXPECT_EQ(delivered, 41u);
+            ASSERT_EQ(seen.size(), 41u);
+            for (size_t key = 0; key < 40; key++) {
+                EXPECT_EQ(seen.count(std::to_wstring(key)), 1u);
+            }
+            EXPECT_EQ(seen.count(L"NULL"), 1u);
+            EXPECT_LE(pool->size(), 2u);
+            EXPECT_EQ(pool->idleCount(), pool->size());
+            EXPECT_EQ(closes, 5);
+
+            OdbcLogger::logInfo("Exiting ForEachRow_DeliversEveryPartition");
+        }
+
+        /**
+         * @test ForEachRowOrdered_MergesSortedPartitions
+         * @brief Tests that sorted partitions are merged into one sorted stream, comparing keys as numbers.
+         */
+        TEST_F(ParallelQueryTest, ForEachRowOrdered_MergesSortedPartitions) {
+            OdbcLogger::logInfo("Entering ForEachRowOrdered_MergesSortedPartitions");
+
+            auto pool = makePool(3);
+            ParallelQuery query(*pool, L"SELECT id, name FROM t WHERE {partition} ORDER BY id",
+                                Partitioning::modulo(L"id", 3), 2);
+            serveKeys(query, 3, 30);
+
+            std::vector<std::wstring> keys;
+            const size_t delivered = query.forEachRowOrdered(ParallelQuery::orderBy(0, true), [&](const ResultSet::Row& row) {
+                keys.push_back(row.isNull(0) ? L"NULL" : std::wstring(row[0]) + L":" + std::wstring(row[1]));
+            });
+
+            EXPECT_EQ(delivered, 31u);
+            ASSERT_EQ(keys.size(), 31u);
+            EXPECT_EQ(keys[0], L"NULL");
+            for (size_t key = 0; key < 30; key++) {
+                EXPECT_EQ(keys[key + 1], std::to_wstring(key) + L":name" + std::to_wstring(key));
+            }
+            EXPECT_EQ(pool->idleCount(), pool->size());
+
+            EXPECT_THROW(ParallelQuery(*pool, L"SELECT id FROM t WHERE {partition}", Partitioning::modulo(L"id", 4))
+                             .forEachRowOrdered(ParallelQuery::orderBy(0), [](const ResultSet::Row&) {}),
+                         std::invalid_argument);
+
+            OdbcLogger::logInfo("Exiting ForEachRowOrdered_MergesSortedPartitions");
+        }
+
+        /**
+         * @test ForEachRow_StopsOnFailure
+         * @brief Tests that a failing partition or callback stops the run, closes cursors and rethrows.
+         */
+        TEST_F(ParallelQueryTest, ForEachRow_StopsOnFailure) {
+            OdbcLogger::logInfo("Entering ForEachRow_StopsOnFailure");
+
+            auto pool = makePool(3);
+            ParallelQuery query(*pool, L"SELECT id, name FROM t WHERE {partition} ORDER BY id",
+                                Partitioning::modulo(L"id", 3), 2);
+            serveKeys(query, 3, 300);
+
+            std::atomic<int> calls{0};
+            EXPECT_THROW(query.forEachRow([&](const ResultSet::Row&) {
+                if (++calls == 10) {
+                    throw std::runtime_error("consumer failed");
+                }
+            }), std::runtime_error);
+            EXPECT_LT(calls, 300);
+            EXPECT_EQ(pool->idleCount(), pool->size());
+
+            calls = 0;
+            EXPECT_THROW(query.forEachRowOrdered(ParallelQuery::orderBy(0, true), [&](const ResultSet::Row&) {
+                if (++calls == 10) {
+                    throw std::runtime_error("consumer failed");
+                }
+            }), std::runtime_error);
+            EXPECT_EQ(calls, 10);
+
+            results.erase(query.partitionQuery(2)); // Partition 2 now fails to execute
+            EXPECT_THROW(query.forEachRowOrdered(ParallelQuery::orderBy(0, true), [](const ResultSet::Row&) {}),
+                         OdbcException);
+            EXPECT_EQ(pool->idleCount(), pool->size());
+
+            OdbcLogger::logInfo("Exiting ForEachRow_StopsOnFailure");
+        }
+
+        /**
+         * @test OrderBy_SortsNullsFirstAndHonoursDirection
+         * @brief Tests numeric, text and descending column orders.
+         */
+        TEST_F(ParallelQueryTest, OrderBy_SortsNullsFirstAndHonoursDirection) {
+            ResultSet rows(1);
+            auto mock = std::make_unique<testing::NiceMock<MockOdbcInterface>>();
+            FakeBlockCursor fake(*mock, {{L"9"}, {L"10"}, {std::nullopt}, {L"-2.5"}});
+            RowsetBuffer rowset(mock.get(), nullptr);
+            ASSERT_TRUE(SQL_SUCCEEDED(rowset.bind(1, 4)));
+            ASSERT_TRUE(SQL_SUCCEEDED(rowset.fetch()));
+            rows.append(rowset);
+            rowset.unbind();
+
+            const ParallelQuery::RowOrder numeric = ParallelQuery::orderBy(0, true);
+            const ParallelQuery::RowOrder text = ParallelQuery::orderBy(0);
+            const ParallelQuery::RowOrder descending = ParallelQuery::orderBy(0, true, true);
+            EXPECT_TRUE(numeric(rows[0], rows[1]));
+            EXPECT_FALSE(text(rows[0], rows[1]));
+            EXPECT_TRUE(numeric(rows[2], rows[3]));
+            EXPECT_TRUE(numeric(rows[3], rows[0]));
+            EXPECT_TRUE(descending(rows[1], rows[0]));
+            EXPECT_TRUE(descending(rows[0], rows[2]));
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_parallelquery_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,286 @@
+#include <test_odbcwrapper.h>
+#include <odbclogger.h>
+
+#include <chrono>
+#include <thread>
+
+using ps::odbc::ColumnBinding;
+using ps::odbc::OdbcException;
+using ps::odbc::OdbcLogger;
+using ps::odbc::PrefetchCursor;
+using ps::odbc::PrefetchOptions;
+using ps::odbc::PrefetchStats;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class PrefetchCursorTest
+         * @brief Fixture that connects the wrapper so prefetch cursors read the rows of a fake block cursor.
+         */
+        class PrefetchCursorTest : public ConnectedOdbcWrapperTest {
+        protected:
+            void SetUp() override {
+                ConnectedOdbcWrapperTest::SetUp();
+                expectBlockCursor(2);
+            }
+
+            /**
+             * @brief Builds `count` rows of an id and a label, with a NULL label on every fifth row.
+             */
+            static std::vector<FakeBlockCursor::Row> makeRows(int count) {
+                std::vector<FakeBlockCursor::Row> rows;
+                for (int i = 0; i < count; i++) {
+                    rows.push_back({std::to_wstring(i),
+                                    i % 5 == 4 ? std::nullopt : std::optional<std::wstring>(L"row " + std::to_wstring(i))});
+                }
+                return rows;
+            }
+        };
+
+        /**
+         * @test PrefetchCursor_ReadsEveryRowInOrder
+         * @brief Tests that rows fetched on the background thread reach the consumer in order, with every rowset counted.
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_ReadsEveryRowInOrder) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_ReadsEveryRowInOrder");
+
+            FakeBlockCursor fake(*mock, makeRows(20));
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLCancel(testing::_)).Times(0);
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, SQL_CLOSE)).Times(0);
+
+            PrefetchOptions options;
+            options.depth = 2;
+            options.rowsetSize = 3;
+            PrefetchCursor cursor = wrapper->openPrefetchCursor(options);
+            EXPECT_EQ(cursor.columnCount(), 2);
+
+            int expected = 0;
+            for (const PrefetchCursor::Row& row : cursor) {
+                ASSERT_EQ(row[0], std::to_wstring(expected));
+                ASSERT_EQ(row[1], expected % 5 == 4 ? L"NULL" : L"row " + std::to_wstring(expected));
+                ASSERT_EQ(cursor.isNull(1), expected % 5 == 4);
+                expected++;
+            }
+            EXPECT_EQ(expected, 20);
+            EXPECT_TRUE(cursor.done());
+            EXPECT_FALSE(cursor.next());
+            EXPECT_EQ(fake.roundTrips(), 8); // Seven rowsets and the final empty fetch
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            PrefetchStats stats = cursor.stats();
+            EXPECT_EQ(stats.rowsets, 7u);
+            EXPECT_EQ(stats.rows, 20u);
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_ReadsEveryRowInOrder");
+        }
+
+        /**
+         * @test PrefetchCursor_ReadsTypedValues
+         * @brief Tests that natively bound rowsets are read in place through current().
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_ReadsTypedValues) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_ReadsTypedValues");
+
+            FakeBlockCursor fake(*mock, {{L"7", L"seven"}, {L"8", std::nullopt}, {L"9", L"nine"}}, {SQL_BIGINT, SQL_VARCHAR});
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            PrefetchOptions options;
+            options.rowsetSize = 2;
+            options.binding = ColumnBinding::Native;
+            PrefetchCursor cursor = wrapper->openPrefetchCursor(options);
+            EXPECT_TRUE(cursor.isNull(0)); // No current row yet
+
+            std::vector<int64_t> ids;
+            std::vector<std::string> names;
+            while (cursor.next()) {
+                ids.push_back(*cursor.current().get<int64_t>(0));
+                std::optional<std::string_view> name = cursor.current().get<std::string_view>(1);
+                names.emplace_back(name ? *name : "NULL");
+            }
+            EXPECT_EQ(ids, std::vector<int64_t>({7, 8, 9}));
+            EXPECT_EQ(names, std::vector<std::string>({"seven", "NULL", "nine"}));
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_ReadsTypedValues");
+        }
+
+        /**
+         * @test PrefetchCursor_CancelsWhenStoppedEarly
+         * @brief Tests that a moved cursor keeps its position and that stopping early cancels the fetch thread without running ahead.
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_CancelsWhenStoppedEarly) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_CancelsWhenStoppedEarly");
+
+            FakeBlockCursor fake(*mock, makeRows(1000));
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLCancel(testing::_)).Times(1);
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, SQL_CLOSE)).Times(1);
+
+            PrefetchOptions options;
+            options.depth = 2;
+            options.rowsetSize = 10;
+            {
+                PrefetchCursor cursor = wrapper->openPrefetchCursor(options);
+                for (int i = 0; i < 15; i++) {
+                    ASSERT_TRUE(cursor.next());
+                }
+                EXPECT_EQ(cursor.row()[0], L"14");
+                PrefetchCursor moved(std::move(cursor));
+                EXPECT_TRUE(cursor.done());
+                EXPECT_TRUE(moved.next());
+                EXPECT_EQ(moved.row()[0], L"15");
+                moved.cancel();
+                EXPECT_TRUE(moved.done());
+                EXPECT_FALSE(moved.next());
+                moved.cancel(); // Stopping twice does nothing more
+            }
+            EXPECT_LE(fake.roundTrips(), 5); // Never more than depth rowsets ahead of the consumer
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_CancelsWhenStoppedEarly");
+        }
+
+        /**
+         * @test PrefetchCursor_RaisesFetchErrorsOnTheConsumer
+         * @brief Tests that a fetch error on the background thread is rethrown by next() once the consumer reaches it.
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_RaisesFetchErrorsOnTheConsumer) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_RaisesFetchErrorsOnTheConsumer");
+
+            FakeBlockCursor fake(*mock, makeRows(10));
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0))
+                .WillOnce(testing::DoDefault())
+                .WillOnce(testing::Return(SQL_ERROR));
+
+            PrefetchOptions options;
+            options.rowsetSize = 4;
+            PrefetchCursor cursor = wrapper->openPrefetchCursor(options);
+            for (int i = 0; i < 4; i++) {
+                ASSERT_TRUE(cursor.next());
+            }
+            EXPECT_THROW(cursor.next(), OdbcException);
+            EXPECT_TRUE(cursor.done());
+            EXPECT_FALSE(cursor.next());
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_RaisesFetchErrorsOnTheConsumer");
+        }
+
+        /**
+         * @test PrefetchCursor_RaisesFetchExceptionsOnTheConsumer
+         * @brief Tests that an exception thrown by a fetch on the background thread ends fetching and is rethrown by next().
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_RaisesFetchExceptionsOnTheConsumer) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_RaisesFetchExceptionsOnTheConsumer");
+
+            FakeBlockCursor fake(*mock, makeRows(10));
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0))
+                .WillOnce(testing::DoDefault())
+                .WillOnce(testing::Throw(std::bad_alloc()));
+
+            PrefetchOptions options;
+            options.rowsetSize = 4;
+            PrefetchCursor cursor = wrapper->openPrefetchCursor(options);
+            for (int i = 0; i < 4; i++) {
+                ASSERT_TRUE(cursor.next());
+            }
+            EXPECT_THROW(cursor.next(), std::bad_alloc);
+            EXPECT_TRUE(cursor.done());
+            EXPECT_FALSE(cursor.next());
+            EXPECT_EQ(fake.boundColumns(), 0u);
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_RaisesFetchExceptionsOnTheConsumer");
+        }
+
+        /**
+         * @test PrefetchCursor_ReportsBindFailureBeforeUnbinding
+         * @brief Tests that a buffer failing to bind raises its SQLSTATE and the buffers bound before it are released afterwards.
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_ReportsBindFailureBeforeUnbinding) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_ReportsBindFailureBeforeUnbinding");
+
+            FakeBlockCursor fake(*mock, makeRows(10));
+            // Unbinding the first buffer discards the record, as it does with a driver
+            StatementDiagnostics diagnostics(*mock, L"HY001", 0);
+            int binds = 0;
+            int unbinds = 0;
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillRepeatedly(diagnostics.posting([&binds, &unbinds](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER buffer, SQLLEN, SQLLEN*) {
+                    if (!buffer) {
+                        unbinds++;
+                        return SQL_SUCCESS;
+                    }
+                    return ++binds == 3 ? SQL_ERROR : SQL_SUCCESS; // The second buffer's first column
+                }));
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(0);
+
+            PrefetchOptions options;
+            options.depth = 1;
+            options.rowsetSize = 4;
+            try {
+                wrapper->openPrefetchCursor(options);
+                FAIL() << "Expected OdbcException";
+            } catch (const OdbcException& e) {
+                EXPECT_EQ(e.sqlState(), "HY001");
+            }
+            EXPECT_EQ(unbinds, 2); // Both columns of the first buffer
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_ReportsBindFailureBeforeUnbinding");
+        }
+
+        /**
+         * @test PrefetchCursor_MeasuresStallsOnBothSides
+         * @brief Tests that waits for slow fetches and for a slow consumer are reported as consumer and producer stalls.
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_MeasuresStallsOnBothSides) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_MeasuresStallsOnBothSides");
+
+            FakeBlockCursor fake(*mock, makeRows(12));
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            PrefetchOptions options;
+            options.depth = 1;
+            options.rowsetSize = 2;
+
+            fake.setLatency(std::chrono::milliseconds(5)); // Slow fetches: the consumer waits
+            PrefetchCursor slowFetch = wrapper->openPrefetchCursor(options);
+            while (slowFetch.next()) {
+            }
+            EXPECT_GE(slowFetch.stats().consumerStall, std::chrono::milliseconds(5));
+
+            fake.reset(makeRows(12));
+            fake.setLatency(std::chrono::milliseconds(0));
+            PrefetchCursor slowConsumer = wrapper->openPrefetchCursor(options);
+            while (slowConsumer.next()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2)); // Slow consumer: the fetch thread waits
+            }
+            EXPECT_GE(slowConsumer.stats().producerStall, std::chrono::milliseconds(5));
+            EXPECT_EQ(slowConsumer.stats().rows, 12u);
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_MeasuresStallsOnBothSides");
+        }
+
+        /**
+         * @test PrefetchCursor_IsEmptyWhenNotConnected
+         * @brief Tests that a cursor opened without a connection yields no rows and starts no fetches.
+         */
+        TEST_F(PrefetchCursorTest, PrefetchCursor_IsEmptyWhenNotConnected) {
+            OdbcLogger::logInfo("Entering PrefetchCursor_IsEmptyWhenNotConnected");
+
+            wrapper->disconnect();
+            PrefetchCursor cursor = wrapper->openPrefetchCursor();
+            EXPECT_TRUE(cursor.done());
+            EXPECT_FALSE(cursor.next());
+            EXPECT_EQ(cursor.columnCount(), 0);
+            EXPECT_EQ(cursor.begin(), cursor.end());
+            EXPECT_EQ(cursor.stats().rowsets, 0u);
+
+            OdbcLogger::logInfo("Exiting PrefetchCursor_IsEmptyWhenNotConnected");
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_prefetchcursor_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
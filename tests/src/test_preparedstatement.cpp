@@ -0,0 +1,494 @@
+#include <test_odbcwrapper.h>
+#include <odbclogger.h>
+#include <cwchar>
+
+using ps::odbc::OdbcLogger;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class PreparedStatementTest
+         * @brief Fixture whose wrapper is connected and hands out statement handles numbered from 1.
+         */
+        class PreparedStatementTest : public ConnectedOdbcWrapperTest {
+        };
+
+        /**
+         * @test Prepare_CachesStatementBySqlText
+         * @brief Tests that preparing the same SQL twice reuses the cached statement.
+         */
+        TEST_F(PreparedStatementTest, Prepare_CachesStatementBySqlText) {
+            OdbcLogger::logInfo("Entering Prepare_CachesStatementBySqlText");
+
+            EXPECT_CALL(*mock, SQLPrepare(reinterpret_cast<SQLHSTMT>(2), testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            auto first = wrapper->prepare(L"SELECT name FROM users WHERE id = ?");
+            auto second = wrapper->prepare(L"SELECT name FROM users WHERE id = ?");
+
+            ASSERT_NE(first, nullptr);
+            EXPECT_EQ(first, second);
+            EXPECT_EQ(first->getHStmt(), reinterpret_cast<SQLHSTMT>(2));
+            EXPECT_EQ(wrapper->getStatementCache().hits(), 1u);
+            EXPECT_EQ(wrapper->getStatementCache().misses(), 1u);
+
+            OdbcLogger::logInfo("Exiting Prepare_CachesStatementBySqlText");
+        }
+
+        /**
+         * @test Prepare_EvictsLeastRecentlyUsed
+         * @brief Tests that the cache evicts the least recently used statement and frees its handle.
+         */
+        TEST_F(PreparedStatementTest, Prepare_EvictsLeastRecentlyUsed) {
+            OdbcLogger::logInfo("Entering Prepare_EvictsLeastRecentlyUsed");
+
+            wrapper->setStatementCacheCapacity(2);
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .Times(4)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, reinterpret_cast<SQLHSTMT>(3)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            wrapper->prepare(L"SELECT 1"); // Handle 2
+            wrapper->prepare(L"SELECT 2"); // Handle 3
+            wrapper->prepare(L"SELECT 1"); // Hit, now most recently used
+            wrapper->prepare(L"SELECT 3"); // Handle 4, evicts "SELECT 2"
+            auto again = wrapper->prepare(L"SELECT 2"); // Miss, handle 5
+
+            EXPECT_EQ(again->getHStmt(), reinterpret_cast<SQLHSTMT>(5));
+            EXPECT_EQ(wrapper->getStatementCache().size(), 2u);
+            EXPECT_EQ(wrapper->getStatementCache().hits(), 1u);
+            EXPECT_EQ(wrapper->getStatementCache().misses(), 4u);
+
+            OdbcLogger::logInfo("Exiting Prepare_EvictsLeastRecentlyUsed");
+        }
+
+        /**
+         * @test Execute_BindsTypedParametersOnce
+         * @brief Tests that typed parameters are bound once and re-executions only call SQLExecute.
+         */
+        TEST_F(PreparedStatementTest, Execute_BindsTypedParametersOnce) {
+            OdbcLogger::logInfo("Entering Execute_BindsTypedParametersOnce");
+
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 2, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 3, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WVARCHAR, 5, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLULEN, SQLSMALLINT, SQLPOINTER value, SQLLEN, SQLLEN* indicator) {
+                    const SQLWCHAR* text = static_cast<const SQLWCHAR*>(value);
+                    EXPECT_EQ(std::wstring(text, text + 5), L"alice");
+                    EXPECT_EQ(*indicator, static_cast<SQLLEN>(5 * sizeof(SQLWCHAR)));
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 4, SQL_PARAM_INPUT, SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .Times(2)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, SQL_CLOSE))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            auto statement = wrapper->prepare(L"INSERT INTO users VALUES (?, ?, ?, ?)");
+            SQL_TIMESTAMP_STRUCT created = {2024, 1, 31, 12, 30, 0, 0};
+            statement->setInt(1, 42);
+            statement->setDouble(2, 3.5);
+            statement->setString(3, L"alice");
+            statement->setTimestamp(4, created);
+            EXPECT_TRUE(statement->execute());
+
+            statement->setInt(1, 43); // Same storage, no rebind needed
+            EXPECT_TRUE(statement->execute());
+
+            OdbcLogger::logInfo("Exiting Execute_BindsTypedParametersOnce");
+        }
+
+        /**
+         * @test Execute_FailureHandlesError
+         * @brief Tests that a failing SQLExecute is reported through handleError.
+         */
+        TEST_F(PreparedStatementTest, Execute_FailureHandlesError) {
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+
+            auto statement = wrapper->prepare(L"DELETE FROM users");
+            EXPECT_THROW(statement->execute(), std::runtime_error);
+        }
+
+        /**
+         * @test Prepare_FailureHandlesError
+         * @brief Tests that a failing SQLPrepare throws and does not cache the statement.
+         */
+        TEST_F(PreparedStatementTest, Prepare_FailureHandlesError) {
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, reinterpret_cast<SQLHSTMT>(2)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            EXPECT_THROW(wrapper->prepare(L"SELEC oops"), std::runtime_error);
+            EXPECT_EQ(wrapper->getStatementCache().size(), 0u);
+        }
+
+        /**
+         * @test Disconnect_ClosesCachedStatements
+         * @brief Tests that disconnecting frees cached statement handles, even ones still referenced.
+         */
+        TEST_F(PreparedStatementTest, Disconnect_ClosesCachedStatements) {
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, reinterpret_cast<SQLHSTMT>(2)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            auto statement = wrapper->prepare(L"SELECT 1");
+            wrapper->disconnect();
+
+            EXPECT_EQ(statement->getHStmt(), static_cast<SQLHSTMT>(SQL_NULL_HSTMT));
+            EXPECT_EQ(wrapper->getStatementCache().size(), 0u);
+        }
+
+        /**
+         * @test Disconnect_ClosesEvictedStatementsOnce
+         * @brief Tests that statements evicted or never cached are freed once at disconnect, not again on release.
+         */
+        TEST_F(PreparedStatementTest, Disconnect_ClosesEvictedStatementsOnce) {
+            wrapper->setStatementCacheCapacity(1);
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .Times(3)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, reinterpret_cast<SQLHSTMT>(2)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, reinterpret_cast<SQLHSTMT>(3)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, reinterpret_cast<SQLHSTMT>(4)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            auto evicted = wrapper->prepare(L"SELECT 1"); // Handle 2
+            wrapper->prepare(L"SELECT 2"); // Handle 3, evicts "SELECT 1"
+            wrapper->setStatementCacheCapacity(0);
+            auto uncached = wrapper->prepare(L"SELECT 3"); // Handle 4, never cached
+
+            wrapper->disconnect();
+            EXPECT_EQ(evicted->getHStmt(), static_cast<SQLHSTMT>(SQL_NULL_HSTMT));
+            EXPECT_EQ(uncached->getHStmt(), static_cast<SQLHSTMT>(SQL_NULL_HSTMT));
+
+            evicted.reset();
+            uncached.reset();
+        }
+
+        /**
+         * @test ExecuteBatch_BindsColumnArraysInOneRoundTrip
+         * @brief Tests that a batch binds one array per parameter, executes once and sums row counts.
+         */
+        TEST_F(PreparedStatementTest, ExecuteBatch_BindsColumnArraysInOneRoundTrip) {
+            OdbcLogger::logInfo("Entering ExecuteBatch_BindsColumnArraysInOneRoundTrip");
+
+            SQLUSMALLINT* status = nullptr;
+            SQLULEN* processed = nullptr;
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)3, 0))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_PARAM_STATUS_PTR, testing::_, 0))
+                .WillOnce([&status](SQLHSTMT, SQLINTEGER, SQLPOINTER value, SQLINTEGER) {
+                    status = static_cast<SQLUSMALLINT*>(value);
+                    return SQL_SUCCESS;
+                })
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_PARAMS_PROCESSED_PTR, testing::_, 0))
+                .WillOnce([&processed](SQLHSTMT, SQLINTEGER, SQLPOINTER value, SQLINTEGER) {
+                    processed = static_cast<SQLULEN*>(value);
+                    return SQL_SUCCESS;
+                })
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT, testing::_, testing::_, testing::_, static_cast<SQLLEN>(sizeof(SQLBIGINT)), testing::_))
+                .WillOnce([](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLULEN, SQLSMALLINT, SQLPOINTER value, SQLLEN, SQLLEN* indicators) {
+                    const SQLBIGINT* ids = static_cast<const SQLBIGINT*>(value);
+                    EXPECT_EQ(ids[0], 1);
+                    EXPECT_EQ(ids[2], 3);
+                    EXPECT_EQ(indicators[1], 0);
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 2, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WVARCHAR, 5, testing::_, testing::_, static_cast<SQLLEN>(6 * sizeof(SQLWCHAR)), testing::_))
+                .WillOnce([](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLULEN, SQLSMALLINT, SQLPOINTER value, SQLLEN, SQLLEN* indicators) {
+                    const SQLWCHAR* names = static_cast<const SQLWCHAR*>(value);
+                    EXPECT_EQ(std::wstring(names + 6, names + 9), L"bob");
+                    EXPECT_EQ(names[9], 0);
+                    EXPECT_EQ(indicators[1], static_cast<SQLLEN>(3 * sizeof(SQLWCHAR)));
+                    EXPECT_EQ(indicators[2], SQL_NULL_DATA);
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .WillOnce([&status, &processed](SQLHSTMT) {
+                    std::fill(status, status + 3, static_cast<SQLUSMALLINT>(SQL_PARAM_SUCCESS));
+                    *processed = 3;
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLRowCount(testing::_, testing::_))
+                .Times(3)
+                .WillRepeatedly([](SQLHSTMT, SQLLEN* count) {
+                    *count = 1;
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLMoreResults(testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, SQL_RESET_PARAMS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            auto statement = wrapper->prepare(L"INSERT INTO users (id, name) VALUES (?, ?)");
+            ps::odbc::ParameterBatch batch(3);
+            batch.setInt(1, 0, 1);
+            batch.setInt(1, 1, 2);
+            batch.setInt(1, 2, 3);
+            batch.setString(2, 0, L"alice");
+            batch.setString(2, 1, L"bob");
+            batch.setNull(2, 2);
+
+            ps::odbc::BatchResult result = statement->executeBatch(batch);
+
+            EXPECT_EQ(result.rowCount, 3);
+            EXPECT_EQ(result.processed, 3u);
+            EXPECT_EQ(result.failedRows(), 0u);
+
+            OdbcLogger::logInfo("Exiting ExecuteBatch_BindsColumnArraysInOneRoundTrip");
+        }
+
+        /**
+         * @test ExecuteBatch_ReportsFailedRows
+         * @brief Tests that a partially applied batch returns per-row status instead of throwing.
+         */
+        TEST_F(PreparedStatementTest, ExecuteBatch_ReportsFailedRows) {
+            SQLUSMALLINT* status = nullptr;
+            SQLULEN* processed = nullptr;
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, 0))
+                .WillRepeatedly([&status, &processed](SQLHSTMT, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER) {
+                    if (attribute == SQL_ATTR_PARAM_STATUS_PTR && value) {
+                        status = static_cast<SQLUSMALLINT*>(value);
+                    } else if (attribute == SQL_ATTR_PARAMS_PROCESSED_PTR && value) {
+                        processed = static_cast<SQLULEN*>(value);
+                    }
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .WillOnce([&status, &processed](SQLHSTMT) {
+                    status[0] = SQL_PARAM_SUCCESS;
+                    status[1] = SQL_PARAM_ERROR;
+                    *processed = 2;
+                    return SQL_ERROR;
+                });
+            EXPECT_CALL(*mock, SQLRowCount(testing::_, testing::_))
+                .WillOnce([](SQLHSTMT, SQLLEN* count) {
+                    *count = 1;
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLMoreResults(testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, SQL_RESET_PARAMS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+
+            auto statement = wrapper->prepare(L"UPDATE accounts SET balance = ?");
+            ps::odbc::ParameterBatch batch(2);
+            batch.setDouble(1, 0, 10.0);
+            batch.setDouble(1, 1, -1.0);
+
+            ps::odbc::BatchResult result;
+            EXPECT_NO_THROW(result = statement->executeBatch(batch));
+            EXPECT_EQ(result.rowCount, 1);
+            EXPECT_EQ(result.processed, 2u);
+            EXPECT_EQ(result.failedRows(), 1u);
+        }
+
+        /**
+         * @test ExecuteBatch_FailureKeepsDiagnostics
+         * @brief Tests that a batch failing outright throws with its SQLSTATE and still unbinds the arrays.
+         */
+        TEST_F(PreparedStatementTest, ExecuteBatch_FailureKeepsDiagnostics) {
+            OdbcLogger::logInfo("Entering ExecuteBatch_FailureKeepsDiagnostics");
+
+            // Resetting the batch discards the record, as it does with a driver
+            StatementDiagnostics diagnostics(*mock, L"23000", 2627);
+            std::vector<SQLPOINTER> processedPointers;
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, 0))
+                .WillRepeatedly([&processedPointers, clear = diagnostics.clearing(SQL_SUCCESS)](SQLHSTMT hStmt, SQLINTEGER attribute,
+                                                                                            SQLPOINTER value, SQLINTEGER length) {
+                    if (attribute == SQL_ATTR_PARAMS_PROCESSED_PTR) {
+                        processedPointers.push_back(value);
+                    }
+                    return clear(hStmt, attribute, value, length);
+                });
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .WillOnce(diagnostics.posting([](SQLHSTMT) { return SQL_ERROR; }));
+            EXPECT_CALL(*mock, SQLRowCount(testing::_, testing::_)).Times(0);
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, SQL_RESET_PARAMS))
+                .WillOnce(diagnostics.clearing(SQL_SUCCESS));
+
+            auto statement = wrapper->prepare(L"INSERT INTO users (id) VALUES (?)");
+            ps::odbc::ParameterBatch batch(2);
+            batch.setInt(1, 0, 1);
+            batch.setInt(1, 1, 1);
+
+            try {
+                statement->executeBatch(batch);
+                FAIL() << "Expected OdbcException";
+            } catch (const OdbcException& e) {
+                EXPECT_EQ(e.sqlState(), "23000");
+                EXPECT_EQ(e.nativeError(), 2627);
+            }
+            ASSERT_EQ(processedPointers.size(), 2u);
+            EXPECT_EQ(processedPointers.back(), nullptr); // No pointer into the result outlives the call
+
+            OdbcLogger::logInfo("Exiting ExecuteBatch_FailureKeepsDiagnostics");
+        }
+
+        /**
+         * @test ExecuteBatch_EmptyColumnLeavesStatementUsable
+         * @brief Tests that a batch with an unset column is rejected before any batch attribute is set.
+         */
+        TEST_F(PreparedStatementTest, ExecuteBatch_EmptyColumnLeavesStatementUsable) {
+            OdbcLogger::logInfo("Entering ExecuteBatch_EmptyColumnLeavesStatementUsable");
+
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(0);
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            auto statement = wrapper->prepare(L"INSERT INTO users (id, name) VALUES (?, ?)");
+            ps::odbc::ParameterBatch batch(2);
+            batch.setString(2, 0, L"alice");
+            batch.setString(2, 1, L"bob");
+
+            EXPECT_THROW(statement->executeBatch(batch), std::invalid_argument);
+
+            statement->setInt(1, 7);
+            EXPECT_TRUE(statement->execute());
+
+            OdbcLogger::logInfo("Exiting ExecuteBatch_EmptyColumnLeavesStatementUsable");
+        }
+
+        /**
+         * @test Unicode_RoundTripsThroughBindAndFetch
+         * @brief Tests that text outside the Basic Multilingual Plane is bound as surrogate pairs and fetched back intact.
+         *
+         * The bytes bound for the parameter are served back through SQLGetData, with the pair
+         * split across two chunks, and the same value is read through the block cursor.
+         */
+        TEST_F(PreparedStatementTest, Unicode_RoundTripsThroughBindAndFetch) {
+            OdbcLogger::logInfo("Entering Unicode_RoundTripsThroughBindAndFetch");
+
+            // 4093 + 1 + 2 code units: the first 8192-byte SQLGetData chunk ends between the surrogates.
+            const std::wstring value = std::wstring(4093, L'a') + L"é\U0001F600";
+            const SQLULEN units = 4096;
+
+            std::vector<unsigned char> sent;
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS))
+                .WillOnce([](SQLHSTMT, SQLWCHAR* text, SQLINTEGER) {
+                    const SqlWString sql(text);
+                    EXPECT_EQ(sql.substr(sql.size() - 2), SqlWString({0xD83D, 0xDE00}));
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WVARCHAR, units, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce([&sent](SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLULEN, SQLSMALLINT, SQLPOINTER value, SQLLEN, SQLLEN* indicator) {
+                    EXPECT_EQ(*indicator, static_cast<SQLLEN>(units * sizeof(SQLWCHAR)));
+                    const unsigned char* bytes = static_cast<const unsigned char*>(value);
+                    sent.assign(bytes, bytes + *indicator);
+                    return SQL_SUCCESS;
+                });
+            EXPECT_CALL(*mock, SQLExecute(testing::_)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, testing::_)).Times(testing::AnyNumber());
+
+            auto statement = wrapper->prepare(L"INSERT INTO notes (body) VALUES (?) -- \U0001F600");
+            statement->setString(1, value);
+            ASSERT_TRUE(statement->execute());
+            ASSERT_EQ(sent.size(), units * sizeof(SQLWCHAR));
+
+            ps::odbc::ParameterBatch batch(2);
+            batch.setString(1, 0, L"\U0001F600\U0001F600");
+            batch.setString(1, 1, L"abc");
+            batch.pack();
+            EXPECT_EQ(batch.columns()[0].columnSize, 4u);
+            EXPECT_EQ(batch.columns()[0].indicators[0], static_cast<SQLLEN>(4 * sizeof(SQLWCHAR)));
+
+            FakeLongData echo(*mock, sent, true);
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLNumResultCols(testing::_, testing::_))
+                .WillRepeatedly([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLFetch(testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_NO_DATA));
+            EXPECT_CALL(*mock, SQLGetData(testing::_, 1, SQL_C_WCHAR, testing::_, testing::_, testing::_)).Times(testing::AtLeast(2));
+
+            ASSERT_TRUE(wrapper->executeQuery(L"SELECT body FROM notes"));
+            auto rows = wrapper->fetchResults();
+            ASSERT_EQ(rows.size(), 1u);
+            EXPECT_EQ(rows[0][0], value);
+
+            FakeBlockCursor cursor(*mock, {{value}, {L"\U0001F600"}}, {SQL_WLONGVARCHAR});
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(testing::_, SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            ps::odbc::ResultSet results = wrapper->fetchResultSet(8);
+            ASSERT_EQ(results.rowCount(), 2u);
+            EXPECT_EQ(results[0][0], value);
+            EXPECT_EQ(results[1][0], L"\U0001F600");
+
+            OdbcLogger::logInfo("Exiting Unicode_RoundTripsThroughBindAndFetch");
+        }
+
+        /**
+         * @test ParameterBatch_RejectsMixedTypes
+         * @brief Tests that a batch column keeps the type of its first value.
+         */
+        TEST(ParameterBatchTest, ParameterBatch_RejectsMixedTypes) {
+            ps::odbc::ParameterBatch batch(2);
+            batch.setInt(1, 0, 7);
+
+            EXPECT_THROW(batch.setString(1, 1, L"seven"), std::invalid_argument);
+            EXPECT_THROW(batch.setInt(1, 2, 8), std::out_of_range);
+            EXPECT_THROW(batch.setNull(2, 0), std::invalid_argument);
+        }
+
+        /**
+         * @test Prepare_FailsIfNotConnected
+         * @brief Tests that prepare returns nullptr without an active connection.
+         */
+        TEST_F(OdbcWrapperTest, Prepare_FailsIfNotConnected) {
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, testing::_)).Times(0);
+
+            EXPECT_EQ(wrapper->prepare(L"SELECT 1"), nullptr);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_preparedstatement_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,308 @@
+#include <test_odbcwrapper.h>
+#include <odbclogger.h>
+
+#include <thread>
+
+using ps::odbc::OdbcLogger;
+using ps::odbc::QueryCache;
+using ps::odbc::QueryCacheStats;
+using ps::odbc::QueryParameter;
+using ps::odbc::ResultSet;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class QueryCacheTest
+         * @brief Fixture that connects the wrapper and gives it a query cache.
+         */
+        class QueryCacheTest : public ConnectedOdbcWrapperTest {
+        protected:
+            void SetUp() override {
+                ConnectedOdbcWrapperTest::SetUp();
+                expectBlockCursor(2);
+
+                cache = std::make_shared<QueryCache>();
+                wrapper->setQueryCache(cache);
+            }
+
+            std::shared_ptr<QueryCache> cache; ///< Cache given to the wrapper.
+        };
+
+        /**
+         * @test Normalize_CollapsesWhitespaceOutsideQuotes
+         * @brief Tests that formatting differences map to the same key while literals, comments, parameters and their types do not.
+         */
+        TEST(QueryCacheKeyTest, Normalize_CollapsesWhitespaceOutsideQuotes) {
+            EXPECT_EQ(QueryCache::normalize(L"  SELECT *\n\tFROM  t ;  "), L"SELECT * FROM t");
+            EXPECT_EQ(QueryCache::normalize(L"SELECT 'a  b', \"x  y\", [p  q]  FROM t"), L"SELECT 'a  b', \"x  y\", [p  q] FROM t");
+            EXPECT_EQ(QueryCache::normalize(L"SELECT 'it''s  ;'"), L"SELECT 'it''s  ;'");
+            EXPECT_EQ(QueryCache::normalize(L"SELECT ';  '"), L"SELECT ';  '");
+            EXPECT_EQ(QueryCache::normalize(L"SELECT a  -- note  it's\n  FROM t"), L"SELECT a -- note  it's\n FROM t");
+            EXPECT_NE(QueryCache::normalize(L"SELECT a -- note\nFROM t"), QueryCache::normalize(L"SELECT a -- note FROM t"));
+            EXPECT_EQ(QueryCache::normalize(L"SELECT 1 - -2"), L"SELECT 1 - -2");
+
+            EXPECT_EQ(QueryCache::makeKey(L"SELECT ?  FROM t", {std::int64_t(1)}), QueryCache::makeKey(L"SELECT ? FROM t", {std::int64_t(1)}));
+            EXPECT_NE(QueryCache::makeKey(L"SELECT ?", {std::int64_t(1)}), QueryCache::makeKey(L"SELECT ?", {std::int64_t(2)}));
+            EXPECT_NE(QueryCache::makeKey(L"SELECT ?", {std::int64_t(1)}), QueryCache::makeKey(L"SELECT ?", {std::wstring(L"1")}));
+            EXPECT_NE(QueryCache::makeKey(L"SELECT ?", {1.0}), QueryCache::makeKey(L"SELECT ?", {std::int64_t(1)}));
+            EXPECT_NE(QueryCache::makeKey(L"SELECT ?", {nullptr}), QueryCache::makeKey(L"SELECT ?"));
+            EXPECT_NE(QueryCache::makeKey(L"SELECT ?, ?", {std::wstring(L"a"), std::wstring(L"b")}),
+                      QueryCache::makeKey(L"SELECT ?, ?", {std::wstring(L"a\x1fS1:b")}));
+        }
+
+        /**
+         * @test Cache_ExpiresEntriesAfterTtl
+         * @brief Tests that hits and misses are counted and an entry past its TTL is dropped on lookup.
+         */
+        TEST(QueryCacheUnitTest, Cache_ExpiresEntriesAfterTtl) {
+            QueryCache cache(1024 * 1024, std::chrono::milliseconds(20), 4);
+            EXPECT_EQ(cache.find(L"a"), nullptr);
+
+            std::shared_ptr<const ResultSet> inserted = cache.insert(L"a", ResultSet(2));
+            cache.insert(L"b", ResultSet(1), {}, std::chrono::hours(1));
+            EXPECT_EQ(cache.find(L"a"), inserted);
+            EXPECT_EQ(cache.find(L"a")->columnCount(), 2u);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(40));
+            EXPECT_EQ(cache.find(L"a"), nullptr);
+            EXPECT_NE(cache.find(L"b"), nullptr);
+
+            const QueryCacheStats stats = cache.stats();
+            EXPECT_EQ(stats.hits, 3u);
+            EXPECT_EQ(stats.misses, 2u);
+            EXPECT_EQ(stats.expirations, 1u);
+            EXPECT_EQ(stats.entries, 1u);
+            EXPECT_DOUBLE_EQ(stats.hitRatio(), 0.6);
+        }
+
+        /**
+         * @test Cache_EvictsLeastRecentlyUsedWithinBudget
+         * @brief Tests that a full shard evicts its least recently used entry and oversized results are not kept.
+         */
+        TEST(QueryCacheUnitTest, Cache_EvictsLeastRecentlyUsedWithinBudget) {
+            const size_t entryBytes = [] {
+                ResultSet result(1);
+                result.compact();
+                return result.memoryUsage() + sizeof(wchar_t); // One-character keys
+            }();
+            QueryCache cache(entryBytes * 2, std::chrono::hours(1), 1);
+
+            cache.insert(L"a", ResultSet(1));
+            cache.insert(L"b", ResultSet(1));
+            EXPECT_NE(cache.find(L"a"), nullptr); // b is now least recently used
+            cache.insert(L"c", ResultSet(1));
+
+            EXPECT_NE(cache.find(L"a"), nullptr);
+            EXPECT_EQ(cache.find(L"b"), nullptr);
+            EXPECT_NE(cache.find(L"c"), nullptr);
+            EXPECT_EQ(cache.stats().evictions, 1u);
+            EXPECT_EQ(cache.stats().bytes, entryBytes * 2);
+
+            const std::wstring longKey(64, L'd'); // Keys count against the budget too
+            std::shared_ptr<const ResultSet> large = cache.insert(longKey, ResultSet(1));
+            ASSERT_NE(large, nullptr);
+            EXPECT_EQ(cache.find(longKey), nullptr);
+            EXPECT_EQ(cache.stats().rejections, 1u);
+            EXPECT_EQ(cache.stats().entries, 2u);
+        }
+
+        /**
+         * @test Cache_InvalidatesByTag
+         * @brief Tests that invalidate() drops exactly the entries carrying a tag and clear() drops the rest.
+         */
+        TEST(QueryCacheUnitTest, Cache_InvalidatesByTag) {
+            QueryCache cache;
+            cache.insert(L"countries", ResultSet(1), {"countries"});
+            cache.insert(L"join", ResultSet(1), {"countries", "cities"});
+            cache.insert(L"cities", ResultSet(1), {"cities"});
+
+            EXPECT_EQ(cache.invalidate("countries"), 2u);
+            EXPECT_EQ(cache.find(L"countries"), nullptr);
+            EXPECT_EQ(cache.find(L"join"), nullptr);
+            EXPECT_NE(cache.find(L"cities"), nullptr);
+
+            cache.clear();
+            EXPECT_EQ(cache.find(L"cities"), nullptr);
+            EXPECT_EQ(cache.stats().invalidations, 3u);
+            EXPECT_EQ(cache.stats().bytes, 0u);
+        }
+
+        /**
+         * @test Cache_RefusesResultsReadBeforeAnInvalidation
+         * @brief Tests that a result queried before one of its tags was invalidated is not cached.
+         */
+        TEST(QueryCacheUnitTest, Cache_RefusesResultsReadBeforeAnInvalidation) {
+            QueryCache cache;
+            const std::uint64_t generation = cache.generation();
+            EXPECT_EQ(cache.find(L"countries"), nullptr); // Miss, the reader queries the old rows
+            cache.invalidate("countries"); // A writer updates the table in between
+            std::shared_ptr<const ResultSet> old = cache.insert(L"countries", ResultSet(1), {"countries"},
+                                                                std::chrono::milliseconds::zero(), generation);
+
+            ASSERT_NE(old, nullptr);
+            EXPECT_EQ(cache.find(L"countries"), nullptr);
+            EXPECT_EQ(cache.stats().stale, 1u);
+
+            cache.insert(L"cities", ResultSet(1), {"cities"}, std::chrono::milliseconds::zero(), generation);
+            EXPECT_NE(cache.find(L"cities"), nullptr); // Other tags are unaffected
+
+            const std::uint64_t beforeClear = cache.generation();
+            cache.clear();
+            cache.insert(L"cities", ResultSet(1), {"cities"}, std::chrono::milliseconds::zero(), beforeClear);
+            EXPECT_EQ(cache.find(L"cities"), nullptr);
+            cache.insert(L"cities", ResultSet(1), {"cities"}, std::chrono::milliseconds::zero(), cache.generation());
+            EXPECT_NE(cache.find(L"cities"), nullptr);
+        }
+
+        /**
+         * @test Cache_ServesConcurrentReaders
+         * @brief Tests that lookups and inserts from several threads keep the counters consistent.
+         */
+        TEST(QueryCacheUnitTest, Cache_ServesConcurrentReaders) {
+            QueryCache cache;
+            for (int k = 0; k < 32; k++) {
+                cache.insert(std::to_wstring(k), ResultSet(1));
+            }
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.emplace_back([&cache, t] {
+                    for (int i = 0; i < 1000; i++) {
+                        const std::wstring key = std::to_wstring(i % 64);
+                        if (!cache.find(key) && i % 64 >= 32) {
+                            cache.insert(std::to_wstring(64 + t), ResultSet(1));
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            const QueryCacheStats stats = cache.stats();
+            EXPECT_EQ(stats.hits + stats.misses, 4000u);
+            EXPECT_EQ(stats.hits, 4u * 512u); // Keys 0 to 31 come up 512 times in 1000 iterations
+            EXPECT_EQ(stats.entries, 36u);
+        }
+
+        /**
+         * @test ExecuteCachedQuery_AnswersRepeatsFromCache
+         * @brief Tests that a repeated query is served from the cache and runs again after its tag is invalidated.
+         */
+        TEST_F(QueryCacheTest, ExecuteCachedQuery_AnswersRepeatsFromCache) {
+            OdbcLogger::logInfo("Entering ExecuteCachedQuery_AnswersRepeatsFromCache");
+
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .Times(3)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            FakeBlockCursor first(*mock, {{L"DE", L"Germany"}, {L"FR", std::nullopt}});
+            std::shared_ptr<const ResultSet> rows = wrapper->executeCachedQuery(L"SELECT code, name FROM countries", {}, {"countries"});
+            ASSERT_EQ(rows->rowCount(), 2u);
+            EXPECT_EQ((*rows)[0][1], L"Germany");
+            EXPECT_TRUE((*rows)[1].isNull(1));
+            EXPECT_EQ(rows->slabCount(), 1u);
+
+            EXPECT_EQ(wrapper->executeCachedQuery(L"SELECT code,  name\nFROM countries;", {}, {"countries"}), rows);
+            EXPECT_EQ(cache->stats().hits, 1u);
+
+            EXPECT_TRUE(wrapper->executeUpdateAndInvalidate(L"UPDATE countries SET name = 'France' WHERE code = 'FR'", {"countries"}));
+            EXPECT_EQ(cache->stats().entries, 0u);
+
+            FakeBlockCursor second(*mock, {{L"DE", L"Germany"}, {L"FR", L"France"}});
+            std::shared_ptr<const ResultSet> fresh = wrapper->executeCachedQuery(L"SELECT code, name FROM countries", {}, {"countries"});
+            ASSERT_EQ(fresh->rowCount(), 2u);
+            EXPECT_EQ((*fresh)[1][1], L"France");
+            EXPECT_EQ((*rows)[1][0], L"FR"); // Results handed out earlier stay valid
+
+            OdbcLogger::logInfo("Exiting ExecuteCachedQuery_AnswersRepeatsFromCache");
+        }
+
+        /**
+         * @test Cache_OversizedReplacementDropsOldResult
+         * @brief Tests that a replacement too large for the budget is not kept and does not leave the outdated result behind.
+         */
+        TEST_F(QueryCacheTest, Cache_OversizedReplacementDropsOldResult) {
+            const size_t emptyBytes = [] {
+                ResultSet result(2);
+                result.compact();
+                return result.memoryUsage() + sizeof(wchar_t); // One-character key
+            }();
+            QueryCache small(emptyBytes, std::chrono::hours(1), 1);
+            small.insert(L"a", ResultSet(2));
+            ASSERT_NE(small.find(L"a"), nullptr);
+
+            FakeBlockCursor fake(*mock, {{L"DE", L"Germany"}});
+            small.insert(L"a", wrapper->fetchResultSet());
+
+            EXPECT_EQ(small.find(L"a"), nullptr);
+            EXPECT_EQ(small.stats().rejections, 1u);
+            EXPECT_EQ(small.stats().entries, 0u);
+            EXPECT_EQ(small.stats().bytes, 0u);
+        }
+
+        /**
+         * @test ExecuteCachedQuery_InvalidationDuringQueryIsNotLost
+         * @brief Tests that rows read while another wrapper invalidates their tag are returned but not cached.
+         */
+        TEST_F(QueryCacheTest, ExecuteCachedQuery_InvalidationDuringQueryIsNotLost) {
+            OdbcLogger::logInfo("Entering ExecuteCachedQuery_InvalidationDuringQueryIsNotLost");
+
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                .WillOnce([this](SQLHSTMT, SQLWCHAR*, SQLINTEGER) {
+                    cache->invalidate("countries"); // Another wrapper's executeUpdateAndInvalidate()
+                    return SQL_SUCCESS;
+                })
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            FakeBlockCursor first(*mock, {{L"FR", std::nullopt}});
+            std::shared_ptr<const ResultSet> rows = wrapper->executeCachedQuery(L"SELECT code, name FROM countries", {}, {"countries"});
+            ASSERT_EQ(rows->rowCount(), 1u);
+            EXPECT_EQ(cache->stats().entries, 0u);
+            EXPECT_EQ(cache->stats().stale, 1u);
+
+            FakeBlockCursor second(*mock, {{L"FR", L"France"}});
+            std::shared_ptr<const ResultSet> fresh = wrapper->executeCachedQuery(L"SELECT code, name FROM countries", {}, {"countries"});
+            EXPECT_EQ((*fresh)[0][1], L"France");
+            EXPECT_EQ(cache->stats().entries, 1u);
+
+            OdbcLogger::logInfo("Exiting ExecuteCachedQuery_InvalidationDuringQueryIsNotLost");
+        }
+
+        /**
+         * @test ExecuteCachedQuery_KeysOnParameters
+         * @brief Tests that parameterized queries are prepared, bound and cached per parameter value.
+         */
+        TEST_F(QueryCacheTest, ExecuteCachedQuery_KeysOnParameters) {
+            OdbcLogger::logInfo("Entering ExecuteCachedQuery_KeysOnParameters");
+
+            EXPECT_CALL(*mock, SQLPrepare(testing::_, testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLBindParameter(testing::_, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecute(testing::_))
+                .Times(2)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            const std::wstring sql = L"SELECT code, name FROM countries WHERE id = ?";
+            FakeBlockCursor first(*mock, {{L"DE", L"Germany"}});
+            std::shared_ptr<const ResultSet> one = wrapper->executeCachedQuery(sql, {std::int64_t(1)});
+            FakeBlockCursor second(*mock, {{L"FR", L"France"}});
+            std::shared_ptr<const ResultSet> two = wrapper->executeCachedQuery(sql, {std::int64_t(2)});
+
+            EXPECT_EQ(wrapper->executeCachedQuery(sql, {std::int64_t(1)}), one);
+            EXPECT_EQ(wrapper->executeCachedQuery(sql, {std::int64_t(2)}), two);
+            EXPECT_EQ((*one)[0][0], L"DE");
+            EXPECT_EQ((*two)[0][0], L"FR");
+            EXPECT_DOUBLE_EQ(cache->stats().hitRatio(), 0.5);
+            EXPECT_FALSE(wrapper->prepare(sql)->isIdempotent()); // The shared statement is left as it was
+
+            OdbcLogger::logInfo("Exiting ExecuteCachedQuery_KeysOnParameters");
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_querycache_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
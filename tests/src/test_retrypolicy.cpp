@@ -0,0 +1,228 @@
+#include <test_odbcwrapper.h>
+#include <odbclogger.h>
+
+using ps::odbc::ErrorClass;
+using ps::odbc::OdbcException;
+using ps::odbc::OdbcLogger;
+using ps::odbc::RetryPolicy;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class RetryPolicyTest
+         * @brief Fixture that connects the wrapper with a retry policy that waits no time between attempts.
+         */
+        class RetryPolicyTest : public ConnectedOdbcWrapperTest {
+        protected:
+            void SetUp() override {
+                ConnectedOdbcWrapperTest::SetUp();
+
+                RetryPolicy policy;
+                policy.maxAttempts = 3;
+                policy.initialBackoff = std::chrono::milliseconds(0);
+                wrapper->setRetryPolicy(policy);
+            }
+
+            /**
+             * @brief Makes the next statement diagnostic report a single record with the given SQLSTATE.
+             */
+            void failNextWith(const wchar_t* sqlState) {
+                EXPECT_CALL(*mock, SQLGetDiagRec(SQL_HANDLE_STMT, testing::_, 1, testing::_, testing::_, testing::_, testing::_, testing::_))
+                    .WillOnce([sqlState](SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR* state, SQLINTEGER* nativeError,
+                                         SQLWCHAR* messageText, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
+                        copySqlWide(state, sqlState, 6);
+                        *nativeError = 0;
+                        copySqlWide(messageText, L"Injected failure", bufferLength);
+                        *textLength = static_cast<SQLSMALLINT>(std::wcslen(L"Injected failure"));
+                        return SQL_SUCCESS;
+                    })
+                    .RetiresOnSaturation();
+            }
+        };
+
+        /**
+         * @test Classify_MatchesStateThenClass
+         * @brief Tests that a listed SQLSTATE wins over its class and unlisted states are permanent.
+         */
+        TEST(RetryPolicyClassificationTest, Classify_MatchesStateThenClass) {
+            RetryPolicy policy;
+            EXPECT_EQ(policy.classify("40001"), ErrorClass::Transient);
+            EXPECT_EQ(policy.classify("HYT00"), ErrorClass::Transient);
+            EXPECT_EQ(policy.classify("08S01"), ErrorClass::ConnectionLost);
+            EXPECT_EQ(policy.classify("08004"), ErrorClass::Permanent);
+            EXPECT_EQ(policy.classify("42S02"), ErrorClass::Permanent);
+            EXPECT_EQ(policy.classify(""), ErrorClass::Permanent);
+
+            policy.classification["42"] = ErrorClass::Transient;
+            EXPECT_EQ(policy.classify("42S02"), ErrorClass::Transient);
+        }
+
+        /**
+         * @test Backoff_GrowsExponentiallyUpToTheCap
+         * @brief Tests the wait before each retry without jitter and with full jitter.
+         */
+        TEST(RetryPolicyClassificationTest, Backoff_GrowsExponentiallyUpToTheCap) {
+            RetryPolicy policy;
+            policy.initialBackoff = std::chrono::milliseconds(100);
+            policy.maxBackoff = std::chrono::milliseconds(1000);
+            policy.jitter = 0.0;
+            EXPECT_EQ(policy.backoff(1, 0.5).count(), 100);
+            EXPECT_EQ(policy.backoff(2, 0.5).count(), 200);
+            EXPECT_EQ(policy.backoff(4, 0.5).count(), 800);
+            EXPECT_EQ(policy.backoff(5, 0.5).count(), 1000);
+
+            policy.jitter = 1.0;
+            EXPECT_EQ(policy.backoff(2, 0.0).count(), 0);
+            EXPECT_EQ(policy.backoff(2, 0.5).count(), 100);
+            for (int i = 0; i < 100; i++) {
+                EXPECT_LE(policy.backoff(5).count(), 1000);
+            }
+        }
+
+        /**
+         * @test ExecuteQuery_RetriesTransientError
+         * @brief Tests that a query failing as a deadlock victim is executed again on the same connection.
+         */
+        TEST_F(RetryPolicyTest, ExecuteQuery_RetriesTransientError) {
+            OdbcLogger::logInfo("Entering ExecuteQuery_RetriesTransientError");
+
+            EXPECT_CALL(*mock, SQLExecDirect(handle(1), testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_ERROR))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+            failNextWith(L"40001");
+
+            EXPECT_TRUE(wrapper->executeQuery(L"SELECT 1"));
+
+            OdbcLogger::logInfo("Exiting ExecuteQuery_RetriesTransientError");
+        }
+
+        /**
+         * @test ExecuteQuery_ReconnectsAfterLostConnection
+         * @brief Tests that a communication link failure reconnects with the stored credentials before retrying.
+         */
+        TEST_F(RetryPolicyTest, ExecuteQuery_ReconnectsAfterLostConnection) {
+            EXPECT_CALL(*mock, SQLExecDirect(handle(1), testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLExecDirect(handle(2), testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, SQL_NTS, testing::_, SQL_NTS, testing::_, SQL_NTS))
+                .WillOnce([](SQLHDBC, SQLWCHAR* dsn, SQLSMALLINT, SQLWCHAR* user, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT) {
+                    EXPECT_EQ(std::wstring(dsn, dsn + 5), L"MyDSN");
+                    EXPECT_EQ(std::wstring(user, user + 4), L"user");
+                    return SQL_SUCCESS;
+                });
+            failNextWith(L"08S01");
+
+            EXPECT_TRUE(wrapper->executeQuery(L"SELECT 1"));
+            EXPECT_TRUE(wrapper->isConnected());
+            EXPECT_EQ(wrapper->getHStmt(), handle(2));
+        }
+
+        /**
+         * @test ExecuteQuery_GivesUpAfterMaxAttempts
+         * @brief Tests that the last error is rethrown once every attempt has failed.
+         */
+        TEST_F(RetryPolicyTest, ExecuteQuery_GivesUpAfterMaxAttempts) {
+            EXPECT_CALL(*mock, SQLExecDirect(handle(1), testing::_, SQL_NTS)).Times(3).WillRepeatedly(testing::Return(SQL_ERROR));
+            failNextWith(L"HYT00");
+            failNextWith(L"40001");
+            failNextWith(L"40001");
+
+            try {
+                wrapper->executeQuery(L"SELECT 1");
+                FAIL() << "Expected OdbcException";
+            } catch (const OdbcException& e) {
+                EXPECT_EQ(e.sqlState(), "HYT00"); // gmock matches the newest expectation first
+            }
+        }
+
+        /**
+         * @test ExecuteQuery_DoesNotRetryPermanentError
+         * @brief Tests that an error outside the classification table is thrown at once.
+         */
+        TEST_F(RetryPolicyTest, ExecuteQuery_DoesNotRetryPermanentError) {
+            EXPECT_CALL(*mock, SQLExecDirect(handle(1), testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_ERROR));
+            failNextWith(L"42S02");
+
+            EXPECT_THROW(wrapper->executeQuery(L"SELECT * FROM missing"), OdbcException);
+        }
+
+        /**
+         * @test ExecuteUpdate_RetriesOnlyWhenIdempotent
+         * @brief Tests that an update is retried only when the caller marks it idempotent.
+         */
+        TEST_F(RetryPolicyTest, ExecuteUpdate_RetriesOnlyWhenIdempotent) {
+            EXPECT_CALL(*mock, SQLExecDirect(handle(1), testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_ERROR))
+                .WillOnce(testing::Return(SQL_ERROR))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+            failNextWith(L"40001");
+            failNextWith(L"40001");
+
+            EXPECT_THROW(wrapper->executeUpdate(L"UPDATE counters SET hits = hits + 1"), OdbcException);
+            EXPECT_TRUE(wrapper->executeUpdate(L"UPDATE users SET name = 'x' WHERE id = 1", true));
+        }
+
+        /**
+         * @test ExecuteQuery_DoesNotRetryInsideTransaction
+         * @brief Tests that a failure inside a transaction is thrown, since the transaction was rolled back.
+         */
+        TEST_F(RetryPolicyTest, ExecuteQuery_DoesNotRetryInsideTransaction) {
+            EXPECT_CALL(*mock, SQLSetConnectAttr(testing::_, SQL_ATTR_AUTOCOMMIT, testing::_, 0))
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLEndTran(testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber())
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecDirect(handle(1), testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_ERROR));
+            failNextWith(L"40001");
+
+            ASSERT_TRUE(wrapper->beginTransaction());
+            EXPECT_THROW(wrapper->executeQuery(L"SELECT 1"), OdbcException);
+        }
+
+        /**
+         * @test Statement_RetriesTransientErrorWhenIdempotent
+         * @brief Tests that an idempotent statement retries a transient error but not a lost connection.
+         */
+        TEST_F(RetryPolicyTest, Statement_RetriesTransientErrorWhenIdempotent) {
+            Statement statement = wrapper->createStatement();
+            ASSERT_EQ(statement.getHStmt(), handle(2));
+            EXPECT_FALSE(statement.isIdempotent());
+            statement.setIdempotent(true);
+
+            EXPECT_CALL(*mock, SQLExecDirect(handle(2), testing::_, SQL_NTS))
+                .WillOnce(testing::Return(SQL_ERROR))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLConnect(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+            failNextWith(L"08S01");
+            failNextWith(L"40P01");
+
+            EXPECT_TRUE(statement.execute(L"SELECT id FROM orders"));
+            EXPECT_THROW(statement.execute(L"SELECT id FROM orders"), OdbcException);
+        }
+
+        /**
+         * @test WithRetry_RepeatsUnitOfWork
+         * @brief Tests that a caller-defined unit of work is repeated when it throws a transient error.
+         */
+        TEST_F(RetryPolicyTest, WithRetry_RepeatsUnitOfWork) {
+            int calls = 0;
+            int result = wrapper->withRetry([&calls]() {
+                if (++calls == 1) {
+                    throw OdbcException("ODBC Error: Deadlock", {{"40001", 1205, "Deadlock"}});
+                }
+                return 42;
+            });
+
+            EXPECT_EQ(result, 42);
+            EXPECT_EQ(calls, 2);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_retrypolicy_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
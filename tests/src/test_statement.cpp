@@ -0,0 +1,272 @@
+#include <test_odbcwrapper.h>
+#include <odbclogger.h>
+
+using ps::odbc::OdbcLogger;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class StatementTest
+         * @brief Fixture whose wrapper is connected and hands out statement handles numbered from 1.
+         */
+        class StatementTest : public ConnectedOdbcWrapperTest {
+        };
+
+        /**
+         * @test CreateStatement_AllocatesIndependentHandles
+         * @brief Tests that each statement gets its own handle, distinct from the wrapper's handle.
+         */
+        TEST_F(StatementTest, CreateStatement_AllocatesIndependentHandles) {
+            OdbcLogger::logInfo("Entering CreateStatement_AllocatesIndependentHandles");
+
+            EXPECT_CALL(*mock, SQLExecDirect(handle(2), testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecDirect(handle(3), testing::_, SQL_NTS)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            Statement orders = wrapper->createStatement();
+            Statement lookups = wrapper->createStatement();
+            ASSERT_TRUE(orders);
+            ASSERT_TRUE(lookups);
+            EXPECT_EQ(orders.getHStmt(), handle(2));
+            EXPECT_EQ(lookups.getHStmt(), handle(3));
+            EXPECT_NE(orders.getHStmt(), wrapper->getHStmt());
+
+            EXPECT_TRUE(orders.execute(L"SELECT id FROM orders"));
+            EXPECT_TRUE(lookups.execute(L"SELECT name FROM customers WHERE id = 1"));
+
+            OdbcLogger::logInfo("Exiting CreateStatement_AllocatesIndependentHandles");
+        }
+
+        /**
+         * @test Release_RecyclesHandleThroughFreeList
+         * @brief Tests that a released handle is closed, reset and handed out again without allocating.
+         */
+        TEST_F(StatementTest, Release_RecyclesHandleThroughFreeList) {
+            EXPECT_CALL(*mock, SQLFreeStmt(handle(2), SQL_CLOSE)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeStmt(handle(2), SQL_RESET_PARAMS)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, handle(2))).Times(0);
+
+            {
+                Statement statement = wrapper->createStatement();
+                EXPECT_EQ(statement.getHStmt(), handle(2));
+            }
+            EXPECT_EQ(wrapper->freeStatementCount(), 1u);
+
+            Statement reused = wrapper->createStatement();
+            EXPECT_EQ(reused.getHStmt(), handle(2));
+            EXPECT_EQ(allocations, 2); // The wrapper's own handle and handle 2
+            EXPECT_EQ(wrapper->freeStatementCount(), 0u);
+
+            testing::Mock::VerifyAndClearExpectations(mock);
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFreeHandle(testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLDisconnect(testing::_)).Times(testing::AnyNumber());
+        }
+
+        /**
+         * @test Release_FreesHandlesBeyondLimit
+         * @brief Tests that the free list keeps at most MAX_FREE_STATEMENTS handles.
+         */
+        TEST_F(StatementTest, Release_FreesHandlesBeyondLimit) {
+            const size_t count = OdbcWrapper::MAX_FREE_STATEMENTS + 1;
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, handle(static_cast<intptr_t>(count) + 1)))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            {
+                std::vector<Statement> statements;
+                for (size_t i = 0; i < count; i++) {
+                    statements.push_back(wrapper->createStatement());
+                }
+            }
+            EXPECT_EQ(wrapper->freeStatementCount(), OdbcWrapper::MAX_FREE_STATEMENTS);
+        }
+
+        /**
+         * @test OpenCursor_StaysOpenDuringLookups
+         * @brief Tests that executing on a second statement does not close the first statement's cursor.
+         */
+        TEST_F(StatementTest, OpenCursor_StaysOpenDuringLookups) {
+            FakeBlockCursor fake(*mock, {{L"1"}, {L"2"}, {L"3"}});
+            EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS)).WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLNumResultCols(handle(2), testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 1; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(handle(2), SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFreeStmt(handle(2), SQL_CLOSE)).Times(0);
+            EXPECT_CALL(*mock, SQLRowCount(handle(3), testing::_))
+                .WillRepeatedly([](SQLHSTMT, SQLLEN* count) { *count = 1; return SQL_SUCCESS; });
+
+            Statement orders = wrapper->createStatement();
+            Statement lookups = wrapper->createStatement();
+            ASSERT_TRUE(orders.execute(L"SELECT id FROM orders"));
+
+            std::vector<std::wstring> seen;
+            for (const auto& row : orders.openCursor(1)) {
+                seen.push_back(row[0]);
+                ASSERT_TRUE(lookups.execute(L"UPDATE orders SET seen = 1 WHERE id = " + row[0]));
+                EXPECT_EQ(lookups.rowCount(), 1);
+            }
+            EXPECT_EQ(seen, (std::vector<std::wstring>{L"1", L"2", L"3"}));
+
+            testing::Mock::VerifyAndClearExpectations(mock);
+            EXPECT_CALL(*mock, SQLFreeStmt(testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFreeHandle(testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLDisconnect(testing::_)).Times(testing::AnyNumber());
+        }
+
+        /**
+         * @test ExecuteUtf8_FetchesTextWithoutWideStrings
+         * @brief Tests that UTF-8 SQL goes to SQLExecDirectA on the statement's handle and results come back as SQL_C_CHAR.
+         */
+        TEST_F(StatementTest, ExecuteUtf8_FetchesTextWithoutWideStrings) {
+            FakeBlockCursor fake(*mock, {{L"1", L"Oslo"}, {L"2", std::nullopt}});
+            EXPECT_CALL(*mock, SQLExecDirectA(handle(2), testing::_, 25)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLNumResultCols(handle(2), testing::_))
+                .WillOnce([](SQLHSTMT, SQLSMALLINT* cols) { *cols = 2; return SQL_SUCCESS; });
+            EXPECT_CALL(*mock, SQLDescribeCol(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+                .Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLBindCol(handle(2), testing::_, SQL_C_CHAR, testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+            EXPECT_CALL(*mock, SQLFetchScroll(handle(2), SQL_FETCH_NEXT, 0)).Times(testing::AnyNumber());
+
+            Statement cities = wrapper->createStatement();
+            ASSERT_TRUE(cities.execute(std::string_view("SELECT id, name FROM city")));
+            EXPECT_EQ(cities.fetchResultsUtf8(), (std::vector<std::vector<std::string>>{{"1", "Oslo"}, {"2", "NULL"}}));
+
+            Statement empty;
+            EXPECT_FALSE(empty.execute(std::string_view("SELECT 1")));
+            EXPECT_TRUE(empty.fetchResultsUtf8().empty());
+        }
+
+        /**
+         * @test Disconnect_DropsOutstandingHandles
+         * @brief Tests that disconnect frees idle handles and statements outliving it do not recycle theirs.
+         */
+        TEST_F(StatementTest, Disconnect_DropsOutstandingHandles) {
+            Statement idle = wrapper->createStatement(); // Handle 2
+            Statement leased = wrapper->createStatement(); // Handle 3
+            idle.release();
+            EXPECT_EQ(wrapper->freeStatementCount(), 1u);
+
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, handle(2))).WillOnce(testing::Return(SQL_SUCCESS));
+            wrapper->disconnect();
+            EXPECT_EQ(wrapper->freeStatementCount(), 0u);
+
+            EXPECT_CALL(*mock, SQLFreeStmt(handle(3), testing::_)).Times(0);
+            leased.release();
+            EXPECT_FALSE(leased);
+
+            wrapper->connect(L"MyDSN", L"user", L"pass");
+            EXPECT_EQ(wrapper->freeStatementCount(), 0u);
+        }
+
+        /**
+         * @test Base_DisconnectAndDestroyReachTheWrapper
+         * @brief Tests that disconnecting and destroying through BasicOdbcWrapper also frees the wrapper's idle handles.
+         */
+        TEST_F(StatementTest, Base_DisconnectAndDestroyReachTheWrapper) {
+            BasicOdbcWrapper<OdbcInterface>& base = *wrapper;
+            wrapper->createStatement().release(); // Handle 2
+
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, handle(2))).WillOnce(testing::Return(SQL_SUCCESS));
+            base.disconnect();
+            EXPECT_EQ(wrapper->freeStatementCount(), 0u);
+
+            base.connect(L"MyDSN", L"user", L"pass"); // Takes statement handle 3
+            wrapper->createStatement().release(); // Handle 4
+            EXPECT_CALL(*mock, SQLFreeHandle(SQL_HANDLE_STMT, handle(4))).WillOnce(testing::Return(SQL_SUCCESS));
+            std::unique_ptr<BasicOdbcWrapper<OdbcInterface>> owner(wrapper.release());
+            owner.reset();
+        }
+
+        /**
+         * @test ExecuteAsync_MultiplexesStatementsOnOneReactor
+         * @brief Tests that executions on several statements are polled side by side by one reactor.
+         */
+        TEST_F(StatementTest, ExecuteAsync_MultiplexesStatementsOnOneReactor) {
+            StillExecuting slow(20, SQL_SUCCESS);
+            StillExecuting fast(2, SQL_NO_DATA);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ASYNC_ENABLE, testing::_, 0))
+                .Times(4)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecDirect(handle(2), testing::_, SQL_NTS)).WillRepeatedly(slow);
+            EXPECT_CALL(*mock, SQLExecDirect(handle(3), testing::_, SQL_NTS)).WillRepeatedly(fast);
+
+            Statement report = wrapper->createStatement();
+            Statement purge = wrapper->createStatement();
+            std::future<bool> reportDone = report.executeAsync(L"SELECT * FROM yearly_report");
+            std::future<bool> purgeDone = purge.executeAsync(L"DELETE FROM sessions WHERE expired = 1");
+
+            EXPECT_TRUE(purgeDone.get()); // SQL_NO_DATA: no rows affected
+            EXPECT_TRUE(reportDone.get());
+            EXPECT_EQ(slow.calls(), 21);
+            EXPECT_EQ(fast.calls(), 3);
+
+            report.release(); // Waits until the reactor has let go of the handle
+            purge.release();
+            EXPECT_EQ(wrapper->getAsyncReactor()->pending(), 0u);
+        }
+
+        /**
+         * @test Release_WaitsForAsyncExecution
+         * @brief Tests that a statement is not recycled while its execution is still in flight.
+         */
+        TEST_F(StatementTest, Release_WaitsForAsyncExecution) {
+            StillExecuting execution(5, SQL_SUCCESS);
+            EXPECT_CALL(*mock, SQLSetStmtAttr(testing::_, SQL_ATTR_ASYNC_ENABLE, testing::_, 0))
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLExecDirect(handle(2), testing::_, SQL_NTS)).WillRepeatedly(execution);
+
+            std::future<bool> done;
+            {
+                Statement statement = wrapper->createStatement();
+                done = statement.executeAsync(L"UPDATE accounts SET balance = balance * 1.01");
+            }
+            EXPECT_EQ(execution.calls(), 6);
+            EXPECT_EQ(wrapper->freeStatementCount(), 1u);
+            EXPECT_TRUE(done.get());
+        }
+
+        /**
+         * @test Reactor_CompletionMayWaitForItsStatement
+         * @brief Tests that waiting for a statement from its own completion returns instead of blocking the reactor thread.
+         */
+        TEST_F(StatementTest, Reactor_CompletionMayWaitForItsStatement) {
+            AsyncReactor reactor;
+            StillExecuting execution(2, SQL_SUCCESS);
+            std::promise<void> waited;
+            std::future<void> done = waited.get_future();
+            reactor.submit(handle(2), execution, [&reactor, &waited](SQLRETURN) {
+                reactor.waitFor(handle(2)); // As releasing the statement or disconnecting would
+                waited.set_value();
+            });
+
+            ASSERT_EQ(done.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+            reactor.waitFor(handle(2));
+            EXPECT_EQ(reactor.pending(), 0u);
+        }
+
+        /**
+         * @test CreateStatement_EmptyIfNotConnected
+         * @brief Tests that no handle is allocated without a connection.
+         */
+        TEST_F(StatementTest, CreateStatement_EmptyIfNotConnected) {
+            wrapper->disconnect();
+            const int before = allocations;
+
+            Statement statement = wrapper->createStatement();
+            EXPECT_FALSE(statement);
+            EXPECT_FALSE(statement.execute(L"SELECT 1"));
+            EXPECT_EQ(statement.rowCount(), -1);
+            EXPECT_EQ(allocations, before);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_statement_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,271 @@
+#include <test_odbcwrapper.h>
+#include <odbccpp/transaction.h>
+#include <odbclogger.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using ps::odbc::OdbcLogger;
+
+namespace ps {
+    namespace test {
+        /**
+         * @class TransactionTest
+         * @brief Fixture that connects the wrapper and accepts any number of executed updates.
+         */
+        class TransactionTest : public ConnectedOdbcWrapperTest {
+        protected:
+            void SetUp() override {
+                ConnectedOdbcWrapperTest::SetUp();
+
+                EXPECT_CALL(*mock, SQLExecDirect(testing::_, testing::_, SQL_NTS))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+                EXPECT_CALL(*mock, SQLRowCount(testing::_, testing::_))
+                    .Times(testing::AnyNumber())
+                    .WillRepeatedly(testing::Return(SQL_SUCCESS));
+            }
+
+            /**
+             * @brief Expects manual-commit mode to be switched on once and off again at the end.
+             */
+            void expectAutocommitToggled() {
+                testing::InSequence sequence;
+                EXPECT_CALL(*mock, SQLSetConnectAttr(testing::_, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, testing::_))
+                    .WillOnce(testing::Return(SQL_SUCCESS));
+                EXPECT_CALL(*mock, SQLSetConnectAttr(testing::_, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, testing::_))
+                    .WillOnce(testing::Return(SQL_SUCCESS));
+            }
+        };
+
+        /**
+         * @test BeginCommit_SwitchesAutocommitAroundTheTransaction
+         * @brief Tests that a transaction turns autocommit off, commits the connection and turns autocommit back on.
+         */
+        TEST_F(TransactionTest, BeginCommit_SwitchesAutocommitAroundTheTransaction) {
+            OdbcLogger::logInfo("Entering BeginCommit_SwitchesAutocommitAroundTheTransaction");
+
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            EXPECT_TRUE(wrapper->beginTransaction());
+            EXPECT_TRUE(wrapper->inTransaction());
+            EXPECT_FALSE(wrapper->beginTransaction()); // No nesting
+            wrapper->executeUpdate(L"UPDATE accounts SET balance = balance - 10 WHERE id = 1");
+            wrapper->executeUpdate(L"UPDATE accounts SET balance = balance + 10 WHERE id = 2");
+            EXPECT_TRUE(wrapper->commit());
+            EXPECT_FALSE(wrapper->inTransaction());
+            EXPECT_FALSE(wrapper->rollback()); // Nothing left to roll back
+
+            OdbcLogger::logInfo("Exiting BeginCommit_SwitchesAutocommitAroundTheTransaction");
+        }
+
+        /**
+         * @test BeginTransaction_FailsIfNotConnected
+         * @brief Tests that no transaction starts without a connection.
+         */
+        TEST_F(TransactionTest, BeginTransaction_FailsIfNotConnected) {
+            wrapper->disconnect();
+            EXPECT_CALL(*mock, SQLSetConnectAttr(testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+            EXPECT_FALSE(wrapper->beginTransaction());
+            EXPECT_THROW(Transaction transaction(*wrapper), std::runtime_error);
+        }
+
+        /**
+         * @test Guard_RollsBackUnlessCommitted
+         * @brief Tests that a guard leaving scope without commit() rolls the transaction back.
+         */
+        TEST_F(TransactionTest, Guard_RollsBackUnlessCommitted) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT)).Times(0);
+
+            try {
+                Transaction transaction(*wrapper);
+                wrapper->executeUpdate(L"DELETE FROM orders WHERE id = 7");
+                throw std::runtime_error("Application failure");
+            } catch (const std::runtime_error&) {
+            }
+
+            EXPECT_FALSE(wrapper->inTransaction());
+        }
+
+        /**
+         * @test Guard_CommitFailureRollsBackOnDestruction
+         * @brief Tests that a failed commit is thrown and the guard then rolls back.
+         */
+        TEST_F(TransactionTest, Guard_CommitFailureRollsBackOnDestruction) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT)).WillOnce(testing::Return(SQL_ERROR));
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            {
+                Transaction transaction(*wrapper);
+                EXPECT_THROW(transaction.commit(), std::runtime_error);
+                EXPECT_TRUE(transaction.active());
+            }
+
+            EXPECT_FALSE(wrapper->inTransaction());
+        }
+
+        /**
+         * @test Guard_UncommittedCommitStaysActive
+         * @brief Tests that a commit the driver rejects without SQL_ERROR returns false and leaves the guard to roll back.
+         */
+        TEST_F(TransactionTest, Guard_UncommittedCommitStaysActive) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT)).WillOnce(testing::Return(SQL_INVALID_HANDLE));
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            {
+                Transaction transaction(*wrapper);
+                EXPECT_FALSE(transaction.commit());
+                EXPECT_TRUE(transaction.active());
+                EXPECT_TRUE(wrapper->inTransaction());
+            }
+
+            EXPECT_FALSE(wrapper->inTransaction());
+        }
+
+        /**
+         * @test Disconnect_RollsBackOpenTransaction
+         * @brief Tests that disconnecting in the middle of a transaction rolls it back and restores autocommit.
+         */
+        TEST_F(TransactionTest, Disconnect_RollsBackOpenTransaction) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            wrapper->beginTransaction();
+            wrapper->disconnect();
+
+            EXPECT_FALSE(wrapper->inTransaction());
+        }
+
+        /**
+         * @test Batched_CommitsEveryBatchSizeStatements
+         * @brief Tests that a batcher commits every N statements without leaving manual-commit mode in between.
+         */
+        TEST_F(TransactionTest, Batched_CommitsEveryBatchSizeStatements) {
+            OdbcLogger::logInfo("Entering Batched_CommitsEveryBatchSizeStatements");
+
+            expectAutocommitToggled(); // Once for the whole run, not once per batch
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT))
+                .Times(3)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            BatchedTransaction batch(*wrapper, 3);
+            for (int i = 0; i < 7; i++) {
+                EXPECT_TRUE(batch.executeUpdate(L"INSERT INTO events (kind) VALUES ('click')"));
+            }
+            EXPECT_EQ(batch.commits(), 2u);
+            EXPECT_EQ(batch.pending(), 1u);
+            EXPECT_TRUE(wrapper->inTransaction());
+
+            EXPECT_TRUE(batch.commit());
+            EXPECT_EQ(batch.commits(), 3u);
+            EXPECT_FALSE(batch.active());
+            EXPECT_FALSE(wrapper->inTransaction());
+
+            OdbcLogger::logInfo("Exiting Batched_CommitsEveryBatchSizeStatements");
+        }
+
+        /**
+         * @test Batched_CommitsOnceBatchIsOlderThanMaxDelay
+         * @brief Tests that a batch is committed by the first statement recorded after its delay has passed.
+         */
+        TEST_F(TransactionTest, Batched_CommitsOnceBatchIsOlderThanMaxDelay) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT))
+                .Times(2)
+                .WillRepeatedly(testing::Return(SQL_SUCCESS));
+
+            BatchedTransaction batch(*wrapper, 1000, std::chrono::milliseconds(20));
+            batch.recordStatement();
+            EXPECT_EQ(batch.commits(), 0u);
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            batch.recordStatement();
+            EXPECT_EQ(batch.commits(), 1u);
+            EXPECT_EQ(batch.pending(), 0u);
+
+            batch.commit(); // Nothing pending: ends the transaction without counting a batch
+            EXPECT_EQ(batch.commits(), 1u);
+        }
+
+        /**
+         * @test Batched_FailedBatchCommitKeepsStatementsPending
+         * @brief Tests that a batch whose commit fails is neither counted nor forgotten.
+         */
+        TEST_F(TransactionTest, Batched_FailedBatchCommitKeepsStatementsPending) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT))
+                .WillOnce(testing::Return(SQL_INVALID_HANDLE))
+                .WillOnce(testing::Return(SQL_SUCCESS))
+                .WillOnce(testing::Return(SQL_SUCCESS));
+
+            BatchedTransaction batch(*wrapper, 2);
+            batch.recordStatement();
+            batch.recordStatement(); // Commit fails
+            EXPECT_EQ(batch.commits(), 0u);
+            EXPECT_EQ(batch.pending(), 2u);
+
+            batch.recordStatement(); // Commits all three
+            EXPECT_EQ(batch.commits(), 1u);
+            EXPECT_EQ(batch.pending(), 0u);
+
+            EXPECT_TRUE(batch.commit());
+            EXPECT_EQ(batch.commits(), 1u);
+        }
+
+        /**
+         * @test Batched_CommitFailureRollsBackOnDestruction
+         * @brief Tests that a failed final commit keeps the batch pending and the batcher then rolls back.
+         */
+        TEST_F(TransactionTest, Batched_CommitFailureRollsBackOnDestruction) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT))
+                .WillOnce(testing::Return(SQL_ERROR))
+                .WillOnce(testing::Return(SQL_INVALID_HANDLE));
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            {
+                BatchedTransaction batch(*wrapper, 10);
+                batch.recordStatement();
+                EXPECT_THROW(batch.commit(), std::runtime_error);
+                EXPECT_TRUE(batch.active());
+                EXPECT_FALSE(batch.commit());
+                EXPECT_TRUE(batch.active());
+                EXPECT_EQ(batch.pending(), 1u);
+                EXPECT_EQ(batch.commits(), 0u);
+            }
+
+            EXPECT_FALSE(wrapper->inTransaction());
+        }
+
+        /**
+         * @test Batched_DestructionRollsBackOpenBatch
+         * @brief Tests that only the batch still open on destruction is rolled back.
+         */
+        TEST_F(TransactionTest, Batched_DestructionRollsBackOpenBatch) {
+            expectAutocommitToggled();
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_COMMIT)).WillOnce(testing::Return(SQL_SUCCESS));
+            EXPECT_CALL(*mock, SQLEndTran(SQL_HANDLE_DBC, testing::_, SQL_ROLLBACK)).WillOnce(testing::Return(SQL_SUCCESS));
+
+            {
+                BatchedTransaction batch(*wrapper, 2);
+                batch.recordStatement();
+                batch.recordStatement(); // Committed
+                batch.recordStatement(); // Rolled back
+            }
+
+            EXPECT_FALSE(wrapper->inTransaction());
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    OdbcLogger::initialize("logs/odbc_transaction_test.log");
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}